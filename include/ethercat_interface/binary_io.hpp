@@ -0,0 +1,170 @@
+/**
+ * @file binary_io.hpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief Helpers for the binary snapshot files kept next to the configuration file.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef BINARY_IO_HPP_
+#define BINARY_IO_HPP_
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <type_traits>
+
+namespace ec
+{
+    namespace binary
+    {
+
+        class BinaryWriter
+        {
+            public:
+
+            template<typename T>
+            void write(const T& value)
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                const auto bytes = reinterpret_cast<const uint8_t*>(&value);
+                m_Buffer.insert(m_Buffer.end(), bytes, bytes + sizeof(T));
+            }
+
+            void write(const std::string& value)
+            {
+                write((uint32_t)value.size());
+                m_Buffer.insert(m_Buffer.end(), value.begin(), value.end());
+            }
+
+            std::vector<uint8_t>& getBuffer()
+            {
+                return m_Buffer;
+            }
+
+            private:
+
+            std::vector<uint8_t> m_Buffer;
+        };
+
+        /**
+         * @brief Bounds checked reader, every read fails once the end of the data is passed.
+         *
+         */
+        class BinaryReader
+        {
+            public:
+
+            BinaryReader(const uint8_t* data, std::size_t size)
+                : m_Data(data), m_Size(size)
+            {
+
+            }
+
+            template<typename T>
+            bool read(T& value)
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                if(m_Position + sizeof(T) > m_Size){
+                    return false;
+                }
+                std::memcpy(&value, m_Data + m_Position, sizeof(T));
+                m_Position += sizeof(T);
+                return true;
+            }
+
+            bool read(std::string& value)
+            {
+                uint32_t length = 0;
+                if(!read(length) || m_Position + length > m_Size){
+                    return false;
+                }
+                value.assign(reinterpret_cast<const char*>(m_Data + m_Position), length);
+                m_Position += length;
+                return true;
+            }
+
+            /**
+             * @brief Reads an enumerator and fails if its value is outside [first, last], so a corrupted byte
+             * is not turned into an enumerator the rest of the code does not handle.
+             *
+             */
+            template<typename T>
+            bool readEnum(T& value, T first, T last)
+            {
+                static_assert(std::is_enum_v<T>);
+                using Underlying = std::underlying_type_t<T>;
+                Underlying raw;
+                if(!read(raw) || raw < (Underlying)first || raw > (Underlying)last){
+                    return false;
+                }
+                value = (T)raw;
+                return true;
+            }
+
+            /**
+             * @brief Reads the number of elements that follow and fails if the rest of the data is too short to hold them,
+             * so a corrupted count fails here instead of allocating the elements.
+             *
+             * @param min_element_size Fewest bytes one element takes in the data.
+             */
+            bool readCount(uint32_t& count, std::size_t min_element_size)
+            {
+                return read(count) && count <= remaining() / min_element_size;
+            }
+
+            std::size_t remaining() const
+            {
+                return m_Size - m_Position;
+            }
+
+            bool isAtEnd() const
+            {
+                return m_Position == m_Size;
+            }
+
+            private:
+
+            const uint8_t* m_Data;
+
+            std::size_t m_Size;
+
+            std::size_t m_Position = 0;
+        };
+
+        /**
+         * @brief Writes the data next to the given path and renames it over the file,
+         * so a concurrent start never reads a half written file.
+         *
+         */
+        inline bool writeFileAtomically(const std::string& path, const std::vector<uint8_t>& data)
+        {
+            const std::string temporaryPath = path + ".tmp";
+            std::FILE* file = std::fopen(temporaryPath.c_str(), "wb");
+            if(!file){
+                return false;
+            }
+
+            const bool writeOk = std::fwrite(data.data(), 1, data.size(), file) == data.size();
+            if(std::fclose(file) != 0 || !writeOk){
+                std::remove(temporaryPath.c_str());
+                return false;
+            }
+
+            if(std::rename(temporaryPath.c_str(), path.c_str()) != 0){
+                std::remove(temporaryPath.c_str());
+                return false;
+            }
+
+            return true;
+        }
+
+    } // End of namespace binary
+} // End of namespace ec
+
+#endif // BINARY_IO_HPP_
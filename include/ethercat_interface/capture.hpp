@@ -0,0 +1,358 @@
+/**
+ * @file capture.hpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief Columnar capture format for long running process data logs.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef CAPTURE_HPP_
+#define CAPTURE_HPP_
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <atomic>
+#include <thread>
+#include <optional>
+#include <cstdio>
+#include <cstdint>
+
+#include "ec_common_defs.hpp"
+
+namespace ec
+{
+    namespace capture
+    {
+
+        constexpr char CaptureMagic[8] = {'E', 'C', 'C', 'A', 'P', '0', '0', '1'};
+
+        /**
+         * @brief Name of the column that holds the sample timestamps, always column 0.
+         *
+         */
+        const std::string TimestampColumnName = "timestamp";
+
+        enum class ColumnEncoding : uint8_t
+        {
+            /**
+             * @brief Difference to the previous sample, zig-zag mapped and stored as LEB128 varint.
+             *
+             */
+            DeltaVarint,
+
+            /**
+             * @brief 8 bytes per sample, used for floating point columns.
+             *
+             */
+            Raw
+        };
+
+        /**
+         * @brief Index entry of a column chunk, written to the footer of the file.
+         *
+         */
+        struct ChunkInfo
+        {
+            uint32_t columnID;
+
+            uint32_t sampleCount;
+
+            uint64_t rowGroup;
+
+            uint64_t fileOffset;
+
+            uint64_t byteSize;
+
+            uint64_t firstTimestamp;
+
+            uint64_t lastTimestamp;
+
+            /**
+             * @brief Smallest sample in the chunk, double bit pattern for floating point columns.
+             *
+             */
+            int64_t min;
+
+            int64_t max;
+
+            ColumnEncoding encoding;
+        };
+
+        struct ColumnInfo
+        {
+            std::string name;
+
+            DataType type;
+        };
+
+        /**
+         * @brief Samples of one column loaded from a capture file.
+         * Integer samples are kept as their 64 bit two's complement value,
+         * floating point samples as the bit pattern of a double.
+         */
+        struct ColumnSeries
+        {
+            DataType type;
+
+            std::vector<uint64_t> timestamps;
+
+            std::vector<int64_t> rawValues;
+
+            double at(std::size_t sample_index) const;
+        };
+
+        /**
+         * @brief Appends a LEB128 varint to the buffer.
+         *
+         */
+        void encodeVarint(uint64_t value, std::vector<uint8_t>& buffer);
+
+        /**
+         * @brief Reads a LEB128 varint, advances the position.
+         *
+         * @return std::nullopt if the buffer ends inside the varint.
+         */
+        std::optional<uint64_t> decodeVarint(const uint8_t* buffer, std::size_t size, std::size_t& position);
+
+        inline uint64_t zigZagEncode(int64_t value)
+        {
+            return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+        }
+
+        inline int64_t zigZagDecode(uint64_t value)
+        {
+            return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+        }
+
+        inline bool isRealType(DataType type)
+        {
+            return type == DataType::FLOAT || type == DataType::DOUBLE;
+        }
+
+        /**
+         * @brief Captures PDO entries cycle by cycle and stores every entry as its own column.
+         * Samples are buffered into row groups of chunk_size samples, a full row group
+         * is encoded and written by a background thread while the cyclic thread fills the next one.
+         */
+        class CaptureWriter
+        {
+            public:
+
+            CaptureWriter();
+
+            ~CaptureWriter();
+
+            CaptureWriter(const CaptureWriter&) = delete;
+            CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+            /**
+             * @brief Adds a column that is sampled from the given process data location.
+             * Columns can only be added before open().
+             *
+             * @param name Name of the column, usually "<slave_name>.<entry_name>".
+             * @param type Type of the PDO entry.
+             * @param source Pointer to the entry inside the domain data.
+             * @return false If the column name is already used or the writer is open.
+             */
+            bool addColumn(const std::string& name, DataType type, const uint8_t* source);
+
+            bool open(const std::string& path, std::size_t chunk_size = 4096);
+
+            std::optional<std::size_t> findColumn(const std::string& name) const;
+
+            inline std::size_t getColumnCount() const
+            {
+                return m_Columns.size();
+            }
+
+            /**
+             * @brief Enables or disables sampling of a column, a disabled column repeats its last sample
+             * so the row groups stay aligned while costing about a byte per sample.
+             * Must be called from the thread that calls sample().
+             *
+             */
+            void setColumnEnabled(std::size_t column_index, bool enabled);
+
+            /**
+             * @brief Writes the buffered samples and the footer, closes the file.
+             *
+             * @return false If any row group or the footer could not be written. The footer is written after the
+             * last complete row group, so the samples written before the failure stay readable.
+             */
+            bool close();
+
+            /**
+             * @brief Samples all columns. Safe to call from the cyclic thread.
+             *
+             * @param timestamp Timestamp of the cycle in nanoseconds.
+             * @return false If the previous row group is still being written and the sample is dropped.
+             */
+            bool sample(uint64_t timestamp);
+
+            inline bool isOpen() const
+            {
+                return m_File != nullptr;
+            }
+
+            inline uint64_t droppedSamples() const
+            {
+                return m_DroppedSamples.load(std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief True after a row group could not be written, the following row groups are dropped.
+             *
+             */
+            inline bool hasWriteFailed() const
+            {
+                return m_HasWriteFailed.load(std::memory_order_relaxed);
+            }
+
+            private:
+
+            struct RowGroup
+            {
+                std::vector<uint64_t> timestamps;
+
+                /**
+                 * @brief Column major samples, column i starts at i * chunk size.
+                 *
+                 */
+                std::vector<int64_t> values;
+
+                std::size_t rows = 0;
+            };
+
+            std::vector<ColumnInfo> m_Columns;
+
+            std::vector<const uint8_t*> m_Sources;
+
+            std::vector<uint8_t> m_ColumnEnabled;
+
+            std::vector<int64_t> m_LastSamples;
+
+            std::FILE* m_File = nullptr;
+
+            uint64_t m_FileOffset = 0;
+
+            std::size_t m_ChunkSize = 0;
+
+            RowGroup m_RowGroups[2];
+
+            std::size_t m_ActiveRowGroup = 0;
+
+            uint64_t m_RowGroupCounter = 0;
+
+            std::vector<ChunkInfo> m_Chunks;
+
+            std::vector<uint8_t> m_EncodeBuffer;
+
+            std::atomic<bool> m_IsFlushPending{false};
+
+            std::atomic<bool> m_IsWriterRunning{false};
+
+            std::atomic<uint64_t> m_DroppedSamples{0};
+
+            std::atomic<bool> m_HasWriteFailed{false};
+
+            std::thread m_WriterThread;
+
+            void writerLoop();
+
+            void writeRowGroup(RowGroup& row_group);
+
+            bool writeChunk(uint32_t column_id, DataType type, const int64_t* samples, const RowGroup& row_group);
+
+            bool writeFooter();
+
+            static int64_t readSource(DataType type, const uint8_t* source);
+        };
+
+        /**
+         * @brief Reads single columns from a capture file without loading the others.
+         *
+         */
+        class CaptureReader
+        {
+            public:
+
+            CaptureReader();
+
+            ~CaptureReader();
+
+            CaptureReader(const CaptureReader&) = delete;
+            CaptureReader& operator=(const CaptureReader&) = delete;
+
+            bool open(const std::string& path);
+
+            void close();
+
+            inline const std::vector<ColumnInfo>& getColumns() const
+            {
+                return m_Columns;
+            }
+
+            inline const std::vector<ChunkInfo>& getChunks() const
+            {
+                return m_Chunks;
+            }
+
+            /**
+             * @brief Loads the samples of one column within [begin_timestamp, end_timestamp].
+             * Only the chunks whose time range overlaps the requested range are read.
+             *
+             * @return std::nullopt If the column does not exist or the file is corrupted.
+             */
+            std::optional<ColumnSeries> readColumn(
+                const std::string& column_name,
+                uint64_t begin_timestamp = 0,
+                uint64_t end_timestamp = UINT64_MAX
+            );
+
+            /**
+             * @brief Smallest and largest sample of one column within [begin_timestamp, end_timestamp].
+             * Chunks that lie completely inside the range are answered from the min and max of their index entry,
+             * only the chunks at the ends of the range are read.
+             *
+             * @return std::nullopt If the column does not exist, has no samples in the range or the file is corrupted.
+             */
+            std::optional<std::pair<double, double>> readColumnBounds(
+                const std::string& column_name,
+                uint64_t begin_timestamp = 0,
+                uint64_t end_timestamp = UINT64_MAX
+            );
+
+            private:
+
+            std::FILE* m_File = nullptr;
+
+            std::vector<ColumnInfo> m_Columns;
+
+            std::vector<ChunkInfo> m_Chunks;
+
+            /**
+             * @brief Position of the timestamp chunk of each row group in m_Chunks.
+             *
+             */
+            std::unordered_map<uint64_t, std::size_t> m_TimestampChunks;
+
+            std::optional<uint32_t> findColumnID(const std::string& column_name) const;
+
+            bool readChunk(const ChunkInfo& chunk, std::vector<int64_t>& samples);
+
+            /**
+             * @brief Appends the samples of the chunk within [begin_timestamp, end_timestamp] to the series.
+             *
+             */
+            bool readChunkInRange(const ChunkInfo& chunk, uint64_t begin_timestamp, uint64_t end_timestamp, ColumnSeries& series);
+        };
+
+    } // End of namespace capture
+} // End of namespace ec
+
+#endif // CAPTURE_HPP_
@@ -0,0 +1,75 @@
+/**
+ * @file config_cache.hpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief Binary snapshot of the parsed program configuration.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef CONFIG_CACHE_HPP_
+#define CONFIG_CACHE_HPP_
+
+#include <string>
+#include <vector>
+#include <optional>
+#include <cstdint>
+
+#include "ec_common_defs.hpp"
+
+namespace ec
+{
+    namespace parser
+    {
+        namespace cache
+        {
+
+            constexpr char CacheMagic[8] = {'E', 'C', 'C', 'F', 'G', '0', '0', '1'};
+
+            /**
+             * @brief Must be incremented whenever the serialized layout of ProgramConfig changes.
+             *
+             */
+            constexpr uint32_t CacheVersion = 10;
+
+            /**
+             * @brief 64 bit FNV-1a hash of the configuration file content.
+             *
+             */
+            uint64_t hashContent(const std::string& content);
+
+            /**
+             * @brief Serializes the program configuration into a compact binary snapshot.
+             *
+             * @param content_hash Hash of the YAML content the configuration was parsed from.
+             */
+            std::vector<uint8_t> serialize(const ProgramConfig& program_config, uint64_t content_hash);
+
+            /**
+             * @brief Deserializes a snapshot created by serialize().
+             *
+             * @return std::nullopt If the snapshot is corrupted, of another version or of another content hash.
+             * An enum field outside the range of its type counts as corrupted.
+             */
+            std::optional<ProgramConfig> deserialize(const uint8_t* data, std::size_t size, uint64_t content_hash);
+
+            /**
+             * @brief Writes the snapshot to a temporary file and renames it over the cache file.
+             *
+             */
+            bool writeCacheFile(const std::string& path_to_cache_file, const ProgramConfig& program_config, uint64_t content_hash);
+
+            /**
+             * @brief Memory-maps the cache file and deserializes it.
+             *
+             * @return std::nullopt If the file does not exist or does not match the content hash.
+             */
+            std::optional<ProgramConfig> readCacheFile(const std::string& path_to_cache_file, uint64_t content_hash);
+
+        } // End of namespace cache
+    } // End of namespace parser
+} // End of namespace ec
+
+#endif // CONFIG_CACHE_HPP_
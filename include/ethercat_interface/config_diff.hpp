@@ -0,0 +1,72 @@
+/**
+ * @file config_diff.hpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief Comparison of two program configurations for hot reloading.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef CONFIG_DIFF_HPP_
+#define CONFIG_DIFF_HPP_
+
+#include <string>
+#include <vector>
+
+#include "ec_common_defs.hpp"
+
+namespace ec
+{
+    namespace parser
+    {
+
+        /**
+         * @brief Result of comparing the active configuration with a reloaded one.
+         *
+         */
+        struct ConfigDiff
+        {
+            /**
+             * @brief Changes that can be applied while the master is cycling, one line per change.
+             *
+             */
+            std::vector<std::string> tunableChanges;
+
+            /**
+             * @brief Changes that require the master to be re-activated, one line per change.
+             *
+             */
+            std::vector<std::string> structuralChanges;
+
+            /**
+             * @brief Indices into the reloaded configuration's slaves whose SlaveTuning changed.
+             *
+             */
+            std::vector<std::size_t> retunedSlaves;
+
+            inline bool isStructural() const
+            {
+                return !structuralChanges.empty();
+            }
+
+            inline bool isEmpty() const
+            {
+                return tunableChanges.empty() && structuralChanges.empty();
+            }
+        };
+
+        /**
+         * @brief Compares the configurations slave by slave, slaves are matched by their names.
+         * Anything that changes the PDO mapping, the addressing of a slave, the startup SDOs,
+         * the DC configuration or the cycle period is structural. Cycle divisors, telemetry selections and scaling
+         * factors are tunable.
+         *
+         */
+        ConfigDiff diffConfigs(const ProgramConfig& active_config, const ProgramConfig& reloaded_config);
+
+    } // End of namespace parser
+} // End of namespace ec
+
+#endif // CONFIG_DIFF_HPP_
@@ -0,0 +1,295 @@
+/**
+ * @file axis_group.hpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief Steps the CiA 402 state machines of all drives of a domain together.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef AXIS_GROUP_HPP_
+#define AXIS_GROUP_HPP_
+
+#include "ethercat_interface/driver/driver_state_machine.hpp"
+#include "ethercat_interface/slave.hpp"
+
+#include <atomic>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace CIA402
+{
+
+    enum class FaultResetPolicy : uint8_t
+    {
+        /**
+         * @brief A fault is only reset after AxisGroup::requestFaultReset().
+         *
+         */
+        Manual,
+
+        /**
+         * @brief A fault is reset as soon as it is reported, if the target state is not Fault.
+         *
+         */
+        Automatic
+    };
+
+    enum class GroupOperationStatus : uint8_t
+    {
+        Idle,
+        InProgress,
+        Done,
+
+        /**
+         * @brief Not all axes got there in time, every axis is sent to SwitchOnDisabled.
+         *
+         */
+        TimedOut,
+
+        /**
+         * @brief An axis faulted during the operation, every axis is sent to SwitchOnDisabled.
+         *
+         */
+        Faulted
+    };
+
+    /**
+     * @brief What an axis did during the last enable() or disable().
+     *
+     */
+    struct AxisDiagnostics
+    {
+        /**
+         * @brief Cycle of the operation the axis reached the state the group waits for, -1 if it did not.
+         *
+         */
+        int32_t readyCycle = -1;
+
+        /**
+         * @brief State of the axis when the operation ended or at the last update().
+         *
+         */
+        State lastState = State::Unknown;
+
+        bool faulted = false;
+    };
+
+    /**
+     * @brief Offsets of an axis' status word and control word in the domain.
+     *
+     */
+    struct AxisEntries
+    {
+        uint32_t statusWordOffset;
+
+        uint32_t controlWordOffset;
+
+        /**
+         * @brief Stale flag of the slave of the axis, nullptr if it is never stale.
+         *
+         */
+        const std::atomic<bool>* staleFlag = nullptr;
+    };
+
+    /**
+     * @brief CiA 402 controller for the drives of one domain.
+     * The axes are kept as parallel arrays: update() gathers all status words, decodes all states,
+     * computes all control words, then writes them back, each in one loop over the group.
+     * An axis whose slave is stale is held: its status word is not read and its control word is not written,
+     * so it keeps the state it was last seen in until the slave is back.
+     * Everything is allocated on construction, update() is meant to be called by the cyclic thread
+     * between receiveDomainData() and sendDomainData().
+     *
+     */
+    class AxisGroup
+    {
+    public:
+
+        AxisGroup(uint8_t* domain_data, const std::vector<AxisEntries>& axes);
+
+        /**
+         * @brief Creates a group of the drives, which have to be in the same domain.
+         *
+         * @return std::nullopt If a drive misses one of the entries or the drives are in different domains.
+         */
+        static std::optional<AxisGroup> fromDrivers(
+            const std::vector<ec::slave::Driver*>& drivers,
+            const std::string& status_word_name = "status_word",
+            const std::string& control_word_name = "control_word"
+        );
+
+        /**
+         * @brief Steps every axis one transition towards its target state.
+         *
+         */
+        void update();
+
+        std::size_t size() const
+        {
+            return m_StatusWordOffsets.size();
+        }
+
+        void setTargetState(std::size_t axis, State target_state)
+        {
+            m_TargetStates[axis] = target_state;
+        }
+
+        void setTargetState(State target_state);
+
+        State getTargetState(std::size_t axis) const
+        {
+            return m_TargetStates[axis];
+        }
+
+        void setFaultResetPolicy(std::size_t axis, FaultResetPolicy policy)
+        {
+            m_FaultResetPolicies[axis] = policy;
+        }
+
+        void setFaultResetPolicy(FaultResetPolicy policy);
+
+        /**
+         * @brief Resets the fault of an axis with the manual policy, the request is dropped once the axis left Fault.
+         *
+         */
+        void requestFaultReset(std::size_t axis)
+        {
+            m_FaultResetRequests[axis] = 1;
+        }
+
+        /**
+         * @brief State decoded by the last update().
+         *
+         */
+        State getState(std::size_t axis) const
+        {
+            return m_States[axis];
+        }
+
+        uint16_t getStatusWord(std::size_t axis) const
+        {
+            return m_StatusWords[axis];
+        }
+
+        uint16_t getControlWord(std::size_t axis) const
+        {
+            return m_ControlWords[axis];
+        }
+
+        /**
+         * @brief Whether every axis was in its target state at the last update().
+         *
+         */
+        bool isTargetReached() const;
+
+        /**
+         * @brief Enables all axes together: each axis is brought to SwitchedOn as fast as it goes,
+         * and once the slowest one is there, enable operation is commanded to all axes in the same cycle.
+         * Replaces the target states, progress is made by update().
+         *
+         * @param timeout_cycles Number of updates the axes get to reach OperationEnabled.
+         */
+        void enable(uint32_t timeout_cycles);
+
+        /**
+         * @brief Disables operation of all axes in the same cycle, they are left in SwitchedOn.
+         *
+         */
+        void disable(uint32_t timeout_cycles);
+
+        GroupOperationStatus getOperationStatus() const
+        {
+            return m_OperationStatus;
+        }
+
+        /**
+         * @brief Number of updates the current or last operation took.
+         *
+         */
+        uint32_t getOperationCycles() const
+        {
+            return m_OperationCycles;
+        }
+
+        const AxisDiagnostics& getAxisDiagnostics(std::size_t axis) const
+        {
+            return m_Diagnostics[axis];
+        }
+
+    private:
+
+        uint8_t* m_DomainData = nullptr;
+
+        std::vector<uint32_t> m_StatusWordOffsets;
+
+        std::vector<uint32_t> m_ControlWordOffsets;
+
+        std::vector<const std::atomic<bool>*> m_StaleFlags;
+
+        /**
+         * @brief 1 for the axes of stale slaves, gathered by every update().
+         *
+         */
+        std::vector<uint8_t> m_HeldAxes;
+
+        std::vector<uint16_t> m_StatusWords;
+
+        std::vector<uint16_t> m_ControlWords;
+
+        std::vector<uint8_t> m_StateIndices;
+
+        std::vector<State> m_States;
+
+        std::vector<State> m_TargetStates;
+
+        std::vector<FaultResetPolicy> m_FaultResetPolicies;
+
+        std::vector<uint8_t> m_FaultResetRequests;
+
+        enum class GroupOperation : uint8_t
+        {
+            None,
+            Enable,
+            Disable
+        };
+
+        GroupOperation m_Operation = GroupOperation::None;
+
+        GroupOperationStatus m_OperationStatus = GroupOperationStatus::Idle;
+
+        uint32_t m_OperationCycles = 0;
+
+        uint32_t m_OperationTimeout = 0;
+
+        /**
+         * @brief Whether enable operation has been commanded to all axes.
+         *
+         */
+        bool m_IsEnableCommanded = false;
+
+        std::vector<AxisDiagnostics> m_Diagnostics;
+
+        /**
+         * @brief Axes that were in a fault at the first update of the operation, their fault does not abort it.
+         *
+         */
+        std::vector<uint8_t> m_FaultedAtStart;
+
+        void startOperation(GroupOperation operation, uint32_t timeout_cycles, State target_state);
+
+        /**
+         * @brief Advances the current enable() or disable() with the states decoded in this update.
+         *
+         */
+        void stepOperation();
+
+        void finishOperation(GroupOperationStatus status);
+    };
+
+} // End of namespace CIA402
+
+#endif // AXIS_GROUP_HPP_
@@ -0,0 +1,264 @@
+/**
+ * @file controller_bank.hpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief PID loops of many axes, updated together every cycle.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef CONTROLLER_BANK_HPP_
+#define CONTROLLER_BANK_HPP_
+
+#include "ethercat_interface/slave.hpp"
+
+#include <atomic>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace ec
+{
+    namespace motion
+    {
+
+        /**
+         * @brief Gains and limits of one loop. The output is kp * error + integral + kd * derivative + feed-forward,
+         * the integral accumulates ki * error * cycle time and the derivative is taken of the negated actual value,
+         * so setpoint steps do not kick the output.
+         *
+         */
+        struct PidGains
+        {
+            double kp = 0.0;
+
+            double ki = 0.0;
+
+            double kd = 0.0;
+
+            double outputMin = std::numeric_limits<double>::lowest();
+
+            double outputMax = std::numeric_limits<double>::max();
+
+            double integralMin = std::numeric_limits<double>::lowest();
+
+            double integralMax = std::numeric_limits<double>::max();
+
+            /**
+             * @brief Weight of the previous derivative in the first order filter of the derivative, 0 for no filtering.
+             *
+             */
+            double derivativeFilter = 0.0;
+        };
+
+        /**
+         * @brief Entry an axis' actual value is read from and entry its output is written to.
+         *
+         */
+        struct ControllerEntries
+        {
+            uint32_t actualOffset;
+
+            ec::DataType actualType;
+
+            uint32_t outputOffset;
+
+            ec::DataType outputType;
+
+            /**
+             * @brief Stale flag of the slave of the axis, nullptr if it is never stale.
+             *
+             */
+            const std::atomic<bool>* staleFlag = nullptr;
+        };
+
+        /**
+         * @brief PID controllers of the axes of one domain, e.g. position loops closed over drives in cyclic synchronous
+         * velocity or torque mode. The gains, states and values of the axes are kept as parallel arrays: update()
+         * gathers all actual values, runs all loops in branch free blocks the compiler vectorizes, then writes
+         * the outputs of the enabled axes. The loop of an axis whose slave is stale is held: its actual value is not
+         * read, its states are kept and nothing is written until the slave is back. Everything is allocated on
+         * construction. The bank is not faster than one controller object per axis, the type dispatch of the
+         * gather and scatter costs what the vectorized loops save, see controller_bank_benchmark.
+         *
+         */
+        class ControllerBank
+        {
+            public:
+
+            /**
+             * @param cycle_time Time between two update() calls in seconds.
+             */
+            ControllerBank(uint8_t* domain_data, const std::vector<ControllerEntries>& axes, double cycle_time);
+
+            /**
+             * @brief Creates the controllers of the drives, which have to be in the same domain.
+             *
+             * @param actual_entry_name Entry the loop is closed over, e.g. "actual_position".
+             * @param output_entry_name Entry the output is written to, e.g. "target_velocity" or "target_torque".
+             * @return std::nullopt If a drive misses one of the entries or the drives are in different domains.
+             */
+            static std::optional<ControllerBank> fromDrivers(
+                const std::vector<ec::slave::Driver*>& drivers,
+                const std::string& actual_entry_name,
+                const std::string& output_entry_name,
+                double cycle_time
+            );
+
+            /**
+             * @brief Runs the loops of all axes once.
+             *
+             */
+            void update();
+
+            std::size_t size() const
+            {
+                return m_Entries.size();
+            }
+
+            void setGains(std::size_t axis, const PidGains& gains);
+
+            void setGains(const PidGains& gains);
+
+            /**
+             * @brief Enabled axes write their output every update. A disabled axis writes nothing
+             * and its integral and derivative are cleared, so it restarts without a bump.
+             *
+             */
+            void setEnabled(std::size_t axis, bool is_enabled)
+            {
+                m_EnableMasks[axis] = is_enabled ? 1.0 : 0.0;
+            }
+
+            void setEnabled(bool is_enabled);
+
+            bool isEnabled(std::size_t axis) const
+            {
+                return m_EnableMasks[axis] != 0.0;
+            }
+
+            void setSetpoint(std::size_t axis, double setpoint)
+            {
+                m_Setpoints[axis] = setpoint;
+            }
+
+            /**
+             * @brief Value added to the output, e.g. the velocity of the trajectory in a position loop.
+             *
+             */
+            void setFeedForward(std::size_t axis, double feed_forward)
+            {
+                m_FeedForwards[axis] = feed_forward;
+            }
+
+            /**
+             * @brief Actual value read by the last update().
+             *
+             */
+            double getActual(std::size_t axis) const
+            {
+                return m_Actuals[axis];
+            }
+
+            double getError(std::size_t axis) const
+            {
+                return m_Errors[axis];
+            }
+
+            double getIntegral(std::size_t axis) const
+            {
+                return m_Integrals[axis];
+            }
+
+            /**
+             * @brief Output computed by the last update(), 0 for a disabled axis.
+             *
+             */
+            double getOutput(std::size_t axis) const
+            {
+                return m_Outputs[axis];
+            }
+
+            private:
+
+            /**
+             * @brief Number of axes the loops are run for at once. The arrays are padded to a multiple of it
+             * with disabled axes, so every block is a loop of known length.
+             *
+             */
+            static constexpr std::size_t BlockSize = 4;
+
+            static std::size_t getPaddedSize(std::size_t axis_count)
+            {
+                return (axis_count + BlockSize - 1) / BlockSize * BlockSize;
+            }
+
+            uint8_t* m_DomainData = nullptr;
+
+            std::vector<ControllerEntries> m_Entries;
+
+            double m_CycleTime = 0.0;
+
+            // Gains and limits.
+
+            std::vector<double> m_Kp;
+
+            std::vector<double> m_Ki;
+
+            std::vector<double> m_Kd;
+
+            std::vector<double> m_OutputMins;
+
+            std::vector<double> m_OutputMaxs;
+
+            std::vector<double> m_IntegralMins;
+
+            std::vector<double> m_IntegralMaxs;
+
+            std::vector<double> m_DerivativeFilters;
+
+            /**
+             * @brief 1 for enabled axes, 0 for disabled ones, multiplied into the states instead of branching.
+             *
+             */
+            std::vector<double> m_EnableMasks;
+
+            /**
+             * @brief 1 for the axes of stale slaves, gathered by every update().
+             *
+             */
+            std::vector<double> m_HoldMasks;
+
+            // Inputs, states and outputs.
+
+            std::vector<double> m_Setpoints;
+
+            std::vector<double> m_FeedForwards;
+
+            std::vector<double> m_Actuals;
+
+            std::vector<double> m_PreviousActuals;
+
+            std::vector<double> m_Errors;
+
+            std::vector<double> m_Integrals;
+
+            std::vector<double> m_Derivatives;
+
+            std::vector<double> m_Outputs;
+
+            /**
+             * @brief Whether the previous actual values are valid, the first update() has no derivative.
+             *
+             */
+            bool m_HasPreviousActuals = false;
+        };
+
+    } // End of namespace motion
+} // End of namespace ec
+
+#endif // CONTROLLER_BANK_HPP_
@@ -14,8 +14,10 @@
 
 #include "ethercat_interface/ec_utils.hpp"
 
-#include <map>
-#include <queue>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
 
 // enum class State;
 
@@ -34,7 +36,7 @@ protected:
 namespace CIA402
 {
 
-    enum class State
+    enum class State : uint8_t
     {
         Start,
         NotReadyToSwitchOn,
@@ -48,7 +50,9 @@ namespace CIA402
         Unknown
     };
 
-    const enum StatusWordBits {
+    constexpr std::size_t StateCount = 10;
+
+    enum StatusWordBits {
         ReadyToSwitchOn = 0,
         SwitchedOn = 1,
         OperationEnabled = 2,
@@ -67,21 +71,16 @@ namespace CIA402
         ManufacturerSpecific_2 = 15
     };
 
-    const std::array<uint16_t, 6> importantStateBits = {
-        (1 << StatusWordBits::ReadyToSwitchOn),
-        (1 << StatusWordBits::SwitchedOn),
-        (1 << StatusWordBits::OperationEnabled),
-        (1 << StatusWordBits::Fault),
-        (1 << StatusWordBits::QuickStop),
-        (1 << StatusWordBits::SwitchonDisabled)
-    };  
-
-    const uint16_t stateCheckBits = ((1 << ReadyToSwitchOn) |
+    /**
+     * @brief Status word bits that encode the state: bits 0 to 3, 5 and 6. Voltage enabled (bit 4) does not.
+     *
+     */
+    constexpr uint16_t stateCheckBits = ((1 << ReadyToSwitchOn) |
                                          (1 << SwitchedOn) |
                                          (1 << OperationEnabled) |
-                                         (1 << Fault) | 
-                                         (1 << QuickStop) | 
-                                         (1 << ReadyToSwitchOn));
+                                         (1 << Fault) |
+                                         (1 << QuickStop) |
+                                         (1 << SwitchonDisabled));
 
     enum class ControlWord : uint16_t
     {
@@ -98,57 +97,287 @@ namespace CIA402
         return static_cast<typename std::underlying_type<ControlWord>::type>(control_word);
     }
 
-    const std::map<State, State> StateTransitions = {
-        {State::Start, State::NotReadyToSwitchOn},            // 0
-        {State::NotReadyToSwitchOn, State::SwitchOnDisabled}, // 1
-        {State::SwitchedOn, State::ReadyToSwitchOn},          // 2
-        {State::ReadyToSwitchOn, State::SwitchedOn},          // 3
-        {State::SwitchedOn, State::OperationEnabled},         // 4
-        {State::OperationEnabled, State::SwitchedOn},         // 5
-        {State::SwitchedOn, State::ReadyToSwitchOn},          // 6
-        {State::ReadyToSwitchOn, State::SwitchOnDisabled},    // 7
-        {State::OperationEnabled, State::ReadyToSwitchOn},    // 8
-        {State::OperationEnabled, State::SwitchOnDisabled},   // 9
-        {State::SwitchedOn, State::SwitchOnDisabled},         // 10
-        {State::OperationEnabled, State::QuickStopActive},    // 11
-        {State::QuickStopActive, State::SwitchOnDisabled},    // 12
-        {State::Unknown, State::FaultReactionActive},         // 13
-        {State::FaultReactionActive, State::Fault},           // 14
-        {State::Fault, State::SwitchOnDisabled},              // 15
-        {State::QuickStopActive, State::OperationEnabled}     // 16
+    constexpr uint16_t controlWordBit(ControlWord control_word)
+    {
+        return (uint16_t)(1 << getControlWordBitIndex(control_word));
+    }
+
+    /**
+     * @brief Device control commands of CiA 402. None is used for the transitions the drive makes on its own.
+     *
+     */
+    enum class Command : uint8_t
+    {
+        None,
+        Shutdown,
+        SwitchOn,
+        DisableVoltage,
+        QuickStop,
+        DisableOperation,
+        EnableOperation,
+        FaultReset
+    };
+
+    constexpr std::size_t CommandCount = 8;
+
+    /**
+     * @brief Bits a command sets and resets in the control word, the remaining bits (halt, mode specific) are kept.
+     *
+     */
+    struct TransitionCommand
+    {
+        uint16_t setBits;
+
+        uint16_t resetBits;
     };
 
     namespace state_transition_commands
     {
 
-        constexpr uint16_t autoSet = 0x0;
-        constexpr uint16_t autoReset = 0x0;
+        constexpr TransitionCommand none = {0x0, 0x0};
+
+        constexpr TransitionCommand shutdown = {
+            controlWordBit(ControlWord::EnableVoltage) | controlWordBit(ControlWord::QuickStop),
+            controlWordBit(ControlWord::SwitchOn) | controlWordBit(ControlWord::FaultReset)
+        };
+
+        constexpr TransitionCommand switchOn = {
+            controlWordBit(ControlWord::SwitchOn) | controlWordBit(ControlWord::EnableVoltage) | controlWordBit(ControlWord::QuickStop),
+            controlWordBit(ControlWord::EnableOperation) | controlWordBit(ControlWord::FaultReset)
+        };
+
+        constexpr TransitionCommand disableVoltage = {
+            0x0,
+            controlWordBit(ControlWord::EnableVoltage) | controlWordBit(ControlWord::FaultReset)
+        };
+
+        constexpr TransitionCommand quickStop = {
+            controlWordBit(ControlWord::EnableVoltage),
+            controlWordBit(ControlWord::QuickStop) | controlWordBit(ControlWord::FaultReset)
+        };
+
+        constexpr TransitionCommand disableOperation = switchOn;
+
+        constexpr TransitionCommand enableOperation = {
+            controlWordBit(ControlWord::SwitchOn) | controlWordBit(ControlWord::EnableVoltage) | controlWordBit(ControlWord::QuickStop) | controlWordBit(ControlWord::EnableOperation),
+            controlWordBit(ControlWord::FaultReset)
+        };
+
+        /**
+         * @brief The drive resets on the rising edge of the bit, see StateMachine::update().
+         *
+         */
+        constexpr TransitionCommand faultReset = {controlWordBit(ControlWord::FaultReset), 0x0};
+
+    } // End of namespace state_transition_commands
+
+    constexpr std::array<TransitionCommand, CommandCount> CommandTable = {
+        state_transition_commands::none,
+        state_transition_commands::shutdown,
+        state_transition_commands::switchOn,
+        state_transition_commands::disableVoltage,
+        state_transition_commands::quickStop,
+        state_transition_commands::disableOperation,
+        state_transition_commands::enableOperation,
+        state_transition_commands::faultReset
+    };
+
+    constexpr uint16_t applyCommand(uint16_t control_word, Command command)
+    {
+        const TransitionCommand& masks = CommandTable[(std::size_t)command];
+        return (uint16_t)((control_word & ~masks.resetBits) | masks.setBits);
+    }
+
+    /**
+     * @brief Packs the six state bits of the status word into an index of StateTable.
+     *
+     */
+    constexpr uint8_t getStateIndex(uint16_t status_word)
+    {
+        return (uint8_t)((status_word & 0x0F) | ((status_word >> 1) & 0x30));
+    }
+
+    namespace detail
+    {
+        /**
+         * @brief Decodes the state bits the way CiA 402 defines them, only used to fill StateTable.
+         *
+         */
+        constexpr State decodeStateBits(uint16_t status_word)
+        {
+            if((status_word & 0x4F) == 0x00){
+                return State::NotReadyToSwitchOn;
+            }
+            if((status_word & 0x4F) == 0x40){
+                return State::SwitchOnDisabled;
+            }
+            if((status_word & 0x6F) == 0x21){
+                return State::ReadyToSwitchOn;
+            }
+            if((status_word & 0x6F) == 0x23){
+                return State::SwitchedOn;
+            }
+            if((status_word & 0x6F) == 0x27){
+                return State::OperationEnabled;
+            }
+            if((status_word & 0x6F) == 0x07){
+                return State::QuickStopActive;
+            }
+            if((status_word & 0x4F) == 0x0F){
+                return State::FaultReactionActive;
+            }
+            if((status_word & 0x4F) == 0x08){
+                return State::Fault;
+            }
+            return State::Unknown;
+        }
+
+        constexpr std::array<State, 64> makeStateTable()
+        {
+            std::array<State, 64> table{};
+            for(uint16_t index = 0; index < 64; index++)
+            {
+                const uint16_t statusWord = (uint16_t)((index & 0x0F) | ((index & 0x30) << 1));
+                table[index] = decodeStateBits(statusWord);
+            }
+            return table;
+        }
+    } // End of namespace detail
+
+    /**
+     * @brief State of every combination of the state bits, indexed by getStateIndex().
+     *
+     */
+    constexpr std::array<State, 64> StateTable = detail::makeStateTable();
+
+    constexpr State decodeState(uint16_t status_word)
+    {
+        return StateTable[getStateIndex(status_word)];
+    }
 
-        constexpr uint16_t shutdownSet = ((1 << getControlWordBitIndex(ControlWord::EnableVoltage)) | (1 << getControlWordBitIndex(ControlWord::QuickStop)));
-        constexpr uint16_t shutdownReset = ((1 << getControlWordBitIndex(ControlWord::SwitchOn)) | (1 << getControlWordBitIndex(ControlWord::FaultReset)));
+    /**
+     * @brief Transition of the device control state machine the master can request with a command.
+     *
+     */
+    struct Transition
+    {
+        State from;
 
-        constexpr uint16_t switchOnSet = ((1 << getControlWordBitIndex(ControlWord::SwitchOn)) | (1 << getControlWordBitIndex(ControlWord::EnableVoltage)) | (1 << (getControlWordBitIndex(ControlWord::QuickStop))));
-        constexpr uint16_t switchOnReset = ((1 << getControlWordBitIndex(ControlWord::EnableVoltage)) | (1 << getControlWordBitIndex(ControlWord::FaultReset)));
+        State to;
 
-        constexpr uint16_t disableOperationSet = ((1 << getControlWordBitIndex(ControlWord::SwitchOn)) | (1 << getControlWordBitIndex(ControlWord::EnableVoltage)) | (1 << (getControlWordBitIndex(ControlWord::QuickStop))));
-        constexpr uint16_t disableOperationReset = ((1 << getControlWordBitIndex(ControlWord::EnableOperation)) | 1 << (getControlWordBitIndex(ControlWord::FaultReset)));
+        Command command;
+    };
 
-        constexpr uint16_t disableVoltageSet = 0x0;
-        constexpr uint16_t disableVoltageReset = ((1 << getControlWordBitIndex(ControlWord::FaultReset)) | (1 << getControlWordBitIndex(ControlWord::EnableVoltage)));
+    /**
+     * @brief The commanded transitions of CiA 402, numbered as in the standard.
+     * 0, 1 and 14 are made by the drive on its own and 13 on any fault, they are not listed.
+     *
+     */
+    constexpr std::array<Transition, 13> Transitions = {{
+        {State::SwitchOnDisabled, State::ReadyToSwitchOn, Command::Shutdown},           // 2
+        {State::ReadyToSwitchOn, State::SwitchedOn, Command::SwitchOn},                 // 3
+        {State::SwitchedOn, State::OperationEnabled, Command::EnableOperation},         // 4
+        {State::OperationEnabled, State::SwitchedOn, Command::DisableOperation},        // 5
+        {State::SwitchedOn, State::ReadyToSwitchOn, Command::Shutdown},                 // 6
+        {State::ReadyToSwitchOn, State::SwitchOnDisabled, Command::DisableVoltage},     // 7
+        {State::OperationEnabled, State::ReadyToSwitchOn, Command::Shutdown},           // 8
+        {State::OperationEnabled, State::SwitchOnDisabled, Command::DisableVoltage},    // 9
+        {State::SwitchedOn, State::SwitchOnDisabled, Command::DisableVoltage},          // 10
+        {State::OperationEnabled, State::QuickStopActive, Command::QuickStop},          // 11
+        {State::QuickStopActive, State::SwitchOnDisabled, Command::DisableVoltage},     // 12
+        {State::Fault, State::SwitchOnDisabled, Command::FaultReset},                   // 15
+        {State::QuickStopActive, State::OperationEnabled, Command::EnableOperation}     // 16
+    }};
+
+    /**
+     * @brief First step from a state towards a target state.
+     *
+     */
+    struct Hop
+    {
+        State next;
 
-        constexpr uint16_t quickStopSet = (1 << getControlWordBitIndex(ControlWord::EnableVoltage));
-        constexpr uint16_t quickStopReset = ((1 << getControlWordBitIndex(ControlWord::FaultReset)) | (1 << getControlWordBitIndex(ControlWord::QuickStop)));
+        Command command;
+    };
 
-        constexpr uint16_t enableOperationSet = ((1 << getControlWordBitIndex(ControlWord::QuickStop)) | (1 << getControlWordBitIndex(ControlWord::EnableVoltage)) | (1 << getControlWordBitIndex(ControlWord::SwitchOn)) | (1 << getControlWordBitIndex(ControlWord::EnableOperation)));
-        constexpr uint16_t enableOperationReset = (1 << getControlWordBitIndex(ControlWord::FaultReset));
+    using NextHopTable = std::array<std::array<Hop, StateCount>, StateCount>;
 
-        constexpr uint16_t faultResetSet = (1 << getControlWordBitIndex(ControlWord::FaultReset));
-        constexpr uint16_t faultResetReset = 0x0;
+    namespace detail
+    {
+        /**
+         * @brief Shortest paths over Transitions, searched backwards from each target.
+         * Quick stop is only entered from operation enabled, every other state heads to switch on disabled instead,
+         * so a quick stop request never enables a drive on its way.
+         *
+         */
+        constexpr NextHopTable makeNextHopTable()
+        {
+            NextHopTable table{};
+            for(std::size_t from = 0; from < StateCount; from++)
+            {
+                for(std::size_t target = 0; target < StateCount; target++)
+                {
+                    table[from][target] = Hop{(State)from, Command::None};
+                }
+            }
+
+            for(std::size_t target = 0; target < StateCount; target++)
+            {
+                std::array<bool, StateCount> reached{};
+                std::array<std::size_t, StateCount> queue{};
+                std::size_t queueHead = 0;
+                std::size_t queueTail = 0;
+
+                if((State)target == State::QuickStopActive){
+                    reached[target] = true;
+                    table[(std::size_t)State::OperationEnabled][target] = Hop{State::QuickStopActive, Command::QuickStop};
+                    reached[(std::size_t)State::OperationEnabled] = true;
+                    // The remaining states are routed like a request for switch on disabled.
+                    queue[queueTail++] = (std::size_t)State::SwitchOnDisabled;
+                    reached[(std::size_t)State::SwitchOnDisabled] = true;
+                }
+                else{
+                    queue[queueTail++] = target;
+                    reached[target] = true;
+                }
+
+                while(queueHead != queueTail)
+                {
+                    const std::size_t current = queue[queueHead++];
+                    for(const auto& transition : Transitions)
+                    {
+                        const std::size_t from = (std::size_t)transition.from;
+                        if((std::size_t)transition.to != current || reached[from]){
+                            continue;
+                        }
+                        reached[from] = true;
+                        table[from][target] = Hop{transition.to, transition.command};
+                        queue[queueTail++] = from;
+                    }
+                }
+            }
+
+            return table;
+        }
+    } // End of namespace detail
+
+    /**
+     * @brief Next hop of every state towards every target state, Command::None if the drive has to get there on its own
+     * or the target can not be commanded.
+     *
+     */
+    constexpr NextHopTable NextHops = detail::makeNextHopTable();
+
+    constexpr Hop findTransition(State current_state, State target_state)
+    {
+        return NextHops[(std::size_t)current_state][(std::size_t)target_state];
     }
 
-    using Transition = std::pair<State, State>;
-    using TransitionCommand = std::pair<uint16_t, uint16_t>;
-
+    /**
+     * @brief Drives one CiA 402 device to a target state, one transition per update.
+     * Holds no allocations, so it can be used inside the cyclic task.
+     *
+     */
     class StateMachine : public ::StateMachine
     {
     public:
@@ -156,30 +385,54 @@ namespace CIA402
 
         ~StateMachine();
 
+        /**
+         * @brief Resets the state machine, the tables are built at compile time.
+         *
+         */
         bool init() override;
 
-        bool addTransition(
-            const State first_state,
-            const State second_state,
-            const uint16_t set_bits,
-            const uint16_t reset_bits);
-
-        bool addTransition(
-            const Transition &transitions,
-            const TransitionCommand &transition_command);
-
-        const std::queue<TransitionCommand> findTransition(
-
-        ) const;
+        void setTargetState(State target_state)
+        {
+            m_TargetState = target_state;
+        }
+
+        State getTargetState() const
+        {
+            return m_TargetState;
+        }
+
+        State getCurrentState() const
+        {
+            return m_CurrentState;
+        }
+
+        bool isTargetReached() const
+        {
+            return m_CurrentState == m_TargetState;
+        }
+
+        /**
+         * @brief Decodes the status word and returns the control word for the next step towards the target state.
+         *
+         * @param status_word Status word (0x6041) read in this cycle.
+         * @param control_word Control word (0x6040) written in the previous cycle, its halt and mode specific bits are kept.
+         */
+        uint16_t update(uint16_t status_word, uint16_t control_word);
+
+        /**
+         * @brief Decodes the state from the status word.
+         *
+         * @return false If the state bits do not form a valid state.
+         */
+        bool findCurrentState(const uint16_t &current_status_word);
 
     private:
-        std::map<Transition, TransitionCommand> m_TransitionMap;
 
-        State m_CurrentState;
+        State m_CurrentState = State::Start;
 
-        bool findCurrentState(const uint16_t &current_status_word);
+        State m_TargetState = State::SwitchOnDisabled;
     };
 
 } // End of namespace CIA402
 
-#endif // DRIVER_STATE_MACHINE_HPP_
\ No newline at end of file
+#endif // DRIVER_STATE_MACHINE_HPP_
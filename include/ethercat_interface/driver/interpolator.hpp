@@ -0,0 +1,258 @@
+/**
+ * @file interpolator.hpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief Upsamples timestamped waypoints to one position setpoint per cycle for drives in cyclic synchronous position mode.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef INTERPOLATOR_HPP_
+#define INTERPOLATOR_HPP_
+
+#include "ethercat_interface/slave.hpp"
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <string>
+#include <cstdint>
+
+namespace ec
+{
+    namespace motion
+    {
+
+        /**
+         * @brief Point of a trajectory.
+         * The time is on the clock of the cycle timer, see Master::getApplicationTime().
+         * Positions are in the units of the position entry, velocities and accelerations per second.
+         *
+         */
+        struct Waypoint
+        {
+            uint64_t timeNs = 0;
+
+            double position = 0.0;
+
+            /**
+             * @brief Used by CubicHermite and Quintic.
+             *
+             */
+            double velocity = 0.0;
+
+            /**
+             * @brief Used by Quintic.
+             *
+             */
+            double acceleration = 0.0;
+        };
+
+        enum class InterpolationMode : uint8_t
+        {
+            /**
+             * @brief Straight lines between the positions, the velocity jumps at every waypoint.
+             *
+             */
+            Linear,
+
+            /**
+             * @brief Cubic polynomials through the positions and velocities, the velocity is continuous.
+             *
+             */
+            CubicHermite,
+
+            /**
+             * @brief Quintic polynomials through the positions, velocities and accelerations, the acceleration is continuous.
+             *
+             */
+            Quintic
+        };
+
+        /**
+         * @brief Position and velocity of a trajectory at some time.
+         *
+         */
+        struct Setpoint
+        {
+            double position = 0.0;
+
+            double velocity = 0.0;
+        };
+
+        /**
+         * @brief Evaluates the segment between two waypoints at time_ns, which is clamped to the segment.
+         *
+         */
+        Setpoint interpolate(const Waypoint& from, const Waypoint& to, uint64_t time_ns, InterpolationMode mode);
+
+        /**
+         * @brief Generates the position setpoint of a drive every cycle from waypoints sent at a lower rate.
+         * Waypoints are pushed by one non real-time thread and consumed by the cyclic thread through a
+         * lock-free ring, update() neither allocates nor blocks. Once the last waypoint is passed the setpoint
+         * holds its position with zero velocity until new waypoints arrive.
+         *
+         */
+        class Interpolator
+        {
+            public:
+
+            /**
+             * @param domain_data Domain image the setpoints are written into.
+             * @param position_offset Offset of the 32 bit target position entry.
+             * @param velocity_offset Offset of the 32 bit velocity feed-forward entry, if it is mapped.
+             * @param queue_capacity Number of waypoints that can be queued ahead of the cyclic thread.
+             */
+            Interpolator(
+                uint8_t* domain_data,
+                uint32_t position_offset,
+                std::optional<uint32_t> velocity_offset = std::nullopt,
+                std::size_t queue_capacity = 64
+            );
+
+            /**
+             * @brief Creates an interpolator writing to the entries of a drive.
+             * The feed-forward entry is optional, the velocity is not written if the drive does not map it.
+             *
+             * @return nullptr If the drive does not map the position entry or its domain is not activated yet.
+             */
+            static std::unique_ptr<Interpolator> fromDriver(
+                ec::slave::Driver* driver,
+                const std::string& position_entry_name = "target_position",
+                const std::string& velocity_entry_name = "velocity_offset",
+                std::size_t queue_capacity = 64
+            );
+
+            /**
+             * @brief Queues a waypoint, called by the producer thread. Waypoints have to be pushed in time order.
+             *
+             * @return false If the queue is full or the waypoint is older than the previous one.
+             */
+            bool pushWaypoint(const Waypoint& waypoint);
+
+            /**
+             * @brief Writes the setpoint of the cycle into the domain, called by the cyclic thread between
+             * receiveDomainData() and sendDomainData().
+             *
+             * @param time_ns Application time of the cycle, the time the trajectory is evaluated at is shifted by setTimeOffset().
+             * @return false If no waypoint has been received yet, nothing is written then.
+             */
+            bool update(uint64_t time_ns);
+
+            void setMode(InterpolationMode mode)
+            {
+                m_Mode = mode;
+            }
+
+            InterpolationMode getMode() const
+            {
+                return m_Mode;
+            }
+
+            /**
+             * @brief Shifts the evaluation time relative to the application time, e.g. by the SYNC0 shift so
+             * the setpoint is the one for the instant the drive latches it.
+             *
+             */
+            void setTimeOffset(int64_t offset_ns)
+            {
+                m_TimeOffset = offset_ns;
+            }
+
+            /**
+             * @brief Converts the velocity in position units per second to the units of the feed-forward entry.
+             *
+             */
+            void setVelocityFactor(double velocity_factor)
+            {
+                m_VelocityFactor = velocity_factor;
+            }
+
+            bool hasVelocityFeedForward() const
+            {
+                return m_VelocityOffset.has_value();
+            }
+
+            /**
+             * @brief Setpoint written by the last update().
+             *
+             */
+            const Setpoint& getSetpoint() const
+            {
+                return m_Setpoint;
+            }
+
+            /**
+             * @brief Number of updates that held the position because no waypoint followed the last one.
+             *
+             */
+            uint64_t getStarvedCycles() const
+            {
+                return m_StarvedCycles.load(std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief Number of waypoints refused because the queue was full.
+             *
+             */
+            uint64_t getDroppedWaypoints() const
+            {
+                return m_DroppedWaypoints.load(std::memory_order_relaxed);
+            }
+
+            private:
+
+            uint8_t* m_DomainData = nullptr;
+
+            uint32_t m_PositionOffset = 0;
+
+            std::optional<uint32_t> m_VelocityOffset;
+
+            InterpolationMode m_Mode = InterpolationMode::CubicHermite;
+
+            int64_t m_TimeOffset = 0;
+
+            double m_VelocityFactor = 1.0;
+
+            std::size_t m_QueueSlots = 0;
+
+            std::unique_ptr<Waypoint[]> m_Queue;
+
+            alignas(64) std::atomic<std::size_t> m_QueueHead{0};
+
+            alignas(64) std::atomic<std::size_t> m_QueueTail{0};
+
+            /**
+             * @brief Time of the last pushed waypoint, only used by the producer.
+             *
+             */
+            uint64_t m_LastPushedTime = 0;
+
+            alignas(64) std::atomic<uint64_t> m_DroppedWaypoints{0};
+
+            std::atomic<uint64_t> m_StarvedCycles{0};
+
+            // Segment being interpolated, only used by the cyclic thread.
+
+            Waypoint m_From;
+
+            Waypoint m_To;
+
+            bool m_HasWaypoint = false;
+
+            Setpoint m_Setpoint;
+
+            /**
+             * @brief Takes the oldest queued waypoint.
+             *
+             * @return false If the queue is empty.
+             */
+            bool popWaypoint(Waypoint& waypoint);
+        };
+
+    } // End of namespace motion
+} // End of namespace ec
+
+#endif // INTERPOLATOR_HPP_
@@ -0,0 +1,263 @@
+/**
+ * @file motion_planner.hpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief Time-synchronized point to point moves of several axes with trapezoidal or jerk-limited S-curve profiles.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef MOTION_PLANNER_HPP_
+#define MOTION_PLANNER_HPP_
+
+#include "ethercat_interface/slave.hpp"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace ec
+{
+    namespace motion
+    {
+
+        /**
+         * @brief Limits of an axis in position units per second, per second squared and per second cubed.
+         *
+         */
+        struct AxisLimits
+        {
+            double maxVelocity;
+
+            double maxAcceleration;
+
+            /**
+             * @brief Not used by trapezoidal profiles.
+             *
+             */
+            double maxJerk;
+        };
+
+        enum class ProfileType : uint8_t
+        {
+            /**
+             * @brief Constant acceleration, cruise, constant deceleration. The acceleration jumps.
+             *
+             */
+            Trapezoidal,
+
+            /**
+             * @brief Seven segments of constant jerk, the acceleration is continuous.
+             *
+             */
+            SCurve
+        };
+
+        /**
+         * @brief Segment of constant jerk, the state at its start and the time it starts at, relative to the move's start.
+         *
+         */
+        struct ProfilePhase
+        {
+            double startTime = 0.0;
+
+            double position = 0.0;
+
+            double velocity = 0.0;
+
+            double acceleration = 0.0;
+
+            double jerk = 0.0;
+        };
+
+        /**
+         * @brief Profile of one axis: the seven segments of an S-curve followed by the rest at the target.
+         * Trapezoidal profiles use the same layout with segments of zero duration.
+         *
+         */
+        struct AxisProfile
+        {
+            static constexpr std::size_t PhaseCount = 8;
+
+            std::array<ProfilePhase, PhaseCount> phases;
+        };
+
+        /**
+         * @brief Computes the rest to rest profile of one axis, time-stretched to the given duration if it is longer.
+         *
+         * @param duration Duration of the move in seconds, 0 for the shortest move within the limits.
+         * @return Duration of the computed profile.
+         */
+        double computeProfile(
+            double start_position,
+            double target_position,
+            const AxisLimits& limits,
+            ProfileType type,
+            double duration,
+            AxisProfile& profile
+        );
+
+        /**
+         * @brief Position, velocity and acceleration of a profile at time seconds after the move's start.
+         *
+         */
+        struct ProfileState
+        {
+            double position;
+
+            double velocity;
+
+            double acceleration;
+        };
+
+        /**
+         * @brief Evaluates a profile, starting the phase search at phase_index which is left at the current phase.
+         * Constant time when the time only moves forward.
+         *
+         */
+        ProfileState evaluateProfile(const AxisProfile& profile, double time, std::size_t& phase_index);
+
+        /**
+         * @brief Plans coordinated moves of a set of axes and writes their position setpoints every cycle.
+         * plan() computes the profiles on the calling thread into the planner's spare buffer, which the cyclic thread
+         * switches to at its next update(). All axes of a move start and arrive together: the axis needing the most time
+         * sets the duration and the other profiles are stretched to it. update() evaluates one polynomial per axis and
+         * neither allocates nor blocks.
+         *
+         */
+        class MotionPlanner
+        {
+            public:
+
+            /**
+             * @param domain_data Domain image the setpoints are written into.
+             * @param position_offsets Offsets of the 32 bit target position entries of the axes.
+             * @param limits Limits of the axes, in the same order.
+             */
+            MotionPlanner(
+                uint8_t* domain_data,
+                const std::vector<uint32_t>& position_offsets,
+                const std::vector<AxisLimits>& limits
+            );
+
+            /**
+             * @brief Creates a planner for the drives, which have to be in the same domain.
+             *
+             * @return nullptr If a drive misses the entry, the drives are in different domains or the counts differ.
+             */
+            static std::unique_ptr<MotionPlanner> fromDrivers(
+                const std::vector<ec::slave::Driver*>& drivers,
+                const std::vector<AxisLimits>& limits,
+                const std::string& position_entry_name = "target_position"
+            );
+
+            /**
+             * @brief Plans a move of all axes from rest to rest, called by a non real-time thread.
+             *
+             * @param start_positions Positions the axes are at when the move starts.
+             * @param start_time_ns Time the move starts at, on the clock passed to update().
+             * @return false If the previous plan has not been taken by update() yet, a size does not match the axes or a limit is not positive.
+             */
+            bool plan(
+                const std::vector<double>& start_positions,
+                const std::vector<double>& target_positions,
+                uint64_t start_time_ns,
+                ProfileType type = ProfileType::SCurve
+            );
+
+            /**
+             * @brief Writes the setpoints of all axes for the cycle, called by the cyclic thread between
+             * receiveDomainData() and sendDomainData().
+             *
+             * @param time_ns Application time of the cycle, see Master::getApplicationTime().
+             * @return false If nothing has been planned yet, nothing is written then.
+             */
+            bool update(uint64_t time_ns);
+
+            std::size_t size() const
+            {
+                return m_PositionOffsets.size();
+            }
+
+            /**
+             * @brief Duration of the move being executed in seconds.
+             *
+             */
+            double getDuration() const
+            {
+                return m_Plans[m_ActivePlan].duration;
+            }
+
+            /**
+             * @brief State of the axis at the last update().
+             *
+             */
+            const ProfileState& getState(std::size_t axis) const
+            {
+                return m_States[axis];
+            }
+
+            /**
+             * @brief Whether the last update() was at or after the end of the move.
+             *
+             */
+            bool isDone() const
+            {
+                return m_IsDone;
+            }
+
+            private:
+
+            struct Plan
+            {
+                uint64_t startTimeNs = 0;
+
+                double duration = 0.0;
+
+                std::vector<AxisProfile> profiles;
+            };
+
+            uint8_t* m_DomainData = nullptr;
+
+            std::vector<uint32_t> m_PositionOffsets;
+
+            std::vector<AxisLimits> m_Limits;
+
+            /**
+             * @brief The plan update() reads and the spare one plan() writes.
+             *
+             */
+            std::array<Plan, 2> m_Plans;
+
+            /**
+             * @brief Only changed by update().
+             *
+             */
+            std::size_t m_ActivePlan = 0;
+
+            /**
+             * @brief Set by plan() when the spare plan is ready, cleared by update() when it switched to it.
+             *
+             */
+            alignas(64) std::atomic<bool> m_IsPlanPending{false};
+
+            bool m_HasPlan = false;
+
+            bool m_IsDone = false;
+
+            // Evaluation state, only used by the cyclic thread.
+
+            std::vector<std::size_t> m_PhaseIndices;
+
+            std::vector<ProfileState> m_States;
+        };
+
+    } // End of namespace motion
+} // End of namespace ec
+
+#endif // MOTION_PLANNER_HPP_
@@ -0,0 +1,155 @@
+/**
+ * @file position_extender.hpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief Extends the wrapping position counters of drives to 64 bit positions.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef POSITION_EXTENDER_HPP_
+#define POSITION_EXTENDER_HPP_
+
+#include "ethercat_interface/slave.hpp"
+
+#include <atomic>
+#include <optional>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace ec
+{
+    namespace motion
+    {
+
+        /**
+         * @brief Offsets of an axis' position entries in the domain.
+         *
+         */
+        struct PositionEntries
+        {
+            uint32_t actualOffset;
+
+            /**
+             * @brief std::nullopt if the axis takes no targets.
+             *
+             */
+            std::optional<uint32_t> targetOffset;
+
+            /**
+             * @brief Stale flag of the slave of the axis, nullptr if it is never stale.
+             *
+             */
+            const std::atomic<bool>* staleFlag = nullptr;
+        };
+
+        /**
+         * @brief 64 bit positions of axes whose position entries are 32 bit counters, e.g. conveyors moving in
+         * one direction until the counter wraps. update() reads the counters of all axes and adds the difference to the
+         * last counter, taken modulo the counter range, to each position: one branch free loop over the axes, correct
+         * as long as an axis moves less than half the counter range per cycle. Targets are given as 64 bit positions and
+         * narrowed to the counter relative to the current position, the same way the drive sees it. The position of
+         * an axis whose slave is stale is held until the slave is back. Everything is allocated on construction.
+         *
+         */
+        class PositionExtender
+        {
+            public:
+
+            PositionExtender(uint8_t* domain_data, const std::vector<PositionEntries>& axes);
+
+            /**
+             * @brief Creates the extender of the drives, which have to be in the same domain.
+             *
+             * @param target_entry_name Entry targets are written to, empty if the drives take no targets.
+             * @return std::nullopt If a drive misses one of the entries, an entry is not 32 bit or the drives are in different domains.
+             */
+            static std::optional<PositionExtender> fromDrivers(
+                const std::vector<ec::slave::Driver*>& drivers,
+                const std::string& actual_entry_name = "actual_position",
+                const std::string& target_entry_name = "target_position"
+            );
+
+            /**
+             * @brief Reads the counters of all axes and extends the positions. The first update takes the sign extended
+             * counter as the position.
+             *
+             */
+            void update();
+
+            std::size_t size() const
+            {
+                return m_Entries.size();
+            }
+
+            /**
+             * @brief Number of bits the counter of the axis counts with, 32 by default. Multi-turn encoders with
+             * fewer bits wrap at 2^bits, the bits above are ignored.
+             *
+             * @return false If bits is not within 2 to 32.
+             */
+            bool setCounterBits(std::size_t axis, uint8_t bits);
+
+            /**
+             * @brief Position extended by the last update().
+             *
+             */
+            int64_t getPosition(std::size_t axis) const
+            {
+                return m_Positions[axis];
+            }
+
+            /**
+             * @brief Counter read by the last update().
+             *
+             */
+            uint32_t getCounter(std::size_t axis) const
+            {
+                return m_Counters[axis];
+            }
+
+            /**
+             * @brief Makes the counter of the last update() the position, e.g. after homing. Has no effect before the first update().
+             *
+             */
+            void setPosition(std::size_t axis, int64_t position)
+            {
+                m_Positions[axis] = position;
+            }
+
+            /**
+             * @brief Narrows the target to the counter and writes it.
+             *
+             * @return false If the axis takes no targets or the target is half the counter range or more away from
+             * the position of the last update(), the drive could not tell the direction.
+             */
+            bool setTarget(std::size_t axis, int64_t target);
+
+            private:
+
+            uint8_t* m_DomainData = nullptr;
+
+            std::vector<PositionEntries> m_Entries;
+
+            /**
+             * @brief Bits of each counter, 2^bits - 1.
+             *
+             */
+            std::vector<uint32_t> m_Masks;
+
+            std::vector<uint32_t> m_Counters;
+
+            std::vector<uint32_t> m_PreviousCounters;
+
+            std::vector<int64_t> m_Positions;
+
+            bool m_IsPrimed = false;
+        };
+
+    } // End of namespace motion
+} // End of namespace ec
+
+#endif // POSITION_EXTENDER_HPP_
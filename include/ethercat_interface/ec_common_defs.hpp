@@ -16,6 +16,9 @@
 #include <vector>
 #include <optional>
 #include <map>
+#include <memory>
+#include <array>
+#include <limits>
 
 #include "ecrt.h"
 
@@ -29,10 +32,13 @@ namespace ec
     struct ProgramConfig;
 
     struct SlaveInfo;
+    struct SlaveLayout;
     struct PDO;
     struct PDO_Entry;
     struct DistributedClockConfig;
     struct SyncManagerConfig;
+    struct SlaveTuning;
+    struct StartupSdo;
 
     //enum class ProgramConfigErrorTypes
     //{
@@ -71,7 +77,32 @@ namespace ec
 
     struct ProgramConfig
     {
-        uint16_t cyclePeriod;
+        uint16_t cyclePeriod = 0;
+
+        /**
+         * @brief Index of the EtherCAT master to request, each master drives its own network interface.
+         * 
+         */
+        uint16_t masterIndex = 0;
+
+        /**
+         * @brief Core the cyclic thread of Master::start() is pinned to, -1 to leave it unpinned.
+         * 
+         */
+        int32_t cpuCore = -1;
+
+        /**
+         * @brief Starts the cycles at multiples of the cycle period on the monotonic clock,
+         * so masters with the same period in one process exchange their frames in the same window.
+         * 
+         */
+        bool alignCycles = false;
+
+        /**
+         * @brief Offset of the aligned cycles in microseconds.
+         * 
+         */
+        uint32_t cycleOffset = 0;
 
         std::vector<SlaveInfo> slaveConfigurations;
     };
@@ -85,6 +116,74 @@ namespace ec
         std::vector<PDO_Entry> entries;
     };  
 
+    enum class FilterType
+    {
+        None,
+        Biquad,
+        MovingAverage,
+        Median3
+    };
+
+    /**
+     * @brief Filter applied to an input entry every cycle, see ec::filter::FilterBank.
+     * 
+     */
+    struct EntryFilter
+    {
+        FilterType type = FilterType::None;
+
+        /**
+         * @brief b0, b1, b2, a1, a2 of a biquad, y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] - a1 y[n-1] - a2 y[n-2].
+         * 
+         */
+        std::array<double, 5> coefficients{};
+
+        /**
+         * @brief Number of samples averaged by a moving average.
+         * 
+         */
+        uint16_t window = 1;
+
+        bool operator==(const EntryFilter& other) const
+        {
+            return type == other.type && coefficients == other.coefficients && window == other.window;
+        }
+
+        bool operator!=(const EntryFilter& other) const
+        {
+            return !(*this == other);
+        }
+    };
+
+    /**
+     * @brief Limits an output entry is clamped to before the domain is sent, see ec::limit::LimitStage.
+     * 
+     */
+    struct EntryLimit
+    {
+        bool isLimited = false;
+
+        double min = -std::numeric_limits<double>::infinity();
+
+        double max = std::numeric_limits<double>::infinity();
+
+        /**
+         * @brief Largest change of the value from one send to the next.
+         * 
+         */
+        double maxStep = std::numeric_limits<double>::infinity();
+
+        bool operator==(const EntryLimit& other) const
+        {
+            return isLimited == other.isLimited && min == other.min && max == other.max && maxStep == other.maxStep;
+        }
+
+        bool operator!=(const EntryLimit& other) const
+        {
+            return !(*this == other);
+        }
+    };
+
     struct PDO_Entry
     {
 
@@ -97,6 +196,24 @@ namespace ec
         Bitlength bitlength;
 
         DataType type;
+
+        EntryFilter filter;
+
+        EntryLimit limit;
+
+        /**
+         * @brief Number of samples of an array entry, e.g. an oversampling terminal. The samples are mapped as
+         * consecutive subindices from subindex on and read with Slave::readSamples().
+         * 
+         */
+        uint16_t count = 1;
+
+        /**
+         * @brief The entry holds the DC system time of an event, e.g. a touch probe latch time, and is
+         * converted to the 64 bit time axis of the input latch times, see Slave::readTimestamp().
+         * 
+         */
+        bool isTimestamp = false;
     };
 
     struct DistributedClockConfig
@@ -111,6 +228,13 @@ namespace ec
 
         int32_t sync1Shift;
 
+        /**
+         * @brief Whether ecrt_slave_config_dc() is called with these times when the slave is configured,
+         * set by "apply_to_slave: true". Otherwise the DC setup of the slave is left to the EtherCAT master.
+         * 
+         */
+        bool isAppliedToSlave = false;
+
     };
 
     struct SyncManagerConfig
@@ -122,6 +246,85 @@ namespace ec
         ec_watchdog_mode_t watchdogMode;
     };
 
+    /**
+     * @brief SDO download registered with the slave configuration, performed by the master
+     * every time the slave is brought from PREOP to SAFEOP.
+     * 
+     */
+    struct StartupSdo
+    {
+        Index index;
+
+        Subindex subindex;
+
+        DataType type;
+
+        /**
+         * @brief Value in EtherCAT (little endian) byte order, its size is the size of the type.
+         * 
+         */
+        std::vector<uint8_t> data;
+
+        bool operator==(const StartupSdo& other) const
+        {
+            return index == other.index && subindex == other.subindex && type == other.type && data == other.data;
+        }
+    };
+
+    /**
+     * @brief Shared between all instances created from the same slave configuration.
+     * 
+     */
+    using StartupSdosPtr = std::shared_ptr<const std::vector<StartupSdo>>;
+
+    /**
+     * @brief Slave settings that do not change the PDO mapping and can be reloaded while the master is cycling.
+     * 
+     */
+    struct SlaveTuning
+    {
+        /**
+         * @brief The slave's data is meant to be handled on every cycleDivisor'th cycle, see Slave::isDue().
+         * 
+         */
+        uint16_t cycleDivisor = 1;
+
+        /**
+         * @brief Factors used by Slave::readScaled() and Slave::writeScaled(), keyed by the entry name.
+         * 
+         */
+        std::map<std::string, double> scalingFactors;
+
+        /**
+         * @brief Entries recorded by the capture, all entries if empty.
+         * 
+         */
+        std::vector<std::string> telemetryEntries;
+
+        bool operator==(const SlaveTuning& other) const
+        {
+            return cycleDivisor == other.cycleDivisor &&
+                   scalingFactors == other.scalingFactors &&
+                   telemetryEntries == other.telemetryEntries;
+        }
+    };
+
+    /**
+     * @brief PDO mapping and sync manager configuration of a slave type.
+     * Immutable once parsed, so every instance of the same slave type shares one layout.
+     * 
+     */
+    struct SlaveLayout
+    {
+        std::vector<PDO> rxPDOs;
+
+        std::vector<PDO> txPDOs;
+
+        std::vector<SyncManagerConfig> syncManagerConfig;
+    };
+
+    using SlaveLayoutPtr = std::shared_ptr<const SlaveLayout>;
+
     /**
      * @brief Struct that holds all the information about the slave.
      * 
@@ -142,13 +345,21 @@ namespace ec
 
         uint32_t productCode;
         
-        std::vector<PDO> rxPDOs;
+        /**
+         * @brief Shared between all instances created from the same slave configuration.
+         * 
+         */
+        SlaveLayoutPtr layout;
 
-        std::vector<PDO> txPDOs;
+        std::optional<DistributedClockConfig> distributedClockConfig;
 
-        std::vector<SyncManagerConfig> syncManagerConfig;
+        /**
+         * @brief Startup parameters in the order they are downloaded, nullptr if the slave has none.
+         * 
+         */
+        StartupSdosPtr startupSdos;
 
-        std::optional<DistributedClockConfig> distributedClockConfig;
+        SlaveTuning tuning;
 
         const std::string toString() const
         {
@@ -159,7 +370,7 @@ namespace ec
             str += "Vendor ID: " + std::to_string(vendorID) + " Product Code: " + std::to_string(productCode) + "\n";
             
             str += "RxPDOs: \n";
-            for(const auto& rxPDO : rxPDOs)
+            for(const auto& rxPDO : layout->rxPDOs)
             {
                 str += "PDO Mapping Address: " + std::to_string(rxPDO.pdoAddress) + "\n";
                 for(const auto& entry : rxPDO.entries)
@@ -170,7 +381,7 @@ namespace ec
             }
 
             str += "TxPDOs: \n";
-            for(const auto& txPDO : txPDOs)
+            for(const auto& txPDO : layout->txPDOs)
             {
                 str += "PDO Mapping Address: " + std::to_string(txPDO.pdoAddress) + "\n";
                 for(const auto& entry : txPDO.entries)
@@ -180,6 +391,10 @@ namespace ec
                 } 
             }
 
+            if(startupSdos){
+                str += "Startup SDOs: " + std::to_string(startupSdos->size()) + "\n";
+            }
+
             if(distributedClockConfig){
                 str += "Distributed Clock configuration: \n";
                 const auto dc = distributedClockConfig.value();
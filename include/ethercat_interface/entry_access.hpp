@@ -0,0 +1,155 @@
+/**
+ * @file entry_access.hpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief Reads and writes PDO entries of any type as doubles, shared by the stages working on the domain images.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef ENTRY_ACCESS_HPP_
+#define ENTRY_ACCESS_HPP_
+
+#include "ec_common_defs.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <cstdint>
+
+namespace ec
+{
+    namespace entry
+    {
+
+        /**
+         * @brief Whether the slave an entry belongs to is stale, see Slave::isStale(). nullptr is never stale.
+         * The stages hold the values of a stale slave instead of using the outdated bytes in the domain.
+         *
+         */
+        inline bool isStale(const std::atomic<bool>* stale_flag)
+        {
+            return stale_flag && stale_flag->load(std::memory_order_relaxed);
+        }
+
+        inline double readEntry(const uint8_t* source, DataType type)
+        {
+            switch (type)
+            {
+            case DataType::UINT8:
+                return EC_READ_U8(source);
+            case DataType::INT8:
+                return EC_READ_S8(source);
+            case DataType::UINT16:
+                return EC_READ_U16(source);
+            case DataType::INT16:
+                return EC_READ_S16(source);
+            case DataType::UINT32:
+                return EC_READ_U32(source);
+            case DataType::INT32:
+                return EC_READ_S32(source);
+            case DataType::UINT64:
+                return (double)EC_READ_U64(source);
+            case DataType::INT64:
+                return (double)EC_READ_S64(source);
+            case DataType::FLOAT:
+                return EC_READ_REAL(source);
+            case DataType::DOUBLE:
+                return EC_READ_LREAL(source);
+            default:
+                return 0.0;
+            }
+        }
+
+        /**
+         * @brief Lowest and highest value an entry of the type holds, a value clamped to them is written without overflowing.
+         *
+         */
+        inline std::pair<double, double> getTypeRange(DataType type)
+        {
+            switch (type)
+            {
+            case DataType::UINT8:
+                return {0.0, (double)UINT8_MAX};
+            case DataType::INT8:
+                return {(double)INT8_MIN, (double)INT8_MAX};
+            case DataType::UINT16:
+                return {0.0, (double)UINT16_MAX};
+            case DataType::INT16:
+                return {(double)INT16_MIN, (double)INT16_MAX};
+            case DataType::UINT32:
+                return {0.0, (double)UINT32_MAX};
+            case DataType::INT32:
+                return {(double)INT32_MIN, (double)INT32_MAX};
+            // The largest 64 bit values are not doubles, the limits are the closest doubles below them.
+            case DataType::UINT64:
+                return {0.0, std::nextafter((double)UINT64_MAX, 0.0)};
+            case DataType::INT64:
+                return {(double)INT64_MIN, std::nextafter((double)INT64_MAX, 0.0)};
+            case DataType::FLOAT:
+                return {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::max()};
+            default:
+                return {std::numeric_limits<double>::lowest(), std::numeric_limits<double>::max()};
+            }
+        }
+
+        /**
+         * @brief Rounds half away from zero, the value is already within the range of the type.
+         *
+         */
+        template<typename T>
+        T roundTo(double value)
+        {
+            return (T)(value + std::copysign(0.5, value));
+        }
+
+        /**
+         * @brief Writes the value rounded to the entry type, the value has to be within getTypeRange() of the type.
+         *
+         */
+        inline void writeEntry(uint8_t* destination, DataType type, double value)
+        {
+            switch (type)
+            {
+            case DataType::UINT8:
+                EC_WRITE_U8(destination, roundTo<uint8_t>(value));
+                break;
+            case DataType::INT8:
+                EC_WRITE_S8(destination, roundTo<int8_t>(value));
+                break;
+            case DataType::UINT16:
+                EC_WRITE_U16(destination, roundTo<uint16_t>(value));
+                break;
+            case DataType::INT16:
+                EC_WRITE_S16(destination, roundTo<int16_t>(value));
+                break;
+            case DataType::UINT32:
+                EC_WRITE_U32(destination, roundTo<uint32_t>(value));
+                break;
+            case DataType::INT32:
+                EC_WRITE_S32(destination, roundTo<int32_t>(value));
+                break;
+            case DataType::UINT64:
+                EC_WRITE_U64(destination, roundTo<uint64_t>(value));
+                break;
+            case DataType::INT64:
+                EC_WRITE_S64(destination, roundTo<int64_t>(value));
+                break;
+            case DataType::FLOAT:
+                EC_WRITE_REAL(destination, (float)value);
+                break;
+            case DataType::DOUBLE:
+                EC_WRITE_LREAL(destination, value);
+                break;
+            default:
+                break;
+            }
+        }
+
+    } // End of namespace entry
+} // End of namespace ec
+
+#endif // ENTRY_ACCESS_HPP_
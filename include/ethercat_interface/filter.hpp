@@ -0,0 +1,185 @@
+/**
+ * @file filter.hpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief Filters of the input entries of a domain, evaluated together every cycle.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef FILTER_HPP_
+#define FILTER_HPP_
+
+#include "ec_common_defs.hpp"
+#include "entry_access.hpp"
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace ec
+{
+    namespace filter
+    {
+
+        /**
+         * @brief Entry of a domain and the filter applied to it.
+         *
+         */
+        struct FilteredEntry
+        {
+            uint32_t offset;
+
+            DataType type;
+
+            EntryFilter filter;
+
+            /**
+             * @brief Stale flag of the slave of the entry, nullptr if it is never stale.
+             *
+             */
+            const std::atomic<bool>* staleFlag = nullptr;
+        };
+
+        /**
+         * @brief Filters all filtered entries of one domain right after the domain is processed.
+         * Entries are grouped by filter type, the states of each group are kept as parallel arrays padded to
+         * blocks, so the biquads and medians of all entries run in branch free loops the compiler vectorizes.
+         * The filtered values are kept next to the raw values in the domain, in the order of the entries.
+         * The filter of an entry whose slave is stale keeps its state and value until the slave is back.
+         * Everything is allocated on construction.
+         *
+         */
+        class FilterBank
+        {
+            public:
+
+            FilterBank(const uint8_t* domain_data, const std::vector<FilteredEntry>& entries);
+
+            /**
+             * @brief Reads the entries and filters them. The first update after construction or reset()
+             * starts every filter in the steady state of the sample read, so there is no transient.
+             *
+             */
+            void update();
+
+            /**
+             * @brief Restarts the filters from the next sample, e.g. after the inputs were stale.
+             *
+             */
+            void reset()
+            {
+                m_IsPrimed = false;
+            }
+
+            std::size_t size() const
+            {
+                return m_Values.size();
+            }
+
+            /**
+             * @brief Filtered value of the entry, 0 before the first update().
+             *
+             */
+            double getValue(std::size_t entry_index) const
+            {
+                return m_Values[entry_index];
+            }
+
+            /**
+             * @brief Address of the filtered value of the entry, stable for the lifetime of the bank.
+             *
+             */
+            const double* getValuePtr(std::size_t entry_index) const
+            {
+                return &m_Values[entry_index];
+            }
+
+            private:
+
+            static constexpr std::size_t BlockSize = 4;
+
+            static std::size_t getPaddedSize(std::size_t count)
+            {
+                return (count + BlockSize - 1) / BlockSize * BlockSize;
+            }
+
+            const uint8_t* m_DomainData = nullptr;
+
+            std::vector<FilteredEntry> m_Entries;
+
+            std::vector<double> m_Values;
+
+            bool m_IsPrimed = false;
+
+            // Biquads in transposed direct form II.
+
+            std::vector<std::size_t> m_BiquadEntries;
+
+            std::vector<double> m_B0;
+
+            std::vector<double> m_B1;
+
+            std::vector<double> m_B2;
+
+            std::vector<double> m_A1;
+
+            std::vector<double> m_A2;
+
+            std::vector<double> m_Z1;
+
+            std::vector<double> m_Z2;
+
+            std::vector<double> m_BiquadInputs;
+
+            std::vector<double> m_BiquadOutputs;
+
+            // Moving averages, the histories of all entries are one array.
+
+            std::vector<std::size_t> m_AverageEntries;
+
+            std::vector<std::size_t> m_HistoryStarts;
+
+            std::vector<uint16_t> m_Windows;
+
+            std::vector<uint16_t> m_HistoryPositions;
+
+            std::vector<double> m_History;
+
+            std::vector<double> m_Sums;
+
+            // Medians of the last three samples.
+
+            std::vector<std::size_t> m_MedianEntries;
+
+            std::vector<double> m_Previous1;
+
+            std::vector<double> m_Previous2;
+
+            std::vector<double> m_MedianInputs;
+
+            std::vector<double> m_MedianOutputs;
+
+            // States of the biquads and medians of stale entries, saved before and restored after the blocks run.
+            std::vector<std::size_t> m_HeldBiquads;
+            std::vector<double> m_HeldZ1;
+            std::vector<double> m_HeldZ2;
+            std::vector<std::size_t> m_HeldMedians;
+            std::vector<double> m_HeldPrevious1;
+            std::vector<double> m_HeldPrevious2;
+
+            bool isHeld(std::size_t entry_index) const
+            {
+                return entry::isStale(m_Entries[entry_index].staleFlag);
+            }
+
+            void prime();
+        };
+
+    } // End of namespace filter
+} // End of namespace ec
+
+#endif // FILTER_HPP_
@@ -0,0 +1,273 @@
+/**
+ * @file health.hpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief Working counter and state monitoring of the domains, the slaves and the master.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef HEALTH_HPP_
+#define HEALTH_HPP_
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace ec
+{
+    namespace health
+    {
+
+        /**
+         * @brief Directions of process data a slave exchanges through one domain.
+         *
+         */
+        struct DomainMember
+        {
+            bool hasOutputs;
+
+            bool hasInputs;
+        };
+
+        /**
+         * @brief Working counter a domain's datagram returns when every slave processed it.
+         * A domain with outputs and inputs is exchanged with LRW, which a slave increments by 2 for writing
+         * and by 1 for reading. A domain in one direction only is exchanged with LWR or LRD, incremented by 1 per slave.
+         *
+         */
+        inline uint32_t expectedWorkingCounter(const std::vector<DomainMember>& members)
+        {
+            bool hasOutputs = false;
+            bool hasInputs = false;
+            for(const auto& member : members)
+            {
+                hasOutputs |= member.hasOutputs;
+                hasInputs |= member.hasInputs;
+            }
+
+            uint32_t workingCounter = 0;
+            for(const auto& member : members)
+            {
+                if(hasOutputs && hasInputs){
+                    workingCounter += (member.hasOutputs ? 2 : 0) + (member.hasInputs ? 1 : 0);
+                }
+                else{
+                    workingCounter += (member.hasOutputs || member.hasInputs) ? 1 : 0;
+                }
+            }
+
+            return workingCounter;
+        }
+
+        /**
+         * @brief Working counter statistics of a domain.
+         * Written by the cyclic thread only, readable from any thread without locking.
+         *
+         */
+        struct DomainHealth
+        {
+            uint32_t expectedWorkingCounter = 0;
+
+            std::atomic<uint32_t> lastWorkingCounter{0};
+
+            std::atomic<uint64_t> checkedCycles{0};
+
+            /**
+             * @brief Cycles whose working counter was above zero but below the expected one.
+             *
+             */
+            std::atomic<uint64_t> incompleteCycles{0};
+
+            /**
+             * @brief Cycles no slave processed the datagram in, e.g. the frame got lost.
+             *
+             */
+            std::atomic<uint64_t> zeroCycles{0};
+
+            /**
+             * @brief Number of cycles in a row without the expected working counter, reset by a complete cycle.
+             *
+             */
+            std::atomic<uint64_t> consecutiveFaultyCycles{0};
+
+            /**
+             * @brief Counts one cycle, called after the domain's datagram is processed.
+             *
+             */
+            inline void check(uint32_t working_counter)
+            {
+                lastWorkingCounter.store(working_counter, std::memory_order_relaxed);
+                checkedCycles.fetch_add(1, std::memory_order_relaxed);
+                if(working_counter == expectedWorkingCounter){
+                    consecutiveFaultyCycles.store(0, std::memory_order_relaxed);
+                    return;
+                }
+
+                if(working_counter == 0){
+                    zeroCycles.fetch_add(1, std::memory_order_relaxed);
+                }
+                else{
+                    incompleteCycles.fetch_add(1, std::memory_order_relaxed);
+                }
+                consecutiveFaultyCycles.fetch_add(1, std::memory_order_relaxed);
+            }
+        };
+
+        /**
+         * @brief Last polled state of a slave's configuration.
+         *
+         */
+        struct SlaveHealth
+        {
+            std::atomic<bool> online{false};
+
+            std::atomic<bool> operational{false};
+
+            /**
+             * @brief Application layer state: 1 INIT, 2 PREOP, 4 SAFEOP, 8 OP.
+             *
+             */
+            std::atomic<uint8_t> alState{0};
+
+            /**
+             * @brief Number of polls that found the state different from the previous poll.
+             *
+             */
+            std::atomic<uint64_t> stateChanges{0};
+
+            /**
+             * @brief Set when the slave leaves OP after having reached it, its inputs in the domain are not updated anymore.
+             * Cleared when the slave is back in OP.
+             *
+             */
+            std::atomic<bool> stale{false};
+
+            std::atomic<uint64_t> losses{0};
+
+            std::atomic<uint64_t> rejoins{0};
+
+            /**
+             * @brief Whether the slave has been in OP since the master was activated, only used by the cyclic thread.
+             *
+             */
+            bool hasBeenOperational = false;
+        };
+
+        /**
+         * @brief Last polled state of the master.
+         *
+         */
+        struct MasterHealth
+        {
+            std::atomic<uint32_t> slavesResponding{0};
+
+            /**
+             * @brief Application layer states of all slaves or'ed together.
+             *
+             */
+            std::atomic<uint8_t> alStates{0};
+
+            std::atomic<bool> linkUp{false};
+
+            std::atomic<uint64_t> stateChecks{0};
+
+            /**
+             * @brief Number of polls that found fewer responding slaves than the previous poll.
+             *
+             */
+            std::atomic<uint64_t> respondingDrops{0};
+        };
+
+        /**
+         * @brief Copy of DomainHealth for the readers.
+         *
+         */
+        struct DomainStatus
+        {
+            uint32_t expectedWorkingCounter;
+
+            uint32_t lastWorkingCounter;
+
+            uint64_t checkedCycles;
+
+            uint64_t incompleteCycles;
+
+            uint64_t zeroCycles;
+
+            uint64_t consecutiveFaultyCycles;
+        };
+
+        struct SlaveStatus
+        {
+            bool online;
+
+            bool operational;
+
+            uint8_t alState;
+
+            uint64_t stateChanges;
+
+            bool stale;
+
+            uint64_t losses;
+
+            uint64_t rejoins;
+        };
+
+        struct MasterStatus
+        {
+            uint32_t slavesResponding;
+
+            uint8_t alStates;
+
+            bool linkUp;
+
+            uint64_t stateChecks;
+
+            uint64_t respondingDrops;
+        };
+
+        inline DomainStatus readStatus(const DomainHealth& health)
+        {
+            return DomainStatus{
+                health.expectedWorkingCounter,
+                health.lastWorkingCounter.load(std::memory_order_relaxed),
+                health.checkedCycles.load(std::memory_order_relaxed),
+                health.incompleteCycles.load(std::memory_order_relaxed),
+                health.zeroCycles.load(std::memory_order_relaxed),
+                health.consecutiveFaultyCycles.load(std::memory_order_relaxed)
+            };
+        }
+
+        inline SlaveStatus readStatus(const SlaveHealth& health)
+        {
+            return SlaveStatus{
+                health.online.load(std::memory_order_relaxed),
+                health.operational.load(std::memory_order_relaxed),
+                health.alState.load(std::memory_order_relaxed),
+                health.stateChanges.load(std::memory_order_relaxed),
+                health.stale.load(std::memory_order_relaxed),
+                health.losses.load(std::memory_order_relaxed),
+                health.rejoins.load(std::memory_order_relaxed)
+            };
+        }
+
+        inline MasterStatus readStatus(const MasterHealth& health)
+        {
+            return MasterStatus{
+                health.slavesResponding.load(std::memory_order_relaxed),
+                health.alStates.load(std::memory_order_relaxed),
+                health.linkUp.load(std::memory_order_relaxed),
+                health.stateChecks.load(std::memory_order_relaxed),
+                health.respondingDrops.load(std::memory_order_relaxed)
+            };
+        }
+
+    } // End of namespace health
+} // End of namespace ec
+
+#endif // HEALTH_HPP_
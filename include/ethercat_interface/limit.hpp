@@ -0,0 +1,167 @@
+/**
+ * @file limit.hpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief Clamps the output entries of a domain to their limits before the domain is sent.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef LIMIT_HPP_
+#define LIMIT_HPP_
+
+#include "ec_common_defs.hpp"
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace ec
+{
+    namespace limit
+    {
+
+        /**
+         * @brief Entry of a domain and the limits it is clamped to.
+         *
+         */
+        struct LimitedEntry
+        {
+            /**
+             * @brief Name the entry is found by, e.g. "slave_name.entry_name".
+             *
+             */
+            std::string name;
+
+            uint32_t offset;
+
+            DataType type;
+
+            EntryLimit limit;
+
+            /**
+             * @brief Stale flag of the slave of the entry, nullptr if it is never stale.
+             *
+             */
+            const std::atomic<bool>* staleFlag = nullptr;
+        };
+
+        /**
+         * @brief Last line of defence between the update function and the bus: clamps every limited entry of a domain
+         * to its range and to its largest step from the value sent before, a NaN is replaced by the value sent before.
+         * The values of all entries are gathered, clamped in one branch free loop over arrays padded to blocks the
+         * compiler vectorizes, and only the clamped ones are written back and counted. An entry whose slave is stale
+         * is held at the value sent before, so the slave rejoins with the output it left with and the step limit
+         * continues from there. Everything is allocated on construction, apply() is called by the master right before
+         * the domain is queued.
+         *
+         */
+        class LimitStage
+        {
+            public:
+
+            LimitStage(uint8_t* domain_data, const std::vector<LimitedEntry>& entries);
+
+            /**
+             * @brief Clamps the entries in the domain. The first apply() after construction has no previous values,
+             * the steps are limited from the second one on.
+             *
+             */
+            void apply();
+
+            std::size_t size() const
+            {
+                return m_Entries.size();
+            }
+
+            std::optional<std::size_t> findEntry(const std::string& name) const;
+
+            /**
+             * @brief Entries are enabled on construction. A disabled entry is sent as written, the value it is
+             * sent with still counts as the previous value of its step limit.
+             *
+             */
+            void setEnabled(std::size_t entry_index, bool is_enabled)
+            {
+                m_EnableMasks[entry_index] = is_enabled ? 1.0 : 0.0;
+            }
+
+            bool isEnabled(std::size_t entry_index) const
+            {
+                return m_EnableMasks[entry_index] != 0.0;
+            }
+
+            /**
+             * @brief Number of apply() calls the entry was clamped in. Can be called from any thread.
+             *
+             */
+            uint64_t getClampCount(std::size_t entry_index) const
+            {
+                return m_ClampCounts[entry_index].load(std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief Number of clamped values of all entries. Can be called from any thread.
+             *
+             */
+            uint64_t getTotalClampCount() const
+            {
+                return m_TotalClampCount.load(std::memory_order_relaxed);
+            }
+
+            private:
+
+            static constexpr std::size_t BlockSize = 4;
+
+            static std::size_t getPaddedSize(std::size_t count)
+            {
+                return (count + BlockSize - 1) / BlockSize * BlockSize;
+            }
+
+            uint8_t* m_DomainData = nullptr;
+
+            std::vector<LimitedEntry> m_Entries;
+
+            std::vector<double> m_Mins;
+
+            std::vector<double> m_Maxs;
+
+            std::vector<double> m_MaxSteps;
+
+            std::vector<double> m_EnableMasks;
+
+            /**
+             * @brief 1 for the entries of stale slaves, gathered by every apply().
+             *
+             */
+            std::vector<double> m_HoldMasks;
+
+            std::vector<double> m_Values;
+
+            std::vector<double> m_PreviousValues;
+
+            std::vector<double> m_Outputs;
+
+            /**
+             * @brief 1 for the entries clamped by the last apply().
+             *
+             */
+            std::vector<double> m_ClampFlags;
+
+            std::unique_ptr<std::atomic<uint64_t>[]> m_ClampCounts;
+
+            std::atomic<uint64_t> m_TotalClampCount{0};
+
+            bool m_HasPreviousValues = false;
+        };
+
+    } // End of namespace limit
+} // End of namespace ec
+
+#endif // LIMIT_HPP_
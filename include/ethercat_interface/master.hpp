@@ -16,12 +16,26 @@
 #include <vector>
 #include <memory>
 #include <functional>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <deque>
 
 #include "ec_common_defs.hpp"
 #include "comm_interface.hpp"
 #include "slave.hpp"
 #include "parser.hpp"
 #include "time_operations.hpp"
+#include "recorder.hpp"
+#include "capture.hpp"
+#include "config_diff.hpp"
+#include "topology.hpp"
+#include "health.hpp"
+#include "filter.hpp"
+#include "limit.hpp"
+#include "timestamp.hpp"
 
 using namespace ec::slave;
 
@@ -31,17 +45,46 @@ using namespace ec::slave;
  */
 using SharedData = std::shared_ptr<std::map<std::string, std::shared_ptr<ec::data::DataMap>>>;
 
-typedef std::map<std::string, Slave*> Slaves;
-
 using CommunicationInterfacePtr = CommunicationInterface*;
 
 struct Domain
 {
     ec_domain_t* domainPtr;
     uint8_t* domainDataPtr;
+    std::size_t domainSize;
     std::vector<std::string> domainSlaves;
     ec_pdo_entry_reg_t* domainEntries;
 
+    /**
+     * @brief Positions of the first RxPDO and the first TxPDO entry of each slave in domainEntries.
+     * 
+     */
+    std::vector<std::size_t> syncManagerEntries;
+
+    /**
+     * @brief Working counter statistics, owned by the master.
+     * 
+     */
+    ec::health::DomainHealth* health = nullptr;
+
+    /**
+     * @brief Filters of the domain's input entries, owned by the master, nullptr if no entry is filtered.
+     * 
+     */
+    ec::filter::FilterBank* filters = nullptr;
+
+    /**
+     * @brief Limits of the domain's output entries, owned by the master, nullptr if no entry is limited.
+     * 
+     */
+    ec::limit::LimitStage* limits = nullptr;
+
+    /**
+     * @brief Latch times of the domain's inputs, owned by the master, nullptr if the domain has no inputs.
+     * 
+     */
+    ec::timestamp::InputTimestamps* timestamps = nullptr;
+
     Domain();
     ~Domain();
 
@@ -49,6 +92,33 @@ struct Domain
     bool createDomainData();
 };
 
+/**
+ * @brief Outcome of Master::reloadConfig().
+ * 
+ */
+struct ReloadReport
+{
+    /**
+     * @brief True if the tunable changes are in effect, false if nothing was applied.
+     * 
+     */
+    bool applied = false;
+
+    /**
+     * @brief Cycle counter value at the boundary the changes were applied at.
+     * 
+     */
+    uint64_t appliedAtCycle = 0;
+
+    std::vector<std::string> appliedChanges;
+
+    /**
+     * @brief Structural changes that caused the reload to be rejected, or the reason the reload failed.
+     * 
+     */
+    std::vector<std::string> rejectedChanges;
+};
+
 class Master
 {
 
@@ -56,6 +126,12 @@ class Master
 
     typedef std::function<void(void)> UpdateFunction;
 
+    /**
+     * @brief Called by the cyclic thread when a slave leaves OP (rejoined = false) and when it is back in OP (rejoined = true).
+     * 
+     */
+    typedef std::function<void(const std::string& slave_name, bool rejoined)> SlaveStateCallback;
+
     /**
      * @brief Default constructor.
      * 
@@ -79,6 +155,36 @@ class Master
      */
     bool init();
 
+    /**
+     * @brief Starts the cyclic thread: it waits for the next cycle, receives the frames and the data of all domains,
+     * calls the update function, then queues the domains and sends the frames.
+     * The thread is pinned to the cpu_core and aligned by align_cycles of the program configuration.
+     * Every master runs its own thread, so several masters in one process cycle independently.
+     * 
+     * @return false If the master is not initialized, has no cycle period, is already started or could not be pinned.
+     */
+    bool start();
+
+    /**
+     * @brief Stops the cyclic thread after its current cycle, called by the destructor.
+     * 
+     */
+    void stop();
+
+    inline bool isRunning() const
+    {
+        return m_IsCycling.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Wake up time of the current cycle in nanoseconds on the clock of the cycle timer,
+     * the same time receive() gives the distributed clocks as the application time.
+     * Meant for the update function, e.g. to evaluate an ec::motion::Interpolator.
+     * 
+     * @return 0 Before init().
+     */
+    uint64_t getApplicationTime() const;
+
     void update();
 
     /**
@@ -93,25 +199,92 @@ class Master
 
     void setUpdateFunction(UpdateFunction update_function);
 
+    /**
+     * @brief Sets the function called on slave losses and rejoins, e.g. to re-enable a drive after it rejoined.
+     * Called from receive(), so it must not block.
+     * 
+     */
+    void setSlaveStateCallback(SlaveStateCallback slave_state_callback);
+
+    /**
+     * @brief Sets the number of threads init() builds the PDO tables and domain registrations with.
+     * 
+     * @param thread_count 1 to build them on the calling thread.
+     */
+    inline void setInitThreadCount(std::size_t thread_count)
+    {
+        m_InitThreadCount = std::max<std::size_t>(1, thread_count);
+    }
+
+    /**
+     * @brief Sets how long init() waits for the EtherCAT master to finish scanning the bus.
+     * 
+     */
+    inline void setBusScanTimeout(std::chrono::milliseconds timeout)
+    {
+        m_BusScanTimeout = timeout;
+    }
+
+    /**
+     * @brief True if init() found the same bus and configuration as in the previous start, skipped validating
+     * the configured slaves against the bus and took the domain offsets from the previous start.
+     * Only the first entry of each sync manager is registered then, instead of every PDO entry.
+     * The topology snapshot is kept in "<config_file_path>.topology".
+     * 
+     */
+    inline bool isFastRestart() const
+    {
+        return m_IsFastRestart;
+    }
+
     void setCommunicationInterface(CommunicationInterface* interface);
 
     /**
      * @brief Get the Slave object pointer in it's derived pointer format. 
      * This enables to use the derived-slave spesific methods in the user code.
+     * The pointer stays valid until the master is destroyed, so it only needs to be fetched once.
      * 
-     * @tparam T Type of the slave: Driver*, IO* etc.
+     * @tparam T Type of the slave: Driver*, IO* etc., Slave* for a slave of any type.
      * @param slave_name Name of the slave
-     * @return std::optional<T> 
+     * @return std::optional<T> std::nullopt if there is no slave of that name and type.
      */
     template<class T>
     std::optional<T> getSlave(const std::string& slave_name)
     {
-        auto slaveExists = m_RegisteredSlaves.find(slave_name);
-        if(slaveExists == m_RegisteredSlaves.end()){
+        auto slaveIndex = m_SlaveIndices.find(slave_name);
+        if(slaveIndex == m_SlaveIndices.end()){
             return std::nullopt;
         }
 
-        return dynamic_cast<T>(slaveExists->second);
+        using ConcreteSlave = std::remove_pointer_t<T>;
+        if constexpr (std::is_same_v<ConcreteSlave, Slave>){
+            return m_SlaveList[slaveIndex->second];
+        }
+        else{
+            ConcreteSlave* slave = std::get_if<ConcreteSlave>(&m_Slaves[slaveIndex->second]);
+            if(!slave){
+                return std::nullopt;
+            }
+            return slave;
+        }
+    }
+
+    /**
+     * @brief Drivers of the domain in bus order, e.g. to create a CIA402::AxisGroup.
+     * 
+     */
+    std::vector<Driver*> getDrivers(const std::string& domain_name)
+    {
+        std::vector<Driver*> drivers;
+        for(auto& slave : m_Slaves)
+        {
+            Driver* driver = std::get_if<Driver>(&slave);
+            if(driver && driver->getSlaveInfo().domainName == domain_name){
+                drivers.push_back(driver);
+            }
+        }
+
+        return drivers;
     }
 
     /**
@@ -229,6 +402,177 @@ class Master
 
     bool sendDomainData(const std::string& domain_name);
 
+    /**
+     * @brief Starts recording the process images of all domains into a memory-mapped file.
+     * Must be called after init(), one frame is recorded on every call to send().
+     * While the cyclic thread runs, the recorder is handed over to it at the next cycle boundary.
+     * 
+     * @param recording_file_path Path of the recording file, overwritten if it exists.
+     * @param cycle_capacity Number of cycles kept in the file, oldest cycles are overwritten once it is full.
+     * @return true If the recording file is created.
+     * @return false otherwise.
+     */
+    bool startRecording(const std::string& recording_file_path, std::size_t cycle_capacity);
+
+    /**
+     * @brief Takes the recorder back from the cyclic thread and closes the recording file.
+     * 
+     * @return false If the cyclic thread did not reach a cycle boundary in time, the recording continues.
+     */
+    bool stopRecording();
+
+    /**
+     * @brief Number of cycles that could not be recorded because the writer thread fell behind.
+     * 
+     */
+    uint64_t getDroppedRecordingFrames() const
+    {
+        return m_Recorder ? m_Recorder->droppedFrames() : 0;
+    }
+
+    /**
+     * @brief Replays a recording made with startRecording().
+     * Each call to receive() advances one recorded cycle and receiveDomainData() overwrites
+     * the input entries of the domain with the recorded ones, so the update function sees the recorded inputs.
+     * The outputs are never restored, the slaves only receive what the update function writes.
+     * Replay stops by itself after the last recorded cycle, the file stays open until stopReplay() is called.
+     * 
+     * @param recording_file_path Path of the recording file.
+     * @return true If all domains of the recording match the configured domains.
+     * @return false otherwise.
+     */
+    bool startReplay(const std::string& recording_file_path);
+
+    /**
+     * @brief Takes the player back from the cyclic thread and closes the recording file.
+     * 
+     * @return false If the cyclic thread did not reach a cycle boundary in time, the replay continues.
+     */
+    bool stopReplay();
+
+    inline bool isReplaying() const
+    {
+        return m_Player != nullptr && m_FinishedPlayer.load(std::memory_order_relaxed) != m_Player.get();
+    }
+
+    /**
+     * @brief Re-runs the update function on every cycle of a recording without the bus.
+     * For each recorded cycle the input entries are restored, filtered and timestamped as in receiveDomainData(),
+     * the update function is called and the limits are applied as in sendDomainData(). Nothing is sent or received,
+     * so the same recording always produces the same outputs. getCycleCounter() returns the recorded cycle meanwhile.
+     * Must be called after init() and while the cyclic thread is stopped.
+     * 
+     * @param recording_file_path Path of the recording file.
+     * @return std::optional<std::size_t> Number of replayed cycles, std::nullopt if the master is cycling
+     * or the domains of the recording do not match the configured domains.
+     */
+    std::optional<std::size_t> replayOffline(const std::string& recording_file_path);
+
+    /**
+     * @brief Starts a columnar capture of the PDO entries of the given slaves, one sample on every call to send().
+     * Each entry is stored in the column "<slave_name>.<entry_name>".
+     * Must be called after init().
+     * 
+     * @param capture_file_path Path of the capture file, overwritten if it exists.
+     * @param slave_names Slaves whose entries are captured, all slaves if empty.
+     * @param chunk_size Number of samples per column chunk.
+     * @return true If the capture file is created.
+     * @return false otherwise.
+     */
+    bool startCapture(
+        const std::string& capture_file_path,
+        const std::vector<std::string>& slave_names = {},
+        std::size_t chunk_size = 4096
+    );
+
+    /**
+     * @brief Takes the capture writer back from the cyclic thread and closes the capture file.
+     * 
+     * @return false If the cyclic thread did not reach a cycle boundary in time, the capture continues.
+     * Also false if the capture file could not be written completely, the capture is closed then.
+     */
+    bool stopCapture();
+
+    /**
+     * @brief Re-parses the configuration file and applies the changes that do not alter the PDO mapping
+     * (cycle divisors, telemetry selections and scaling factors) without stopping the cycle.
+     * All tunable changes are published together and taken over by the cyclic thread in the next receive().
+     * If the reloaded configuration contains any structural change nothing is applied.
+     * Must not be called from the cyclic thread, blocks until the changes are taken over or the timeout expires.
+     * 
+     * @param timeout Maximum time to wait for the cyclic thread to reach a cycle boundary.
+     * @return ReloadReport 
+     */
+    ReloadReport reloadConfig(std::chrono::milliseconds timeout = std::chrono::milliseconds(1000));
+
+    /**
+     * @brief Sets the number of SDO request operations (state polls and transfer starts) made in each receive().
+     * The slaves with queued transfers are served in turns, so a busy slave can not stall the others.
+     * 
+     */
+    inline void setSdoBudget(std::size_t sdo_budget)
+    {
+        m_SdoBudget = sdo_budget;
+    }
+
+    /**
+     * @brief Polls the master state and the states of the next slaves on every state_check_divisor-th call to receive().
+     * Each poll is a call into the EtherCAT master, so the slaves are polled in turns instead of all at once.
+     * 
+     * @param state_check_divisor 0 disables the polling.
+     * @param slaves_per_check Number of slave states polled per check.
+     */
+    inline void setStateCheck(std::size_t state_check_divisor, std::size_t slaves_per_check = 8)
+    {
+        m_StateCheckDivisor = state_check_divisor;
+        m_SlavesPerStateCheck = slaves_per_check;
+    }
+
+    /**
+     * @brief Working counter statistics of the domain, updated by every receiveDomainData().
+     * Can be called from any thread.
+     * 
+     */
+    std::optional<ec::health::DomainStatus> getDomainStatus(const std::string& domain_name) const;
+
+    /**
+     * @brief Last polled state of the slave, see setStateCheck(). Can be called from any thread.
+     * 
+     */
+    std::optional<ec::health::SlaveStatus> getSlaveStatus(const std::string& slave_name) const;
+
+    /**
+     * @brief Limit stage run by sendDomainData() for the domain, its entries are named "slave_name.entry_name".
+     * 
+     * @return nullptr If no output entry of the domain has a limit.
+     */
+    ec::limit::LimitStage* getLimitStage(const std::string& domain_name);
+
+    /**
+     * @brief Latch times of the inputs of the domain, updated by receiveDomainData(). The timestamp entries are named "slave_name.entry_name".
+     * 
+     * @return nullptr If the domain has no inputs.
+     */
+    ec::timestamp::InputTimestamps* getInputTimestamps(const std::string& domain_name);
+
+    /**
+     * @brief Last polled state of the master, see setStateCheck(). Can be called from any thread.
+     * 
+     */
+    inline ec::health::MasterStatus getMasterStatus() const
+    {
+        return ec::health::readStatus(m_MasterHealth);
+    }
+
+    /**
+     * @brief Number of calls to send() since init().
+     * 
+     */
+    inline uint64_t getCycleCounter() const
+    {
+        return m_CycleCounter.load(std::memory_order_relaxed);
+    }
+
     private:
 
     std::string m_PathToConfigurationFile;
@@ -238,9 +582,9 @@ class Master
      * 
      */
 
-    CommunicationInterfacePtr m_CommunicationInterface;
+    CommunicationInterfacePtr m_CommunicationInterface = nullptr;
 
-    ec_master_t* m_MasterPtr;
+    ec_master_t* m_MasterPtr = nullptr;
 
     std::unordered_map<std::string, Domain> m_Domains;
 
@@ -250,7 +594,56 @@ class Master
      */
     UpdateFunction m_UpdateFunction;
 
-    Slaves m_RegisteredSlaves;
+    SlaveStateCallback m_SlaveStateCallback;
+
+    /**
+     * @brief All slaves stored by value in bus position order, not resized after registerSlaves().
+     * 
+     */
+    std::vector<ec::slave::SlaveVariant> m_Slaves;
+
+    /**
+     * @brief Index into m_Slaves by slave name, only used while setting up.
+     * 
+     */
+    std::unordered_map<std::string, std::size_t> m_SlaveIndices;
+
+    /**
+     * @brief Base pointers to the slaves in m_Slaves, in the same order.
+     * 
+     */
+    std::vector<Slave*> m_SlaveList;
+
+    std::size_t m_InitThreadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    /**
+     * @brief Backs the PDO, sync manager and domain registration tables of all slaves, sized once in init().
+     * Each slave's tables are contiguous, the domain registration lists follow the tables of the last slave.
+     * 
+     */
+    ec::arena::TableArena m_TableArena;
+
+    std::chrono::milliseconds m_BusScanTimeout{5000};
+
+    bool m_IsFastRestart = false;
+
+    /**
+     * @brief Content hash of the configuration file init() was called with.
+     * 
+     */
+    uint64_t m_ConfigHash = 0;
+
+    /**
+     * @brief Slaves found on the bus by init(), empty if the bus could not be scanned.
+     * 
+     */
+    std::optional<std::vector<ec::topology::SlaveIdentity>> m_BusTopology;
+
+    /**
+     * @brief Domain layouts recorded by the previous start, the offsets of the entries on a fast restart.
+     * 
+     */
+    std::vector<ec::topology::DomainLayout> m_SnapshotDomains;
 
     SharedData m_SharedData;
 
@@ -259,28 +652,377 @@ class Master
     std::unique_ptr<CyclicTaskTimer> m_TaskTimer;
     bool m_IsDistributedClockEnabled = false;
 
+    std::thread m_CyclicThread;
+
+    std::atomic<bool> m_IsCycling{false};
+
+    /**
+     * @brief Loop of the thread started by start().
+     * 
+     */
+    void cyclicTask();
+
+    /**
+     * @brief Number of calls to send(), used to index the recorded cycles.
+     * 
+     */
+    std::atomic<uint64_t> m_CycleCounter{0};
+
+    /**
+     * @brief First application time written to the EtherCAT master, the SYNC0 pulses of the slaves are aligned to it.
+     * 
+     */
+    uint64_t m_ApplicationStartTime = 0;
+
     /**
-     * @brief Register a slave in the map
+     * @brief Time of the last send(), on the clock of the application time. Only taken if a domain has inputs.
      * 
-     * @param slave: ec::slave::Slave object instance
-     * @return true if slave is added to the map successfully 
-     * @return false if slave can't be added to the map
      */
-    bool registerSlave(Slave& slave);
+    uint64_t m_LastSendTime = 0;
+
+    /**
+     * @brief Owners of the recorder, player and capture writer, only touched by the start and stop functions.
+     * The cyclic thread uses them through m_ActiveStreams.
+     * 
+     */
+    std::unique_ptr<ec::recorder::ProcessDataRecorder> m_Recorder;
+
+    std::unique_ptr<ec::recorder::ProcessDataPlayer> m_Player;
+
+    std::unique_ptr<ec::capture::CaptureWriter> m_CaptureWriter;
+
+    /**
+     * @brief Player whose recording ended, set by the cyclic thread which stops using it.
+     * 
+     */
+    std::atomic<const ec::recorder::ProcessDataPlayer*> m_FinishedPlayer{nullptr};
+
+    /**
+     * @brief Image of a domain inside the replayed recording and the input ranges restored from it.
+     * 
+     */
+    struct ReplayedDomain
+    {
+        std::size_t imageIndex;
+
+        std::vector<ec::recorder::ImageRange> ranges;
+    };
+
+    /**
+     * @brief Recorder, player and capture writer used by the cyclic thread, handed over at a cycle boundary
+     * like the tuning updates so they are never replaced while send() or receive() use them.
+     * 
+     */
+    struct DataStreams
+    {
+        ec::recorder::ProcessDataRecorder* recorder = nullptr;
+
+        /**
+         * @brief Domain image pointers passed to the recorder, in the order given to the recorder on open.
+         * 
+         */
+        std::vector<const uint8_t*> recordedImages;
+
+        ec::recorder::ProcessDataPlayer* player = nullptr;
+
+        std::map<std::string, ReplayedDomain> replayedDomains;
+
+        ec::capture::CaptureWriter* captureWriter = nullptr;
+
+        uint64_t updateID = 0;
+    };
+
+    /**
+     * @brief Serializes the start and stop functions, each publishes a copy of m_Streams with its change applied.
+     * 
+     */
+    std::mutex m_StreamsMutex;
+
+    /**
+     * @brief Streams last handed to the cyclic thread, only touched by the start and stop functions.
+     * 
+     */
+    DataStreams m_Streams;
+
+    uint64_t m_StreamsCounter = 0;
+
+    std::atomic<uint64_t> m_AppliedStreamsID{0};
 
     /**
-     * @brief Registers the slaves specified in the configuration file.
+     * @brief Published by publishStreams(), taken over by the cyclic thread in receive().
      * 
-     * @return true If all slaves are added to the map.
-     * @return false If a slave can't be added to the map.
+     */
+    std::atomic<DataStreams*> m_PendingStreams{nullptr};
+
+    /**
+     * @brief Streams used by send(), receive() and receiveDomainData(), only touched by the thread running the cycle.
+     * 
+     */
+    DataStreams* m_ActiveStreams = nullptr;
+
+    /**
+     * @brief Streams replaced by the active ones, freed by publishStreams() outside of the cyclic thread.
+     * 
+     */
+    std::atomic<DataStreams*> m_RetiredStreams{nullptr};
+
+    /**
+     * @brief Hands the streams to the thread running the cycle. Applied right away if no cyclic thread runs
+     * or if called from it, otherwise waits until the cyclic thread takes them over in receive().
+     * 
+     * @return false If the cyclic thread did not reach a cycle boundary in time, nothing is changed then.
+     */
+    bool publishStreams(const DataStreams& streams);
+
+    void applyPendingStreams();
+
+    /**
+     * @brief Clears m_FinishedPlayer if it is the given player, called once the cyclic thread no longer uses the player.
+     * 
+     */
+    void forgetFinishedPlayer(const ec::recorder::ProcessDataPlayer* player);
+
+    /**
+     * @brief Reloaded settings handed from reloadConfig() to the cyclic thread.
+     * 
+     */
+    struct TuningUpdate
+    {
+        std::vector<Slave*> slaves;
+
+        /**
+         * @brief New tuning of slaves[i], referenced by the slave until the next update is applied.
+         * 
+         */
+        std::vector<ec::SlaveTuning> tunings;
+
+        /**
+         * @brief Enable flag of every capture column, empty if no capture was running at reload.
+         * 
+         */
+        std::vector<uint8_t> captureMask;
+
+        ec::capture::CaptureWriter* captureWriter = nullptr;
+
+        uint64_t updateID = 0;
+
+        uint64_t appliedAtCycle = 0;
+    };
+
+    /**
+     * @brief SDO engines of all slaves, served round robin by processSdoRequests().
+     * 
+     */
+    std::vector<ec::sdo::SdoEngine*> m_SdoEngines;
+
+    std::size_t m_NextSdoEngine = 0;
+
+    std::size_t m_SdoBudget = 8;
+
+    void processSdoRequests();
+
+    /**
+     * @brief Fulfils the futures and runs the callbacks of completed SDO transfers, so the cyclic thread never does.
+     * Started by init() if any slave has an SDO engine and stopped by the destructor.
+     * 
+     */
+    std::thread m_SdoCompletionThread;
+
+    std::atomic<bool> m_IsDeliveringSdoResults{false};
+
+    void sdoCompletionTask();
+
+    /**
+     * @brief Domain health of each domain, a deque so the Domain objects can point into it.
+     * 
+     */
+    std::deque<ec::health::DomainHealth> m_DomainHealth;
+
+    /**
+     * @brief State of each slave, in the order of m_SlaveList.
+     * 
+     */
+    std::unique_ptr<ec::health::SlaveHealth[]> m_SlaveHealth;
+
+    ec::health::MasterHealth m_MasterHealth;
+
+    std::size_t m_StateCheckDivisor = 100;
+
+    std::size_t m_SlavesPerStateCheck = 8;
+
+    std::size_t m_NextStateCheckedSlave = 0;
+
+    /**
+     * @brief Computes the expected working counter of each domain and creates the health counters.
+     * 
+     */
+    void setupHealthMonitoring();
+
+    /**
+     * @brief Filter bank of each domain with filtered entries, a deque so the Domain objects can point into it.
+     * 
+     */
+    std::deque<ec::filter::FilterBank> m_FilterBanks;
+
+    /**
+     * @brief Creates the filter banks of the domains from the filters of the TxPDO entries
+     * and hands the filtered values to the slaves.
+     * 
+     */
+    void setupFilters();
+
+    /**
+     * @brief Limit stage of each domain with limited entries, a deque so the Domain objects can point into it.
+     * 
+     */
+    std::deque<ec::limit::LimitStage> m_LimitStages;
+
+    /**
+     * @brief Creates the limit stages of the domains from the limits of the RxPDO entries.
+     * 
+     */
+    void setupLimits();
+
+    /**
+     * @brief Input timestamps of each domain with inputs, a deque so the Domain objects can point into it.
+     * 
+     */
+    std::deque<ec::timestamp::InputTimestamps> m_InputTimestamps;
+
+    /**
+     * @brief Creates the input timestamps of the domains from the DC configurations of the slaves and their timestamp entries.
+     * 
+     */
+    void setupTimestamps();
+
+    /**
+     * @brief Polls the master state and the next slaves' states if the cycle is due, called in receive().
+     * A slave leaving OP is marked stale, the rest of its domain keeps being exchanged.
+     * The EtherCAT master reconfigures a rejoining slave, including its startup SDOs, and brings it back to OP.
+     * 
+     */
+    void checkStates();
+
+    std::mutex m_ReloadMutex;
+
+    /**
+     * @brief ID of the last update created by reloadConfig().
+     * 
+     */
+    uint64_t m_UpdateCounter = 0;
+
+    /**
+     * @brief ID of the last update the cyclic thread has taken over.
+     * 
+     */
+    std::atomic<uint64_t> m_AppliedUpdateID{0};
+
+    /**
+     * @brief Published by reloadConfig(), taken over by the cyclic thread in receive().
+     * 
+     */
+    std::atomic<TuningUpdate*> m_PendingUpdate{nullptr};
+
+    /**
+     * @brief Update whose tunings the slaves currently reference, only touched by the cyclic thread.
+     * 
+     */
+    TuningUpdate* m_ActiveUpdate = nullptr;
+
+    /**
+     * @brief Update replaced by the active one, freed by reloadConfig() outside of the cyclic thread.
+     * 
+     */
+    std::atomic<TuningUpdate*> m_RetiredUpdate{nullptr};
+
+    void applyPendingUpdate();
+
+    /**
+     * @brief Enable flags of the writer's columns according to the telemetry selections.
+     * 
+     * @param tunings Tuning of each slave, the slaves' current tuning is used for slaves not in the map.
+     */
+    std::vector<uint8_t> createCaptureMask(
+        const ec::capture::CaptureWriter& writer,
+        const std::map<std::string, const ec::SlaveTuning*>& tunings
+    ) const;
+
+    /**
+     * @brief Byte ranges of the input entries of every domain, adjacent entries merged into one range.
+     * 
+     */
+    std::map<std::string, std::vector<ec::recorder::ImageRange>> createInputRanges() const;
+
+    /**
+     * @brief Finds the image of every configured domain in the recording.
+     * 
+     * @return std::nullopt If a domain is missing from the recording or has a different size.
+     */
+    std::optional<std::map<std::string, ReplayedDomain>> findReplayedDomains(const ec::recorder::ProcessDataPlayer& player) const;
+
+    /**
+     * @brief Filters and timestamps the inputs of the domain after they are received.
+     * 
+     * @param send_time Time the frame carrying the inputs was sent, 0 if unknown.
+     */
+    void processInputs(Domain& domain, uint64_t send_time);
+
+    /**
+     * @brief Creates the slaves specified in the configuration file, ordered by their alias and position.
+     * 
+     * @return true If all slaves are created.
+     * @return false If a slave name is used twice or a slave type is unknown.
      */
     bool registerSlaves();
 
+    /**
+     * @brief Slave of the given name, nullptr if there is none.
+     * 
+     */
+    Slave* findSlave(const std::string& slave_name) const;
+
+    /**
+     * @brief Sizes the table arena and builds the PDO and sync manager tables of all slaves in parallel,
+     * each slave in its own region of the arena.
+     * 
+     */
+    bool buildSlaveTables();
+
+    /**
+     * @brief Number of PDO entries each domain registers, keyed by domain name.
+     * 
+     */
+    std::map<std::string, std::size_t> countDomainEntries() const;
+
+    /**
+     * @brief Scans the bus and compares it with the topology snapshot of the previous start,
+     * the configured slaves are validated against the bus only if the snapshot does not match.
+     * 
+     * @return false If a configured slave's identity differs from the slave at its address.
+     */
+    bool checkTopology();
+
+    /**
+     * @brief Records the scanned bus and the domain layouts after activation, if they changed since the last start.
+     * 
+     */
+    void updateTopologySnapshot();
+
     bool createDomains();
 
     bool initSlaves();
 
     bool registerDomainEntries();
+
+    /**
+     * @brief Registers the first entry of each sync manager of the domain and takes the offsets of all entries
+     * from the snapshot of the previous start. The EtherCAT master maps the whole process data of a sync manager
+     * into the domain when one of its entries is registered, so the other entries need no registration.
+     * 
+     * @return false If the snapshot has no layout for the domain or a registered offset differs from it,
+     * the whole registration list has to be registered then.
+     */
+    bool registerCachedOffsets(const std::string& domain_name, Domain& domain);
     
 };
 
@@ -62,12 +62,57 @@ namespace ec
          */
         std::optional<SlaveInformation> parseSlaveConfig(const YAML::Node& slave_node);
 
+        /**
+         * @brief Encodes a startup SDO value in EtherCAT byte order.
+         * 
+         * @return Bytes of the value, empty if the type is unknown, std::nullopt if the value does not fit into the type.
+         */
+        std::optional<std::vector<uint8_t>> encodeSdoValue(const YAML::Node& value_node, DataType type);
+
+        /**
+         * @brief Parses the filter of a PDO entry, one of
+         * {type: biquad, b: [b0, b1, b2], a: [a1, a2]} (or a: [a0, a1, a2], normalized by a0),
+         * {type: moving_average, window: n} and {type: median3}.
+         * 
+         * @return std::nullopt If the filter type is unknown or its parameters are invalid.
+         */
+        std::optional<EntryFilter> parseEntryFilter(const YAML::Node& filter_node);
+
+        /**
+         * @brief Parses the limit of a PDO entry, {min: a, max: b, max_step: c}, each of them optional.
+         * 
+         * @return std::nullopt If min is above max or max_step is negative.
+         */
+        std::optional<EntryLimit> parseEntryLimit(const YAML::Node& limit_node);
+
         /**
          * @brief Parses the .yaml configuration file specified in the path_to_config_file parameter
          * 
          * @param path_to_config_file 
          */
         std::optional<ProgramConfig> parseConfigFile(const std::string& path_to_config_file);
+
+        /**
+         * @brief Parses the YAML documents of a configuration file.
+         * 
+         * @param config_docs Documents loaded from the configuration file.
+         * @return std::nullopt If there are no documents or any slave document is invalid, no slave is left out.
+         */
+        std::optional<ProgramConfig> parseConfigDocuments(const std::vector<YAML::Node>& config_docs);
+
+        /**
+         * @brief Loads the configuration from a binary snapshot keyed by the hash of the file content,
+         * falls back to parsing the YAML and rewrites the snapshot if the content has changed.
+         * 
+         * @param path_to_config_file 
+         * @param path_to_cache_file Path of the snapshot, "<path_to_config_file>.cache" if empty.
+         * @param content_hash Set to the hash of the file content if not nullptr.
+         */
+        std::optional<ProgramConfig> parseConfigFileCached(
+            const std::string& path_to_config_file,
+            const std::string& path_to_cache_file = "",
+            uint64_t* content_hash = nullptr
+        );
     
 
     } // End of namespace parser
@@ -0,0 +1,299 @@
+/**
+ * @file recorder.hpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief Memory-mapped process data recorder and replay player.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef RECORDER_HPP_
+#define RECORDER_HPP_
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <optional>
+#include <cstdint>
+#include <cstddef>
+
+namespace ec
+{
+    namespace recorder
+    {
+
+        constexpr char RecordingMagic[8] = {'E', 'C', 'R', 'E', 'C', '0', '0', '1'};
+        constexpr uint32_t RecordingVersion = 1;
+        constexpr std::size_t MaxDomainNameLength = 64;
+
+        /**
+         * @brief Name and size of a domain image that is going to be recorded.
+         *
+         */
+        struct DomainImageInfo
+        {
+            std::string name;
+
+            std::size_t size;
+        };
+
+        /**
+         * @brief Header at the beginning of a recording file.
+         * The file is laid out as: header | domain descriptors | cycle index | frames.
+         * A frame holds the images of all domains of one cycle back to back.
+         */
+        struct RecordingHeader
+        {
+            char magic[8];
+
+            uint32_t version;
+
+            uint32_t domainCount;
+
+            uint64_t cycleCapacity;
+
+            uint64_t frameSize;
+
+            uint64_t indexOffset;
+
+            uint64_t dataOffset;
+
+            /**
+             * @brief Total number of frames written, the file is used as a ring once it is full.
+             *
+             */
+            uint64_t framesWritten;
+        };
+
+        struct DomainDescriptor
+        {
+            char name[MaxDomainNameLength];
+
+            uint64_t size;
+
+            uint64_t offsetInFrame;
+        };
+
+        struct IndexEntry
+        {
+            uint64_t cycle;
+
+            uint64_t timestamp;
+        };
+
+        /**
+         * @brief Byte range inside a domain image.
+         *
+         */
+        struct ImageRange
+        {
+            std::size_t offset;
+
+            std::size_t size;
+        };
+
+        /**
+         * @brief Records the process images of every cycle into a preallocated memory-mapped file.
+         * The cyclic thread only copies the images into a preallocated ring,
+         * a background thread moves the frames from the ring into the file.
+         */
+        class ProcessDataRecorder
+        {
+            public:
+
+            ProcessDataRecorder();
+
+            ~ProcessDataRecorder();
+
+            ProcessDataRecorder(const ProcessDataRecorder&) = delete;
+            ProcessDataRecorder& operator=(const ProcessDataRecorder&) = delete;
+
+            /**
+             * @brief Creates and preallocates the recording file and starts the writer thread.
+             *
+             * @param path Path of the recording file, overwritten if it exists.
+             * @param domains Domains to record, in the order the images are passed to record().
+             * @param cycle_capacity Number of cycles the file can hold before it wraps around.
+             * @param ring_slots Number of frames buffered between the cyclic and the writer thread.
+             * @return true If the file is mapped and the writer thread is running.
+             * @return false otherwise.
+             */
+            bool open(
+                const std::string& path,
+                const std::vector<DomainImageInfo>& domains,
+                std::size_t cycle_capacity,
+                std::size_t ring_slots = 1024
+            );
+
+            /**
+             * @brief Flushes the buffered frames, stops the writer thread and unmaps the file.
+             *
+             */
+            void close();
+
+            /**
+             * @brief Copies one cycle's images into the ring. Safe to call from the cyclic thread.
+             *
+             * @param cycle Cycle counter of the recorded cycle.
+             * @param timestamp Timestamp of the cycle in nanoseconds.
+             * @param images One pointer per domain given to open(), in the same order.
+             * @return true If the frame is buffered.
+             * @return false If the ring is full and the frame is dropped.
+             */
+            bool record(uint64_t cycle, uint64_t timestamp, const uint8_t* const* images);
+
+            inline bool isOpen() const
+            {
+                return m_FileData != nullptr;
+            }
+
+            inline uint64_t droppedFrames() const
+            {
+                return m_DroppedFrames.load(std::memory_order_relaxed);
+            }
+
+            inline uint64_t writtenFrames() const
+            {
+                return m_WrittenFrames.load(std::memory_order_relaxed);
+            }
+
+            private:
+
+            int m_FileDescriptor = -1;
+
+            uint8_t* m_FileData = nullptr;
+
+            std::size_t m_FileSize = 0;
+
+            RecordingHeader* m_Header = nullptr;
+
+            std::vector<DomainImageInfo> m_Domains;
+
+            std::vector<std::size_t> m_DomainOffsets;
+
+            std::size_t m_FrameSize = 0;
+
+            std::size_t m_RingSlots = 0;
+
+            std::unique_ptr<uint8_t[]> m_RingFrames;
+
+            std::unique_ptr<IndexEntry[]> m_RingIndex;
+
+            alignas(64) std::atomic<std::size_t> m_RingHead{0};
+
+            alignas(64) std::atomic<std::size_t> m_RingTail{0};
+
+            alignas(64) std::atomic<uint64_t> m_DroppedFrames{0};
+
+            std::atomic<uint64_t> m_WrittenFrames{0};
+
+            std::atomic<bool> m_IsWriterRunning{false};
+
+            std::thread m_WriterThread;
+
+            void writerLoop();
+
+            /**
+             * @brief Moves all frames currently in the ring into the file.
+             *
+             * @return Number of frames moved.
+             */
+            std::size_t drainRing();
+
+        };
+
+        /**
+         * @brief Reads a recording file and provides the recorded images cycle by cycle.
+         *
+         */
+        class ProcessDataPlayer
+        {
+            public:
+
+            ProcessDataPlayer();
+
+            ~ProcessDataPlayer();
+
+            ProcessDataPlayer(const ProcessDataPlayer&) = delete;
+            ProcessDataPlayer& operator=(const ProcessDataPlayer&) = delete;
+
+            bool open(const std::string& path);
+
+            void close();
+
+            /**
+             * @brief Number of frames available in the file, oldest first.
+             *
+             */
+            std::size_t frameCount() const;
+
+            std::optional<std::size_t> findDomain(const std::string& domain_name) const;
+
+            std::size_t getDomainSize(std::size_t domain_index) const;
+
+            /**
+             * @brief Moves to the given frame, 0 being the oldest frame in the file.
+             *
+             */
+            bool seek(std::size_t frame);
+
+            /**
+             * @brief Advances to the next frame.
+             *
+             * @return false If there are no more frames.
+             */
+            bool next();
+
+            const IndexEntry& getCurrentIndex() const;
+
+            const uint8_t* getImage(std::size_t domain_index) const;
+
+            /**
+             * @brief Copies the image of the current frame for the given domain to the destination.
+             *
+             */
+            bool copyImage(std::size_t domain_index, uint8_t* destination) const;
+
+            /**
+             * @brief Copies only the given ranges of the current frame's image, e.g. the input entries of a live domain.
+             * The ranges have to lie inside the domain's image, the bytes outside of them are left untouched.
+             *
+             */
+            bool copyRanges(std::size_t domain_index, uint8_t* destination, const std::vector<ImageRange>& ranges) const;
+
+            private:
+
+            int m_FileDescriptor = -1;
+
+            const uint8_t* m_FileData = nullptr;
+
+            std::size_t m_FileSize = 0;
+
+            const RecordingHeader* m_Header = nullptr;
+
+            const DomainDescriptor* m_Domains = nullptr;
+
+            const IndexEntry* m_Index = nullptr;
+
+            std::size_t m_FirstSlot = 0;
+
+            std::size_t m_FrameCount = 0;
+
+            std::size_t m_CurrentFrame = 0;
+
+            bool m_HasStarted = false;
+
+            inline std::size_t currentSlot() const
+            {
+                return (m_FirstSlot + m_CurrentFrame) % m_Header->cycleCapacity;
+            }
+        };
+
+    } // End of namespace recorder
+} // End of namespace ec
+
+#endif // RECORDER_HPP_
@@ -0,0 +1,123 @@
+/**
+ * @file sample_array.hpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief Typed views of the samples of array entries, e.g. the samples an oversampling terminal maps every cycle.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef SAMPLE_ARRAY_HPP_
+#define SAMPLE_ARRAY_HPP_
+
+#include "ec_common_defs.hpp"
+
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+
+namespace ec
+{
+    namespace samples
+    {
+
+        /**
+         * @brief Entry type of T, DataType::UNKNOWN if no entry has the type.
+         *
+         */
+        template<typename T>
+        constexpr DataType getDataType()
+        {
+            if constexpr (std::is_same_v<uint8_t, T>){ return DataType::UINT8; }
+            else if constexpr (std::is_same_v<int8_t, T>){ return DataType::INT8; }
+            else if constexpr (std::is_same_v<uint16_t, T>){ return DataType::UINT16; }
+            else if constexpr (std::is_same_v<int16_t, T>){ return DataType::INT16; }
+            else if constexpr (std::is_same_v<uint32_t, T>){ return DataType::UINT32; }
+            else if constexpr (std::is_same_v<int32_t, T>){ return DataType::INT32; }
+            else if constexpr (std::is_same_v<uint64_t, T>){ return DataType::UINT64; }
+            else if constexpr (std::is_same_v<int64_t, T>){ return DataType::INT64; }
+            else if constexpr (std::is_same_v<float, T>){ return DataType::FLOAT; }
+            else if constexpr (std::is_same_v<double, T>){ return DataType::DOUBLE; }
+            else { return DataType::UNKNOWN; }
+        }
+
+        /**
+         * @brief Size of a sample of the type in bytes, 0 for DataType::UNKNOWN.
+         *
+         */
+        std::size_t getSampleSize(DataType type);
+
+        /**
+         * @brief Converts the samples to floats in one pass the compiler vectorizes and multiplies them with the scale.
+         * Integers above 2^24 lose their lowest bits.
+         *
+         * @param samples First sample in the domain, the others follow without gaps.
+         * @return false If the type is DataType::UNKNOWN.
+         */
+        bool convertToFloat(const uint8_t* samples, DataType type, std::size_t count, float scale, float* output);
+
+        /**
+         * @brief Samples of one array entry in the domain, valid as long as the domain. Reads the samples
+         * in the byte order of the bus like Slave::read().
+         *
+         */
+        template<typename T>
+        class SampleSpan
+        {
+            static_assert(getDataType<T>() != DataType::UNKNOWN, "No entry has the sample type");
+
+            public:
+
+            SampleSpan(const uint8_t* samples, std::size_t count)
+                : m_Samples(samples), m_Count(count)
+            {
+
+            }
+
+            T operator[](std::size_t sample_index) const
+            {
+                const uint8_t* sample = m_Samples + sample_index * sizeof(T);
+                if constexpr (std::is_same_v<uint8_t, T>){ return EC_READ_U8(sample); }
+                else if constexpr (std::is_same_v<int8_t, T>){ return EC_READ_S8(sample); }
+                else if constexpr (std::is_same_v<uint16_t, T>){ return EC_READ_U16(sample); }
+                else if constexpr (std::is_same_v<int16_t, T>){ return EC_READ_S16(sample); }
+                else if constexpr (std::is_same_v<uint32_t, T>){ return EC_READ_U32(sample); }
+                else if constexpr (std::is_same_v<int32_t, T>){ return EC_READ_S32(sample); }
+                else if constexpr (std::is_same_v<uint64_t, T>){ return EC_READ_U64(sample); }
+                else if constexpr (std::is_same_v<int64_t, T>){ return EC_READ_S64(sample); }
+                else if constexpr (std::is_same_v<float, T>){ return EC_READ_REAL(sample); }
+                else { return EC_READ_LREAL(sample); }
+            }
+
+            std::size_t size() const
+            {
+                return m_Count;
+            }
+
+            const uint8_t* data() const
+            {
+                return m_Samples;
+            }
+
+            /**
+             * @brief Converts all samples to floats, output holds size() floats.
+             *
+             */
+            void toFloat(float* output, float scale = 1.0f) const
+            {
+                convertToFloat(m_Samples, getDataType<T>(), m_Count, scale, output);
+            }
+
+            private:
+
+            const uint8_t* m_Samples = nullptr;
+
+            std::size_t m_Count = 0;
+        };
+
+    } // End of namespace samples
+} // End of namespace ec
+
+#endif // SAMPLE_ARRAY_HPP_
@@ -0,0 +1,277 @@
+/**
+ * @file sdo.hpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief Non-blocking SDO transfers driven by the cyclic loop.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef SDO_HPP_
+#define SDO_HPP_
+
+#include <array>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <future>
+#include <optional>
+#include <functional>
+#include <cstring>
+#include <cstdint>
+
+#include "ec_common_defs.hpp"
+
+namespace ec
+{
+    namespace sdo
+    {
+
+        /**
+         * @brief Largest SDO value the engine transfers, enough for every numeric object.
+         *
+         */
+        constexpr std::size_t MaxSdoDataSize = 8;
+
+        /**
+         * @brief Data sizes of the pre-created requests, a download needs a request of exactly its size.
+         *
+         */
+        constexpr std::array<std::size_t, 4> SdoRequestSizes = {1, 2, 4, 8};
+
+        struct SdoResult
+        {
+            bool success = false;
+
+            Index index = 0;
+
+            Subindex subindex = 0;
+
+            /**
+             * @brief Number of valid bytes in data, for uploads the size reported by the slave.
+             *
+             */
+            std::size_t size = 0;
+
+            std::array<uint8_t, MaxSdoDataSize> data{};
+
+            /**
+             * @brief Interprets the uploaded data as T.
+             *
+             * @return std::nullopt If the transfer failed or fewer than sizeof(T) bytes were uploaded.
+             */
+            template<typename T>
+            std::optional<T> as() const
+            {
+                if(!success || size < sizeof(T)){
+                    return std::nullopt;
+                }
+
+                T value;
+                std::memcpy(&value, data.data(), sizeof(T));
+                return value;
+            }
+        };
+
+        /**
+         * @brief Called by deliverCompletions() when a transfer completes, never from the cyclic thread.
+         * A slow callback delays the results of the other transfers, not the cycle.
+         *
+         */
+        typedef std::function<void(const SdoResult&)> SdoCallback;
+
+        /**
+         * @brief Queues SDO uploads and downloads of one slave and runs them on SDO requests that are
+         * created before the master is activated. Any thread can queue transfers, process() is called
+         * from the cyclic thread and never allocates or blocks.
+         * process() only moves completed transfers to a completion ring, deliverCompletions() fulfils their futures
+         * and runs their callbacks on a thread that is not the cyclic thread.
+         *
+         */
+        class SdoEngine
+        {
+            public:
+
+            SdoEngine();
+
+            ~SdoEngine();
+
+            SdoEngine(const SdoEngine&) = delete;
+            SdoEngine& operator=(const SdoEngine&) = delete;
+
+            /**
+             * @brief Creates requests_per_size SDO requests for each of SdoRequestSizes, must be called before activating the master.
+             *
+             * @param slave_config Configuration of the slave the transfers are made with.
+             * @param queue_capacity Maximum number of queued and running transfers.
+             * @param timeout_ms Timeout of a single transfer, 0 to wait forever.
+             * @return false If a request can not be created.
+             */
+            bool createRequests(
+                ec_slave_config_t* slave_config,
+                std::size_t requests_per_size = 1,
+                std::size_t queue_capacity = 16,
+                uint32_t timeout_ms = 1000
+            );
+
+            /**
+             * @brief Queues an upload from the slave.
+             *
+             * @return std::nullopt If the queue is full.
+             */
+            std::optional<std::future<SdoResult>> read(Index index, Subindex subindex);
+
+            bool read(Index index, Subindex subindex, SdoCallback callback);
+
+            /**
+             * @brief Queues a download of size bytes to the slave.
+             *
+             * @return std::nullopt If the queue is full or size is not one of SdoRequestSizes.
+             */
+            std::optional<std::future<SdoResult>> write(Index index, Subindex subindex, const void* data, std::size_t size);
+
+            bool write(Index index, Subindex subindex, const void* data, std::size_t size, SdoCallback callback);
+
+            template<typename T>
+            std::optional<std::future<SdoResult>> write(Index index, Subindex subindex, T value)
+            {
+                static_assert(std::is_arithmetic_v<T>, "SDO values must be arithmetic types.");
+                return write(index, subindex, &value, sizeof(T));
+            }
+
+            /**
+             * @brief Polls the running transfers and starts queued ones. Called from the cyclic thread.
+             *
+             * @param budget Maximum number of request operations (state polls and starts) made in this call.
+             * @return std::size_t Number of request operations made.
+             */
+            std::size_t process(std::size_t budget);
+
+            /**
+             * @brief Fulfils the futures and runs the callbacks of the transfers completed by process().
+             * Must be called from a single thread other than the cyclic thread, Master calls it from its SDO completion thread.
+             *
+             * @return std::size_t Number of delivered results.
+             */
+            std::size_t deliverCompletions();
+
+            /**
+             * @brief True if any transfer is queued or running.
+             *
+             */
+            inline bool hasWork() const
+            {
+                return m_PendingJobs.load(std::memory_order_acquire) != 0;
+            }
+
+            private:
+
+            enum class JobState : uint8_t
+            {
+                Free,
+                Queued,
+                Running,
+                Completed
+            };
+
+            struct Job
+            {
+                std::atomic<JobState> state{JobState::Free};
+
+                bool isDownload = false;
+
+                Index index = 0;
+
+                Subindex subindex = 0;
+
+                std::size_t size = 0;
+
+                std::array<uint8_t, MaxSdoDataSize> data{};
+
+                bool hasPromise = false;
+
+                std::promise<SdoResult> promise;
+
+                SdoCallback callback;
+
+                /**
+                 * @brief Written by the cyclic thread before the job is put in the completion ring.
+                 *
+                 */
+                SdoResult result;
+            };
+
+            struct Request
+            {
+                ec_sdo_request_t* handle = nullptr;
+
+                std::size_t size = 0;
+
+                /**
+                 * @brief Job running on this request, nullptr if the request is free.
+                 *
+                 */
+                Job* job = nullptr;
+            };
+
+            std::vector<Request> m_Requests;
+
+            std::unique_ptr<Job[]> m_Jobs;
+
+            std::size_t m_JobCapacity = 0;
+
+            /**
+             * @brief Serializes the producers, the cyclic thread never takes it.
+             *
+             */
+            std::mutex m_EnqueueMutex;
+
+            /**
+             * @brief Ring of queued jobs, written by the producers and read by the cyclic thread.
+             *
+             */
+            std::unique_ptr<Job*[]> m_Queue;
+
+            std::atomic<std::size_t> m_QueueHead{0};
+
+            std::atomic<std::size_t> m_QueueTail{0};
+
+            std::atomic<std::size_t> m_PendingJobs{0};
+
+            /**
+             * @brief Ring of completed jobs, written by the cyclic thread and read by deliverCompletions().
+             * Holds every job at once, so it can never be full.
+             *
+             */
+            std::unique_ptr<Job*[]> m_Completions;
+
+            std::atomic<std::size_t> m_CompletionHead{0};
+
+            std::atomic<std::size_t> m_CompletionTail{0};
+
+            /**
+             * @brief Queues a transfer, the result is delivered through the future if it is not nullptr, otherwise through the callback.
+             *
+             */
+            bool enqueue(
+                bool is_download,
+                Index index,
+                Subindex subindex,
+                const void* data,
+                std::size_t size,
+                SdoCallback callback,
+                std::future<SdoResult>* future
+            );
+
+            Request* findFreeRequest(const Job& job);
+
+            void complete(Request& request, bool success);
+        };
+
+    } // End of namespace sdo
+} // End of namespace ec
+
+#endif // SDO_HPP_
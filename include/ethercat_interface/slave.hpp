@@ -15,9 +15,14 @@
 #include <optional>
 #include <iostream>
 #include <unordered_map>
+#include <variant>
+#include <cmath>
 
 #include "data.hpp"
 #include "ec_common_defs.hpp"
+#include "sdo.hpp"
+#include "sample_array.hpp"
+#include "table_arena.hpp"
 
 namespace ec
 {
@@ -55,15 +60,24 @@ namespace ec
                     m_TxPDOs(nullptr),
                     m_SyncManagerConfig(nullptr)
             {
-                m_SlaveInfo = s.m_SlaveInfo;
+                m_SlaveInfo = std::move(s.m_SlaveInfo);
                 m_SlaveConfigPtr = s.m_SlaveConfigPtr;
                 m_SlaveState = s.m_SlaveState;
                 m_RxPDOs = s.m_RxPDOs;
                 m_TxPDOs = s.m_TxPDOs;
-                m_RxMappings = s.m_RxMappings;
-                m_TxMappings = s.m_TxMappings;
+                m_RxMappings = std::move(s.m_RxMappings);
+                m_TxMappings = std::move(s.m_TxMappings);
                 m_SyncManagerConfig = s.m_SyncManagerConfig;
-                m_Offsets = s.m_Offsets;
+                m_Offsets = std::move(s.m_Offsets);
+                m_AreTablesBuilt = s.m_AreTablesBuilt;
+                m_Tuning = s.m_Tuning;
+                m_SdoEngine = std::move(s.m_SdoEngine);
+                m_OwnTables = std::move(s.m_OwnTables);
+                m_StaleFlag = s.m_StaleFlag;
+                m_FilteredValues = std::move(s.m_FilteredValues);
+                m_SampleArrays = std::move(s.m_SampleArrays);
+                m_InputLatchTime = s.m_InputLatchTime;
+                m_Timestamps = std::move(s.m_Timestamps);
 
                 s.m_SlaveConfigPtr = nullptr;
                 s.m_RxPDOs = nullptr;
@@ -258,9 +272,17 @@ namespace ec
 
             }
     
+            /**
+             * @brief Reads the entry from the domain.
+             * 
+             * @return std::nullopt If the slave is stale, see isStale().
+             */
             template<typename T>
             std::optional<T> read(const std::string& entry_name)
             {
+                if(isStale()){
+                    return std::nullopt;
+                }
 
                 auto entryQueryOffset = m_Offsets.find(entry_name);
         
@@ -278,13 +300,274 @@ namespace ec
             /**
              * @brief Return the slave information struct stored inside the slave object.
              * 
-             * @return const SlaveInfo 
+             * @return const SlaveInfo& 
              */
-            const SlaveInfo getSlaveInfo() const
+            const SlaveInfo& getSlaveInfo() const
             {
                 return m_SlaveInfo;
             }
 
+            /**
+             * @brief Return the reloadable settings currently in effect for the slave.
+             * 
+             * @return const SlaveTuning& 
+             */
+            const SlaveTuning& getTuning() const
+            {
+                return m_Tuning ? *m_Tuning : m_SlaveInfo.tuning;
+            }
+
+            /**
+             * @brief Replaces the settings returned by getTuning(), the master calls this at a cycle boundary 
+             * after a configuration reload. The tuning object must outlive its use by the slave.
+             * 
+             * @param tuning nullptr to return to the settings the slave was constructed with.
+             */
+            void setTuning(const SlaveTuning* tuning)
+            {
+                m_Tuning = tuning;
+            }
+
+            /**
+             * @brief Whether the slave left OP and its inputs in the domain are outdated.
+             * The slave is brought back to OP by the EtherCAT master once it rejoins the bus.
+             * 
+             */
+            bool isStale() const
+            {
+                return m_StaleFlag && m_StaleFlag->load(std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief Sets the flag isStale() reads, owned and updated by the master.
+             * 
+             */
+            void setStaleFlag(const std::atomic<bool>* stale_flag)
+            {
+                m_StaleFlag = stale_flag;
+            }
+
+            /**
+             * @brief Flag isStale() reads, nullptr before the master is initialized.
+             * Given to the stages that process the slave's entries together with other slaves'.
+             * 
+             */
+            const std::atomic<bool>* getStaleFlag() const
+            {
+                return m_StaleFlag;
+            }
+
+            /**
+             * @brief Reads the filtered value of an entry with a filter in the configuration,
+             * updated by the master every time the domain is received.
+             * 
+             * @return std::nullopt If the slave is stale or the entry is not filtered.
+             */
+            std::optional<double> readFiltered(const std::string& entry_name) const
+            {
+                if(isStale()){
+                    return std::nullopt;
+                }
+
+                auto found = m_FilteredValues.find(entry_name);
+                if(found == m_FilteredValues.end()){
+                    return std::nullopt;
+                }
+
+                return *found->second;
+            }
+
+            /**
+             * @brief Sets the value readFiltered() returns for the entry, owned and updated by the master.
+             * 
+             */
+            void setFilteredValue(const std::string& entry_name, const double* value)
+            {
+                m_FilteredValues[entry_name] = value;
+            }
+
+            /**
+             * @brief Time the inputs read from the domain were latched at by the slave: the last SYNC0 pulse
+             * for a slave with a distributed clock, the time the frame passed by otherwise.
+             * On the time axis of the application time, updated by the master every time the domain is received.
+             * 
+             * @return std::nullopt If the slave is stale or the time is not known yet.
+             */
+            std::optional<uint64_t> getInputLatchTime() const
+            {
+                if(isStale() || !m_InputLatchTime || *m_InputLatchTime == 0){
+                    return std::nullopt;
+                }
+
+                return *m_InputLatchTime;
+            }
+
+            /**
+             * @brief Sets the time getInputLatchTime() returns, owned and updated by the master.
+             * 
+             */
+            void setInputLatchTime(const uint64_t* latch_time)
+            {
+                m_InputLatchTime = latch_time;
+            }
+
+            /**
+             * @brief Reads a timestamp entry, an entry with "timestamp: true" in the configuration,
+             * converted to the 64 bit time axis of getInputLatchTime(). 0 until the domain is received after the first send().
+             * 
+             * @return std::nullopt If the slave is stale or the entry is not a timestamp.
+             */
+            std::optional<uint64_t> readTimestamp(const std::string& entry_name) const
+            {
+                if(isStale()){
+                    return std::nullopt;
+                }
+
+                auto found = m_Timestamps.find(entry_name);
+                if(found == m_Timestamps.end()){
+                    return std::nullopt;
+                }
+
+                return *found->second;
+            }
+
+            /**
+             * @brief Sets the value readTimestamp() returns for the entry, owned and updated by the master.
+             * 
+             */
+            void setTimestampValue(const std::string& entry_name, const uint64_t* value)
+            {
+                m_Timestamps[entry_name] = value;
+            }
+
+            /**
+             * @brief Samples of an array entry, an entry with a count in the configuration, in the domain.
+             * One lookup for all samples of the entry.
+             * 
+             * @tparam T Type of the samples.
+             * @return std::nullopt If the slave is stale, the entry is not an array or T is not the type of the entry.
+             */
+            template<typename T>
+            std::optional<samples::SampleSpan<T>> readSamples(const std::string& entry_name) const
+            {
+                if(isStale()){
+                    return std::nullopt;
+                }
+
+                auto found = m_SampleArrays.find(entry_name);
+                if(found == m_SampleArrays.end() || found->second.type != samples::getDataType<T>()){
+                    return std::nullopt;
+                }
+
+                return samples::SampleSpan<T>(m_DomainDataPtr + found->second.offset, found->second.count);
+            }
+
+            /**
+             * @brief Converts the samples of an array entry to floats and multiplies them with the entry's scaling factor.
+             * 
+             * @param output Holds at least the number of samples of the entry.
+             * @return false If the slave is stale, the entry is not an array or the output is too small.
+             */
+            bool readSamples(const std::string& entry_name, float* output, std::size_t output_size) const;
+
+            /**
+             * @brief Number of samples of an array entry.
+             * 
+             * @return std::nullopt If the entry is not an array.
+             */
+            std::optional<std::size_t> getSampleCount(const std::string& entry_name) const
+            {
+                auto found = m_SampleArrays.find(entry_name);
+                if(found == m_SampleArrays.end()){
+                    return std::nullopt;
+                }
+
+                return found->second.count;
+            }
+
+            /**
+             * @brief Checks whether the slave's data should be handled in the given cycle according to its cycle divisor.
+             * 
+             * @param cycle Cycle counter of the master.
+             */
+            bool isDue(uint64_t cycle) const
+            {
+                return (cycle % getTuning().cycleDivisor) == 0;
+            }
+
+            /**
+             * @brief Reads the entry and multiplies it with its scaling factor, 1.0 if none is configured.
+             * 
+             * @tparam T Type of the PDO entry.
+             */
+            template<typename T>
+            std::optional<double> readScaled(const std::string& entry_name)
+            {
+                const auto raw = read<T>(entry_name);
+                if(!raw){
+                    return std::nullopt;
+                }
+
+                return static_cast<double>(raw.value()) * getScalingFactor(entry_name);
+            }
+
+            /**
+             * @brief Divides the value by the entry's scaling factor and writes it, rounded for integer entries.
+             * 
+             * @tparam T Type of the PDO entry.
+             */
+            template<typename T>
+            bool writeScaled(const std::string& entry_name, double value)
+            {
+                const double raw = value / getScalingFactor(entry_name);
+                if constexpr (std::is_integral_v<T>)
+                {
+                    return write<T>(entry_name, static_cast<T>(std::llround(raw)));
+                }
+                else
+                {
+                    return write<T>(entry_name, static_cast<T>(raw));
+                }
+            }
+
+            double getScalingFactor(const std::string& entry_name) const
+            {
+                const auto& scalingFactors = getTuning().scalingFactors;
+                auto found = scalingFactors.find(entry_name);
+                if(found == scalingFactors.end()){
+                    return 1.0;
+                }
+
+                return found->second;
+            }
+
+            /**
+             * @brief Configures the distributed clock of the slave, called by init() if the configuration
+             * has "apply_to_slave: true". Must be called before the master is activated.
+             * 
+             */
+            bool configureDistributedClock(const DistributedClockConfig& dc_config);
+
+            /**
+             * @brief Return the engine that runs the SDO transfers of the slave, nullptr before init().
+             * 
+             * @return sdo::SdoEngine* 
+             */
+            sdo::SdoEngine* getSdoEngine()
+            {
+                return m_SdoEngine.get();
+            }
+
+            /**
+             * @brief Return the PDO and sync manager layout shared by all slaves of the same configuration.
+             * 
+             * @return const SlaveLayout& 
+             */
+            const SlaveLayout& getLayout() const
+            {
+                return *m_SlaveInfo.layout;
+            }
+
             std::optional<uint*> getOffsetPtr(const std::string& offset_name)
             {
                 auto found = m_Offsets.find(offset_name);
@@ -295,8 +578,69 @@ namespace ec
                 return &found->second;
             }
 
-            bool configurePDOs();
+            /**
+             * @brief Offset of a sample of an entry, the offset of the entry itself for the first sample.
+             * 
+             * @return std::nullopt If the entry has no such sample.
+             */
+            std::optional<uint*> getOffsetPtr(const std::string& offset_name, std::size_t sample_index)
+            {
+                if(sample_index == 0){
+                    return getOffsetPtr(offset_name);
+                }
+
+                auto found = m_SampleArrays.find(offset_name);
+                if(found == m_SampleArrays.end() || sample_index >= found->second.count){
+                    return std::nullopt;
+                }
+
+                return &found->second.sampleOffsets[sample_index - 1];
+            }
+
+            /**
+             * @brief Takes the offsets of the array entries once the domain entries are registered.
+             * 
+             * @return false If the samples of an array are not placed one after the other in the domain.
+             */
+            bool setupSampleArrays();
+
+            bool configurePDOs(arena::TableArena& arena);
+
+            /**
+             * @brief Builds the PDO and sync manager tables of the slave without calling the EtherCAT master,
+             * so the tables of different slaves can be built in parallel before init() is called.
+             * init() builds the tables itself if they are not built yet.
+             * 
+             * @param arena Region of getTableSize() bytes the tables are placed in, must outlive init().
+             * @return true If the tables are built.
+             */
+            bool buildTables(arena::TableArena& arena);
+
+            /**
+             * @brief Builds the tables in an arena owned by the slave.
+             * 
+             */
+            bool buildTables();
+
+            /**
+             * @brief Number of bytes buildTables() takes from its arena.
+             * 
+             */
+            std::size_t getTableSize() const;
+
+            /**
+             * @brief Number of PDO entries the slave registers in its domain.
+             * 
+             */
+            std::size_t getEntryCount() const;
             
+            /**
+             * @brief Polls the state of the slave's configuration from the EtherCAT master.
+             * 
+             * @return std::nullopt If the slave is not configured yet.
+             */
+            std::optional<ec_slave_config_state_t> readState() const;
+
             /**
              * @brief Sets member variable pointer to the pointer to the EtherCAT domain.
              * 
@@ -307,6 +651,15 @@ namespace ec
                 m_DomainDataPtr = domain_data_ptr;
             }
 
+            /**
+             * @brief Returns the pointer to the data of the slave's domain, nullptr before the master is activated.
+             * 
+             */
+            uint8_t* getDomainDataPtr() const
+            {
+                return m_DomainDataPtr;
+            }
+
             protected: // Protected member variables
 
             SlaveInfo m_SlaveInfo;
@@ -343,11 +696,68 @@ namespace ec
 
             std::shared_ptr<data::DataMap> m_SharedDataMap;
 
+            /**
+             * @brief Tuning set by the master after a reload, m_SlaveInfo.tuning is used if nullptr.
+             * 
+             */
+            const SlaveTuning* m_Tuning = nullptr;
+
+            const std::atomic<bool>* m_StaleFlag = nullptr;
+
+            std::unordered_map<std::string, const double*> m_FilteredValues;
+
+            struct SampleArray
+            {
+                DataType type;
+
+                uint16_t count;
+
+                /**
+                 * @brief Offset of the first sample, taken from m_Offsets by setupSampleArrays().
+                 * 
+                 */
+                uint offset = 0;
+
+                /**
+                 * @brief Offsets the samples after the first one are registered with.
+                 * 
+                 */
+                std::vector<uint> sampleOffsets;
+            };
+
+            std::unordered_map<std::string, SampleArray> m_SampleArrays;
+
+            const uint64_t* m_InputLatchTime = nullptr;
+
+            std::unordered_map<std::string, const uint64_t*> m_Timestamps;
+
+            std::unique_ptr<sdo::SdoEngine> m_SdoEngine;
+
+            /**
+             * @brief Backs the tables if they are built without an arena of the master.
+             * 
+             */
+            arena::TableArena m_OwnTables;
+
+            bool m_AreTablesBuilt = false;
+
             protected: // Protected member functions
 
             virtual bool createSlaveConfigPtr(ec_master_t* master_ptr);
 
-            virtual bool createSlaveSyncManagerConfig();
+            virtual bool createSlaveSyncManagerConfig(arena::TableArena& arena);
+
+            /**
+             * @brief Registers the startup SDOs of the slave with its configuration.
+             * 
+             */
+            bool registerStartupSdos();
+
+            /**
+             * @brief Creates the SDO engine and its requests, must be called before the master is activated.
+             * 
+             */
+            bool createSdoEngine();
 
             /**
              * @brief Sets and initializes the m_SharedDataMap object, must be called after calling the init function of the slave object.
@@ -549,6 +959,8 @@ namespace ec
             
             Driver(const SlaveInfo& slave_info);
 
+            Driver(Driver&&) = default;
+
             ~Driver();
 
             private:
@@ -576,6 +988,8 @@ namespace ec
 
             IO(const SlaveInfo& slave_info);
 
+            IO(IO&&) = default;
+
             ~IO();
 
             private:
@@ -592,6 +1006,8 @@ namespace ec
 
             PLC(const SlaveInfo& slave_info);
 
+            PLC(PLC&&) = default;
+
             ~PLC();
 
             private:
@@ -608,6 +1024,8 @@ namespace ec
             public:
 
             Coupler(const SlaveInfo& slave_info);
+
+            Coupler(Coupler&&) = default;
             ~Coupler();
 
             bool init(ec_master_t* master_ptr, ec_domain_t* domain_ptr = nullptr) override;
@@ -615,6 +1033,17 @@ namespace ec
             private:
         };
 
+        /**
+         * @brief Slave stored by value with its concrete type, lets the master keep all slaves in one contiguous array.
+         * 
+         */
+        using SlaveVariant = std::variant<Driver, IO, PLC, Coupler>;
+
+        inline Slave& asSlave(SlaveVariant& slave_variant)
+        {
+            return std::visit([](auto& slave) -> Slave& { return slave; }, slave_variant);
+        }
+
     } // End of namespace slave
 } // End of namespace ec
 
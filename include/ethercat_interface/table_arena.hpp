@@ -0,0 +1,157 @@
+/**
+ * @file table_arena.hpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief Bump allocator for the configuration tables handed to the EtherCAT master.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef TABLE_ARENA_HPP_
+#define TABLE_ARENA_HPP_
+
+#include <memory>
+#include <new>
+#include <cstddef>
+#include <type_traits>
+
+namespace ec
+{
+    namespace arena
+    {
+
+        /**
+         * @brief Hands out arrays from one block that is sized once and released at once.
+         * Only meant for trivially destructible tables such as ec_pdo_info_t or ec_pdo_entry_reg_t,
+         * their destructors are never called.
+         * An arena either owns its block or is a view on a region carved from another arena,
+         * so each slave can fill its own region from another thread.
+         *
+         */
+        class TableArena
+        {
+            public:
+
+            /**
+             * @brief Every array starts at this alignment, so the footprint of a table does not depend on allocation order.
+             *
+             */
+            static constexpr std::size_t Alignment = alignof(std::max_align_t);
+
+            template<typename T>
+            static constexpr std::size_t footprint(std::size_t count)
+            {
+                static_assert(alignof(T) <= Alignment);
+                return (count * sizeof(T) + Alignment - 1) / Alignment * Alignment;
+            }
+
+            TableArena() = default;
+
+            TableArena(TableArena&&) = default;
+
+            TableArena& operator=(TableArena&&) = default;
+
+            TableArena(const TableArena&) = delete;
+
+            TableArena& operator=(const TableArena&) = delete;
+
+            /**
+             * @brief Releases the current block and allocates a new one of the given size.
+             *
+             */
+            void reserve(std::size_t capacity)
+            {
+                capacity = footprint<std::byte>(capacity);
+                const std::size_t blockCount = (capacity + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t);
+                m_Block.reset(blockCount ? new std::max_align_t[blockCount] : nullptr);
+                m_Data = reinterpret_cast<std::byte*>(m_Block.get());
+                m_Capacity = capacity;
+                m_Used = 0;
+            }
+
+            /**
+             * @brief Frees the block, every table handed out by this arena and the arenas carved from it becomes invalid.
+             *
+             */
+            void release()
+            {
+                m_Block.reset();
+                m_Data = nullptr;
+                m_Capacity = 0;
+                m_Used = 0;
+            }
+
+            /**
+             * @brief Value-initialized array of count elements.
+             *
+             * @return nullptr If the arena does not have enough space left.
+             */
+            template<typename T>
+            T* allocate(std::size_t count)
+            {
+                static_assert(std::is_trivially_destructible_v<T>);
+                std::byte* region = take(footprint<T>(count));
+                if(!region){
+                    return nullptr;
+                }
+                T* array = reinterpret_cast<T*>(region);
+                for(std::size_t i = 0; i < count; i++)
+                {
+                    new (array + i) T{};
+                }
+                return array;
+            }
+
+            /**
+             * @brief Arena viewing the next size bytes of this one, owned by this arena.
+             *
+             * @return An empty arena if there is not enough space left.
+             */
+            TableArena carve(std::size_t size)
+            {
+                TableArena region;
+                size = footprint<std::byte>(size);
+                if(std::byte* data = take(size)){
+                    region.m_Data = data;
+                    region.m_Capacity = size;
+                }
+                return region;
+            }
+
+            std::size_t getCapacity() const
+            {
+                return m_Capacity;
+            }
+
+            std::size_t getUsed() const
+            {
+                return m_Used;
+            }
+
+            private:
+
+            std::unique_ptr<std::max_align_t[]> m_Block;
+
+            std::byte* m_Data = nullptr;
+
+            std::size_t m_Capacity = 0;
+
+            std::size_t m_Used = 0;
+
+            std::byte* take(std::size_t size)
+            {
+                if(m_Used + size > m_Capacity){
+                    return nullptr;
+                }
+                std::byte* region = m_Data + m_Used;
+                m_Used += size;
+                return region;
+            }
+        };
+
+    } // End of namespace arena
+} // End of namespace ec
+
+#endif // TABLE_ARENA_HPP_
@@ -87,8 +87,21 @@ const uint64_t timespectoNanoSec(const std::timespec& t);
 
         virtual void init();
 
+        /**
+         * @brief Like init(), but the first sleep() wakes up at the next multiple of the cycle period on the timer's clock plus the offset.
+         * Timers with the same period and clock wake up together, no matter when they were started.
+         * 
+         * @param offset_ns Shift of the wake up times, reduced modulo the period.
+         */
+        void initAligned(int64_t offset_ns = 0);
+
         virtual void sleep();
 
+        const std::timespec& getWakeupTime() const
+        {
+            return m_WakeupTime;
+        }
+
         virtual ~CyclicTaskTimer(){};
 
         protected:
@@ -0,0 +1,171 @@
+/**
+ * @file timestamp.hpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief Times the inputs of a domain were latched at and timestamp entries on the same 64 bit time axis.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef TIMESTAMP_HPP_
+#define TIMESTAMP_HPP_
+
+#include "ec_common_defs.hpp"
+
+#include <optional>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace ec
+{
+    namespace timestamp
+    {
+
+        /**
+         * @brief Slaves that latch their inputs at the same time: the slaves with the same SYNC0 cycle and shift,
+         * or the slaves without a distributed clock, which latch their inputs when the frame passes them.
+         *
+         */
+        struct LatchGroup
+        {
+            /**
+             * @brief Cycle of the SYNC0 pulses in nanoseconds, the SYNC0 and SYNC1 cycles of the DC configuration
+             * added like the EtherCAT master does. 0 for the slaves without a distributed clock.
+             *
+             */
+            uint64_t cycle = 0;
+
+            int32_t shift = 0;
+
+            bool operator==(const LatchGroup& other) const
+            {
+                return cycle == other.cycle && shift == other.shift;
+            }
+        };
+
+        /**
+         * @brief Input entry holding the DC system time of an event, e.g. the latch time of a touch probe.
+         *
+         */
+        struct TimestampEntry
+        {
+            /**
+             * @brief Name the entry is found by, e.g. "slave_name.entry_name".
+             *
+             */
+            std::string name;
+
+            uint32_t offset;
+
+            /**
+             * @brief UINT32 or INT32 for the lower 32 bits of the system time, UINT64 or INT64 for all of it.
+             *
+             */
+            DataType type;
+
+            /**
+             * @brief Index of the latch group of the entry's slave.
+             *
+             */
+            std::size_t group;
+        };
+
+        /**
+         * @brief Last SYNC0 pulse at or before the time. The pulses are the multiples of the cycle after the
+         * start time, moved by the shift, the grid the EtherCAT master starts the SYNC0 signals of the slaves on.
+         *
+         * @param start_time First application time written to the EtherCAT master.
+         */
+        uint64_t getLastPulse(uint64_t time, uint64_t start_time, const LatchGroup& group);
+
+        /**
+         * @brief Extends the lower 32 bits of a system time to the 64 bit time closest to the reference.
+         * The time is right as long as it is less than 2^31 ns (about 2.1 s) away from the reference.
+         *
+         */
+        uint64_t extendTimestamp(uint32_t timestamp, uint64_t reference_time);
+
+        /**
+         * @brief Tags the inputs of one domain with the time they were latched at.
+         * The times are on the clock of the application time, which the EtherCAT master synchronizes the
+         * DC system time to, so the latch times and the timestamp entries share one time axis.
+         * The inputs received in a cycle were latched before the frame of the cycle before was sent:
+         * at the last SYNC0 pulse before it by slaves with a distributed clock, when the frame passed by the others.
+         * update() is called by the master every time the domain is received, everything is allocated on construction.
+         *
+         */
+        class InputTimestamps
+        {
+            public:
+
+            InputTimestamps(const uint8_t* domain_data, const std::vector<LatchGroup>& groups, const std::vector<TimestampEntry>& entries);
+
+            /**
+             * @brief Updates the latch times of the groups and converts the timestamp entries.
+             *
+             * @param start_time First application time written to the EtherCAT master, 0 if none was written yet.
+             * @param send_time Time the frame with the inputs was sent at, on the clock of the application time.
+             */
+            void update(uint64_t start_time, uint64_t send_time);
+
+            std::size_t size() const
+            {
+                return m_Entries.size();
+            }
+
+            std::size_t getGroupCount() const
+            {
+                return m_Groups.size();
+            }
+
+            std::optional<std::size_t> findEntry(const std::string& name) const;
+
+            /**
+             * @brief Time the inputs of the group were latched at, 0 until it is known.
+             *
+             */
+            uint64_t getLatchTime(std::size_t group_index) const
+            {
+                return m_LatchTimes[group_index];
+            }
+
+            const uint64_t* getLatchTimePtr(std::size_t group_index) const
+            {
+                return &m_LatchTimes[group_index];
+            }
+
+            /**
+             * @brief Value of the timestamp entry on the time axis of the latch times, 0 until it is known.
+             *
+             */
+            uint64_t getTimestamp(std::size_t entry_index) const
+            {
+                return m_Timestamps[entry_index];
+            }
+
+            const uint64_t* getTimestampPtr(std::size_t entry_index) const
+            {
+                return &m_Timestamps[entry_index];
+            }
+
+            private:
+
+            const uint8_t* m_DomainData = nullptr;
+
+            std::vector<LatchGroup> m_Groups;
+
+            std::vector<TimestampEntry> m_Entries;
+
+            std::vector<uint64_t> m_LatchTimes;
+
+            std::vector<uint64_t> m_Timestamps;
+        };
+
+    } // End of namespace timestamp
+} // End of namespace ec
+
+#endif // TIMESTAMP_HPP_
@@ -0,0 +1,148 @@
+/**
+ * @file topology.hpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief Fingerprint of the scanned bus and the domain layouts derived from it, kept between restarts.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef TOPOLOGY_HPP_
+#define TOPOLOGY_HPP_
+
+#include <string>
+#include <vector>
+#include <optional>
+#include <chrono>
+#include <cstdint>
+
+#include "ec_common_defs.hpp"
+
+namespace ec
+{
+    namespace topology
+    {
+
+        constexpr char TopologyMagic[8] = {'E', 'C', 'T', 'O', 'P', '0', '0', '1'};
+
+        /**
+         * @brief Must be incremented whenever the serialized layout of TopologySnapshot changes.
+         *
+         */
+        constexpr uint32_t TopologyVersion = 1;
+
+        /**
+         * @brief Identity of a slave found on the bus.
+         *
+         */
+        struct SlaveIdentity
+        {
+            uint16_t alias;
+
+            /**
+             * @brief Ring position of the slave.
+             *
+             */
+            uint16_t position;
+
+            uint32_t vendorID;
+
+            uint32_t productCode;
+
+            uint32_t revisionNumber;
+
+            bool operator==(const SlaveIdentity& other) const
+            {
+                return alias == other.alias && position == other.position && vendorID == other.vendorID &&
+                    productCode == other.productCode && revisionNumber == other.revisionNumber;
+            }
+        };
+
+        /**
+         * @brief Process image layout of a domain after activation.
+         *
+         */
+        struct DomainLayout
+        {
+            std::string domainName;
+
+            std::size_t size;
+
+            /**
+             * @brief Offsets of the registered PDO entries, in the order of the domain's registration list.
+             *
+             */
+            std::vector<unsigned int> offsets;
+
+            bool operator==(const DomainLayout& other) const
+            {
+                return domainName == other.domainName && size == other.size && offsets == other.offsets;
+            }
+        };
+
+        struct TopologySnapshot
+        {
+            /**
+             * @brief Content hash of the configuration file the layouts were derived from.
+             *
+             */
+            uint64_t configHash = 0;
+
+            std::vector<SlaveIdentity> slaves;
+
+            /**
+             * @brief Domain layouts, sorted by domain name.
+             *
+             */
+            std::vector<DomainLayout> domains;
+
+            /**
+             * @brief True if the snapshot was taken with the same configuration on the same bus.
+             *
+             */
+            inline bool matches(uint64_t config_hash, const std::vector<SlaveIdentity>& bus) const
+            {
+                return configHash == config_hash && slaves == bus;
+            }
+        };
+
+        /**
+         * @brief Waits for the master to finish scanning the bus and reads the identity of every slave.
+         *
+         * @param timeout Maximum time to wait for a running bus scan.
+         * @return std::nullopt If the master can not be queried or the scan does not finish in time.
+         */
+        std::optional<std::vector<SlaveIdentity>> scanBus(ec_master_t* master, std::chrono::milliseconds timeout);
+
+        /**
+         * @brief Compares the configured slaves with the slaves on the bus.
+         * Slaves addressed with an alias are located relative to the slave holding that alias.
+         * Configured slaves that are not on the bus are not reported, the master configures them once they appear.
+         *
+         * @return One line for each configured slave whose vendor ID or product code differs from the slave at its address.
+         */
+        std::vector<std::string> findMismatches(const std::vector<SlaveInfo>& slave_configs, const std::vector<SlaveIdentity>& bus);
+
+        std::vector<uint8_t> serialize(const TopologySnapshot& snapshot);
+
+        /**
+         * @brief Deserializes a snapshot created by serialize().
+         *
+         * @return std::nullopt If the snapshot is corrupted or of another version.
+         */
+        std::optional<TopologySnapshot> deserialize(const uint8_t* data, std::size_t size);
+
+        /**
+         * @brief Writes the snapshot to a temporary file and renames it over the snapshot file.
+         *
+         */
+        bool writeSnapshotFile(const std::string& path_to_snapshot_file, const TopologySnapshot& snapshot);
+
+        std::optional<TopologySnapshot> readSnapshotFile(const std::string& path_to_snapshot_file);
+
+    } // End of namespace topology
+} // End of namespace ec
+
+#endif // TOPOLOGY_HPP_
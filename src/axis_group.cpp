@@ -0,0 +1,242 @@
+/**
+ * @file axis_group.cpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ethercat_interface/driver/axis_group.hpp"
+#include "ethercat_interface/entry_access.hpp"
+
+#include <algorithm>
+
+namespace CIA402
+{
+
+    AxisGroup::AxisGroup(uint8_t* domain_data, const std::vector<AxisEntries>& axes)
+        : m_DomainData(domain_data),
+          m_HeldAxes(axes.size(), 0),
+          m_StatusWords(axes.size(), 0),
+          m_ControlWords(axes.size(), 0),
+          m_StateIndices(axes.size(), 0),
+          m_States(axes.size(), State::Unknown),
+          m_TargetStates(axes.size(), State::SwitchOnDisabled),
+          m_FaultResetPolicies(axes.size(), FaultResetPolicy::Manual),
+          m_FaultResetRequests(axes.size(), 0),
+          m_Diagnostics(axes.size()),
+          m_FaultedAtStart(axes.size(), 0)
+    {
+        m_StatusWordOffsets.reserve(axes.size());
+        m_ControlWordOffsets.reserve(axes.size());
+        m_StaleFlags.reserve(axes.size());
+        for(const auto& axis : axes)
+        {
+            m_StatusWordOffsets.push_back(axis.statusWordOffset);
+            m_ControlWordOffsets.push_back(axis.controlWordOffset);
+            m_StaleFlags.push_back(axis.staleFlag);
+        }
+    }
+
+    std::optional<AxisGroup> AxisGroup::fromDrivers(
+        const std::vector<ec::slave::Driver*>& drivers,
+        const std::string& status_word_name,
+        const std::string& control_word_name
+    )
+    {
+        if(drivers.empty()){
+            return std::nullopt;
+        }
+
+        uint8_t* domainData = drivers.front()->getDomainDataPtr();
+        std::vector<AxisEntries> axes;
+        axes.reserve(drivers.size());
+        for(auto* driver : drivers)
+        {
+            if(driver->getDomainDataPtr() != domainData){
+                return std::nullopt;
+            }
+            const auto statusWordOffset = driver->getOffsetPtr(status_word_name);
+            const auto controlWordOffset = driver->getOffsetPtr(control_word_name);
+            if(!statusWordOffset || !controlWordOffset){
+                return std::nullopt;
+            }
+            axes.push_back(AxisEntries{*statusWordOffset.value(), *controlWordOffset.value(), driver->getStaleFlag()});
+        }
+
+        return AxisGroup(domainData, axes);
+    }
+
+    void AxisGroup::update()
+    {
+        const std::size_t axisCount = size();
+
+        // Gather: the only scattered accesses of the cycle. A held axis keeps the words of its last update.
+        for(std::size_t i = 0; i < axisCount; i++)
+        {
+            m_HeldAxes[i] = (uint8_t)ec::entry::isStale(m_StaleFlags[i]);
+            if(m_HeldAxes[i]){
+                continue;
+            }
+            m_StatusWords[i] = EC_READ_U16(m_DomainData + m_StatusWordOffsets[i]);
+            m_ControlWords[i] = EC_READ_U16(m_DomainData + m_ControlWordOffsets[i]);
+        }
+
+        // Decode: the index computation is branch free and vectorized by the compiler, the table lookup follows.
+        for(std::size_t i = 0; i < axisCount; i++)
+        {
+            m_StateIndices[i] = getStateIndex(m_StatusWords[i]);
+        }
+        for(std::size_t i = 0; i < axisCount; i++)
+        {
+            m_States[i] = StateTable[m_StateIndices[i]];
+        }
+
+        stepOperation();
+
+        constexpr uint16_t faultResetBit = controlWordBit(ControlWord::FaultReset);
+        for(std::size_t i = 0; i < axisCount; i++)
+        {
+            if(m_HeldAxes[i]){
+                continue;
+            }
+            const State state = m_States[i];
+            m_FaultResetRequests[i] &= (uint8_t)(state == State::Fault);
+
+            Command command = NextHops[(std::size_t)state][(std::size_t)m_TargetStates[i]].command;
+            uint16_t controlWord = m_ControlWords[i];
+            if(command == Command::FaultReset){
+                if(m_FaultResetPolicies[i] == FaultResetPolicy::Manual && !m_FaultResetRequests[i]){
+                    command = Command::None;
+                }
+                else if(controlWord & faultResetBit){
+                    // The drive resets on the rising edge, so the bit is cleared for one cycle first.
+                    controlWord &= (uint16_t)~faultResetBit;
+                    command = Command::None;
+                }
+            }
+            m_ControlWords[i] = applyCommand(controlWord, command);
+        }
+
+        // Scatter.
+        for(std::size_t i = 0; i < axisCount; i++)
+        {
+            if(m_HeldAxes[i]){
+                continue;
+            }
+            EC_WRITE_U16(m_DomainData + m_ControlWordOffsets[i], m_ControlWords[i]);
+        }
+    }
+
+    void AxisGroup::setTargetState(State target_state)
+    {
+        std::fill(m_TargetStates.begin(), m_TargetStates.end(), target_state);
+    }
+
+    void AxisGroup::setFaultResetPolicy(FaultResetPolicy policy)
+    {
+        std::fill(m_FaultResetPolicies.begin(), m_FaultResetPolicies.end(), policy);
+    }
+
+    void AxisGroup::enable(uint32_t timeout_cycles)
+    {
+        startOperation(GroupOperation::Enable, timeout_cycles, State::SwitchedOn);
+    }
+
+    void AxisGroup::disable(uint32_t timeout_cycles)
+    {
+        startOperation(GroupOperation::Disable, timeout_cycles, State::SwitchedOn);
+    }
+
+    void AxisGroup::startOperation(GroupOperation operation, uint32_t timeout_cycles, State target_state)
+    {
+        m_Operation = operation;
+        m_OperationStatus = GroupOperationStatus::InProgress;
+        m_OperationCycles = 0;
+        m_OperationTimeout = timeout_cycles;
+        m_IsEnableCommanded = false;
+        std::fill(m_Diagnostics.begin(), m_Diagnostics.end(), AxisDiagnostics{});
+        setTargetState(target_state);
+    }
+
+    void AxisGroup::stepOperation()
+    {
+        if(m_OperationStatus != GroupOperationStatus::InProgress){
+            return;
+        }
+        m_OperationCycles++;
+
+        bool isEveryAxisReady = true;
+        bool isEveryAxisDone = true;
+        bool hasFaulted = false;
+        for(std::size_t i = 0; i < size(); i++)
+        {
+            const State state = m_States[i];
+            auto& diagnostics = m_Diagnostics[i];
+            diagnostics.lastState = state;
+
+            const bool isFault = state == State::Fault || state == State::FaultReactionActive;
+            if(m_OperationCycles == 1){
+                m_FaultedAtStart[i] = (uint8_t)isFault;
+            }
+            if(isFault && !m_FaultedAtStart[i]){
+                diagnostics.faulted = true;
+                hasFaulted = true;
+            }
+            if(!isFault){
+                // A fault reset at the start of the operation counts as recovered.
+                m_FaultedAtStart[i] = 0;
+            }
+
+            // Enabling waits for SwitchedOn, disabling for anything but an enabled drive.
+            const bool isReady = m_Operation == GroupOperation::Enable ?
+                (state == State::SwitchedOn || state == State::OperationEnabled) :
+                (state == State::SwitchedOn || state == State::ReadyToSwitchOn || state == State::SwitchOnDisabled);
+            if(isReady && diagnostics.readyCycle < 0){
+                diagnostics.readyCycle = (int32_t)m_OperationCycles;
+            }
+            isEveryAxisReady &= isReady;
+            isEveryAxisDone &= m_Operation == GroupOperation::Enable ? state == State::OperationEnabled : isReady;
+        }
+
+        if(hasFaulted){
+            finishOperation(GroupOperationStatus::Faulted);
+        }
+        else if(isEveryAxisDone){
+            finishOperation(GroupOperationStatus::Done);
+        }
+        else if(m_Operation == GroupOperation::Enable && isEveryAxisReady && !m_IsEnableCommanded){
+            // The commands below are computed in this same update, so every axis gets the enable bit in one frame.
+            setTargetState(State::OperationEnabled);
+            m_IsEnableCommanded = true;
+        }
+        else if(m_OperationCycles >= m_OperationTimeout){
+            finishOperation(GroupOperationStatus::TimedOut);
+        }
+    }
+
+    void AxisGroup::finishOperation(GroupOperationStatus status)
+    {
+        m_OperationStatus = status;
+        m_Operation = GroupOperation::None;
+        if(status != GroupOperationStatus::Done){
+            setTargetState(State::SwitchOnDisabled);
+        }
+    }
+
+    bool AxisGroup::isTargetReached() const
+    {
+        for(std::size_t i = 0; i < size(); i++)
+        {
+            if(m_States[i] != m_TargetStates[i]){
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+} // End of namespace CIA402
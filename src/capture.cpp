@@ -0,0 +1,704 @@
+/**
+ * @file capture.cpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ethercat_interface/capture.hpp"
+
+#include <cstring>
+#include <chrono>
+#include <algorithm>
+
+#include <unistd.h>
+
+namespace ec
+{
+    namespace capture
+    {
+
+        namespace
+        {
+            template<typename T>
+            void appendPod(std::vector<uint8_t>& buffer, const T& value)
+            {
+                const auto bytes = reinterpret_cast<const uint8_t*>(&value);
+                buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+            }
+
+            template<typename T>
+            bool readPod(std::FILE* file, T& value)
+            {
+                return std::fread(&value, sizeof(T), 1, file) == 1;
+            }
+
+            int64_t doubleBits(double value)
+            {
+                int64_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                return bits;
+            }
+
+            double bitsToDouble(int64_t bits)
+            {
+                double value;
+                std::memcpy(&value, &bits, sizeof(value));
+                return value;
+            }
+
+            /**
+             * @brief Orders two samples of the given column type.
+             *
+             */
+            bool isLess(DataType type, int64_t lhs, int64_t rhs)
+            {
+                if(isRealType(type)){
+                    return bitsToDouble(lhs) < bitsToDouble(rhs);
+                }
+                if(type == DataType::UINT64){
+                    return static_cast<uint64_t>(lhs) < static_cast<uint64_t>(rhs);
+                }
+                return lhs < rhs;
+            }
+
+            double toDouble(DataType type, int64_t raw)
+            {
+                if(isRealType(type)){
+                    return bitsToDouble(raw);
+                }
+                if(type == DataType::UINT64){
+                    return static_cast<double>(static_cast<uint64_t>(raw));
+                }
+                return static_cast<double>(raw);
+            }
+        }
+
+        double ColumnSeries::at(std::size_t sample_index) const
+        {
+            return toDouble(type, rawValues.at(sample_index));
+        }
+
+        void encodeVarint(uint64_t value, std::vector<uint8_t>& buffer)
+        {
+            while(value >= 0x80)
+            {
+                buffer.push_back(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            buffer.push_back(static_cast<uint8_t>(value));
+        }
+
+        std::optional<uint64_t> decodeVarint(const uint8_t* buffer, std::size_t size, std::size_t& position)
+        {
+            uint64_t value = 0;
+            for(unsigned int shift = 0; shift < 64; shift += 7)
+            {
+                if(position >= size){
+                    return std::nullopt;
+                }
+                const uint8_t byte = buffer[position++];
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if(!(byte & 0x80)){
+                    return value;
+                }
+            }
+
+            return std::nullopt;
+        }
+
+        CaptureWriter::CaptureWriter()
+        {
+            m_Columns.push_back({TimestampColumnName, DataType::UINT64});
+            m_Sources.push_back(nullptr);
+            m_ColumnEnabled.push_back(1);
+            m_LastSamples.push_back(0);
+        }
+
+        CaptureWriter::~CaptureWriter()
+        {
+            close();
+        }
+
+        bool CaptureWriter::addColumn(const std::string& name, DataType type, const uint8_t* source)
+        {
+            if(isOpen() || !source || type == DataType::UNKNOWN){
+                return false;
+            }
+
+            const bool nameTaken = std::any_of(m_Columns.cbegin(), m_Columns.cend(), [&name](const ColumnInfo& column){
+                return column.name == name;
+            });
+            if(nameTaken){
+                return false;
+            }
+
+            m_Columns.push_back({name, type});
+            m_Sources.push_back(source);
+            m_ColumnEnabled.push_back(1);
+            m_LastSamples.push_back(0);
+
+            return true;
+        }
+
+        std::optional<std::size_t> CaptureWriter::findColumn(const std::string& name) const
+        {
+            for(std::size_t i = 0; i < m_Columns.size(); i++)
+            {
+                if(m_Columns[i].name == name){
+                    return i;
+                }
+            }
+
+            return std::nullopt;
+        }
+
+        void CaptureWriter::setColumnEnabled(std::size_t column_index, bool enabled)
+        {
+            // The timestamp column is always sampled.
+            if(column_index == 0 || column_index >= m_ColumnEnabled.size()){
+                return;
+            }
+
+            m_ColumnEnabled[column_index] = enabled;
+        }
+
+        bool CaptureWriter::open(const std::string& path, std::size_t chunk_size)
+        {
+            if(isOpen() || chunk_size == 0){
+                return false;
+            }
+
+            m_File = std::fopen(path.c_str(), "wb");
+            if(!m_File){
+                return false;
+            }
+
+            if(std::fwrite(CaptureMagic, sizeof(CaptureMagic), 1, m_File) != 1){
+                std::fclose(m_File);
+                m_File = nullptr;
+                return false;
+            }
+            m_FileOffset = sizeof(CaptureMagic);
+
+            m_ChunkSize = chunk_size;
+            for(auto& rowGroup : m_RowGroups)
+            {
+                rowGroup.timestamps.assign(m_ChunkSize, 0);
+                rowGroup.values.assign(m_ChunkSize * m_Columns.size(), 0);
+                rowGroup.rows = 0;
+            }
+            m_ActiveRowGroup = 0;
+            m_RowGroupCounter = 0;
+            m_Chunks.clear();
+            m_DroppedSamples.store(0);
+            m_HasWriteFailed.store(false);
+            m_IsFlushPending.store(false);
+
+            m_IsWriterRunning.store(true);
+            m_WriterThread = std::thread(&CaptureWriter::writerLoop, this);
+
+            return true;
+        }
+
+        bool CaptureWriter::close()
+        {
+            if(!isOpen()){
+                return true;
+            }
+
+            m_IsWriterRunning.store(false);
+            if(m_WriterThread.joinable()){
+                m_WriterThread.join();
+            }
+
+            // The pending row group is older than the active one.
+            if(m_IsFlushPending.load()){
+                writeRowGroup(m_RowGroups[m_ActiveRowGroup ^ 1]);
+                m_IsFlushPending.store(false);
+            }
+            writeRowGroup(m_RowGroups[m_ActiveRowGroup]);
+
+            const bool hasWriteFailed = m_HasWriteFailed.load();
+            if(hasWriteFailed){
+                // Parts of the failed row group may have reached the file, the footer is written over them.
+                std::clearerr(m_File);
+                std::fseek(m_File, (long)m_FileOffset, SEEK_SET);
+            }
+            bool isFooterWritten = writeFooter() && std::fflush(m_File) == 0;
+            if(isFooterWritten && hasWriteFailed){
+                // The trailer is read from the end of the file, nothing may follow it.
+                isFooterWritten = ftruncate(fileno(m_File), (off_t)std::ftell(m_File)) == 0;
+            }
+
+            const bool isClosed = std::fclose(m_File) == 0;
+            m_File = nullptr;
+
+            return !hasWriteFailed && isFooterWritten && isClosed;
+        }
+
+        bool CaptureWriter::sample(uint64_t timestamp)
+        {
+            auto handOff = [this](){
+                if(!m_IsFlushPending.load(std::memory_order_acquire)){
+                    m_ActiveRowGroup ^= 1;
+                    m_IsFlushPending.store(true, std::memory_order_release);
+                }
+            };
+
+            if(m_RowGroups[m_ActiveRowGroup].rows == m_ChunkSize){
+                handOff();
+                if(m_RowGroups[m_ActiveRowGroup].rows == m_ChunkSize){
+                    m_DroppedSamples.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+            }
+
+            RowGroup& rowGroup = m_RowGroups[m_ActiveRowGroup];
+            const std::size_t row = rowGroup.rows;
+            rowGroup.timestamps[row] = timestamp;
+            rowGroup.values[row] = static_cast<int64_t>(timestamp);
+            for(std::size_t i = 1; i < m_Columns.size(); i++)
+            {
+                if(m_ColumnEnabled[i]){
+                    m_LastSamples[i] = readSource(m_Columns[i].type, m_Sources[i]);
+                }
+                rowGroup.values[i * m_ChunkSize + row] = m_LastSamples[i];
+            }
+            rowGroup.rows += 1;
+
+            if(rowGroup.rows == m_ChunkSize){
+                handOff();
+            }
+
+            return true;
+        }
+
+        int64_t CaptureWriter::readSource(DataType type, const uint8_t* source)
+        {
+            switch (type)
+            {
+            case DataType::UINT8:
+                return EC_READ_U8(source);
+            case DataType::INT8:
+                return EC_READ_S8(source);
+            case DataType::UINT16:
+                return EC_READ_U16(source);
+            case DataType::INT16:
+                return EC_READ_S16(source);
+            case DataType::UINT32:
+                return EC_READ_U32(source);
+            case DataType::INT32:
+                return EC_READ_S32(source);
+            case DataType::UINT64:
+                return static_cast<int64_t>(EC_READ_U64(source));
+            case DataType::INT64:
+                return EC_READ_S64(source);
+            case DataType::FLOAT:
+                return doubleBits(EC_READ_REAL(source));
+            case DataType::DOUBLE:
+                return doubleBits(EC_READ_LREAL(source));
+            default:
+                return 0;
+            }
+        }
+
+        void CaptureWriter::writerLoop()
+        {
+            while(m_IsWriterRunning.load())
+            {
+                if(m_IsFlushPending.load(std::memory_order_acquire)){
+                    writeRowGroup(m_RowGroups[m_ActiveRowGroup ^ 1]);
+                    m_IsFlushPending.store(false, std::memory_order_release);
+                    continue;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        void CaptureWriter::writeRowGroup(RowGroup& row_group)
+        {
+            if(row_group.rows == 0){
+                return;
+            }
+
+            bool isWritten = !m_HasWriteFailed.load(std::memory_order_relaxed);
+            const std::size_t chunkCount = m_Chunks.size();
+            const uint64_t fileOffset = m_FileOffset;
+            for(std::size_t i = 0; i < m_Columns.size() && isWritten; i++)
+            {
+                isWritten = writeChunk((uint32_t)i, m_Columns[i].type, row_group.values.data() + i * m_ChunkSize, row_group);
+            }
+            // fwrite only fills the buffer of the stream, errors like a full disk show up when it is flushed.
+            if(isWritten && std::fflush(m_File) != 0){
+                isWritten = false;
+            }
+
+            if(isWritten){
+                m_RowGroupCounter += 1;
+            }
+            else{
+                m_Chunks.resize(chunkCount);
+                m_FileOffset = fileOffset;
+                m_DroppedSamples.fetch_add(row_group.rows, std::memory_order_relaxed);
+                m_HasWriteFailed.store(true, std::memory_order_relaxed);
+            }
+            row_group.rows = 0;
+        }
+
+        bool CaptureWriter::writeChunk(uint32_t column_id, DataType type, const int64_t* samples, const RowGroup& row_group)
+        {
+            ChunkInfo chunk;
+            chunk.columnID = column_id;
+            chunk.sampleCount = (uint32_t)row_group.rows;
+            chunk.rowGroup = m_RowGroupCounter;
+            chunk.fileOffset = m_FileOffset;
+            chunk.firstTimestamp = row_group.timestamps[0];
+            chunk.lastTimestamp = row_group.timestamps[row_group.rows - 1];
+            chunk.encoding = isRealType(type) ? ColumnEncoding::Raw : ColumnEncoding::DeltaVarint;
+            chunk.min = samples[0];
+            chunk.max = samples[0];
+
+            m_EncodeBuffer.clear();
+            uint64_t previous = 0;
+            for(std::size_t i = 0; i < row_group.rows; i++)
+            {
+                const int64_t current = samples[i];
+                if(isLess(type, current, chunk.min)){
+                    chunk.min = current;
+                }
+                if(isLess(type, chunk.max, current)){
+                    chunk.max = current;
+                }
+
+                if(chunk.encoding == ColumnEncoding::Raw){
+                    appendPod(m_EncodeBuffer, current);
+                    continue;
+                }
+                // Counters wrap, so the difference is taken modulo 2^64.
+                const int64_t delta = static_cast<int64_t>(static_cast<uint64_t>(current) - previous);
+                encodeVarint(zigZagEncode(delta), m_EncodeBuffer);
+                previous = static_cast<uint64_t>(current);
+            }
+
+            chunk.byteSize = m_EncodeBuffer.size();
+            if(std::fwrite(m_EncodeBuffer.data(), 1, m_EncodeBuffer.size(), m_File) != m_EncodeBuffer.size()){
+                return false;
+            }
+            m_FileOffset += m_EncodeBuffer.size();
+
+            m_Chunks.push_back(chunk);
+
+            return true;
+        }
+
+        bool CaptureWriter::writeFooter()
+        {
+            std::vector<uint8_t> footer;
+
+            appendPod(footer, (uint32_t)m_Columns.size());
+            for(const auto& column : m_Columns)
+            {
+                appendPod(footer, (uint16_t)column.name.size());
+                footer.insert(footer.end(), column.name.begin(), column.name.end());
+                appendPod(footer, (uint8_t)column.type);
+            }
+
+            appendPod(footer, (uint64_t)m_Chunks.size());
+            for(const auto& chunk : m_Chunks)
+            {
+                appendPod(footer, chunk.columnID);
+                appendPod(footer, chunk.sampleCount);
+                appendPod(footer, chunk.rowGroup);
+                appendPod(footer, chunk.fileOffset);
+                appendPod(footer, chunk.byteSize);
+                appendPod(footer, chunk.firstTimestamp);
+                appendPod(footer, chunk.lastTimestamp);
+                appendPod(footer, chunk.min);
+                appendPod(footer, chunk.max);
+                appendPod(footer, (uint8_t)chunk.encoding);
+            }
+
+            appendPod(footer, m_FileOffset);
+            footer.insert(footer.end(), CaptureMagic, CaptureMagic + sizeof(CaptureMagic));
+
+            return std::fwrite(footer.data(), 1, footer.size(), m_File) == footer.size();
+        }
+
+        CaptureReader::CaptureReader()
+        {
+
+        }
+
+        CaptureReader::~CaptureReader()
+        {
+            close();
+        }
+
+        bool CaptureReader::open(const std::string& path)
+        {
+            if(m_File){
+                return false;
+            }
+
+            m_File = std::fopen(path.c_str(), "rb");
+            if(!m_File){
+                return false;
+            }
+
+            const bool footerOk = [this]() -> bool {
+                char magic[sizeof(CaptureMagic)];
+                if(std::fread(magic, sizeof(magic), 1, m_File) != 1 || std::memcmp(magic, CaptureMagic, sizeof(magic)) != 0){
+                    return false;
+                }
+
+                const long trailerSize = sizeof(uint64_t) + sizeof(CaptureMagic);
+                uint64_t footerOffset = 0;
+                if(std::fseek(m_File, -trailerSize, SEEK_END) != 0 || !readPod(m_File, footerOffset)){
+                    return false;
+                }
+                if(std::fread(magic, sizeof(magic), 1, m_File) != 1 || std::memcmp(magic, CaptureMagic, sizeof(magic)) != 0){
+                    return false;
+                }
+
+                if(std::fseek(m_File, (long)footerOffset, SEEK_SET) != 0){
+                    return false;
+                }
+
+                uint32_t columnCount = 0;
+                if(!readPod(m_File, columnCount)){
+                    return false;
+                }
+                for(uint32_t i = 0; i < columnCount; i++)
+                {
+                    uint16_t nameLength = 0;
+                    uint8_t type = 0;
+                    if(!readPod(m_File, nameLength)){
+                        return false;
+                    }
+                    std::string name(nameLength, '\0');
+                    if(nameLength != 0 && std::fread(name.data(), 1, nameLength, m_File) != nameLength){
+                        return false;
+                    }
+                    if(!readPod(m_File, type)){
+                        return false;
+                    }
+                    m_Columns.push_back({name, static_cast<DataType>(type)});
+                }
+
+                uint64_t chunkCount = 0;
+                if(!readPod(m_File, chunkCount)){
+                    return false;
+                }
+                for(uint64_t i = 0; i < chunkCount; i++)
+                {
+                    ChunkInfo chunk;
+                    uint8_t encoding = 0;
+                    const bool chunkOk = readPod(m_File, chunk.columnID) &&
+                                         readPod(m_File, chunk.sampleCount) &&
+                                         readPod(m_File, chunk.rowGroup) &&
+                                         readPod(m_File, chunk.fileOffset) &&
+                                         readPod(m_File, chunk.byteSize) &&
+                                         readPod(m_File, chunk.firstTimestamp) &&
+                                         readPod(m_File, chunk.lastTimestamp) &&
+                                         readPod(m_File, chunk.min) &&
+                                         readPod(m_File, chunk.max) &&
+                                         readPod(m_File, encoding);
+                    if(!chunkOk || chunk.columnID >= m_Columns.size()){
+                        return false;
+                    }
+                    chunk.encoding = static_cast<ColumnEncoding>(encoding);
+                    if(chunk.columnID == 0 && !m_TimestampChunks.emplace(chunk.rowGroup, m_Chunks.size()).second){
+                        return false;
+                    }
+                    m_Chunks.push_back(chunk);
+                }
+
+                return true;
+            }();
+
+            if(!footerOk){
+                close();
+                return false;
+            }
+
+            return true;
+        }
+
+        void CaptureReader::close()
+        {
+            if(m_File){
+                std::fclose(m_File);
+                m_File = nullptr;
+            }
+            m_Columns.clear();
+            m_Chunks.clear();
+            m_TimestampChunks.clear();
+        }
+
+        std::optional<uint32_t> CaptureReader::findColumnID(const std::string& column_name) const
+        {
+            auto columnFound = std::find_if(m_Columns.cbegin(), m_Columns.cend(), [&column_name](const ColumnInfo& column){
+                return column.name == column_name;
+            });
+            if(columnFound == m_Columns.cend()){
+                return std::nullopt;
+            }
+
+            return (uint32_t)std::distance(m_Columns.cbegin(), columnFound);
+        }
+
+        bool CaptureReader::readChunk(const ChunkInfo& chunk, std::vector<int64_t>& samples)
+        {
+            std::vector<uint8_t> encoded(chunk.byteSize);
+            if(std::fseek(m_File, (long)chunk.fileOffset, SEEK_SET) != 0){
+                return false;
+            }
+            if(chunk.byteSize != 0 && std::fread(encoded.data(), 1, encoded.size(), m_File) != encoded.size()){
+                return false;
+            }
+
+            samples.resize(chunk.sampleCount);
+            if(chunk.encoding == ColumnEncoding::Raw){
+                if(encoded.size() != chunk.sampleCount * sizeof(int64_t)){
+                    return false;
+                }
+                std::memcpy(samples.data(), encoded.data(), encoded.size());
+                return true;
+            }
+
+            std::size_t position = 0;
+            uint64_t previous = 0;
+            for(uint32_t i = 0; i < chunk.sampleCount; i++)
+            {
+                const auto zigZagged = decodeVarint(encoded.data(), encoded.size(), position);
+                if(!zigZagged){
+                    return false;
+                }
+                previous += static_cast<uint64_t>(zigZagDecode(zigZagged.value()));
+                samples[i] = static_cast<int64_t>(previous);
+            }
+
+            return true;
+        }
+
+        bool CaptureReader::readChunkInRange(const ChunkInfo& chunk, uint64_t begin_timestamp, uint64_t end_timestamp, ColumnSeries& series)
+        {
+            auto timestampChunk = m_TimestampChunks.find(chunk.rowGroup);
+            if(timestampChunk == m_TimestampChunks.end()){
+                return false;
+            }
+
+            std::vector<int64_t> timestamps;
+            std::vector<int64_t> values;
+            if(!readChunk(m_Chunks[timestampChunk->second], timestamps) || !readChunk(chunk, values) || timestamps.size() != values.size()){
+                return false;
+            }
+
+            for(std::size_t i = 0; i < values.size(); i++)
+            {
+                const uint64_t timestamp = static_cast<uint64_t>(timestamps[i]);
+                if(timestamp < begin_timestamp || timestamp > end_timestamp){
+                    continue;
+                }
+                series.timestamps.push_back(timestamp);
+                series.rawValues.push_back(values[i]);
+            }
+
+            return true;
+        }
+
+        std::optional<ColumnSeries> CaptureReader::readColumn(
+            const std::string& column_name,
+            uint64_t begin_timestamp,
+            uint64_t end_timestamp
+        )
+        {
+            const auto columnID = findColumnID(column_name);
+            if(!m_File || !columnID){
+                return std::nullopt;
+            }
+
+            ColumnSeries series;
+            series.type = m_Columns[columnID.value()].type;
+
+            for(const auto& chunk : m_Chunks)
+            {
+                if(chunk.columnID != columnID.value()){
+                    continue;
+                }
+                if(chunk.lastTimestamp < begin_timestamp || chunk.firstTimestamp > end_timestamp){
+                    continue;
+                }
+
+                if(!readChunkInRange(chunk, begin_timestamp, end_timestamp, series)){
+                    return std::nullopt;
+                }
+            }
+
+            return series;
+        }
+
+        std::optional<std::pair<double, double>> CaptureReader::readColumnBounds(
+            const std::string& column_name,
+            uint64_t begin_timestamp,
+            uint64_t end_timestamp
+        )
+        {
+            const auto columnID = findColumnID(column_name);
+            if(!m_File || !columnID){
+                return std::nullopt;
+            }
+            const DataType type = m_Columns[columnID.value()].type;
+
+            std::optional<int64_t> min;
+            std::optional<int64_t> max;
+            auto include = [type, &min, &max](int64_t sample){
+                if(!min || isLess(type, sample, min.value())){
+                    min = sample;
+                }
+                if(!max || isLess(type, max.value(), sample)){
+                    max = sample;
+                }
+            };
+
+            ColumnSeries edge;
+            for(const auto& chunk : m_Chunks)
+            {
+                if(chunk.columnID != columnID.value()){
+                    continue;
+                }
+                if(chunk.lastTimestamp < begin_timestamp || chunk.firstTimestamp > end_timestamp){
+                    continue;
+                }
+
+                if(chunk.firstTimestamp >= begin_timestamp && chunk.lastTimestamp <= end_timestamp){
+                    include(chunk.min);
+                    include(chunk.max);
+                    continue;
+                }
+
+                edge.rawValues.clear();
+                edge.timestamps.clear();
+                if(!readChunkInRange(chunk, begin_timestamp, end_timestamp, edge)){
+                    return std::nullopt;
+                }
+                for(const int64_t sample : edge.rawValues)
+                {
+                    include(sample);
+                }
+            }
+
+            if(!min){
+                return std::nullopt;
+            }
+
+            return std::make_pair(toDouble(type, min.value()), toDouble(type, max.value()));
+        }
+
+    } // End of namespace capture
+} // End of namespace ec
@@ -0,0 +1,534 @@
+/**
+ * @file config_cache.cpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ethercat_interface/config_cache.hpp"
+#include "ethercat_interface/binary_io.hpp"
+
+#include <cstring>
+#include <algorithm>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace ec
+{
+    namespace parser
+    {
+        namespace cache
+        {
+
+            namespace
+            {
+                using binary::BinaryWriter;
+                using binary::BinaryReader;
+
+                // Fewest bytes each element takes in the cache, the counts read from a cache are bounded by them.
+                constexpr std::size_t MinStringSize = sizeof(uint32_t);
+                constexpr std::size_t MinEntrySize = MinStringSize + sizeof(Index) + sizeof(Subindex) + sizeof(Bitlength) + sizeof(DataType) +
+                                                     sizeof(FilterType) + sizeof(EntryFilter::coefficients) + sizeof(EntryFilter::window) +
+                                                     sizeof(uint8_t) + 3 * sizeof(double) + sizeof(PDO_Entry::count) + sizeof(uint8_t);
+                constexpr std::size_t MinPdoSize = sizeof(PDO::pdoType) + sizeof(PDO::pdoAddress) + sizeof(uint32_t);
+                constexpr std::size_t MinSyncManagerSize = sizeof(SyncManagerConfig::index) + sizeof(ec_direction_t) + sizeof(ec_watchdog_mode_t);
+                constexpr std::size_t MinLayoutSize = 3 * sizeof(uint32_t);
+                constexpr std::size_t MinStartupSdoSize = sizeof(Index) + sizeof(Subindex) + sizeof(DataType) + sizeof(uint32_t);
+                constexpr std::size_t MinStartupSdoListSize = sizeof(uint32_t);
+                constexpr std::size_t MinSlaveInfoSize = 2 * MinStringSize + sizeof(SlaveInfo::slaveType) + sizeof(SlaveInfo::alias) +
+                                                         sizeof(SlaveInfo::position) + sizeof(SlaveInfo::vendorID) + sizeof(SlaveInfo::productCode) +
+                                                         2 * sizeof(uint32_t) + sizeof(SlaveTuning::cycleDivisor) + 2 * sizeof(uint32_t) + sizeof(uint8_t);
+
+                void writePDOs(BinaryWriter& writer, const std::vector<PDO>& pdos)
+                {
+                    writer.write((uint32_t)pdos.size());
+                    for(const auto& pdo : pdos)
+                    {
+                        writer.write(pdo.pdoType);
+                        writer.write(pdo.pdoAddress);
+                        writer.write((uint32_t)pdo.entries.size());
+                        for(const auto& entry : pdo.entries)
+                        {
+                            writer.write(entry.entryName);
+                            writer.write(entry.index);
+                            writer.write(entry.subindex);
+                            writer.write(entry.bitlength);
+                            writer.write(entry.type);
+                            writer.write(entry.filter.type);
+                            for(const double coefficient : entry.filter.coefficients)
+                            {
+                                writer.write(coefficient);
+                            }
+                            writer.write(entry.filter.window);
+                            writer.write((uint8_t)entry.limit.isLimited);
+                            writer.write(entry.limit.min);
+                            writer.write(entry.limit.max);
+                            writer.write(entry.limit.maxStep);
+                            writer.write(entry.count);
+                            writer.write((uint8_t)entry.isTimestamp);
+                        }
+                    }
+                }
+
+                bool readPDOs(BinaryReader& reader, std::vector<PDO>& pdos)
+                {
+                    uint32_t pdoCount = 0;
+                    if(!reader.readCount(pdoCount, MinPdoSize)){
+                        return false;
+                    }
+                    pdos.resize(pdoCount);
+                    for(auto& pdo : pdos)
+                    {
+                        uint32_t entryCount = 0;
+                        if(!reader.readEnum(pdo.pdoType, PDO_Type::RxPDO, PDO_Type::TxPDO) || !reader.read(pdo.pdoAddress) ||
+                           !reader.readCount(entryCount, MinEntrySize)){
+                            return false;
+                        }
+                        pdo.entries.resize(entryCount);
+                        for(auto& entry : pdo.entries)
+                        {
+                            const bool entryOk = reader.read(entry.entryName) &&
+                                                 reader.read(entry.index) &&
+                                                 reader.read(entry.subindex) &&
+                                                 reader.read(entry.bitlength) &&
+                                                 reader.readEnum(entry.type, DataType::UINT8, DataType::UNKNOWN) &&
+                                                 reader.readEnum(entry.filter.type, FilterType::None, FilterType::Median3);
+                            if(!entryOk){
+                                return false;
+                            }
+                            for(double& coefficient : entry.filter.coefficients)
+                            {
+                                if(!reader.read(coefficient)){
+                                    return false;
+                                }
+                            }
+                            uint8_t isLimited = 0;
+                            uint8_t isTimestamp = 0;
+                            const bool settingsOk = reader.read(entry.filter.window) &&
+                                                 reader.read(isLimited) &&
+                                                 reader.read(entry.limit.min) &&
+                                                 reader.read(entry.limit.max) &&
+                                                 reader.read(entry.limit.maxStep) &&
+                                                 reader.read(entry.count) &&
+                                                 reader.read(isTimestamp);
+                            if(!settingsOk){
+                                return false;
+                            }
+                            entry.limit.isLimited = isLimited != 0;
+                            entry.isTimestamp = isTimestamp != 0;
+                        }
+                    }
+                    return true;
+                }
+
+                void writeLayout(BinaryWriter& writer, const SlaveLayout& layout)
+                {
+                    writePDOs(writer, layout.rxPDOs);
+                    writePDOs(writer, layout.txPDOs);
+
+                    writer.write((uint32_t)layout.syncManagerConfig.size());
+                    for(const auto& syncManager : layout.syncManagerConfig)
+                    {
+                        writer.write(syncManager.index);
+                        writer.write(syncManager.syncManagerDirection);
+                        writer.write(syncManager.watchdogMode);
+                    }
+                }
+
+                bool readLayout(BinaryReader& reader, SlaveLayout& layout)
+                {
+                    if(!readPDOs(reader, layout.rxPDOs) || !readPDOs(reader, layout.txPDOs)){
+                        return false;
+                    }
+
+                    uint32_t syncManagerCount = 0;
+                    if(!reader.readCount(syncManagerCount, MinSyncManagerSize)){
+                        return false;
+                    }
+                    layout.syncManagerConfig.resize(syncManagerCount);
+                    for(auto& syncManager : layout.syncManagerConfig)
+                    {
+                        const bool syncManagerOk = reader.read(syncManager.index) &&
+                                                   reader.readEnum(syncManager.syncManagerDirection, EC_DIR_INVALID, (ec_direction_t)(EC_DIR_COUNT - 1)) &&
+                                                   reader.readEnum(syncManager.watchdogMode, EC_WD_DEFAULT, EC_WD_DISABLE);
+                        if(!syncManagerOk){
+                            return false;
+                        }
+                    }
+
+                    return true;
+                }
+
+                /**
+                 * @brief Index written for a slave that does not point to a shared object, e.g. has no startup SDOs.
+                 *
+                 */
+                constexpr uint32_t NoSharedObject = UINT32_MAX;
+
+                void writeStartupSdos(BinaryWriter& writer, const std::vector<StartupSdo>& startup_sdos)
+                {
+                    writer.write((uint32_t)startup_sdos.size());
+                    for(const auto& startupSdo : startup_sdos)
+                    {
+                        writer.write(startupSdo.index);
+                        writer.write(startupSdo.subindex);
+                        writer.write(startupSdo.type);
+                        writer.write((uint32_t)startupSdo.data.size());
+                        for(const uint8_t byte : startupSdo.data)
+                        {
+                            writer.write(byte);
+                        }
+                    }
+                }
+
+                bool readStartupSdos(BinaryReader& reader, std::vector<StartupSdo>& startup_sdos)
+                {
+                    uint32_t sdoCount = 0;
+                    if(!reader.readCount(sdoCount, MinStartupSdoSize)){
+                        return false;
+                    }
+                    startup_sdos.resize(sdoCount);
+                    for(auto& startupSdo : startup_sdos)
+                    {
+                        uint32_t dataSize = 0;
+                        const bool sdoOk = reader.read(startupSdo.index) &&
+                                           reader.read(startupSdo.subindex) &&
+                                           reader.readEnum(startupSdo.type, DataType::UINT8, DataType::UNKNOWN) &&
+                                           reader.read(dataSize) &&
+                                           dataSize <= sizeof(uint64_t);
+                        if(!sdoOk){
+                            return false;
+                        }
+                        startupSdo.data.resize(dataSize);
+                        for(uint8_t& byte : startupSdo.data)
+                        {
+                            if(!reader.read(byte)){
+                                return false;
+                            }
+                        }
+                    }
+                    return true;
+                }
+
+                /**
+                 * @brief Collects the distinct objects the slaves point to, so that shared objects are written once.
+                 *
+                 * @param indices Index of each slave's object in the returned list, NoSharedObject for nullptr.
+                 */
+                template<typename T, typename Getter>
+                std::vector<const T*> collectShared(const std::vector<SlaveInfo>& slave_infos, Getter getter, std::vector<uint32_t>& indices)
+                {
+                    std::vector<const T*> objects;
+                    for(const auto& slaveInfo : slave_infos)
+                    {
+                        const T* object = getter(slaveInfo);
+                        if(!object){
+                            indices.push_back(NoSharedObject);
+                            continue;
+                        }
+                        auto objectFound = std::find(objects.cbegin(), objects.cend(), object);
+                        indices.push_back((uint32_t)std::distance(objects.cbegin(), objectFound));
+                        if(objectFound == objects.cend()){
+                            objects.push_back(object);
+                        }
+                    }
+                    return objects;
+                }
+
+                void writeSlaveInfo(BinaryWriter& writer, const SlaveInfo& slave_info, uint32_t layout_index, uint32_t startup_sdos_index)
+                {
+                    writer.write(slave_info.slaveName);
+                    writer.write(slave_info.domainName);
+                    writer.write(slave_info.slaveType);
+                    writer.write(slave_info.alias);
+                    writer.write(slave_info.position);
+                    writer.write(slave_info.vendorID);
+                    writer.write(slave_info.productCode);
+                    writer.write(layout_index);
+                    writer.write(startup_sdos_index);
+
+                    writer.write(slave_info.tuning.cycleDivisor);
+                    writer.write((uint32_t)slave_info.tuning.scalingFactors.size());
+                    for(const auto& [entryName, factor] : slave_info.tuning.scalingFactors)
+                    {
+                        writer.write(entryName);
+                        writer.write(factor);
+                    }
+                    writer.write((uint32_t)slave_info.tuning.telemetryEntries.size());
+                    for(const auto& entryName : slave_info.tuning.telemetryEntries)
+                    {
+                        writer.write(entryName);
+                    }
+
+                    writer.write((uint8_t)slave_info.distributedClockConfig.has_value());
+                    if(slave_info.distributedClockConfig){
+                        const auto& dcConfig = slave_info.distributedClockConfig.value();
+                        writer.write(dcConfig.assignActivate);
+                        writer.write(dcConfig.sync0Activate);
+                        writer.write(dcConfig.sync0Shift);
+                        writer.write(dcConfig.sync1Activate);
+                        writer.write(dcConfig.sync1Shift);
+                        writer.write((uint8_t)dcConfig.isAppliedToSlave);
+                    }
+                }
+
+                bool readSlaveInfo(
+                    BinaryReader& reader,
+                    SlaveInfo& slave_info,
+                    const std::vector<SlaveLayoutPtr>& layouts,
+                    const std::vector<StartupSdosPtr>& startup_sdo_lists
+                )
+                {
+                    const bool headerOk = reader.read(slave_info.slaveName) &&
+                                          reader.read(slave_info.domainName) &&
+                                          reader.readEnum(slave_info.slaveType, SlaveType::Driver, SlaveType::IO) &&
+                                          reader.read(slave_info.alias) &&
+                                          reader.read(slave_info.position) &&
+                                          reader.read(slave_info.vendorID) &&
+                                          reader.read(slave_info.productCode);
+                    uint32_t layoutIndex = 0;
+                    if(!headerOk || !reader.read(layoutIndex) || layoutIndex >= layouts.size()){
+                        return false;
+                    }
+                    slave_info.layout = layouts[layoutIndex];
+
+                    uint32_t startupSdosIndex = 0;
+                    if(!reader.read(startupSdosIndex)){
+                        return false;
+                    }
+                    if(startupSdosIndex != NoSharedObject){
+                        if(startupSdosIndex >= startup_sdo_lists.size()){
+                            return false;
+                        }
+                        slave_info.startupSdos = startup_sdo_lists[startupSdosIndex];
+                    }
+
+                    uint32_t scalingFactorCount = 0;
+                    if(!reader.read(slave_info.tuning.cycleDivisor) || !reader.readCount(scalingFactorCount, MinStringSize + sizeof(double))){
+                        return false;
+                    }
+                    for(uint32_t i = 0; i < scalingFactorCount; i++)
+                    {
+                        std::string entryName;
+                        double factor = 0.0;
+                        if(!reader.read(entryName) || !reader.read(factor)){
+                            return false;
+                        }
+                        slave_info.tuning.scalingFactors[entryName] = factor;
+                    }
+                    uint32_t telemetryEntryCount = 0;
+                    if(!reader.readCount(telemetryEntryCount, MinStringSize)){
+                        return false;
+                    }
+                    slave_info.tuning.telemetryEntries.resize(telemetryEntryCount);
+                    for(auto& entryName : slave_info.tuning.telemetryEntries)
+                    {
+                        if(!reader.read(entryName)){
+                            return false;
+                        }
+                    }
+
+                    uint8_t hasDcConfig = 0;
+                    if(!reader.read(hasDcConfig)){
+                        return false;
+                    }
+                    if(hasDcConfig){
+                        DistributedClockConfig dcConfig;
+                        uint8_t isAppliedToSlave = 0;
+                        const bool dcConfigOk = reader.read(dcConfig.assignActivate) &&
+                                                reader.read(dcConfig.sync0Activate) &&
+                                                reader.read(dcConfig.sync0Shift) &&
+                                                reader.read(dcConfig.sync1Activate) &&
+                                                reader.read(dcConfig.sync1Shift) &&
+                                                reader.read(isAppliedToSlave);
+                        if(!dcConfigOk){
+                            return false;
+                        }
+                        dcConfig.isAppliedToSlave = isAppliedToSlave != 0;
+                        slave_info.distributedClockConfig = dcConfig;
+                    }
+                    else{
+                        slave_info.distributedClockConfig = std::nullopt;
+                    }
+
+                    return true;
+                }
+            }
+
+            uint64_t hashContent(const std::string& content)
+            {
+                uint64_t hash = 0xcbf29ce484222325ULL;
+                for(const char c : content)
+                {
+                    hash ^= static_cast<uint8_t>(c);
+                    hash *= 0x100000001b3ULL;
+                }
+                return hash;
+            }
+
+            std::vector<uint8_t> serialize(const ProgramConfig& program_config, uint64_t content_hash)
+            {
+                BinaryWriter writer;
+                for(const char c : CacheMagic)
+                {
+                    writer.write(c);
+                }
+                writer.write(CacheVersion);
+                writer.write(content_hash);
+
+                writer.write(program_config.cyclePeriod);
+                writer.write(program_config.masterIndex);
+                writer.write(program_config.cpuCore);
+                writer.write((uint8_t)program_config.alignCycles);
+                writer.write(program_config.cycleOffset);
+
+                // Layouts and startup SDO lists shared by several slaves are written once and referenced by index.
+                std::vector<uint32_t> layoutIndices;
+                const auto layouts = collectShared<SlaveLayout>(
+                    program_config.slaveConfigurations,
+                    [](const SlaveInfo& slave_info){ return slave_info.layout.get(); },
+                    layoutIndices
+                );
+                std::vector<uint32_t> startupSdosIndices;
+                const auto startupSdoLists = collectShared<std::vector<StartupSdo>>(
+                    program_config.slaveConfigurations,
+                    [](const SlaveInfo& slave_info){ return slave_info.startupSdos.get(); },
+                    startupSdosIndices
+                );
+
+                writer.write((uint32_t)layouts.size());
+                for(const auto* layout : layouts)
+                {
+                    writeLayout(writer, *layout);
+                }
+
+                writer.write((uint32_t)startupSdoLists.size());
+                for(const auto* startupSdos : startupSdoLists)
+                {
+                    writeStartupSdos(writer, *startupSdos);
+                }
+
+                writer.write((uint32_t)program_config.slaveConfigurations.size());
+                for(std::size_t i = 0; i < program_config.slaveConfigurations.size(); i++)
+                {
+                    writeSlaveInfo(writer, program_config.slaveConfigurations[i], layoutIndices[i], startupSdosIndices[i]);
+                }
+
+                return std::move(writer.getBuffer());
+            }
+
+            std::optional<ProgramConfig> deserialize(const uint8_t* data, std::size_t size, uint64_t content_hash)
+            {
+                BinaryReader reader(data, size);
+
+                char magic[sizeof(CacheMagic)];
+                for(char& c : magic)
+                {
+                    if(!reader.read(c)){
+                        return std::nullopt;
+                    }
+                }
+                if(std::memcmp(magic, CacheMagic, sizeof(CacheMagic)) != 0){
+                    return std::nullopt;
+                }
+
+                uint32_t version = 0;
+                uint64_t hash = 0;
+                if(!reader.read(version) || version != CacheVersion || !reader.read(hash) || hash != content_hash){
+                    return std::nullopt;
+                }
+
+                ProgramConfig programConfig;
+                uint32_t layoutCount = 0;
+                uint8_t alignCycles = 0;
+                if(!reader.read(programConfig.cyclePeriod) || !reader.read(programConfig.masterIndex) || !reader.read(programConfig.cpuCore) ||
+                   !reader.read(alignCycles) || !reader.read(programConfig.cycleOffset) || !reader.readCount(layoutCount, MinLayoutSize)){
+                    return std::nullopt;
+                }
+                programConfig.alignCycles = alignCycles != 0;
+
+                std::vector<SlaveLayoutPtr> layouts;
+                for(uint32_t i = 0; i < layoutCount; i++)
+                {
+                    SlaveLayout layout;
+                    if(!readLayout(reader, layout)){
+                        return std::nullopt;
+                    }
+                    layouts.push_back(std::make_shared<const SlaveLayout>(std::move(layout)));
+                }
+
+                uint32_t startupSdoListCount = 0;
+                if(!reader.readCount(startupSdoListCount, MinStartupSdoListSize)){
+                    return std::nullopt;
+                }
+                std::vector<StartupSdosPtr> startupSdoLists;
+                for(uint32_t i = 0; i < startupSdoListCount; i++)
+                {
+                    std::vector<StartupSdo> startupSdos;
+                    if(!readStartupSdos(reader, startupSdos)){
+                        return std::nullopt;
+                    }
+                    startupSdoLists.push_back(std::make_shared<const std::vector<StartupSdo>>(std::move(startupSdos)));
+                }
+
+                uint32_t slaveCount = 0;
+                if(!reader.readCount(slaveCount, MinSlaveInfoSize)){
+                    return std::nullopt;
+                }
+                programConfig.slaveConfigurations.resize(slaveCount);
+                for(auto& slaveInfo : programConfig.slaveConfigurations)
+                {
+                    if(!readSlaveInfo(reader, slaveInfo, layouts, startupSdoLists)){
+                        return std::nullopt;
+                    }
+                }
+
+                if(!reader.isAtEnd()){
+                    return std::nullopt;
+                }
+
+                return programConfig;
+            }
+
+            bool writeCacheFile(const std::string& path_to_cache_file, const ProgramConfig& program_config, uint64_t content_hash)
+            {
+                return binary::writeFileAtomically(path_to_cache_file, serialize(program_config, content_hash));
+            }
+
+            std::optional<ProgramConfig> readCacheFile(const std::string& path_to_cache_file, uint64_t content_hash)
+            {
+                const int fileDescriptor = ::open(path_to_cache_file.c_str(), O_RDONLY);
+                if(fileDescriptor < 0){
+                    return std::nullopt;
+                }
+
+                struct stat fileStat;
+                if(fstat(fileDescriptor, &fileStat) != 0 || fileStat.st_size == 0){
+                    ::close(fileDescriptor);
+                    return std::nullopt;
+                }
+                const std::size_t fileSize = (std::size_t)fileStat.st_size;
+
+                void* mapping = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+                ::close(fileDescriptor);
+                if(mapping == MAP_FAILED){
+                    return std::nullopt;
+                }
+
+                auto programConfig = deserialize(static_cast<const uint8_t*>(mapping), fileSize, content_hash);
+
+                munmap(mapping, fileSize);
+
+                return programConfig;
+            }
+
+        } // End of namespace cache
+    } // End of namespace parser
+} // End of namespace ec
@@ -0,0 +1,299 @@
+/**
+ * @file config_diff.cpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ethercat_interface/config_diff.hpp"
+
+#include <map>
+#include <set>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+
+namespace ec
+{
+    namespace parser
+    {
+
+        namespace
+        {
+            std::string toHex(uint32_t value)
+            {
+                std::ostringstream stream;
+                stream << "0x" << std::hex << std::uppercase << value;
+                return stream.str();
+            }
+
+            template<typename T>
+            std::string describeChange(const std::string& what, const T& old_value, const T& new_value)
+            {
+                std::ostringstream stream;
+                stream << what << ": " << old_value << " -> " << new_value;
+                return stream.str();
+            }
+
+            /**
+             * @brief Compares two PDO lists, reports the first difference.
+             *
+             */
+            std::optional<std::string> comparePDOs(const std::vector<PDO>& active, const std::vector<PDO>& reloaded)
+            {
+                if(active.size() != reloaded.size()){
+                    return describeChange("number of PDOs", active.size(), reloaded.size());
+                }
+
+                for(std::size_t i = 0; i < active.size(); i++)
+                {
+                    const auto& activePDO = active[i];
+                    const auto& reloadedPDO = reloaded[i];
+                    const std::string pdoName = "PDO " + toHex(activePDO.pdoAddress);
+
+                    if(activePDO.pdoAddress != reloadedPDO.pdoAddress){
+                        return "PDO address: " + toHex(activePDO.pdoAddress) + " -> " + toHex(reloadedPDO.pdoAddress);
+                    }
+                    if(activePDO.entries.size() != reloadedPDO.entries.size()){
+                        return describeChange(pdoName + " number of entries", activePDO.entries.size(), reloadedPDO.entries.size());
+                    }
+
+                    for(std::size_t j = 0; j < activePDO.entries.size(); j++)
+                    {
+                        const auto& activeEntry = activePDO.entries[j];
+                        const auto& reloadedEntry = reloadedPDO.entries[j];
+                        if(activeEntry.entryName != reloadedEntry.entryName){
+                            return describeChange(pdoName + " entry " + std::to_string(j) + " name", activeEntry.entryName, reloadedEntry.entryName);
+                        }
+
+                        const std::string entryName = pdoName + " entry " + activeEntry.entryName;
+                        if(activeEntry.index != reloadedEntry.index){
+                            return entryName + " index: " + toHex(activeEntry.index) + " -> " + toHex(reloadedEntry.index);
+                        }
+                        if(activeEntry.subindex != reloadedEntry.subindex){
+                            return entryName + " subindex: " + toHex(activeEntry.subindex) + " -> " + toHex(reloadedEntry.subindex);
+                        }
+                        if(activeEntry.bitlength != reloadedEntry.bitlength){
+                            return describeChange(entryName + " bitlength", +activeEntry.bitlength, +reloadedEntry.bitlength);
+                        }
+                        if(activeEntry.count != reloadedEntry.count){
+                            return describeChange(entryName + " count", +activeEntry.count, +reloadedEntry.count);
+                        }
+                        if(activeEntry.type != reloadedEntry.type){
+                            return entryName + " type changed";
+                        }
+                        if(activeEntry.filter != reloadedEntry.filter){
+                            return entryName + " filter changed";
+                        }
+                        if(activeEntry.limit != reloadedEntry.limit){
+                            return entryName + " limit changed";
+                        }
+                        if(activeEntry.isTimestamp != reloadedEntry.isTimestamp){
+                            return entryName + " timestamp changed";
+                        }
+                    }
+                }
+
+                return std::nullopt;
+            }
+
+            std::optional<std::string> compareLayouts(const SlaveLayout& active, const SlaveLayout& reloaded)
+            {
+                if(auto difference = comparePDOs(active.rxPDOs, reloaded.rxPDOs)){
+                    return "RxPDO " + difference.value();
+                }
+                if(auto difference = comparePDOs(active.txPDOs, reloaded.txPDOs)){
+                    return "TxPDO " + difference.value();
+                }
+
+                if(active.syncManagerConfig.size() != reloaded.syncManagerConfig.size()){
+                    return describeChange("number of sync managers", active.syncManagerConfig.size(), reloaded.syncManagerConfig.size());
+                }
+                for(std::size_t i = 0; i < active.syncManagerConfig.size(); i++)
+                {
+                    const auto& activeSM = active.syncManagerConfig[i];
+                    const auto& reloadedSM = reloaded.syncManagerConfig[i];
+                    if(activeSM.index != reloadedSM.index ||
+                       activeSM.syncManagerDirection != reloadedSM.syncManagerDirection ||
+                       activeSM.watchdogMode != reloadedSM.watchdogMode){
+                        return "sync manager " + std::to_string(activeSM.index) + " changed";
+                    }
+                }
+
+                return std::nullopt;
+            }
+
+            void diffTuning(
+                const std::string& prefix,
+                const SlaveTuning& active,
+                const SlaveTuning& reloaded,
+                std::vector<std::string>& changes
+            )
+            {
+                if(active.cycleDivisor != reloaded.cycleDivisor){
+                    changes.push_back(describeChange(prefix + "cycle_divisor", active.cycleDivisor, reloaded.cycleDivisor));
+                }
+
+                for(const auto& [entryName, factor] : reloaded.scalingFactors)
+                {
+                    auto found = active.scalingFactors.find(entryName);
+                    const double oldFactor = found == active.scalingFactors.end() ? 1.0 : found->second;
+                    if(oldFactor != factor){
+                        changes.push_back(describeChange(prefix + entryName + " scale", oldFactor, factor));
+                    }
+                }
+                for(const auto& [entryName, factor] : active.scalingFactors)
+                {
+                    if(reloaded.scalingFactors.find(entryName) == reloaded.scalingFactors.end() && factor != 1.0){
+                        changes.push_back(describeChange(prefix + entryName + " scale", factor, 1.0));
+                    }
+                }
+
+                if(active.telemetryEntries != reloaded.telemetryEntries){
+                    auto join = [](const std::vector<std::string>& entries) -> std::string {
+                        if(entries.empty()){
+                            return "all";
+                        }
+                        std::string joined;
+                        for(const auto& entry : entries)
+                        {
+                            joined += (joined.empty() ? "" : ",") + entry;
+                        }
+                        return "[" + joined + "]";
+                    };
+                    changes.push_back(prefix + "telemetry: " + join(active.telemetryEntries) + " -> " + join(reloaded.telemetryEntries));
+                }
+            }
+        }
+
+        ConfigDiff diffConfigs(const ProgramConfig& active_config, const ProgramConfig& reloaded_config)
+        {
+            ConfigDiff diff;
+
+            if(active_config.cyclePeriod != reloaded_config.cyclePeriod){
+                diff.structuralChanges.push_back(describeChange("cycle_period", active_config.cyclePeriod, reloaded_config.cyclePeriod));
+            }
+            if(active_config.masterIndex != reloaded_config.masterIndex){
+                diff.structuralChanges.push_back(describeChange("master_index", active_config.masterIndex, reloaded_config.masterIndex));
+            }
+            if(active_config.cpuCore != reloaded_config.cpuCore){
+                diff.structuralChanges.push_back(describeChange("cpu_core", active_config.cpuCore, reloaded_config.cpuCore));
+            }
+            if(active_config.alignCycles != reloaded_config.alignCycles){
+                auto toString = [](bool value) -> std::string {
+                    return value ? "true" : "false";
+                };
+                diff.structuralChanges.push_back(describeChange("align_cycles", toString(active_config.alignCycles), toString(reloaded_config.alignCycles)));
+            }
+            if(active_config.cycleOffset != reloaded_config.cycleOffset){
+                diff.structuralChanges.push_back(describeChange("cycle_offset", active_config.cycleOffset, reloaded_config.cycleOffset));
+            }
+
+            std::map<std::string, const SlaveInfo*> activeSlaves;
+            for(const auto& slaveInfo : active_config.slaveConfigurations)
+            {
+                activeSlaves[slaveInfo.slaveName] = &slaveInfo;
+            }
+
+            std::set<std::string> matchedSlaves;
+            for(std::size_t i = 0; i < reloaded_config.slaveConfigurations.size(); i++)
+            {
+                const auto& reloaded = reloaded_config.slaveConfigurations[i];
+                const std::string prefix = reloaded.slaveName + ": ";
+
+                auto activeFound = activeSlaves.find(reloaded.slaveName);
+                if(activeFound == activeSlaves.end()){
+                    diff.structuralChanges.push_back(prefix + "slave added");
+                    continue;
+                }
+                matchedSlaves.insert(reloaded.slaveName);
+                const auto& active = *activeFound->second;
+
+                const std::size_t structuralBefore = diff.structuralChanges.size();
+                auto& structural = diff.structuralChanges;
+
+                if(active.slaveType != reloaded.slaveType){
+                    structural.push_back(prefix + "slave type changed");
+                }
+                if(active.domainName != reloaded.domainName){
+                    structural.push_back(describeChange(prefix + "domain", active.domainName, reloaded.domainName));
+                }
+                if(active.alias != reloaded.alias){
+                    structural.push_back(describeChange(prefix + "alias", active.alias, reloaded.alias));
+                }
+                if(active.position != reloaded.position){
+                    structural.push_back(describeChange(prefix + "position", active.position, reloaded.position));
+                }
+                if(active.vendorID != reloaded.vendorID){
+                    structural.push_back(prefix + "vendor_id: " + toHex(active.vendorID) + " -> " + toHex(reloaded.vendorID));
+                }
+                if(active.productCode != reloaded.productCode){
+                    structural.push_back(prefix + "product_code: " + toHex(active.productCode) + " -> " + toHex(reloaded.productCode));
+                }
+                if(active.layout != reloaded.layout && active.layout && reloaded.layout){
+                    if(auto difference = compareLayouts(*active.layout, *reloaded.layout)){
+                        structural.push_back(prefix + difference.value());
+                    }
+                }
+
+                // Startup SDOs are only downloaded when the slave is configured.
+                const bool hasActiveSdos = active.startupSdos && !active.startupSdos->empty();
+                const bool hasReloadedSdos = reloaded.startupSdos && !reloaded.startupSdos->empty();
+                if(hasActiveSdos != hasReloadedSdos || (hasActiveSdos && *active.startupSdos != *reloaded.startupSdos)){
+                    structural.push_back(prefix + "startup_sdos changed");
+                }
+
+                const auto& activeDC = active.distributedClockConfig;
+                const auto& reloadedDC = reloaded.distributedClockConfig;
+                if(activeDC.has_value() != reloadedDC.has_value()){
+                    structural.push_back(prefix + (reloadedDC ? "distributed clock enabled" : "distributed clock disabled"));
+                }
+                else if(activeDC){
+                    if(activeDC->assignActivate != reloadedDC->assignActivate){
+                        structural.push_back(prefix + "assign_activate: " + toHex(activeDC->assignActivate) + " -> " + toHex(reloadedDC->assignActivate));
+                    }
+                    if(activeDC->sync0Activate != reloadedDC->sync0Activate){
+                        structural.push_back(describeChange(prefix + "sync0_cycle", activeDC->sync0Activate, reloadedDC->sync0Activate));
+                    }
+                    if(activeDC->sync1Activate != reloadedDC->sync1Activate){
+                        structural.push_back(describeChange(prefix + "sync1_cycle", activeDC->sync1Activate, reloadedDC->sync1Activate));
+                    }
+                    // The slave only takes over new shift times when it is configured again.
+                    if(activeDC->sync0Shift != reloadedDC->sync0Shift){
+                        structural.push_back(describeChange(prefix + "sync0_shift", activeDC->sync0Shift, reloadedDC->sync0Shift) + " requires restart");
+                    }
+                    if(activeDC->sync1Shift != reloadedDC->sync1Shift){
+                        structural.push_back(describeChange(prefix + "sync1_shift", activeDC->sync1Shift, reloadedDC->sync1Shift) + " requires restart");
+                    }
+                    if(activeDC->isAppliedToSlave != reloadedDC->isAppliedToSlave){
+                        structural.push_back(prefix + (reloadedDC->isAppliedToSlave ? "apply_to_slave enabled" : "apply_to_slave disabled"));
+                    }
+                }
+
+                // Tuning of a slave that is changed structurally is not worth reporting.
+                if(diff.structuralChanges.size() != structuralBefore){
+                    continue;
+                }
+
+                if(!(active.tuning == reloaded.tuning)){
+                    diffTuning(prefix, active.tuning, reloaded.tuning, diff.tunableChanges);
+                    diff.retunedSlaves.push_back(i);
+                }
+            }
+
+            for(const auto& slaveInfo : active_config.slaveConfigurations)
+            {
+                if(matchedSlaves.count(slaveInfo.slaveName) == 0){
+                    diff.structuralChanges.push_back(slaveInfo.slaveName + ": slave removed");
+                }
+            }
+
+            return diff;
+        }
+
+    } // End of namespace parser
+} // End of namespace ec
@@ -0,0 +1,219 @@
+/**
+ * @file controller_bank.cpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ethercat_interface/driver/controller_bank.hpp"
+#include "ethercat_interface/entry_access.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace ec
+{
+    namespace motion
+    {
+
+        using ec::entry::readEntry;
+        using ec::entry::writeEntry;
+        using ec::entry::getTypeRange;
+
+        namespace
+        {
+
+            std::optional<ec::DataType> findEntryType(const ec::SlaveLayout& layout, const std::string& entry_name)
+            {
+                for(const auto* pdos : {&layout.rxPDOs, &layout.txPDOs})
+                {
+                    for(const auto& pdo : *pdos)
+                    {
+                        for(const auto& entry : pdo.entries)
+                        {
+                            if(entry.entryName == entry_name){
+                                return entry.type;
+                            }
+                        }
+                    }
+                }
+
+                return std::nullopt;
+            }
+
+        } // End of anonymous namespace
+
+        ControllerBank::ControllerBank(uint8_t* domain_data, const std::vector<ControllerEntries>& axes, double cycle_time)
+            : m_DomainData(domain_data),
+              m_Entries(axes),
+              m_CycleTime(cycle_time),
+              m_Kp(getPaddedSize(axes.size()), 0.0),
+              m_Ki(getPaddedSize(axes.size()), 0.0),
+              m_Kd(getPaddedSize(axes.size()), 0.0),
+              m_OutputMins(getPaddedSize(axes.size()), 0.0),
+              m_OutputMaxs(getPaddedSize(axes.size()), 0.0),
+              m_IntegralMins(getPaddedSize(axes.size()), 0.0),
+              m_IntegralMaxs(getPaddedSize(axes.size()), 0.0),
+              m_DerivativeFilters(getPaddedSize(axes.size()), 0.0),
+              m_EnableMasks(getPaddedSize(axes.size()), 0.0),
+              m_HoldMasks(getPaddedSize(axes.size()), 0.0),
+              m_Setpoints(getPaddedSize(axes.size()), 0.0),
+              m_FeedForwards(getPaddedSize(axes.size()), 0.0),
+              m_Actuals(getPaddedSize(axes.size()), 0.0),
+              m_PreviousActuals(getPaddedSize(axes.size()), 0.0),
+              m_Errors(getPaddedSize(axes.size()), 0.0),
+              m_Integrals(getPaddedSize(axes.size()), 0.0),
+              m_Derivatives(getPaddedSize(axes.size()), 0.0),
+              m_Outputs(getPaddedSize(axes.size()), 0.0)
+        {
+            for(std::size_t axis = 0; axis < axes.size(); axis++)
+            {
+                setGains(axis, PidGains{});
+            }
+        }
+
+        std::optional<ControllerBank> ControllerBank::fromDrivers(
+            const std::vector<ec::slave::Driver*>& drivers,
+            const std::string& actual_entry_name,
+            const std::string& output_entry_name,
+            double cycle_time
+        )
+        {
+            if(drivers.empty()){
+                return std::nullopt;
+            }
+
+            uint8_t* domainData = drivers.front()->getDomainDataPtr();
+            std::vector<ControllerEntries> axes;
+            axes.reserve(drivers.size());
+            for(auto* driver : drivers)
+            {
+                if(driver->getDomainDataPtr() != domainData){
+                    return std::nullopt;
+                }
+                const auto actualOffset = driver->getOffsetPtr(actual_entry_name);
+                const auto outputOffset = driver->getOffsetPtr(output_entry_name);
+                const auto actualType = findEntryType(driver->getLayout(), actual_entry_name);
+                const auto outputType = findEntryType(driver->getLayout(), output_entry_name);
+                if(!actualOffset || !outputOffset || !actualType || !outputType){
+                    return std::nullopt;
+                }
+                axes.push_back(ControllerEntries{
+                    *actualOffset.value(), actualType.value(), *outputOffset.value(), outputType.value(), driver->getStaleFlag()
+                });
+            }
+
+            return ControllerBank(domainData, axes, cycle_time);
+        }
+
+        void ControllerBank::setGains(std::size_t axis, const PidGains& gains)
+        {
+            m_Kp[axis] = gains.kp;
+            m_Ki[axis] = gains.ki;
+            m_Kd[axis] = gains.kd;
+            // The output limits are narrowed to the range of the entry, so the integral does not wind up against it either.
+            const auto [typeMin, typeMax] = getTypeRange(m_Entries[axis].outputType);
+            m_OutputMins[axis] = std::max(gains.outputMin, typeMin);
+            m_OutputMaxs[axis] = std::min(gains.outputMax, typeMax);
+            m_IntegralMins[axis] = gains.integralMin;
+            m_IntegralMaxs[axis] = gains.integralMax;
+            m_DerivativeFilters[axis] = gains.derivativeFilter;
+        }
+
+        void ControllerBank::setGains(const PidGains& gains)
+        {
+            for(std::size_t axis = 0; axis < size(); axis++)
+            {
+                setGains(axis, gains);
+            }
+        }
+
+        void ControllerBank::setEnabled(bool is_enabled)
+        {
+            std::fill(m_EnableMasks.begin(), m_EnableMasks.begin() + size(), is_enabled ? 1.0 : 0.0);
+        }
+
+        void ControllerBank::update()
+        {
+            const std::size_t axisCount = size();
+
+            // Gather: the only scattered reads of the cycle. A held axis keeps its last actual value.
+            for(std::size_t i = 0; i < axisCount; i++)
+            {
+                const bool isHeld = entry::isStale(m_Entries[i].staleFlag);
+                m_HoldMasks[i] = isHeld ? 1.0 : 0.0;
+                if(!isHeld){
+                    m_Actuals[i] = readEntry(m_DomainData + m_Entries[i].actualOffset, m_Entries[i].actualType);
+                }
+            }
+            if(!m_HasPreviousActuals){
+                m_PreviousActuals = m_Actuals;
+                m_HasPreviousActuals = true;
+            }
+
+            // The loops: branch free over arrays padded to whole blocks, so the compiler vectorizes each block.
+            const double cycleTime = m_CycleTime;
+            const double inverseCycleTime = cycleTime > 0.0 ? 1.0 / cycleTime : 0.0;
+            const double* kp = m_Kp.data();
+            const double* ki = m_Ki.data();
+            const double* kd = m_Kd.data();
+            const double* outputMins = m_OutputMins.data();
+            const double* outputMaxs = m_OutputMaxs.data();
+            const double* integralMins = m_IntegralMins.data();
+            const double* integralMaxs = m_IntegralMaxs.data();
+            const double* derivativeFilters = m_DerivativeFilters.data();
+            const double* enableMasks = m_EnableMasks.data();
+            const double* holdMasks = m_HoldMasks.data();
+            const double* setpoints = m_Setpoints.data();
+            const double* feedForwards = m_FeedForwards.data();
+            const double* actuals = m_Actuals.data();
+            double* previousActuals = m_PreviousActuals.data();
+            double* errors = m_Errors.data();
+            double* integrals = m_Integrals.data();
+            double* derivatives = m_Derivatives.data();
+            double* outputs = m_Outputs.data();
+            for(std::size_t block = 0; block < m_EnableMasks.size(); block += BlockSize)
+            {
+#pragma GCC ivdep
+                for(std::size_t i = block; i < block + BlockSize; i++)
+                {
+                    const double error = setpoints[i] - actuals[i];
+                    const double rate = (previousActuals[i] - actuals[i]) * inverseCycleTime;
+                    const double derivative = derivativeFilters[i] * derivatives[i] + (1.0 - derivativeFilters[i]) * rate;
+                    const double integral = integrals[i] + ki[i] * error * cycleTime;
+
+                    const double unsaturated = feedForwards[i] + kp[i] * error + integral + kd[i] * derivative;
+                    const double output = std::min(std::max(unsaturated, outputMins[i]), outputMaxs[i]);
+
+                    // Anti-windup: the integral is frozen while the output saturates in the direction the error pushes it.
+                    const bool isWindingUp = ((unsaturated > outputMaxs[i]) & (error > 0.0)) | ((unsaturated < outputMins[i]) & (error < 0.0));
+                    const double nextIntegral = std::min(std::max(isWindingUp ? integrals[i] : integral, integralMins[i]), integralMaxs[i]);
+
+                    // A held axis keeps its states, blended by the hold mask so the block stays branch free.
+                    const double mask = enableMasks[i];
+                    const double hold = holdMasks[i];
+                    const double update = 1.0 - hold;
+                    errors[i] = hold * errors[i] + update * error;
+                    integrals[i] = hold * integrals[i] + update * nextIntegral * mask;
+                    derivatives[i] = hold * derivatives[i] + update * derivative * mask;
+                    outputs[i] = hold * outputs[i] + update * output * mask;
+                    previousActuals[i] = actuals[i];
+                }
+            }
+
+            // Scatter.
+            for(std::size_t i = 0; i < axisCount; i++)
+            {
+                if(m_EnableMasks[i] != 0.0 && m_HoldMasks[i] == 0.0){
+                    writeEntry(m_DomainData + m_Entries[i].outputOffset, m_Entries[i].outputType, m_Outputs[i]);
+                }
+            }
+        }
+
+    } // End of namespace motion
+} // End of namespace ec
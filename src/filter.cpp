@@ -0,0 +1,246 @@
+/**
+ * @file filter.cpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ethercat_interface/filter.hpp"
+#include "ethercat_interface/entry_access.hpp"
+
+#include <algorithm>
+
+namespace ec
+{
+    namespace filter
+    {
+
+        using entry::readEntry;
+
+        FilterBank::FilterBank(const uint8_t* domain_data, const std::vector<FilteredEntry>& entries)
+            : m_DomainData(domain_data), m_Entries(entries), m_Values(entries.size(), 0.0)
+        {
+            std::size_t historySize = 0;
+            for(std::size_t i = 0; i < entries.size(); i++)
+            {
+                const EntryFilter& filter = entries[i].filter;
+                switch (filter.type)
+                {
+                case FilterType::Biquad:
+                    m_BiquadEntries.push_back(i);
+                    break;
+                case FilterType::MovingAverage:
+                    m_AverageEntries.push_back(i);
+                    m_HistoryStarts.push_back(historySize);
+                    m_Windows.push_back(std::max<uint16_t>(1, filter.window));
+                    historySize += m_Windows.back();
+                    break;
+                case FilterType::Median3:
+                    m_MedianEntries.push_back(i);
+                    break;
+                default:
+                    break;
+                }
+            }
+
+            // Padding entries have zero coefficients and stay at zero.
+            const std::size_t biquadCount = getPaddedSize(m_BiquadEntries.size());
+            for(auto* coefficients : {&m_B0, &m_B1, &m_B2, &m_A1, &m_A2, &m_Z1, &m_Z2, &m_BiquadInputs, &m_BiquadOutputs})
+            {
+                coefficients->assign(biquadCount, 0.0);
+            }
+            for(std::size_t i = 0; i < m_BiquadEntries.size(); i++)
+            {
+                const auto& coefficients = entries[m_BiquadEntries[i]].filter.coefficients;
+                m_B0[i] = coefficients[0];
+                m_B1[i] = coefficients[1];
+                m_B2[i] = coefficients[2];
+                m_A1[i] = coefficients[3];
+                m_A2[i] = coefficients[4];
+            }
+
+            m_HistoryPositions.assign(m_AverageEntries.size(), 0);
+            m_History.assign(historySize, 0.0);
+            m_Sums.assign(m_AverageEntries.size(), 0.0);
+
+            const std::size_t medianCount = getPaddedSize(m_MedianEntries.size());
+            for(auto* values : {&m_Previous1, &m_Previous2, &m_MedianInputs, &m_MedianOutputs})
+            {
+                values->assign(medianCount, 0.0);
+            }
+
+            m_HeldBiquads.reserve(m_BiquadEntries.size());
+            m_HeldZ1.assign(m_BiquadEntries.size(), 0.0);
+            m_HeldZ2.assign(m_BiquadEntries.size(), 0.0);
+            m_HeldMedians.reserve(m_MedianEntries.size());
+            m_HeldPrevious1.assign(m_MedianEntries.size(), 0.0);
+            m_HeldPrevious2.assign(m_MedianEntries.size(), 0.0);
+        }
+
+        void FilterBank::update()
+        {
+            // Gather, the only scattered reads of the cycle. The blocks run for the stale entries too,
+            // their states are restored afterwards.
+            m_HeldBiquads.clear();
+            for(std::size_t i = 0; i < m_BiquadEntries.size(); i++)
+            {
+                if(isHeld(m_BiquadEntries[i])){
+                    m_HeldBiquads.push_back(i);
+                    continue;
+                }
+                const FilteredEntry& entry = m_Entries[m_BiquadEntries[i]];
+                m_BiquadInputs[i] = readEntry(m_DomainData + entry.offset, entry.type);
+            }
+            m_HeldMedians.clear();
+            for(std::size_t i = 0; i < m_MedianEntries.size(); i++)
+            {
+                if(isHeld(m_MedianEntries[i])){
+                    m_HeldMedians.push_back(i);
+                    continue;
+                }
+                const FilteredEntry& entry = m_Entries[m_MedianEntries[i]];
+                m_MedianInputs[i] = readEntry(m_DomainData + entry.offset, entry.type);
+            }
+            if(!m_IsPrimed){
+                prime();
+            }
+            for(std::size_t held = 0; held < m_HeldBiquads.size(); held++)
+            {
+                m_HeldZ1[held] = m_Z1[m_HeldBiquads[held]];
+                m_HeldZ2[held] = m_Z2[m_HeldBiquads[held]];
+            }
+            for(std::size_t held = 0; held < m_HeldMedians.size(); held++)
+            {
+                m_HeldPrevious1[held] = m_Previous1[m_HeldMedians[held]];
+                m_HeldPrevious2[held] = m_Previous2[m_HeldMedians[held]];
+            }
+
+            const double* b0 = m_B0.data();
+            const double* b1 = m_B1.data();
+            const double* b2 = m_B2.data();
+            const double* a1 = m_A1.data();
+            const double* a2 = m_A2.data();
+            const double* biquadInputs = m_BiquadInputs.data();
+            double* z1 = m_Z1.data();
+            double* z2 = m_Z2.data();
+            double* biquadOutputs = m_BiquadOutputs.data();
+            // GCC fully unrolls a block of four before the loop vectorizer runs and then leaves it scalar,
+            // so the blocks are kept as loops.
+            for(std::size_t block = 0; block < m_BiquadOutputs.size(); block += BlockSize)
+            {
+#pragma GCC ivdep
+#pragma GCC unroll 1
+                for(std::size_t i = block; i < block + BlockSize; i++)
+                {
+                    const double x = biquadInputs[i];
+                    const double y = b0[i] * x + z1[i];
+                    z1[i] = b1[i] * x - a1[i] * y + z2[i];
+                    z2[i] = b2[i] * x - a2[i] * y;
+                    biquadOutputs[i] = y;
+                }
+            }
+
+            const double* medianInputs = m_MedianInputs.data();
+            double* previous1 = m_Previous1.data();
+            double* previous2 = m_Previous2.data();
+            double* medianOutputs = m_MedianOutputs.data();
+            for(std::size_t block = 0; block < m_MedianOutputs.size(); block += BlockSize)
+            {
+#pragma GCC ivdep
+#pragma GCC unroll 1
+                for(std::size_t i = block; i < block + BlockSize; i++)
+                {
+                    const double x = medianInputs[i];
+                    medianOutputs[i] = std::max(std::min(x, previous1[i]), std::min(std::max(x, previous1[i]), previous2[i]));
+                    previous2[i] = previous1[i];
+                    previous1[i] = x;
+                }
+            }
+
+            for(std::size_t held = 0; held < m_HeldBiquads.size(); held++)
+            {
+                const std::size_t i = m_HeldBiquads[held];
+                m_Z1[i] = m_HeldZ1[held];
+                m_Z2[i] = m_HeldZ2[held];
+                m_BiquadOutputs[i] = m_Values[m_BiquadEntries[i]];
+            }
+            for(std::size_t held = 0; held < m_HeldMedians.size(); held++)
+            {
+                const std::size_t i = m_HeldMedians[held];
+                m_Previous1[i] = m_HeldPrevious1[held];
+                m_Previous2[i] = m_HeldPrevious2[held];
+                m_MedianOutputs[i] = m_Values[m_MedianEntries[i]];
+            }
+
+            // The running sums are recomputed from the history once per window, so rounding errors do not add up.
+            for(std::size_t i = 0; i < m_AverageEntries.size(); i++)
+            {
+                if(isHeld(m_AverageEntries[i])){
+                    continue;
+                }
+                const FilteredEntry& entry = m_Entries[m_AverageEntries[i]];
+                const double x = readEntry(m_DomainData + entry.offset, entry.type);
+                double* history = m_History.data() + m_HistoryStarts[i];
+                uint16_t& position = m_HistoryPositions[i];
+                m_Sums[i] += x - history[position];
+                history[position] = x;
+                if(++position == m_Windows[i]){
+                    position = 0;
+                    double sum = 0.0;
+                    for(uint16_t j = 0; j < m_Windows[i]; j++)
+                    {
+                        sum += history[j];
+                    }
+                    m_Sums[i] = sum;
+                }
+                m_Values[m_AverageEntries[i]] = m_Sums[i] / m_Windows[i];
+            }
+
+            // Scatter.
+            for(std::size_t i = 0; i < m_BiquadEntries.size(); i++)
+            {
+                m_Values[m_BiquadEntries[i]] = m_BiquadOutputs[i];
+            }
+            for(std::size_t i = 0; i < m_MedianEntries.size(); i++)
+            {
+                m_Values[m_MedianEntries[i]] = m_MedianOutputs[i];
+            }
+        }
+
+        void FilterBank::prime()
+        {
+            // A biquad fed x for ever outputs its DC gain times x, the states are set to that steady state.
+            for(std::size_t i = 0; i < m_BiquadEntries.size(); i++)
+            {
+                const double x = m_BiquadInputs[i];
+                const double denominator = 1.0 + m_A1[i] + m_A2[i];
+                const double gain = denominator != 0.0 ? (m_B0[i] + m_B1[i] + m_B2[i]) / denominator : 1.0;
+                const double y = gain * x;
+                m_Z1[i] = y - m_B0[i] * x;
+                m_Z2[i] = m_B2[i] * x - m_A2[i] * y;
+            }
+
+            for(std::size_t i = 0; i < m_MedianEntries.size(); i++)
+            {
+                m_Previous1[i] = m_MedianInputs[i];
+                m_Previous2[i] = m_MedianInputs[i];
+            }
+
+            for(std::size_t i = 0; i < m_AverageEntries.size(); i++)
+            {
+                const FilteredEntry& entry = m_Entries[m_AverageEntries[i]];
+                const double x = readEntry(m_DomainData + entry.offset, entry.type);
+                std::fill_n(m_History.begin() + m_HistoryStarts[i], m_Windows[i], x);
+                m_HistoryPositions[i] = 0;
+                m_Sums[i] = x * m_Windows[i];
+            }
+
+            m_IsPrimed = true;
+        }
+
+    } // End of namespace filter
+} // End of namespace ec
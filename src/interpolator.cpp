@@ -0,0 +1,189 @@
+/**
+ * @file interpolator.cpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ethercat_interface/driver/interpolator.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ec
+{
+    namespace motion
+    {
+
+        Setpoint interpolate(const Waypoint& from, const Waypoint& to, uint64_t time_ns, InterpolationMode mode)
+        {
+            if(to.timeNs <= from.timeNs){
+                return Setpoint{to.position, 0.0};
+            }
+
+            const double duration = (double)(to.timeNs - from.timeNs) * 1e-9;
+            const double elapsed = time_ns <= from.timeNs ? 0.0 : std::min((double)(time_ns - from.timeNs) * 1e-9, duration);
+            const double s = elapsed / duration;
+            const double distance = to.position - from.position;
+
+            switch (mode)
+            {
+            case InterpolationMode::Linear:
+                return Setpoint{from.position + distance * s, distance / duration};
+            case InterpolationMode::CubicHermite:
+            {
+                const double s2 = s * s;
+                const double s3 = s2 * s;
+                const double position = (2.0 * s3 - 3.0 * s2 + 1.0) * from.position
+                    + (s3 - 2.0 * s2 + s) * duration * from.velocity
+                    + (-2.0 * s3 + 3.0 * s2) * to.position
+                    + (s3 - s2) * duration * to.velocity;
+                const double velocity = ((6.0 * s2 - 6.0 * s) * from.position
+                    + (3.0 * s2 - 4.0 * s + 1.0) * duration * from.velocity
+                    + (-6.0 * s2 + 6.0 * s) * to.position
+                    + (3.0 * s2 - 2.0 * s) * duration * to.velocity) / duration;
+                return Setpoint{position, velocity};
+            }
+            case InterpolationMode::Quintic:
+            {
+                const double t = duration;
+                const double t2 = t * t;
+                const double c2 = from.acceleration / 2.0;
+                const double c3 = (20.0 * distance - (8.0 * to.velocity + 12.0 * from.velocity) * t
+                    - (3.0 * from.acceleration - to.acceleration) * t2) / (2.0 * t2 * t);
+                const double c4 = (-30.0 * distance + (14.0 * to.velocity + 16.0 * from.velocity) * t
+                    + (3.0 * from.acceleration - 2.0 * to.acceleration) * t2) / (2.0 * t2 * t2);
+                const double c5 = (12.0 * distance - 6.0 * (to.velocity + from.velocity) * t
+                    + (to.acceleration - from.acceleration) * t2) / (2.0 * t2 * t2 * t);
+                const double x = elapsed;
+                const double position = from.position + x * (from.velocity + x * (c2 + x * (c3 + x * (c4 + x * c5))));
+                const double velocity = from.velocity + x * (2.0 * c2 + x * (3.0 * c3 + x * (4.0 * c4 + x * 5.0 * c5)));
+                return Setpoint{position, velocity};
+            }
+            default:
+                return Setpoint{to.position, 0.0};
+            }
+        }
+
+        Interpolator::Interpolator(
+            uint8_t* domain_data,
+            uint32_t position_offset,
+            std::optional<uint32_t> velocity_offset,
+            std::size_t queue_capacity
+        )
+            : m_DomainData(domain_data),
+              m_PositionOffset(position_offset),
+              m_VelocityOffset(velocity_offset),
+              // One slot stays empty to tell a full ring from an empty one.
+              m_QueueSlots(std::max<std::size_t>(1, queue_capacity) + 1),
+              m_Queue(std::make_unique<Waypoint[]>(m_QueueSlots))
+        {
+
+        }
+
+        std::unique_ptr<Interpolator> Interpolator::fromDriver(
+            ec::slave::Driver* driver,
+            const std::string& position_entry_name,
+            const std::string& velocity_entry_name,
+            std::size_t queue_capacity
+        )
+        {
+            if(!driver || !driver->getDomainDataPtr()){
+                return nullptr;
+            }
+
+            const auto positionOffset = driver->getOffsetPtr(position_entry_name);
+            if(!positionOffset){
+                return nullptr;
+            }
+
+            std::optional<uint32_t> velocityOffset;
+            if(const auto found = driver->getOffsetPtr(velocity_entry_name)){
+                velocityOffset = *found.value();
+            }
+
+            return std::make_unique<Interpolator>(
+                driver->getDomainDataPtr(),
+                *positionOffset.value(),
+                velocityOffset,
+                queue_capacity
+            );
+        }
+
+        bool Interpolator::pushWaypoint(const Waypoint& waypoint)
+        {
+            if(waypoint.timeNs < m_LastPushedTime){
+                return false;
+            }
+
+            const std::size_t head = m_QueueHead.load(std::memory_order_relaxed);
+            const std::size_t nextHead = (head + 1) % m_QueueSlots;
+            if(nextHead == m_QueueTail.load(std::memory_order_acquire)){
+                m_DroppedWaypoints.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            m_Queue[head] = waypoint;
+            m_LastPushedTime = waypoint.timeNs;
+            m_QueueHead.store(nextHead, std::memory_order_release);
+
+            return true;
+        }
+
+        bool Interpolator::popWaypoint(Waypoint& waypoint)
+        {
+            const std::size_t tail = m_QueueTail.load(std::memory_order_relaxed);
+            if(tail == m_QueueHead.load(std::memory_order_acquire)){
+                return false;
+            }
+
+            waypoint = m_Queue[tail];
+            m_QueueTail.store((tail + 1) % m_QueueSlots, std::memory_order_release);
+
+            return true;
+        }
+
+        bool Interpolator::update(uint64_t time_ns)
+        {
+            const uint64_t time = (uint64_t)((int64_t)time_ns + m_TimeOffset);
+
+            if(!m_HasWaypoint){
+                if(!popWaypoint(m_To)){
+                    return false;
+                }
+                // Held until the time of the first waypoint.
+                m_From = m_To;
+                m_HasWaypoint = true;
+            }
+
+            Waypoint next;
+            while(time >= m_To.timeNs && popWaypoint(next))
+            {
+                m_From = m_To;
+                m_To = next;
+            }
+
+            if(time > m_To.timeNs){
+                // Starved: hold the position, the next segment starts from here instead of from the stale waypoint.
+                m_To = Waypoint{time, m_To.position, 0.0, 0.0};
+                m_From = m_To;
+                m_StarvedCycles.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            m_Setpoint = interpolate(m_From, m_To, time, m_Mode);
+
+            // The entries are 32 bit, positions beyond their range wrap like the drive's position counter.
+            EC_WRITE_S32(m_DomainData + m_PositionOffset, (int32_t)(uint32_t)std::llround(m_Setpoint.position));
+            if(m_VelocityOffset){
+                EC_WRITE_S32(m_DomainData + m_VelocityOffset.value(), (int32_t)std::llround(m_Setpoint.velocity * m_VelocityFactor));
+            }
+
+            return true;
+        }
+
+    } // End of namespace motion
+} // End of namespace ec
@@ -0,0 +1,129 @@
+/**
+ * @file limit.cpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ethercat_interface/limit.hpp"
+#include "ethercat_interface/entry_access.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace ec
+{
+    namespace limit
+    {
+
+        using entry::readEntry;
+        using entry::writeEntry;
+        using entry::getTypeRange;
+
+        LimitStage::LimitStage(uint8_t* domain_data, const std::vector<LimitedEntry>& entries)
+            : m_DomainData(domain_data),
+              m_Entries(entries),
+              m_Mins(getPaddedSize(entries.size()), 0.0),
+              m_Maxs(getPaddedSize(entries.size()), 0.0),
+              m_MaxSteps(getPaddedSize(entries.size()), 0.0),
+              m_EnableMasks(getPaddedSize(entries.size()), 0.0),
+              m_HoldMasks(getPaddedSize(entries.size()), 0.0),
+              m_Values(getPaddedSize(entries.size()), 0.0),
+              m_PreviousValues(getPaddedSize(entries.size()), 0.0),
+              m_Outputs(getPaddedSize(entries.size()), 0.0),
+              m_ClampFlags(getPaddedSize(entries.size()), 0.0),
+              m_ClampCounts(std::make_unique<std::atomic<uint64_t>[]>(entries.size()))
+        {
+            for(std::size_t i = 0; i < entries.size(); i++)
+            {
+                // The range is narrowed to the entry type, so a clamped value always fits the entry.
+                const auto [typeMin, typeMax] = getTypeRange(entries[i].type);
+                m_Mins[i] = std::max(entries[i].limit.min, typeMin);
+                m_Maxs[i] = std::min(entries[i].limit.max, typeMax);
+                m_MaxSteps[i] = entries[i].limit.maxStep;
+                m_EnableMasks[i] = 1.0;
+            }
+        }
+
+        std::optional<std::size_t> LimitStage::findEntry(const std::string& name) const
+        {
+            for(std::size_t i = 0; i < m_Entries.size(); i++)
+            {
+                if(m_Entries[i].name == name){
+                    return i;
+                }
+            }
+
+            return std::nullopt;
+        }
+
+        void LimitStage::apply()
+        {
+            const std::size_t entryCount = size();
+
+            // Gather.
+            for(std::size_t i = 0; i < entryCount; i++)
+            {
+                m_Values[i] = readEntry(m_DomainData + m_Entries[i].offset, m_Entries[i].type);
+                m_HoldMasks[i] = entry::isStale(m_Entries[i].staleFlag) ? 1.0 : 0.0;
+            }
+            if(!m_HasPreviousValues){
+                std::copy(m_Values.cbegin(), m_Values.cend(), m_PreviousValues.begin());
+                m_HasPreviousValues = true;
+            }
+
+            // Clamp, branch free over arrays padded to whole blocks. Each block stays a loop, once GCC unrolls it
+            // the vectorizer does not pick it up.
+            const double* mins = m_Mins.data();
+            const double* maxs = m_Maxs.data();
+            const double* maxSteps = m_MaxSteps.data();
+            const double* enableMasks = m_EnableMasks.data();
+            const double* holdMasks = m_HoldMasks.data();
+            const double* values = m_Values.data();
+            double* previousValues = m_PreviousValues.data();
+            double* outputs = m_Outputs.data();
+            double* clampFlags = m_ClampFlags.data();
+            for(std::size_t block = 0; block < m_Values.size(); block += BlockSize)
+            {
+#pragma GCC ivdep
+#pragma GCC unroll 1
+                for(std::size_t i = block; i < block + BlockSize; i++)
+                {
+                    const double lowest = std::max(mins[i], previousValues[i] - maxSteps[i]);
+                    const double highest = std::min(maxs[i], previousValues[i] + maxSteps[i]);
+                    // A NaN written to a floating point entry is replaced by the previous value.
+                    const double value = values[i] == values[i] ? values[i] : previousValues[i];
+                    const double clamped = std::max(lowest, std::min(value, highest));
+                    const double limited = enableMasks[i] != 0.0 ? clamped : values[i];
+                    const double output = holdMasks[i] != 0.0 ? previousValues[i] : limited;
+                    outputs[i] = output;
+                    clampFlags[i] = output != values[i] ? 1.0 : 0.0;
+                    previousValues[i] = output;
+                }
+            }
+
+            // Only the clamped and held entries are written back, so the branch is almost never taken.
+            uint64_t clampCount = 0;
+            for(std::size_t i = 0; i < entryCount; i++)
+            {
+                if(m_ClampFlags[i] != 0.0){
+                    writeEntry(m_DomainData + m_Entries[i].offset, m_Entries[i].type, m_Outputs[i]);
+                    if(m_HoldMasks[i] != 0.0){
+                        continue;
+                    }
+                    m_ClampCounts[i].store(m_ClampCounts[i].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                    clampCount++;
+                }
+            }
+            if(clampCount != 0){
+                m_TotalClampCount.store(m_TotalClampCount.load(std::memory_order_relaxed) + clampCount, std::memory_order_relaxed);
+            }
+        }
+
+    } // End of namespace limit
+} // End of namespace ec
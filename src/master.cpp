@@ -11,12 +11,63 @@
 
 #include "ethercat_interface/master.hpp"
 
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+#include <thread>
+
+#include <pthread.h>
+
 using namespace ec;
 
+namespace
+{
+    /**
+     * @brief Runs function(i) for every i in [0, task_count) on up to thread_count threads, the calling thread included.
+     * 
+     * @return false If any of the calls returned false.
+     */
+    template<typename Function>
+    bool runInParallel(std::size_t task_count, std::size_t thread_count, Function function)
+    {
+        std::atomic<std::size_t> nextTask{0};
+        std::atomic<bool> allSucceeded{true};
+        auto worker = [&](){
+            for(std::size_t task = nextTask.fetch_add(1); task < task_count; task = nextTask.fetch_add(1))
+            {
+                if(!function(task)){
+                    allSucceeded.store(false);
+                }
+            }
+        };
+
+        std::vector<std::thread> workers;
+        const std::size_t workerCount = std::min(thread_count, task_count);
+        for(std::size_t i = 1; i < workerCount; i++)
+        {
+            workers.emplace_back(worker);
+        }
+        worker();
+        for(auto& workerThread : workers)
+        {
+            workerThread.join();
+        }
+
+        return allSucceeded.load();
+    }
+
+    /**
+     * @brief Time the start and stop functions of the recorder, replay and capture wait for a cycle boundary.
+     * 
+     */
+    constexpr std::chrono::milliseconds StreamHandoverTimeout{1000};
+}
+
 Domain::Domain()
 {
     domainPtr = nullptr;
     domainDataPtr = nullptr;
+    domainSize = 0;
     domainEntries = nullptr;
 }
 
@@ -45,6 +96,7 @@ bool Domain::createDomainData()
     if(!domainDataPtr){
         return false;
     }
+    domainSize = ecrt_domain_size(domainPtr);
     return true;
 }
 
@@ -62,27 +114,41 @@ Master::Master(const std::string& config_file_path)
 
 Master::~Master()
 {
-    ecrt_master_deactivate_slaves(m_MasterPtr);
-    ecrt_master_deactivate(m_MasterPtr);
+    stop();
+    stopRecording();
+    stopReplay();
+    stopCapture();
+    m_IsDeliveringSdoResults.store(false);
+    if(m_SdoCompletionThread.joinable()){
+        m_SdoCompletionThread.join();
+    }
+    delete m_PendingUpdate.exchange(nullptr);
+    delete m_RetiredUpdate.exchange(nullptr);
+    delete m_ActiveUpdate;
+    delete m_PendingStreams.exchange(nullptr);
+    delete m_RetiredStreams.exchange(nullptr);
+    delete m_ActiveStreams;
+    if(m_MasterPtr){
+        ecrt_master_deactivate_slaves(m_MasterPtr);
+        ecrt_master_deactivate(m_MasterPtr);
+        ecrt_release_master(m_MasterPtr);
+    }
+
+    // The master copies the tables while configuring, nothing references them after deactivation.
+    m_TableArena.release();
 }
 
 bool Master::init()
 {
     bool initOK = true;
 
-    m_MasterPtr = ecrt_request_master(0);
-    if(!m_MasterPtr){
-        return false;
-    }
-    //std::cout << "Requested master\n";
-
     if(m_PathToConfigurationFile.empty()){
         return false;
     }
 
     //std::cout << "Got config file\n";
 
-    const auto programConfigOpt = ec::parser::parseConfigFile(m_PathToConfigurationFile);
+    const auto programConfigOpt = ec::parser::parseConfigFileCached(m_PathToConfigurationFile, "", &m_ConfigHash);
     if(!programConfigOpt){
         return false;
     }
@@ -91,13 +157,30 @@ bool Master::init()
 
     m_ProgramConfiguration = programConfigOpt.value();
 
+    // The configuration selects the master, so each Master object can drive its own network interface.
+    m_MasterPtr = ecrt_request_master(m_ProgramConfiguration.masterIndex);
+    if(!m_MasterPtr){
+        return false;
+    }
+    //std::cout << "Requested master\n";
+
+    initOK = checkTopology();
+    if(!initOK){
+        return false;
+    }
+
 
     initOK = registerSlaves();
     if(!initOK){
         return false;
     }
     
-    if(m_RegisteredSlaves.empty()){
+    if(m_Slaves.empty()){
+        return false;
+    }
+
+    initOK = buildSlaveTables();
+    if(!initOK){
         return false;
     }
 
@@ -117,10 +200,10 @@ bool Master::init()
     
     if(isDcEnabledForAnyOfTheSlaves){
         m_IsDistributedClockEnabled = true;
-        m_TaskTimer = std::make_unique<CyclicTaskTimerDC>();
+        m_TaskTimer = std::make_unique<CyclicTaskTimerDC>((int64_t)m_ProgramConfiguration.cyclePeriod * 1000);
     }
     else if(m_ProgramConfiguration.cyclePeriod != 0){
-        m_TaskTimer = std::make_unique<CyclicTaskTimer>();
+        m_TaskTimer = std::make_unique<CyclicTaskTimer>((int64_t)m_ProgramConfiguration.cyclePeriod * 1000);
     }
 
 
@@ -135,10 +218,24 @@ bool Master::init()
     if(!initOK){
         return false;
     }
+
+    for(Slave* slave : m_SlaveList)
+    {
+        if(auto sdoEngine = slave->getSdoEngine()){
+            m_SdoEngines.push_back(sdoEngine);
+        }
+    }
+    if(!m_SdoEngines.empty()){
+        m_IsDeliveringSdoResults.store(true);
+        m_SdoCompletionThread = std::thread(&Master::sdoCompletionTask, this);
+    }
     
     //std::cout << "Initialized slaves\n";
 
     initOK = registerDomainEntries();
+    if(!initOK){
+        return false;
+    }
 
     //std::cout << "Registered domain entries\n";
 
@@ -150,6 +247,10 @@ bool Master::init()
             //std::cout << "Domain pointer is nullptr\n";
             break;
         }
+        if(m_IsFastRestart && registerCachedOffsets(name, domain)){
+            continue;
+        }
+        // Entries registered by registerCachedOffsets() keep the offsets they were given.
         if(domain.registerPDOs()){
             isRegisteringPDOsOk = false;
             break;
@@ -182,25 +283,103 @@ bool Master::init()
         return creatingDomainDataOk;
     }
 
-    for(auto domainMapIter = m_Domains.begin(); domainMapIter != m_Domains.end(); domainMapIter++)
+    for(Slave* slave : m_SlaveList)
     {
-        for(const auto& str : (*domainMapIter).second.domainSlaves)
-        {   
-            auto foundSlave = m_RegisteredSlaves.find(str);
-            if(foundSlave == m_RegisteredSlaves.end()){
-                continue;
-            }
-
-            (*foundSlave).second->setDomainDataPtr((*domainMapIter).second.domainDataPtr);
+        slave->setDomainDataPtr(m_Domains.at(slave->getSlaveInfo().domainName).domainDataPtr);
+        if(!slave->setupSampleArrays()){
+            std::cout << "Samples of an array entry of " << slave->getSlaveInfo().slaveName << " are not contiguous in the domain\n";
+            return false;
         }
     }
 
+    setupHealthMonitoring();
+
+    setupFilters();
+
+    setupLimits();
+
+    setupTimestamps();
+
     //std::cout << "Created domain data\n";
 
+    updateTopologySnapshot();
+
     return initOK;
 
 }
 
+bool Master::start()
+{
+    if(!m_MasterPtr || !m_TaskTimer || m_ProgramConfiguration.cyclePeriod == 0 || m_CyclicThread.joinable()){
+        return false;
+    }
+
+    if(m_ProgramConfiguration.alignCycles){
+        m_TaskTimer->initAligned((int64_t)m_ProgramConfiguration.cycleOffset * 1000);
+    }
+    else{
+        m_TaskTimer->init();
+    }
+
+    m_IsCycling.store(true);
+    m_CyclicThread = std::thread(&Master::cyclicTask, this);
+
+    if(m_ProgramConfiguration.cpuCore >= 0){
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        if(m_ProgramConfiguration.cpuCore >= CPU_SETSIZE){
+            stop();
+            return false;
+        }
+        CPU_SET(m_ProgramConfiguration.cpuCore, &cpuSet);
+        if(pthread_setaffinity_np(m_CyclicThread.native_handle(), sizeof(cpuSet), &cpuSet) != 0){
+            stop();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+uint64_t Master::getApplicationTime() const
+{
+    if(!m_TaskTimer){
+        return 0;
+    }
+
+    return timespectoNanoSec(m_TaskTimer->getWakeupTime());
+}
+
+void Master::stop()
+{
+    m_IsCycling.store(false);
+    if(m_CyclicThread.joinable()){
+        m_CyclicThread.join();
+    }
+}
+
+void Master::cyclicTask()
+{
+    while(m_IsCycling.load(std::memory_order_relaxed))
+    {
+        m_TaskTimer->sleep();
+
+        receive();
+        for(const auto& [name, domain] : m_Domains)
+        {
+            receiveDomainData(name);
+        }
+
+        update();
+
+        for(const auto& [name, domain] : m_Domains)
+        {
+            sendDomainData(name);
+        }
+        send();
+    }
+}
+
 void Master::update()
 {   
 
@@ -226,232 +405,356 @@ void Master::setUpdateFunction(UpdateFunction update_function)
     m_UpdateFunction = std::move(update_function);
 }
 
-void Master::setCommunicationInterface(CommunicationInterface* interface)
+void Master::setSlaveStateCallback(SlaveStateCallback slave_state_callback)
 {
-    m_CommunicationInterface = interface;
+    m_SlaveStateCallback = std::move(slave_state_callback);
 }
 
-bool Master::registerSlave(Slave& slave)
+void Master::setCommunicationInterface(CommunicationInterface* interface)
 {
-    const std::string slaveName = slave.getSlaveInfo().slaveName;
-    const auto slaveFound = m_RegisteredSlaves.find(slaveName);
-    if(slaveFound != m_RegisteredSlaves.end()){
-        return false;
-    }
-    m_RegisteredSlaves[slaveName] = new Slave(std::move(slave));
-    return true;
+    m_CommunicationInterface = interface;
 }
 
 bool Master::registerSlaves()
 {
-
-    const std::size_t numOfSlaves = m_ProgramConfiguration.slaveConfigurations.size();
-    bool slavesRegistered = true;
-
-    for(std::vector<SlaveInfo>::const_iterator slaveIter = m_ProgramConfiguration.slaveConfigurations.begin(); slaveIter < m_ProgramConfiguration.slaveConfigurations.cend(); slaveIter++)
+    const auto& slaveConfigs = m_ProgramConfiguration.slaveConfigurations;
+
+    // Slaves addressed through the same alias are next to each other on the bus.
+    std::vector<std::size_t> busOrder(slaveConfigs.size());
+    std::iota(busOrder.begin(), busOrder.end(), 0);
+    std::stable_sort(busOrder.begin(), busOrder.end(), [&slaveConfigs](std::size_t lhs, std::size_t rhs){
+        return std::tie(slaveConfigs[lhs].alias, slaveConfigs[lhs].position) < std::tie(slaveConfigs[rhs].alias, slaveConfigs[rhs].position);
+    });
+
+    m_SlaveList.clear();
+    m_SlaveIndices.clear();
+    m_Slaves.clear();
+    m_Slaves.reserve(slaveConfigs.size());
+    for(const std::size_t configIndex : busOrder)
     {
-        const auto& slaveConfig = *slaveIter;
-        const auto slaveType = slaveConfig.slaveType;
-        switch (slaveType)
+        const auto& slaveConfig = slaveConfigs[configIndex];
+        if(!m_SlaveIndices.emplace(slaveConfig.slaveName, m_Slaves.size()).second){
+            return false;
+        }
+
+        switch (slaveConfig.slaveType)
         {
         case SlaveType::Driver :
-        {
-            slave::Driver driverSlave(slaveConfig);
-            slavesRegistered = registerSlave(driverSlave);
+            m_Slaves.emplace_back(std::in_place_type<slave::Driver>, slaveConfig);
             break;
-        }
         case SlaveType::IO :
-        {
-            slave::IO ioSlave(slaveConfig);
-            slavesRegistered = registerSlave(ioSlave);
+            m_Slaves.emplace_back(std::in_place_type<slave::IO>, slaveConfig);
             break;
-        }
         case SlaveType::PLC :
-        {
-            slave::PLC plcSlave(slaveConfig);
-            slavesRegistered = registerSlave(plcSlave); 
+            m_Slaves.emplace_back(std::in_place_type<slave::PLC>, slaveConfig);
             break;
-        }
         case SlaveType::Coupler :
-        {
-            slave::Coupler couplerSlave(slaveConfig);
-            slavesRegistered = registerSlave(couplerSlave);
+            m_Slaves.emplace_back(std::in_place_type<slave::Coupler>, slaveConfig);
             break;
-        }
         default:
-            slavesRegistered = false;
-            break;
+            return false;
         }
+    }
 
+    // m_Slaves is not resized anymore, so the base pointers stay valid.
+    for(auto& slaveVariant : m_Slaves)
+    {
+        m_SlaveList.push_back(&slave::asSlave(slaveVariant));
     }
 
-    return slavesRegistered;
+    return true;
 }
 
-bool Master::createDomains()
+Slave* Master::findSlave(const std::string& slave_name) const
 {
-    bool domainsCreated = true;
+    auto slaveIndex = m_SlaveIndices.find(slave_name);
+    if(slaveIndex == m_SlaveIndices.end()){
+        return nullptr;
+    }
+
+    return m_SlaveList[slaveIndex->second];
+}
 
-    for(auto const & [name, slave] : m_RegisteredSlaves)
+bool Master::buildSlaveTables()
+{
+    std::size_t arenaSize = 0;
+    for(const Slave* slave : m_SlaveList)
     {
-        const auto domainNameOfSlave = slave->getSlaveInfo().domainName;
-        if(domainNameOfSlave.empty()){
-            domainsCreated = false;
-            break;
-        }
-        
-        // Check if domain exists
-        if(m_Domains.find(domainNameOfSlave) == m_Domains.end()){
-            // If not, create a new Domain struct and EtherCAT domain pointer.
-            m_Domains[domainNameOfSlave] = Domain();
-            auto& currentDomain = m_Domains.at(domainNameOfSlave);
-            currentDomain.domainPtr = ecrt_master_create_domain(this->m_MasterPtr);
-            // Check domain pointer
-            currentDomain.domainSlaves.push_back(name);
+        arenaSize += slave->getTableSize();
+    }
+    for(const auto& [name, entryCount] : countDomainEntries())
+    {
+        arenaSize += ec::arena::TableArena::footprint<ec_pdo_entry_reg_t>(entryCount + 1);
+    }
+    m_TableArena.reserve(arenaSize);
 
-            break;
-        }
-        // If domain already exists, just add the slave name to its domainSlaves vector:
-        auto& currentDomain = m_Domains.at(domainNameOfSlave);
-        currentDomain.domainSlaves.push_back(name);
+    // Regions are carved in configuration order, so each slave's tables are contiguous.
+    std::vector<ec::arena::TableArena> slaveRegions;
+    slaveRegions.reserve(m_SlaveList.size());
+    for(const Slave* slave : m_SlaveList)
+    {
+        slaveRegions.push_back(m_TableArena.carve(slave->getTableSize()));
+    }
+
+    return runInParallel(m_SlaveList.size(), m_InitThreadCount, [this, &slaveRegions](std::size_t slave_index) -> bool {
+        return m_SlaveList[slave_index]->buildTables(slaveRegions[slave_index]);
+    });
+}
 
+std::map<std::string, std::size_t> Master::countDomainEntries() const
+{
+    std::map<std::string, std::size_t> domainEntryCounts;
+    for(const Slave* slave : m_SlaveList)
+    {
+        domainEntryCounts[slave->getSlaveInfo().domainName] += slave->getEntryCount();
     }
 
-    return domainsCreated;
+    return domainEntryCounts;
 }
 
-bool Master::initSlaves()
+bool Master::checkTopology()
 {
+    m_IsFastRestart = false;
+    m_SnapshotDomains.clear();
+
+    m_BusTopology = ec::topology::scanBus(m_MasterPtr, m_BusScanTimeout);
+    if(!m_BusTopology){
+        // Nothing to validate against, the slaves are configured as they appear.
+        std::cout << "Could not scan the bus, slaves are not validated\n";
+        return true;
+    }
 
-    bool slavesInitiliazed = true;
+    auto snapshot = ec::topology::readSnapshotFile(m_PathToConfigurationFile + ".topology");
+    if(snapshot && snapshot->matches(m_ConfigHash, m_BusTopology.value())){
+        m_IsFastRestart = true;
+        m_SnapshotDomains = std::move(snapshot->domains);
+        return true;
+    }
 
-    for(auto& [name, slave] : m_RegisteredSlaves)
+    const auto mismatches = ec::topology::findMismatches(m_ProgramConfiguration.slaveConfigurations, m_BusTopology.value());
+    for(const auto& mismatch : mismatches)
     {
-        const auto slavesDomainName = slave->getSlaveInfo().domainName;
-        auto& currentDomain = m_Domains.at(slavesDomainName);
-        slavesInitiliazed = slave->init(this->m_MasterPtr, currentDomain.domainPtr);
+        std::cout << "Slave mismatch: " << mismatch << "\n";
     }
 
-    return slavesInitiliazed;
+    return mismatches.empty();
 }
 
-bool Master::registerDomainEntries()
-{   
+void Master::updateTopologySnapshot()
+{
+    if(!m_BusTopology){
+        return;
+    }
 
-    auto deduceDomainSize = [this](const Domain& domain) -> std::size_t{
-        const auto& domainSlaves = domain.domainSlaves;
-        std::size_t domainSize = 0;
-        for(std::vector<std::string>::const_iterator slaveNameIter = domainSlaves.cbegin(); slaveNameIter < domainSlaves.cend(); slaveNameIter++){
-            const auto currentSlaveInfo = this->m_RegisteredSlaves.at(*slaveNameIter)->getSlaveInfo();
-            
-            for(const auto& pdoMapping : currentSlaveInfo.rxPDOs)
-            {
-                domainSize += pdoMapping.entries.size();
-            }
+    std::vector<ec::topology::DomainLayout> domainLayouts;
+    for(const auto& [name, domain] : m_Domains)
+    {
+        ec::topology::DomainLayout layout{name, domain.domainSize, {}};
+        for(const ec_pdo_entry_reg_t* entryReg = domain.domainEntries; entryReg && entryReg->index; entryReg++)
+        {
+            layout.offsets.push_back(*entryReg->offset);
+        }
+        domainLayouts.push_back(std::move(layout));
+    }
+    std::sort(domainLayouts.begin(), domainLayouts.end(), [](const auto& lhs, const auto& rhs){
+        return lhs.domainName < rhs.domainName;
+    });
 
-            for(const auto& pdoMapping : currentSlaveInfo.txPDOs)
-            {
-                domainSize += pdoMapping.entries.size();
+    if(m_IsFastRestart){
+        if(domainLayouts == m_SnapshotDomains){
+            return;
+        }
+        // Same identities but another process image, e.g. a slave's firmware maps its PDOs differently now.
+        std::cout << "Domain layouts differ from the previous start, topology snapshot is rewritten\n";
+    }
+
+    // A failed write only costs the next start a validation of the slaves.
+    ec::topology::writeSnapshotFile(
+        m_PathToConfigurationFile + ".topology",
+        ec::topology::TopologySnapshot{m_ConfigHash, m_BusTopology.value(), std::move(domainLayouts)}
+    );
+}
+
+bool Master::createDomains()
+{
+    for(Slave* slave : m_SlaveList)
+    {
+        const auto& slaveInfo = slave->getSlaveInfo();
+        if(slaveInfo.domainName.empty()){
+            return false;
+        }
+
+        // Create the domain when its first slave is found.
+        auto domainFound = m_Domains.find(slaveInfo.domainName);
+        if(domainFound == m_Domains.end()){
+            domainFound = m_Domains.emplace(slaveInfo.domainName, Domain()).first;
+            domainFound->second.domainPtr = ecrt_master_create_domain(this->m_MasterPtr);
+            if(!domainFound->second.domainPtr){
+                return false;
             }
-            //domainSize += (currentSlaveInfo.rxPDOs.size() + currentSlaveInfo.txPDOs.size());
         }
+        domainFound->second.domainSlaves.push_back(slaveInfo.slaveName);
+    }
 
-        return domainSize;
-    };
+    return true;
+}
+
+bool Master::initSlaves()
+{
+    // The EtherCAT master serializes the configuration calls anyway, the tables are already built.
+    for(Slave* slave : m_SlaveList)
+    {
+        auto& currentDomain = m_Domains.at(slave->getSlaveInfo().domainName);
+        if(!slave->init(this->m_MasterPtr, currentDomain.domainPtr)){
+            return false;
+        }
+    }
 
-    bool registerOK = true;
+    return true;
+}
 
-    for(auto & [name, domain] : m_Domains)
+bool Master::registerDomainEntries()
+{
+    // Each slave fills its own range of its domain's registration list, so the ranges are assigned first.
+    std::vector<ec_pdo_entry_reg_t*> slaveRegistrations(m_SlaveList.size(), nullptr);
+    std::map<std::string, std::size_t> domainEntryCounts;
+    std::vector<std::size_t> slaveFirstEntries(m_SlaveList.size(), 0);
+    for(std::size_t i = 0; i < m_SlaveList.size(); i++)
     {
+        auto& domainEntryCount = domainEntryCounts[m_SlaveList[i]->getSlaveInfo().domainName];
+        slaveFirstEntries[i] = domainEntryCount;
+        domainEntryCount += m_SlaveList[i]->getEntryCount();
+    }
 
-        std::size_t currentDomainEntrySize = deduceDomainSize(domain);
+    for(auto& [name, domain] : m_Domains)
+    {
+        const std::size_t currentDomainEntrySize = domainEntryCounts[name];
         std::cout << "Number of PDOs to register for the domain: " << currentDomainEntrySize << std::endl;
-        domain.domainEntries = new ec_pdo_entry_reg_t[currentDomainEntrySize + 1]; // Plus one is for the empty struct at the end of the pointer.
+        // Plus one is for the empty struct at the end of the list, the arena hands out zeroed entries.
+        domain.domainEntries = m_TableArena.allocate<ec_pdo_entry_reg_t>(currentDomainEntrySize + 1);
+        if(!domain.domainEntries){
+            return false;
+        }
+    }
+
+    for(std::size_t i = 0; i < m_SlaveList.size(); i++)
+    {
+        Domain& domain = m_Domains.at(m_SlaveList[i]->getSlaveInfo().domainName);
+        slaveRegistrations[i] = domain.domainEntries + slaveFirstEntries[i];
 
-        std:size_t entryIteration = 0;
-        for(const std::string& slaveName : domain.domainSlaves)
+        // The RxPDOs of a slave are in its output sync manager, the TxPDOs in its input sync manager.
+        const auto& layout = m_SlaveList[i]->getLayout();
+        std::size_t rxEntryCount = 0;
+        for(const auto& pdo : layout.rxPDOs)
         {
-            auto& currentSlave = m_RegisteredSlaves.at(slaveName);
-            const auto currentSlaveInfo = currentSlave->getSlaveInfo();
-            for(const auto rxpdo : currentSlaveInfo.rxPDOs)
+            for(const auto& entry : pdo.entries)
             {
-                for(const auto& entry : rxpdo.entries)
-                {
-
-                    auto entryOffsetPtr = currentSlave->getOffsetPtr(entry.entryName);
-                    if(!entryOffsetPtr){
-                        registerOK = false;
-                        break;
-                    }
-                    ec_pdo_entry_reg_t entryReg;
-                    entryReg.alias = currentSlaveInfo.alias;
-                    entryReg.position = currentSlaveInfo.position;
-                    entryReg.vendor_id = currentSlaveInfo.vendorID;
-                    entryReg.product_code = currentSlaveInfo.productCode;
-                    entryReg.index = entry.index;
-                    entryReg.subindex = entry.subindex;
-                    entryReg.offset = entryOffsetPtr.value();
-                    domain.domainEntries[entryIteration] = entryReg;
-                    entryIteration += 1;
-                    
-                }
-                if(!registerOK){
-                    break;
-                }
-            }
-            if(!registerOK){
-                break;
+                rxEntryCount += entry.count;
             }
+        }
+        if(rxEntryCount != 0){
+            domain.syncManagerEntries.push_back(slaveFirstEntries[i]);
+        }
+        if(m_SlaveList[i]->getEntryCount() != rxEntryCount){
+            domain.syncManagerEntries.push_back(slaveFirstEntries[i] + rxEntryCount);
+        }
+    }
 
-            for(const auto txpdo : currentSlaveInfo.txPDOs)
+    return runInParallel(m_SlaveList.size(), m_InitThreadCount, [this, &slaveRegistrations](std::size_t slave_index) -> bool {
+        Slave* currentSlave = m_SlaveList[slave_index];
+        const auto& currentSlaveInfo = currentSlave->getSlaveInfo();
+        const auto& currentLayout = currentSlave->getLayout();
+        ec_pdo_entry_reg_t* entryReg = slaveRegistrations[slave_index];
+
+        for(const auto* pdos : {&currentLayout.rxPDOs, &currentLayout.txPDOs})
+        {
+            for(const auto& pdo : *pdos)
             {
-                for(const auto& entry : txpdo.entries)
-                {   
-                    auto entryOffsetPtr = currentSlave->getOffsetPtr(entry.entryName);
-                    if(!entryOffsetPtr){
-                        registerOK = false;
-                        // LOG:
-                        break;
+                for(const auto& entry : pdo.entries)
+                {
+                    // Every sample of an array is registered, so the master maps all of them.
+                    for(uint16_t sample = 0; sample < entry.count; sample++)
+                    {
+                        auto entryOffsetPtr = currentSlave->getOffsetPtr(entry.entryName, sample);
+                        if(!entryOffsetPtr){
+                            return false;
+                        }
+                        entryReg->alias = currentSlaveInfo.alias;
+                        entryReg->position = currentSlaveInfo.position;
+                        entryReg->vendor_id = currentSlaveInfo.vendorID;
+                        entryReg->product_code = currentSlaveInfo.productCode;
+                        entryReg->index = entry.index;
+                        entryReg->subindex = entry.subindex + sample;
+                        entryReg->offset = entryOffsetPtr.value();
+                        entryReg->bit_position = nullptr;
+                        entryReg += 1;
                     }
-                    ec_pdo_entry_reg_t entryReg;
-                    entryReg.alias = currentSlaveInfo.alias;
-                    entryReg.position = currentSlaveInfo.position;
-                    entryReg.vendor_id = currentSlaveInfo.vendorID;
-                    entryReg.product_code = currentSlaveInfo.productCode;
-                    entryReg.index = entry.index;
-                    entryReg.subindex = entry.subindex;
-                    entryReg.offset = entryOffsetPtr.value();
-                    domain.domainEntries[entryIteration] = entryReg;
-                    entryIteration += 1;
-                    
-                }
-                if(!registerOK){
-                    break;
                 }
             }
-            if(!registerOK){
-                break;
-            }
         }
-        if(!registerOK){
-            break;
+
+        return true;
+    });
+}
+
+bool Master::registerCachedOffsets(const std::string& domain_name, Domain& domain)
+{
+    auto layout = std::find_if(m_SnapshotDomains.cbegin(), m_SnapshotDomains.cend(), [&domain_name](const auto& snapshot_layout){
+        return snapshot_layout.domainName == domain_name;
+    });
+    std::size_t entryCount = 0;
+    for(const ec_pdo_entry_reg_t* entryReg = domain.domainEntries; entryReg && entryReg->index; entryReg++)
+    {
+        entryCount++;
+    }
+    if(layout == m_SnapshotDomains.cend() || layout->offsets.size() != entryCount){
+        return false;
+    }
+
+    for(const std::size_t entryIndex : domain.syncManagerEntries)
+    {
+        const ec_pdo_entry_reg_t registration[2] = {domain.domainEntries[entryIndex], {}};
+        if(ecrt_domain_reg_pdo_entry_list(domain.domainPtr, registration) || *registration[0].offset != layout->offsets[entryIndex]){
+            std::cout << "Offsets of domain " << domain_name << " differ from the previous start, all entries are registered\n";
+            return false;
         }
+    }
 
-        domain.domainEntries[currentDomainEntrySize] = {};
+    for(std::size_t i = 0; i < entryCount; i++)
+    {
+        *domain.domainEntries[i].offset = layout->offsets[i];
     }
 
-    return registerOK;
+    return true;
 }
 
 void Master::receive()
 {
     if(m_IsDistributedClockEnabled){
+        // The timer is owned by m_TaskTimer, only borrow it here.
         CyclicTaskTimerDC* tempDcTimer = dynamic_cast<CyclicTaskTimerDC*>(m_TaskTimer.get());     
         tempDcTimer->writeAppTimeToMaster(m_MasterPtr);
-        delete tempDcTimer;
+        if(m_ApplicationStartTime == 0){
+            m_ApplicationStartTime = getApplicationTime();
+        }
     }
 
     ecrt_master_receive(m_MasterPtr);
+
+    applyPendingUpdate();
+
+    applyPendingStreams();
+
+    processSdoRequests();
+
+    checkStates();
+
+    DataStreams* streams = m_ActiveStreams;
+    if(streams && streams->player && !streams->player->next()){
+        // End of the recording, continue with the live process data. The player is closed by stopReplay().
+        m_FinishedPlayer.store(streams->player, std::memory_order_relaxed);
+        streams->player = nullptr;
+    }
     
 }
 
@@ -461,9 +764,24 @@ void Master::send()
         CyclicTaskTimerDC* tempDcTimer = dynamic_cast<CyclicTaskTimerDC*>(m_TaskTimer.get());
         tempDcTimer->syncReferenceClock(m_MasterPtr);
         tempDcTimer->syncSlaveClocks(m_MasterPtr);
-        delete tempDcTimer;
     }
 
+    const DataStreams* streams = m_ActiveStreams;
+    const bool isStreaming = streams && (streams->recorder || streams->captureWriter);
+    if(isStreaming || !m_InputTimestamps.empty()){
+        std::timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        const uint64_t timestamp = timespectoNanoSec(now);
+        if(isStreaming && streams->recorder){
+            streams->recorder->record(m_CycleCounter.load(std::memory_order_relaxed), timestamp, streams->recordedImages.data());
+        }
+        if(isStreaming && streams->captureWriter){
+            streams->captureWriter->sample(timestamp);
+        }
+        m_LastSendTime = timestamp;
+    }
+    m_CycleCounter.fetch_add(1, std::memory_order_relaxed);
+
     ecrt_master_send(m_MasterPtr);
 }
 
@@ -477,9 +795,37 @@ bool Master::receiveDomainData(const std::string& domain_name)
 
     ecrt_domain_process(domainFound->second.domainPtr);
 
+    if(domainFound->second.health){
+        ec_domain_state_t domainState{};
+        ecrt_domain_state(domainFound->second.domainPtr, &domainState);
+        domainFound->second.health->check(domainState.working_counter);
+    }
+
+    const DataStreams* streams = m_ActiveStreams;
+    if(streams && streams->player){
+        auto replayedDomain = streams->replayedDomains.find(domain_name);
+        if(replayedDomain != streams->replayedDomains.end()){
+            streams->player->copyRanges(replayedDomain->second.imageIndex, domainFound->second.domainDataPtr, replayedDomain->second.ranges);
+        }
+    }
+
+    // The inputs came with the frame of the last send().
+    processInputs(domainFound->second, m_LastSendTime);
+
     return true;
 }
 
+void Master::processInputs(Domain& domain, uint64_t send_time)
+{
+    if(domain.filters){
+        domain.filters->update();
+    }
+
+    if(domain.timestamps && send_time != 0){
+        domain.timestamps->update(m_ApplicationStartTime, send_time);
+    }
+}
+
 bool Master::sendDomainData(const std::string& domain_name)
 {
     auto domainFound = m_Domains.find(domain_name);
@@ -488,7 +834,842 @@ bool Master::sendDomainData(const std::string& domain_name)
         return false;
     }
 
+    if(domainFound->second.limits){
+        domainFound->second.limits->apply();
+    }
+
     ecrt_domain_queue(domainFound->second.domainPtr);
 
     return true;
 }
+
+void Master::setupHealthMonitoring()
+{
+    std::map<std::string, std::vector<ec::health::DomainMember>> domainMembers;
+    for(const Slave* slave : m_SlaveList)
+    {
+        // RxPDOs are written by the master, TxPDOs are read.
+        const auto& layout = slave->getLayout();
+        auto hasEntries = [](const std::vector<PDO>& pdos){
+            return std::any_of(pdos.cbegin(), pdos.cend(), [](const PDO& pdo){ return !pdo.entries.empty(); });
+        };
+        domainMembers[slave->getSlaveInfo().domainName].push_back({hasEntries(layout.rxPDOs), hasEntries(layout.txPDOs)});
+    }
+
+    m_DomainHealth.clear();
+    for(auto& [name, domain] : m_Domains)
+    {
+        auto& health = m_DomainHealth.emplace_back();
+        health.expectedWorkingCounter = ec::health::expectedWorkingCounter(domainMembers[name]);
+        domain.health = &health;
+    }
+
+    m_SlaveHealth = std::make_unique<ec::health::SlaveHealth[]>(m_SlaveList.size());
+    for(std::size_t i = 0; i < m_SlaveList.size(); i++)
+    {
+        m_SlaveList[i]->setStaleFlag(&m_SlaveHealth[i].stale);
+    }
+    m_NextStateCheckedSlave = 0;
+}
+
+void Master::setupFilters()
+{
+    std::map<std::string, std::vector<ec::filter::FilteredEntry>> domainEntries;
+    std::map<std::string, std::vector<std::pair<Slave*, std::string>>> domainReaders;
+    for(Slave* slave : m_SlaveList)
+    {
+        const std::string& domainName = slave->getSlaveInfo().domainName;
+        for(const auto& pdo : slave->getLayout().txPDOs)
+        {
+            for(const auto& entry : pdo.entries)
+            {
+                const auto offset = slave->getOffsetPtr(entry.entryName);
+                if(entry.filter.type == FilterType::None || !offset){
+                    continue;
+                }
+                domainEntries[domainName].push_back({*offset.value(), entry.type, entry.filter, slave->getStaleFlag()});
+                domainReaders[domainName].push_back({slave, entry.entryName});
+            }
+        }
+    }
+
+    m_FilterBanks.clear();
+    for(auto& [name, domain] : m_Domains)
+    {
+        domain.filters = nullptr;
+        auto entriesFound = domainEntries.find(name);
+        if(entriesFound == domainEntries.end()){
+            continue;
+        }
+
+        auto& bank = m_FilterBanks.emplace_back(domain.domainDataPtr, entriesFound->second);
+        domain.filters = &bank;
+        const auto& readers = domainReaders[name];
+        for(std::size_t i = 0; i < readers.size(); i++)
+        {
+            readers[i].first->setFilteredValue(readers[i].second, bank.getValuePtr(i));
+        }
+    }
+}
+
+void Master::setupLimits()
+{
+    std::map<std::string, std::vector<ec::limit::LimitedEntry>> domainEntries;
+    for(Slave* slave : m_SlaveList)
+    {
+        const SlaveInfo& slaveInfo = slave->getSlaveInfo();
+        for(const auto& pdo : slave->getLayout().rxPDOs)
+        {
+            for(const auto& entry : pdo.entries)
+            {
+                const auto offset = slave->getOffsetPtr(entry.entryName);
+                if(!entry.limit.isLimited || !offset){
+                    continue;
+                }
+                domainEntries[slaveInfo.domainName].push_back({
+                    slaveInfo.slaveName + "." + entry.entryName, *offset.value(), entry.type, entry.limit, slave->getStaleFlag()
+                });
+            }
+        }
+    }
+
+    m_LimitStages.clear();
+    for(auto& [name, domain] : m_Domains)
+    {
+        domain.limits = nullptr;
+        auto entriesFound = domainEntries.find(name);
+        if(entriesFound != domainEntries.end()){
+            domain.limits = &m_LimitStages.emplace_back(domain.domainDataPtr, entriesFound->second);
+        }
+    }
+}
+
+void Master::setupTimestamps()
+{
+    struct DomainInputs
+    {
+        std::vector<ec::timestamp::LatchGroup> groups;
+
+        std::vector<ec::timestamp::TimestampEntry> entries;
+
+        std::vector<std::pair<Slave*, std::size_t>> slaveGroups;
+
+        std::vector<std::pair<Slave*, std::string>> readers;
+    };
+
+    std::map<std::string, DomainInputs> domainInputs;
+    for(Slave* slave : m_SlaveList)
+    {
+        const SlaveInfo& slaveInfo = slave->getSlaveInfo();
+        const auto& txPDOs = slave->getLayout().txPDOs;
+        const bool hasInputs = std::any_of(txPDOs.cbegin(), txPDOs.cend(), [](const PDO& pdo){ return !pdo.entries.empty(); });
+        if(!hasInputs){
+            continue;
+        }
+
+        // The configured shift is the one the slave was configured with, a reloaded shift takes effect once the slaves are configured again.
+        ec::timestamp::LatchGroup group;
+        if(slaveInfo.distributedClockConfig){
+            group.cycle = (uint64_t)slaveInfo.distributedClockConfig->sync0Activate + slaveInfo.distributedClockConfig->sync1Activate;
+            group.shift = group.cycle != 0 ? slaveInfo.distributedClockConfig->sync0Shift : 0;
+        }
+        auto& inputs = domainInputs[slaveInfo.domainName];
+        const auto groupFound = std::find(inputs.groups.cbegin(), inputs.groups.cend(), group);
+        const std::size_t groupIndex = groupFound - inputs.groups.cbegin();
+        if(groupFound == inputs.groups.cend()){
+            inputs.groups.push_back(group);
+        }
+        inputs.slaveGroups.push_back({slave, groupIndex});
+
+        for(const auto& pdo : txPDOs)
+        {
+            for(const auto& entry : pdo.entries)
+            {
+                const auto offset = slave->getOffsetPtr(entry.entryName);
+                if(!entry.isTimestamp || !offset){
+                    continue;
+                }
+                inputs.entries.push_back({slaveInfo.slaveName + "." + entry.entryName, *offset.value(), entry.type, groupIndex});
+                inputs.readers.push_back({slave, entry.entryName});
+            }
+        }
+    }
+
+    m_InputTimestamps.clear();
+    for(auto& [name, domain] : m_Domains)
+    {
+        domain.timestamps = nullptr;
+        auto inputsFound = domainInputs.find(name);
+        if(inputsFound == domainInputs.end()){
+            continue;
+        }
+
+        const DomainInputs& inputs = inputsFound->second;
+        auto& timestamps = m_InputTimestamps.emplace_back(domain.domainDataPtr, inputs.groups, inputs.entries);
+        domain.timestamps = &timestamps;
+        for(const auto& [slave, groupIndex] : inputs.slaveGroups)
+        {
+            slave->setInputLatchTime(timestamps.getLatchTimePtr(groupIndex));
+        }
+        for(std::size_t i = 0; i < inputs.readers.size(); i++)
+        {
+            inputs.readers[i].first->setTimestampValue(inputs.readers[i].second, timestamps.getTimestampPtr(i));
+        }
+    }
+}
+
+void Master::checkStates()
+{
+    if(m_StateCheckDivisor == 0 || m_CycleCounter.load(std::memory_order_relaxed) % m_StateCheckDivisor != 0){
+        return;
+    }
+
+    ec_master_state_t masterState{};
+    ecrt_master_state(m_MasterPtr, &masterState);
+    const uint32_t previousResponding = m_MasterHealth.slavesResponding.exchange(masterState.slaves_responding, std::memory_order_relaxed);
+    if(masterState.slaves_responding < previousResponding){
+        m_MasterHealth.respondingDrops.fetch_add(1, std::memory_order_relaxed);
+    }
+    m_MasterHealth.alStates.store(masterState.al_states, std::memory_order_relaxed);
+    m_MasterHealth.linkUp.store(masterState.link_up, std::memory_order_relaxed);
+    m_MasterHealth.stateChecks.fetch_add(1, std::memory_order_relaxed);
+
+    if(!m_SlaveHealth){
+        return;
+    }
+
+    const std::size_t slaveCount = m_SlaveList.size();
+    for(std::size_t i = 0; i < std::min(m_SlavesPerStateCheck, slaveCount); i++)
+    {
+        const std::size_t slaveIndex = m_NextStateCheckedSlave;
+        m_NextStateCheckedSlave = (m_NextStateCheckedSlave + 1) % slaveCount;
+
+        const auto state = m_SlaveList[slaveIndex]->readState();
+        if(!state){
+            continue;
+        }
+
+        auto& health = m_SlaveHealth[slaveIndex];
+        // An AL state of 0 means the slave has not been polled yet.
+        const uint8_t previousAlState = health.alState.exchange(state->al_state, std::memory_order_relaxed);
+        const bool wasOnline = health.online.exchange(state->online, std::memory_order_relaxed);
+        const bool wasOperational = health.operational.exchange(state->operational, std::memory_order_relaxed);
+        if(previousAlState != 0 && (previousAlState != state->al_state || wasOnline != (bool)state->online || wasOperational != (bool)state->operational)){
+            health.stateChanges.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Slaves that have not reached OP yet are still starting up, not lost.
+        const bool isOperational = state->online && state->operational;
+        bool rejoined = false;
+        if(isOperational){
+            health.hasBeenOperational = true;
+            if(!health.stale.exchange(false, std::memory_order_relaxed)){
+                continue;
+            }
+            health.rejoins.fetch_add(1, std::memory_order_relaxed);
+            rejoined = true;
+        }
+        else if(health.hasBeenOperational && !health.stale.load(std::memory_order_relaxed)){
+            health.stale.store(true, std::memory_order_relaxed);
+            health.losses.fetch_add(1, std::memory_order_relaxed);
+        }
+        else{
+            continue;
+        }
+
+        if(m_SlaveStateCallback){
+            m_SlaveStateCallback(m_SlaveList[slaveIndex]->getSlaveInfo().slaveName, rejoined);
+        }
+    }
+}
+
+std::optional<ec::health::DomainStatus> Master::getDomainStatus(const std::string& domain_name) const
+{
+    auto domainFound = m_Domains.find(domain_name);
+    if(domainFound == m_Domains.end() || !domainFound->second.health){
+        return std::nullopt;
+    }
+
+    return ec::health::readStatus(*domainFound->second.health);
+}
+
+ec::limit::LimitStage* Master::getLimitStage(const std::string& domain_name)
+{
+    auto domainFound = m_Domains.find(domain_name);
+    if(domainFound == m_Domains.end()){
+        return nullptr;
+    }
+
+    return domainFound->second.limits;
+}
+
+ec::timestamp::InputTimestamps* Master::getInputTimestamps(const std::string& domain_name)
+{
+    auto domainFound = m_Domains.find(domain_name);
+    if(domainFound == m_Domains.end()){
+        return nullptr;
+    }
+
+    return domainFound->second.timestamps;
+}
+
+std::optional<ec::health::SlaveStatus> Master::getSlaveStatus(const std::string& slave_name) const
+{
+    auto slaveIndex = m_SlaveIndices.find(slave_name);
+    if(slaveIndex == m_SlaveIndices.end() || !m_SlaveHealth){
+        return std::nullopt;
+    }
+
+    return ec::health::readStatus(m_SlaveHealth[slaveIndex->second]);
+}
+
+bool Master::startRecording(const std::string& recording_file_path, std::size_t cycle_capacity)
+{
+    std::lock_guard<std::mutex> lock(m_StreamsMutex);
+    if(m_Recorder || m_Domains.empty()){
+        return false;
+    }
+
+    // Sort the domains by name so the recordings of the same configuration have the same layout.
+    std::vector<std::string> domainNames;
+    for(const auto& [name, domain] : m_Domains)
+    {
+        if(!domain.domainDataPtr){
+            return false;
+        }
+        domainNames.push_back(name);
+    }
+    std::sort(domainNames.begin(), domainNames.end());
+
+    DataStreams streams = m_Streams;
+    std::vector<ec::recorder::DomainImageInfo> recordedDomains;
+    streams.recordedImages.clear();
+    for(const auto& name : domainNames)
+    {
+        const auto& domain = m_Domains.at(name);
+        recordedDomains.push_back({name, domain.domainSize});
+        streams.recordedImages.push_back(domain.domainDataPtr);
+    }
+
+    auto recorder = std::make_unique<ec::recorder::ProcessDataRecorder>();
+    if(!recorder->open(recording_file_path, recordedDomains, cycle_capacity)){
+        return false;
+    }
+
+    streams.recorder = recorder.get();
+    if(!publishStreams(streams)){
+        return false;
+    }
+    m_Streams = std::move(streams);
+    m_Recorder = std::move(recorder);
+
+    return true;
+}
+
+bool Master::stopRecording()
+{
+    std::lock_guard<std::mutex> lock(m_StreamsMutex);
+    if(!m_Recorder){
+        return true;
+    }
+
+    DataStreams streams = m_Streams;
+    streams.recorder = nullptr;
+    streams.recordedImages.clear();
+    if(!publishStreams(streams)){
+        return false;
+    }
+    m_Streams = std::move(streams);
+
+    m_Recorder->close();
+    m_Recorder.reset();
+
+    return true;
+}
+
+bool Master::startReplay(const std::string& recording_file_path)
+{
+    std::lock_guard<std::mutex> lock(m_StreamsMutex);
+    // A finished replay is replaced by the new one.
+    if(m_Player && m_FinishedPlayer.load(std::memory_order_relaxed) != m_Player.get()){
+        return false;
+    }
+
+    auto player = std::make_unique<ec::recorder::ProcessDataPlayer>();
+    if(!player->open(recording_file_path)){
+        return false;
+    }
+
+    auto replayedDomains = findReplayedDomains(*player);
+    if(!replayedDomains){
+        return false;
+    }
+
+    DataStreams streams = m_Streams;
+    streams.replayedDomains = std::move(replayedDomains.value());
+    streams.player = player.get();
+    if(!publishStreams(streams)){
+        return false;
+    }
+    m_Streams = std::move(streams);
+    forgetFinishedPlayer(m_Player.get());
+    m_Player = std::move(player);
+
+    return true;
+}
+
+std::optional<std::size_t> Master::replayOffline(const std::string& recording_file_path)
+{
+    std::lock_guard<std::mutex> lock(m_StreamsMutex);
+    if(m_IsCycling.load() || m_Domains.empty()){
+        return std::nullopt;
+    }
+
+    ec::recorder::ProcessDataPlayer player;
+    if(!player.open(recording_file_path)){
+        return std::nullopt;
+    }
+
+    const auto replayedDomains = findReplayedDomains(player);
+    if(!replayedDomains){
+        return std::nullopt;
+    }
+
+    const uint64_t cycleCounter = m_CycleCounter.load();
+    // The inputs of a cycle came with the frame sent at the end of the previous one.
+    uint64_t previousSendTime = 0;
+    std::size_t replayedCycles = 0;
+    while(player.next())
+    {
+        m_CycleCounter.store(player.getCurrentIndex().cycle, std::memory_order_relaxed);
+        for(auto& [name, domain] : m_Domains)
+        {
+            const ReplayedDomain& replayedDomain = replayedDomains->at(name);
+            player.copyRanges(replayedDomain.imageIndex, domain.domainDataPtr, replayedDomain.ranges);
+            processInputs(domain, previousSendTime);
+        }
+
+        update();
+
+        for(auto& [name, domain] : m_Domains)
+        {
+            if(domain.limits){
+                domain.limits->apply();
+            }
+        }
+
+        previousSendTime = player.getCurrentIndex().timestamp;
+        replayedCycles += 1;
+    }
+    m_CycleCounter.store(cycleCounter);
+
+    return replayedCycles;
+}
+
+bool Master::stopReplay()
+{
+    std::lock_guard<std::mutex> lock(m_StreamsMutex);
+    if(!m_Player){
+        return true;
+    }
+
+    DataStreams streams = m_Streams;
+    streams.player = nullptr;
+    streams.replayedDomains.clear();
+    if(!publishStreams(streams)){
+        return false;
+    }
+    m_Streams = std::move(streams);
+
+    forgetFinishedPlayer(m_Player.get());
+    m_Player->close();
+    m_Player.reset();
+
+    return true;
+}
+
+bool Master::startCapture(
+    const std::string& capture_file_path,
+    const std::vector<std::string>& slave_names,
+    std::size_t chunk_size
+)
+{
+    std::lock_guard<std::mutex> lock(m_StreamsMutex);
+    if(m_CaptureWriter){
+        return false;
+    }
+
+    std::vector<std::string> capturedSlaves = slave_names;
+    if(capturedSlaves.empty()){
+        for(const Slave* slave : m_SlaveList)
+        {
+            capturedSlaves.push_back(slave->getSlaveInfo().slaveName);
+        }
+    }
+
+    auto writer = std::make_unique<ec::capture::CaptureWriter>();
+    for(const auto& slaveName : capturedSlaves)
+    {
+        Slave* slave = findSlave(slaveName);
+        if(!slave){
+            return false;
+        }
+
+        const uint8_t* domainData = slave->getDomainDataPtr();
+        if(!domainData){
+            return false;
+        }
+
+        const auto& layout = slave->getLayout();
+        for(const auto* pdos : {&layout.rxPDOs, &layout.txPDOs})
+        {
+            for(const auto& pdo : *pdos)
+            {
+                for(const auto& entry : pdo.entries)
+                {
+                    auto offset = slave->getOffsetPtr(entry.entryName);
+                    if(!offset || entry.type == DataType::UNKNOWN){
+                        continue;
+                    }
+                    writer->addColumn(slaveName + "." + entry.entryName, entry.type, domainData + *offset.value());
+                }
+            }
+        }
+    }
+
+    const auto captureMask = createCaptureMask(*writer, {});
+    for(std::size_t i = 0; i < captureMask.size(); i++)
+    {
+        writer->setColumnEnabled(i, captureMask[i]);
+    }
+
+    if(!writer->open(capture_file_path, chunk_size)){
+        return false;
+    }
+
+    DataStreams streams = m_Streams;
+    streams.captureWriter = writer.get();
+    if(!publishStreams(streams)){
+        return false;
+    }
+    m_Streams = std::move(streams);
+    m_CaptureWriter = std::move(writer);
+
+    return true;
+}
+
+bool Master::stopCapture()
+{
+    std::lock_guard<std::mutex> lock(m_StreamsMutex);
+    if(!m_CaptureWriter){
+        return true;
+    }
+
+    DataStreams streams = m_Streams;
+    streams.captureWriter = nullptr;
+    if(!publishStreams(streams)){
+        return false;
+    }
+    m_Streams = std::move(streams);
+
+    const bool isWritten = m_CaptureWriter->close();
+    m_CaptureWriter.reset();
+    if(!isWritten){
+        std::cout << "Could not write the capture file completely\n";
+    }
+
+    return isWritten;
+}
+
+void Master::processSdoRequests()
+{
+    std::size_t budget = m_SdoBudget;
+    for(std::size_t visited = 0; visited < m_SdoEngines.size() && budget > 0; visited++)
+    {
+        ec::sdo::SdoEngine* sdoEngine = m_SdoEngines[m_NextSdoEngine];
+        m_NextSdoEngine = (m_NextSdoEngine + 1) % m_SdoEngines.size();
+        if(!sdoEngine->hasWork()){
+            continue;
+        }
+
+        budget -= sdoEngine->process(budget);
+    }
+}
+
+void Master::sdoCompletionTask()
+{
+    while(m_IsDeliveringSdoResults.load())
+    {
+        std::size_t delivered = 0;
+        for(ec::sdo::SdoEngine* sdoEngine : m_SdoEngines)
+        {
+            delivered += sdoEngine->deliverCompletions();
+        }
+        if(delivered == 0){
+            std::this_thread::sleep_for(std::chrono::microseconds(500));
+        }
+    }
+}
+
+ReloadReport Master::reloadConfig(std::chrono::milliseconds timeout)
+{
+    std::lock_guard<std::mutex> reloadLock(m_ReloadMutex);
+
+    ReloadReport report;
+
+    const auto reloadedConfigOpt = ec::parser::parseConfigFileCached(m_PathToConfigurationFile);
+    if(!reloadedConfigOpt){
+        report.rejectedChanges.push_back("Could not parse " + m_PathToConfigurationFile);
+        return report;
+    }
+    const ProgramConfig& reloadedConfig = reloadedConfigOpt.value();
+
+    const auto diff = ec::parser::diffConfigs(m_ProgramConfiguration, reloadedConfig);
+    if(diff.isStructural()){
+        report.rejectedChanges = diff.structuralChanges;
+        return report;
+    }
+
+    // The slaves keep referencing the tuning of the last applied update, so every update carries all slaves.
+    if(!diff.retunedSlaves.empty()){
+        auto update = std::make_unique<TuningUpdate>();
+        update->updateID = ++m_UpdateCounter;
+        for(const auto& slaveInfo : reloadedConfig.slaveConfigurations)
+        {
+            update->slaves.push_back(findSlave(slaveInfo.slaveName));
+            update->tunings.push_back(slaveInfo.tuning);
+        }
+
+        if(m_CaptureWriter){
+            std::map<std::string, const SlaveTuning*> tunings;
+            for(std::size_t i = 0; i < update->tunings.size(); i++)
+            {
+                tunings[reloadedConfig.slaveConfigurations[i].slaveName] = &update->tunings[i];
+            }
+            update->captureMask = createCaptureMask(*m_CaptureWriter, tunings);
+            update->captureWriter = m_CaptureWriter.get();
+        }
+
+        const uint64_t updateID = update->updateID;
+        // Stays valid after being applied, it is only freed by the next reload.
+        const TuningUpdate* published = update.get();
+        m_PendingUpdate.store(update.release(), std::memory_order_release);
+
+        auto isApplied = [this, updateID]() -> bool {
+            return m_AppliedUpdateID.load(std::memory_order_acquire) == updateID;
+        };
+
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while(!isApplied() && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+
+        if(!isApplied()){
+            TuningUpdate* withdrawn = m_PendingUpdate.exchange(nullptr, std::memory_order_acq_rel);
+            if(withdrawn){
+                delete withdrawn;
+                report.rejectedChanges.push_back("The cyclic thread did not reach a cycle boundary within the timeout");
+                return report;
+            }
+            // Taken over by the cyclic thread in the meantime, it is being applied right now.
+            while(!isApplied())
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        delete m_RetiredUpdate.exchange(nullptr, std::memory_order_acq_rel);
+        report.appliedAtCycle = published->appliedAtCycle;
+    }
+    else{
+        report.appliedAtCycle = getCycleCounter();
+    }
+
+    report.appliedChanges = diff.tunableChanges;
+    report.applied = true;
+    m_ProgramConfiguration = reloadedConfig;
+
+    return report;
+}
+
+void Master::applyPendingUpdate()
+{
+    TuningUpdate* update = m_PendingUpdate.exchange(nullptr, std::memory_order_acq_rel);
+    if(!update){
+        return;
+    }
+
+    for(std::size_t i = 0; i < update->slaves.size(); i++)
+    {
+        update->slaves[i]->setTuning(&update->tunings[i]);
+    }
+
+    // The capture might have been restarted since the mask was created.
+    if(update->captureWriter && m_ActiveStreams && m_ActiveStreams->captureWriter == update->captureWriter){
+        for(std::size_t i = 0; i < update->captureMask.size(); i++)
+        {
+            update->captureWriter->setColumnEnabled(i, update->captureMask[i]);
+        }
+    }
+
+    update->appliedAtCycle = m_CycleCounter.load(std::memory_order_relaxed);
+    m_RetiredUpdate.store(m_ActiveUpdate, std::memory_order_relaxed);
+    m_ActiveUpdate = update;
+    m_AppliedUpdateID.store(update->updateID, std::memory_order_release);
+}
+
+bool Master::publishStreams(const DataStreams& streams)
+{
+    auto published = std::make_unique<DataStreams>(streams);
+    // Without a cyclic thread, or called from it, nothing else uses the active streams.
+    if(!m_IsCycling.load() || std::this_thread::get_id() == m_CyclicThread.get_id()){
+        delete m_ActiveStreams;
+        m_ActiveStreams = published.release();
+        return true;
+    }
+
+    published->updateID = ++m_StreamsCounter;
+    const uint64_t updateID = published->updateID;
+    m_PendingStreams.store(published.release(), std::memory_order_release);
+
+    auto isApplied = [this, updateID]() -> bool {
+        return m_AppliedStreamsID.load(std::memory_order_acquire) == updateID;
+    };
+
+    const auto deadline = std::chrono::steady_clock::now() + StreamHandoverTimeout;
+    while(!isApplied() && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+
+    if(!isApplied()){
+        DataStreams* withdrawn = m_PendingStreams.exchange(nullptr, std::memory_order_acq_rel);
+        if(withdrawn){
+            delete withdrawn;
+            return false;
+        }
+        // Taken over by the cyclic thread in the meantime.
+        while(!isApplied())
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    // The cyclic thread has left the cycle that used the replaced streams.
+    delete m_RetiredStreams.exchange(nullptr, std::memory_order_acq_rel);
+
+    return true;
+}
+
+void Master::forgetFinishedPlayer(const ec::recorder::ProcessDataPlayer* player)
+{
+    // Another player allocated later might get the same address.
+    m_FinishedPlayer.compare_exchange_strong(player, nullptr, std::memory_order_relaxed);
+}
+
+void Master::applyPendingStreams()
+{
+    DataStreams* streams = m_PendingStreams.exchange(nullptr, std::memory_order_acq_rel);
+    if(!streams){
+        return;
+    }
+
+    m_RetiredStreams.store(m_ActiveStreams, std::memory_order_relaxed);
+    m_ActiveStreams = streams;
+    m_AppliedStreamsID.store(streams->updateID, std::memory_order_release);
+}
+
+std::optional<std::map<std::string, Master::ReplayedDomain>> Master::findReplayedDomains(const ec::recorder::ProcessDataPlayer& player) const
+{
+    std::map<std::string, ReplayedDomain> replayedDomains;
+    auto inputRanges = createInputRanges();
+    for(const auto& [name, domain] : m_Domains)
+    {
+        const auto imageIndex = player.findDomain(name);
+        if(!imageIndex || player.getDomainSize(imageIndex.value()) != domain.domainSize){
+            return std::nullopt;
+        }
+        replayedDomains[name] = ReplayedDomain{imageIndex.value(), std::move(inputRanges[name])};
+    }
+
+    return replayedDomains;
+}
+
+std::map<std::string, std::vector<ec::recorder::ImageRange>> Master::createInputRanges() const
+{
+    std::map<std::string, std::vector<ec::recorder::ImageRange>> domainRanges;
+    for(Slave* slave : m_SlaveList)
+    {
+        auto& ranges = domainRanges[slave->getSlaveInfo().domainName];
+        for(const auto& pdo : slave->getLayout().txPDOs)
+        {
+            for(const auto& entry : pdo.entries)
+            {
+                // The samples of an array entry are registered back to back.
+                const auto offset = slave->getOffsetPtr(entry.entryName);
+                if(!offset){
+                    continue;
+                }
+                ranges.push_back({*offset.value(), (std::size_t)((entry.bitlength + 7) / 8) * entry.count});
+            }
+        }
+    }
+
+    for(auto& [name, ranges] : domainRanges)
+    {
+        std::sort(ranges.begin(), ranges.end(), [](const auto& lhs, const auto& rhs){
+            return lhs.offset < rhs.offset;
+        });
+
+        std::vector<ec::recorder::ImageRange> merged;
+        for(const auto& range : ranges)
+        {
+            if(!merged.empty() && range.offset <= merged.back().offset + merged.back().size){
+                merged.back().size = std::max(merged.back().size, range.offset + range.size - merged.back().offset);
+                continue;
+            }
+            merged.push_back(range);
+        }
+        ranges = std::move(merged);
+    }
+
+    return domainRanges;
+}
+
+std::vector<uint8_t> Master::createCaptureMask(
+    const ec::capture::CaptureWriter& writer,
+    const std::map<std::string, const SlaveTuning*>& tunings
+) const
+{
+    std::vector<uint8_t> mask(writer.getColumnCount(), 1);
+
+    for(const Slave* slave : m_SlaveList)
+    {
+        const std::string& name = slave->getSlaveInfo().slaveName;
+        auto tuningFound = tunings.find(name);
+        const SlaveTuning& tuning = tuningFound != tunings.end() ? *tuningFound->second : slave->getTuning();
+        if(tuning.telemetryEntries.empty()){
+            continue;
+        }
+
+        const auto& layout = slave->getLayout();
+        for(const auto* pdos : {&layout.rxPDOs, &layout.txPDOs})
+        {
+            for(const auto& pdo : *pdos)
+            {
+                for(const auto& entry : pdo.entries)
+                {
+                    const auto columnIndex = writer.findColumn(name + "." + entry.entryName);
+                    if(!columnIndex){
+                        continue;
+                    }
+                    const auto& selected = tuning.telemetryEntries;
+                    mask[columnIndex.value()] = std::find(selected.cbegin(), selected.cend(), entry.entryName) != selected.cend();
+                }
+            }
+        }
+    }
+
+    return mask;
+}
@@ -0,0 +1,256 @@
+/**
+ * @file motion_planner.cpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ethercat_interface/driver/motion_planner.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ec
+{
+    namespace motion
+    {
+
+        double computeProfile(
+            double start_position,
+            double target_position,
+            const AxisLimits& limits,
+            ProfileType type,
+            double duration,
+            AxisProfile& profile
+        )
+        {
+            const double distance = std::abs(target_position - start_position);
+            const double direction = target_position < start_position ? -1.0 : 1.0;
+            const double maxVelocity = limits.maxVelocity;
+            const double maxAcceleration = limits.maxAcceleration;
+            const double maxJerk = limits.maxJerk;
+
+            // Duration, jerk and acceleration at the start of the seven segments.
+            std::array<double, 7> durations{};
+            std::array<double, 7> jerks{};
+            std::array<double, 7> accelerations{};
+
+            if(distance > 0.0 && type == ProfileType::SCurve){
+                // Jerk and constant acceleration times of accelerating from rest to the velocity.
+                const auto accelerationTimes = [&](double velocity, double& jerk_time, double& constant_time){
+                    if(velocity * maxJerk <= maxAcceleration * maxAcceleration){
+                        jerk_time = std::sqrt(velocity / maxJerk);
+                        constant_time = 0.0;
+                    }
+                    else{
+                        jerk_time = maxAcceleration / maxJerk;
+                        constant_time = velocity / maxAcceleration - jerk_time;
+                    }
+                };
+
+                double jerkTime;
+                double constantTime;
+                double velocity = maxVelocity;
+                accelerationTimes(velocity, jerkTime, constantTime);
+                double cruiseTime = 0.0;
+                const double accelerationDistance = velocity * (2.0 * jerkTime + constantTime) / 2.0;
+                if(2.0 * accelerationDistance <= distance){
+                    cruiseTime = (distance - 2.0 * accelerationDistance) / velocity;
+                }
+                else{
+                    // The velocity limit is not reached, the peak velocity is where accelerating and decelerating meet.
+                    velocity = std::cbrt(distance * distance * maxJerk / 4.0);
+                    if(velocity * maxJerk > maxAcceleration * maxAcceleration){
+                        const double ratio = maxAcceleration * maxAcceleration / maxJerk;
+                        velocity = (-ratio + std::sqrt(ratio * ratio + 4.0 * maxAcceleration * distance)) / 2.0;
+                    }
+                    accelerationTimes(velocity, jerkTime, constantTime);
+                }
+
+                const double peakAcceleration = maxJerk * jerkTime;
+                durations = {jerkTime, constantTime, jerkTime, cruiseTime, jerkTime, constantTime, jerkTime};
+                jerks = {maxJerk, 0.0, -maxJerk, 0.0, -maxJerk, 0.0, maxJerk};
+                accelerations = {0.0, peakAcceleration, peakAcceleration, 0.0, 0.0, -peakAcceleration, -peakAcceleration};
+            }
+            else if(distance > 0.0){
+                double accelerationTime = maxVelocity / maxAcceleration;
+                double cruiseTime = 0.0;
+                if(maxVelocity * accelerationTime > distance){
+                    accelerationTime = std::sqrt(distance / maxAcceleration);
+                }
+                else{
+                    cruiseTime = (distance - maxVelocity * accelerationTime) / maxVelocity;
+                }
+
+                durations = {0.0, accelerationTime, 0.0, cruiseTime, 0.0, accelerationTime, 0.0};
+                accelerations = {0.0, maxAcceleration, 0.0, 0.0, 0.0, -maxAcceleration, 0.0};
+            }
+
+            double profileDuration = 0.0;
+            for(const double phaseDuration : durations)
+            {
+                profileDuration += phaseDuration;
+            }
+
+            // Stretching time by a factor divides the velocities by it, the accelerations by its square and the jerks by its cube.
+            double scale = 1.0;
+            if(profileDuration > 0.0 && duration > profileDuration){
+                scale = duration / profileDuration;
+                profileDuration = duration;
+            }
+
+            ProfilePhase phase{0.0, start_position, 0.0, 0.0, 0.0};
+            for(std::size_t i = 0; i < durations.size(); i++)
+            {
+                phase.acceleration = direction * accelerations[i] / (scale * scale);
+                phase.jerk = direction * jerks[i] / (scale * scale * scale);
+                profile.phases[i] = phase;
+
+                const double dt = durations[i] * scale;
+                phase.startTime += dt;
+                phase.position += dt * (phase.velocity + dt * (phase.acceleration / 2.0 + dt * phase.jerk / 6.0));
+                phase.velocity += dt * (phase.acceleration + dt * phase.jerk / 2.0);
+            }
+
+            // The rest at the target, exact instead of the integrated position.
+            profile.phases[AxisProfile::PhaseCount - 1] = ProfilePhase{profileDuration, target_position, 0.0, 0.0, 0.0};
+
+            return profileDuration;
+        }
+
+        ProfileState evaluateProfile(const AxisProfile& profile, double time, std::size_t& phase_index)
+        {
+            if(time < profile.phases[phase_index].startTime){
+                phase_index = 0;
+            }
+            while(phase_index + 1 < AxisProfile::PhaseCount && time >= profile.phases[phase_index + 1].startTime)
+            {
+                phase_index++;
+            }
+
+            const ProfilePhase& phase = profile.phases[phase_index];
+            const double dt = std::max(0.0, time - phase.startTime);
+
+            return ProfileState{
+                phase.position + dt * (phase.velocity + dt * (phase.acceleration / 2.0 + dt * phase.jerk / 6.0)),
+                phase.velocity + dt * (phase.acceleration + dt * phase.jerk / 2.0),
+                phase.acceleration + dt * phase.jerk
+            };
+        }
+
+        MotionPlanner::MotionPlanner(
+            uint8_t* domain_data,
+            const std::vector<uint32_t>& position_offsets,
+            const std::vector<AxisLimits>& limits
+        )
+            : m_DomainData(domain_data),
+              m_PositionOffsets(position_offsets),
+              m_Limits(limits),
+              m_PhaseIndices(position_offsets.size(), 0),
+              m_States(position_offsets.size(), ProfileState{0.0, 0.0, 0.0})
+        {
+            for(auto& plan : m_Plans)
+            {
+                plan.profiles.resize(position_offsets.size());
+            }
+        }
+
+        std::unique_ptr<MotionPlanner> MotionPlanner::fromDrivers(
+            const std::vector<ec::slave::Driver*>& drivers,
+            const std::vector<AxisLimits>& limits,
+            const std::string& position_entry_name
+        )
+        {
+            if(drivers.empty() || drivers.size() != limits.size()){
+                return nullptr;
+            }
+
+            uint8_t* domainData = drivers.front()->getDomainDataPtr();
+            std::vector<uint32_t> positionOffsets;
+            positionOffsets.reserve(drivers.size());
+            for(auto* driver : drivers)
+            {
+                if(!domainData || driver->getDomainDataPtr() != domainData){
+                    return nullptr;
+                }
+                const auto positionOffset = driver->getOffsetPtr(position_entry_name);
+                if(!positionOffset){
+                    return nullptr;
+                }
+                positionOffsets.push_back(*positionOffset.value());
+            }
+
+            return std::make_unique<MotionPlanner>(domainData, positionOffsets, limits);
+        }
+
+        bool MotionPlanner::plan(
+            const std::vector<double>& start_positions,
+            const std::vector<double>& target_positions,
+            uint64_t start_time_ns,
+            ProfileType type
+        )
+        {
+            if(start_positions.size() != size() || target_positions.size() != size() || m_Limits.size() != size()){
+                return false;
+            }
+            for(const auto& limits : m_Limits)
+            {
+                if(limits.maxVelocity <= 0.0 || limits.maxAcceleration <= 0.0 || (type == ProfileType::SCurve && limits.maxJerk <= 0.0)){
+                    return false;
+                }
+            }
+
+            // update() only switches plans while one is pending, so the spare plan is not read until it is published below.
+            if(m_IsPlanPending.load(std::memory_order_acquire)){
+                return false;
+            }
+            Plan& spare = m_Plans[1 - m_ActivePlan];
+
+            double duration = 0.0;
+            for(std::size_t axis = 0; axis < size(); axis++)
+            {
+                duration = std::max(duration, computeProfile(start_positions[axis], target_positions[axis], m_Limits[axis], type, 0.0, spare.profiles[axis]));
+            }
+            for(std::size_t axis = 0; axis < size(); axis++)
+            {
+                computeProfile(start_positions[axis], target_positions[axis], m_Limits[axis], type, duration, spare.profiles[axis]);
+            }
+            spare.startTimeNs = start_time_ns;
+            spare.duration = duration;
+
+            m_IsPlanPending.store(true, std::memory_order_release);
+
+            return true;
+        }
+
+        bool MotionPlanner::update(uint64_t time_ns)
+        {
+            if(m_IsPlanPending.load(std::memory_order_acquire)){
+                m_ActivePlan = 1 - m_ActivePlan;
+                std::fill(m_PhaseIndices.begin(), m_PhaseIndices.end(), 0);
+                m_HasPlan = true;
+                m_IsPlanPending.store(false, std::memory_order_release);
+            }
+            if(!m_HasPlan){
+                return false;
+            }
+
+            const Plan& plan = m_Plans[m_ActivePlan];
+            const double time = (double)(int64_t)(time_ns - plan.startTimeNs) * 1e-9;
+            for(std::size_t axis = 0; axis < size(); axis++)
+            {
+                m_States[axis] = evaluateProfile(plan.profiles[axis], time, m_PhaseIndices[axis]);
+                // The entries are 32 bit, positions beyond their range wrap like the drive's position counter.
+                EC_WRITE_S32(m_DomainData + m_PositionOffsets[axis], (int32_t)(uint32_t)std::llround(m_States[axis].position));
+            }
+            m_IsDone = time >= plan.duration;
+
+            return true;
+        }
+
+    } // End of namespace motion
+} // End of namespace ec
@@ -10,47 +10,241 @@
  */
 
 #include "ethercat_interface/parser.hpp"
+#include "ethercat_interface/config_cache.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <type_traits>
 
 namespace ec
 {
     namespace parser
     {
+        namespace
+        {
+            /**
+             * @brief Reads an integer of exactly the given type, std::nullopt if the value does not fit into it.
+             * Read through 64 bits first, so an 8 bit value is never taken as a character or silently narrowed.
+             *
+             */
+            template<typename T>
+            std::optional<T> parseInteger(const YAML::Node& node)
+            {
+                using Wide = std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>;
+                const Wide value = node.as<Wide>();
+                if(value < std::numeric_limits<T>::min() || value > std::numeric_limits<T>::max()){
+                    return std::nullopt;
+                }
+                return static_cast<T>(value);
+            }
+
+            template<typename T>
+            std::optional<uint64_t> parseRaw(const YAML::Node& node)
+            {
+                using Unsigned = std::make_unsigned_t<T>;
+                const auto value = parseInteger<T>(node);
+                if(!value){
+                    return std::nullopt;
+                }
+                return static_cast<Unsigned>(value.value());
+            }
+        }
+
         std::optional<ProgramConfig> parseConfigFile(const std::string& path_to_config_file)
         {
-            const auto configDocs = YAML::LoadAllFromFile(path_to_config_file);
-            if(configDocs.empty()){
+            return parseConfigDocuments(YAML::LoadAllFromFile(path_to_config_file));
+        }
+
+        std::optional<ProgramConfig> parseConfigFileCached(
+            const std::string& path_to_config_file,
+            const std::string& path_to_cache_file,
+            uint64_t* content_hash
+        )
+        {
+            std::ifstream configFile(path_to_config_file);
+            if(!configFile){
+                return std::nullopt;
+            }
+            std::stringstream contentStream;
+            contentStream << configFile.rdbuf();
+            const std::string content = contentStream.str();
+
+            const std::string cachePath = path_to_cache_file.empty() ? path_to_config_file + ".cache" : path_to_cache_file;
+            const uint64_t contentHash = cache::hashContent(content);
+            if(content_hash){
+                *content_hash = contentHash;
+            }
+
+            if(auto cachedConfig = cache::readCacheFile(cachePath, contentHash)){
+                return cachedConfig;
+            }
+
+            auto programConfig = parseConfigDocuments(YAML::LoadAll(content));
+            if(programConfig){
+                // A failed write only costs the next start another YAML parse.
+                cache::writeCacheFile(cachePath, programConfig.value(), contentHash);
+            }
+
+            return programConfig;
+        }
+
+        std::optional<std::vector<uint8_t>> encodeSdoValue(const YAML::Node& value_node, DataType type)
+        {
+            std::optional<uint64_t> raw = 0;
+            std::size_t size = 0;
+            switch(type)
+            {
+            case DataType::UINT8: raw = parseRaw<uint8_t>(value_node); size = 1; break;
+            case DataType::INT8: raw = parseRaw<int8_t>(value_node); size = 1; break;
+            case DataType::UINT16: raw = parseRaw<uint16_t>(value_node); size = 2; break;
+            case DataType::INT16: raw = parseRaw<int16_t>(value_node); size = 2; break;
+            case DataType::UINT32: raw = parseRaw<uint32_t>(value_node); size = 4; break;
+            case DataType::INT32: raw = parseRaw<int32_t>(value_node); size = 4; break;
+            case DataType::UINT64: raw = parseRaw<uint64_t>(value_node); size = 8; break;
+            case DataType::INT64: raw = parseRaw<int64_t>(value_node); size = 8; break;
+            case DataType::FLOAT:
+            {
+                const float value = value_node.as<float>();
+                uint32_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                raw = bits;
+                size = 4;
+                break;
+            }
+            case DataType::DOUBLE:
+            {
+                const double value = value_node.as<double>();
+                uint64_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                raw = bits;
+                size = 8;
+                break;
+            }
+            default:
+                break;
+            }
+
+            if(!raw){
+                return std::nullopt;
+            }
+
+            std::vector<uint8_t> data(size);
+            for(std::size_t i = 0; i < size; i++)
+            {
+                data[i] = static_cast<uint8_t>(raw.value() >> (8 * i));
+            }
+
+            return data;
+        }
+
+        std::optional<EntryFilter> parseEntryFilter(const YAML::Node& filter_node)
+        {
+            EntryFilter filter;
+            const std::string filterType = filter_node["type"].as<std::string>("");
+            if(filterType == "biquad"){
+                auto b = filter_node["b"].as<std::vector<double>>(std::vector<double>{});
+                auto a = filter_node["a"].as<std::vector<double>>(std::vector<double>{});
+                if(a.size() == 3 && a[0] != 0.0){
+                    // Normalized to a0 = 1, filter design tools print a0 as well.
+                    const double a0 = a[0];
+                    for(double& coefficient : b)
+                    {
+                        coefficient /= a0;
+                    }
+                    a = {a[1] / a0, a[2] / a0};
+                }
+                if(b.size() != 3 || a.size() != 2){
+                    return std::nullopt;
+                }
+                filter.type = FilterType::Biquad;
+                filter.coefficients = {b[0], b[1], b[2], a[0], a[1]};
+            }
+            else if(filterType == "moving_average"){
+                const int window = filter_node["window"].as<int>(0);
+                if(window < 1 || window > UINT16_MAX){
+                    return std::nullopt;
+                }
+                filter.type = FilterType::MovingAverage;
+                filter.window = (uint16_t)window;
+            }
+            else if(filterType == "median3"){
+                filter.type = FilterType::Median3;
+            }
+            else{
+                return std::nullopt;
+            }
+
+            return filter;
+        }
+
+        std::optional<EntryLimit> parseEntryLimit(const YAML::Node& limit_node)
+        {
+            EntryLimit limit;
+            limit.isLimited = true;
+            limit.min = limit_node["min"].as<double>(limit.min);
+            limit.max = limit_node["max"].as<double>(limit.max);
+            limit.maxStep = limit_node["max_step"].as<double>(limit.maxStep);
+            if(limit.min > limit.max || limit.maxStep < 0.0){
+                return std::nullopt;
+            }
+
+            return limit;
+        }
+
+        std::optional<ProgramConfig> parseConfigDocuments(const std::vector<YAML::Node>& config_docs)
+        {
+            if(config_docs.empty()){
                 return std::nullopt;
             }
             ProgramConfig pConf;
 
-            for(const YAML::Node& doc : configDocs)
+            for(const YAML::Node& doc : config_docs)
             {
                 if(const auto& program_config = doc["program_config"])
                 {
-
+                    if(program_config.IsMap()){
+                        if(const auto cyclePeriodNode = program_config["cycle_period"]){
+                            pConf.cyclePeriod = cyclePeriodNode.as<uint16_t>();
+                        }
+                        if(const auto masterIndexNode = program_config["master_index"]){
+                            pConf.masterIndex = masterIndexNode.as<uint16_t>();
+                        }
+                        if(const auto cpuCoreNode = program_config["cpu_core"]){
+                            pConf.cpuCore = cpuCoreNode.as<int32_t>();
+                        }
+                        if(const auto alignCyclesNode = program_config["align_cycles"]){
+                            pConf.alignCycles = alignCyclesNode.as<bool>();
+                        }
+                        if(const auto cycleOffsetNode = program_config["cycle_offset"]){
+                            pConf.cycleOffset = cycleOffsetNode.as<uint32_t>();
+                        }
+                    }
                     continue;
                 }
                 
                 auto slaveInformationExp = parseSlaveConfig(doc);
-                if(slaveInformationExp.has_value()){
-                    const auto slaveInformation = slaveInformationExp.value();
-                    if(std::holds_alternative<std::vector<SlaveInfo>>(slaveInformation)){
-                        const auto& slaveInfoVec = std::get<std::vector<SlaveInfo>>(slaveInformation);
-                        for(auto slaveInfoIter= slaveInfoVec.cbegin(); slaveInfoIter != slaveInfoVec.cend(); slaveInfoIter++)
-                        {
-                            pConf.slaveConfigurations.push_back(std::move(*slaveInfoIter));
-                        }   
-                    }
-                    else if(std::holds_alternative<SlaveInfo>(slaveInformation)){
-                        pConf.slaveConfigurations.push_back(std::move(
-                            std::get<SlaveInfo>(slaveInformation)
-                        ));
-                    }
+                if(!slaveInformationExp){
+                    // Leaving the slave out would run the rest of the bus with it unconfigured.
+                    std::cout << "Invalid configuration of slave " << doc["slave_name"].as<std::string>("") << "\n";
+                    return std::nullopt;
+                }
+
+                auto& slaveInformation = slaveInformationExp.value();
+                if(std::holds_alternative<std::vector<SlaveInfo>>(slaveInformation)){
+                    auto& slaveInfoVec = std::get<std::vector<SlaveInfo>>(slaveInformation);
+                    for(auto slaveInfoIter= slaveInfoVec.begin(); slaveInfoIter != slaveInfoVec.end(); slaveInfoIter++)
+                    {
+                        pConf.slaveConfigurations.push_back(std::move(*slaveInfoIter));
+                    }   
+                }
+                else if(std::holds_alternative<SlaveInfo>(slaveInformation)){
+                    pConf.slaveConfigurations.push_back(std::move(
+                        std::get<SlaveInfo>(slaveInformation)
+                    ));
                 }
-                else
-                {
-                  continue;
-                } 
 
             }
 
@@ -90,12 +284,57 @@ namespace ec
                 dcConfig.sync0Shift = dc_node["sync0_shift"].as<int32_t>();
                 dcConfig.sync1Activate = dc_node["sync1_activate"].as<uint32_t>();
                 dcConfig.sync1Shift = dc_node["sync1_shift"].as<int32_t>();
+                if(const auto applyNode = dc_node["apply_to_slave"]){
+                    dcConfig.isAppliedToSlave = applyNode.as<bool>();
+                }
                 slaveInfo.distributedClockConfig = dcConfig;
             }
             else{
                 slaveInfo.distributedClockConfig = std::nullopt;
             }
 
+            if(const auto divisorNode = slave_node["cycle_divisor"]){
+                slaveInfo.tuning.cycleDivisor = std::max<uint16_t>(1, divisorNode.as<uint16_t>());
+            }
+
+            if(const auto telemetryNode = slave_node["telemetry"]){
+                slaveInfo.tuning.telemetryEntries = telemetryNode.as<std::vector<std::string>>();
+            }
+
+            if(const auto startupSdosNode = slave_node["startup_sdos"]){
+                std::vector<StartupSdo> startupSdos;
+                for(const YAML::Node& sdoNode : startupSdosNode)
+                {
+                    StartupSdo startupSdo;
+                    startupSdo.index = sdoNode["index"].as<uint16_t>();
+                    const auto subindex = parseInteger<Subindex>(sdoNode["subindex"]);
+                    if(!subindex){
+                        std::cout << slaveInfo.slaveName << ": subindex of startup SDO 0x" << std::hex << startupSdo.index << std::dec << " is out of range\n";
+                        return std::nullopt;
+                    }
+                    const std::string typeName = sdoNode["type"].as<std::string>();
+                    const auto typeFound = dataTypes.find(typeName);
+                    if(typeFound == dataTypes.end()){
+                        std::cout << slaveInfo.slaveName << ": startup SDO 0x" << std::hex << startupSdo.index << std::dec << " has the unknown type " << typeName << "\n";
+                        return std::nullopt;
+                    }
+                    startupSdo.subindex = subindex.value();
+                    startupSdo.type = typeFound->second;
+                    auto data = encodeSdoValue(sdoNode["value"], startupSdo.type);
+                    if(!data){
+                        std::cout << slaveInfo.slaveName << ": value of startup SDO 0x" << std::hex << startupSdo.index << std::dec << " does not fit " << typeName << "\n";
+                        return std::nullopt;
+                    }
+                    startupSdo.data = std::move(data.value());
+                    startupSdos.emplace_back(std::move(startupSdo));
+                }
+                // Shared by every instance created from this node, like the layout.
+                slaveInfo.startupSdos = std::make_shared<const std::vector<StartupSdo>>(std::move(startupSdos));
+            }
+
+            // Every instance created from this node shares the layout.
+            SlaveLayout slaveLayout;
+
             for(const YAML::Node& sync_manager : slave_node["sync_manager_config"])
             {
                 SyncManagerConfig smConfig;
@@ -123,7 +362,7 @@ namespace ec
                     smConfig.watchdogMode = EC_WD_DISABLE;
                 }
 
-                slaveInfo.syncManagerConfig.emplace_back(std::move(smConfig));
+                slaveLayout.syncManagerConfig.emplace_back(std::move(smConfig));
             }
 
             constexpr uint16_t maxNumOfPdoMappings = 8;
@@ -155,16 +394,65 @@ namespace ec
 
                             return typeFound->second;
                         }();
+                        if(const auto scaleNode = entry["scale"]){
+                            slaveInfo.tuning.scalingFactors[pdoEntry.entryName] = scaleNode.as<double>();
+                        }
+                        if(const auto filterNode = entry["filter"]){
+                            const auto filter = parseEntryFilter(filterNode);
+                            if(!filter){
+                                std::cout << slaveInfo.slaveName << ": filter of entry " << pdoEntry.entryName << " is invalid\n";
+                                return std::nullopt;
+                            }
+                            pdoEntry.filter = filter.value();
+                        }
+                        if(const auto limitNode = entry["limit"]){
+                            const auto limit = parseEntryLimit(limitNode);
+                            if(!limit){
+                                std::cout << slaveInfo.slaveName << ": limit of entry " << pdoEntry.entryName << " is invalid\n";
+                                return std::nullopt;
+                            }
+                            pdoEntry.limit = limit.value();
+                        }
+                        if(const auto countNode = entry["count"]){
+                            // The samples of an array are read as whole bytes and are neither filtered nor limited.
+                            const int count = countNode.as<int>(0);
+                            const bool isArrayOk = count >= 1 &&
+                                                   pdoEntry.subindex + count - 1 <= UINT8_MAX &&
+                                                   (count == 1 || (pdoEntry.bitlength % 8 == 0 &&
+                                                                   pdoEntry.filter.type == FilterType::None &&
+                                                                   !pdoEntry.limit.isLimited));
+                            if(!isArrayOk){
+                                std::cout << slaveInfo.slaveName << ": count of entry " << pdoEntry.entryName << " is invalid\n";
+                                return std::nullopt;
+                            }
+                            pdoEntry.count = (uint16_t)count;
+                        }
+                        if(const auto timestampNode = entry["timestamp"]){
+                            bool isTimestamp = false;
+                            // Lower 32 bits or all 64 bits of the DC system time, one value per entry.
+                            const bool isTimestampOk = YAML::convert<bool>::decode(timestampNode, isTimestamp) &&
+                                                       (!isTimestamp ||
+                                                        ((pdoEntry.type == DataType::UINT32 || pdoEntry.type == DataType::INT32 ||
+                                                          pdoEntry.type == DataType::UINT64 || pdoEntry.type == DataType::INT64) &&
+                                                         pdoEntry.count == 1 &&
+                                                         pdoEntry.filter.type == FilterType::None &&
+                                                         !pdoEntry.limit.isLimited));
+                            if(!isTimestampOk){
+                                std::cout << slaveInfo.slaveName << ": timestamp flag of entry " << pdoEntry.entryName << " is invalid\n";
+                                return std::nullopt;
+                            }
+                            pdoEntry.isTimestamp = isTimestamp;
+                        }
                         pdo.entries.emplace_back(pdoEntry);
                     }
 
                     if(pdoType == "rx"){
                         pdo.pdoType = PDO_Type::RxPDO;
-                        slaveInfo.rxPDOs.emplace_back(pdo);
+                        slaveLayout.rxPDOs.emplace_back(std::move(pdo));
                     }
                     else if(pdoType == "tx"){
                         pdo.pdoType = PDO_Type::TxPDO;
-                        slaveInfo.txPDOs.emplace_back(pdo);
+                        slaveLayout.txPDOs.emplace_back(std::move(pdo));
                     }
 
                     pdoMappingYamlNodeName = "pdo_mapping_";
@@ -173,6 +461,8 @@ namespace ec
                     break;
                 }
             }
+
+            slaveInfo.layout = std::make_shared<const SlaveLayout>(std::move(slaveLayout));
             
             if(slaveCount > 1){
                 const auto slaveTags = slave_node["slave_tags"].as<std::vector<std::string>>();
@@ -180,14 +470,14 @@ namespace ec
                 int slavePosition = slaveInfo.position - 1;
                 for(std::vector<std::string>::const_iterator slaveTagIter = slaveTags.cbegin(); slaveTagIter != slaveTags.cend(); slaveTagIter++)
                 {  
-                    // Override the slave name with the tag given in the config file
+                    // Override the slave name with the tag given in the config file, the layout pointer is shared.
                     SlaveInfo currInfo = slaveInfo;
                     currInfo.slaveName = *slaveTagIter;
                     // Increment the position of the slaves in the bus.
                     currInfo.position = slavePosition + 1;
                     slavePosition += 1;
                     // Leave the rest of the parameters untouched
-                    multipleSlaveInformation.push_back(currInfo);
+                    multipleSlaveInformation.push_back(std::move(currInfo));
                 } 
 
                 if(slaveTags.size() != multipleSlaveInformation.size()){
@@ -0,0 +1,163 @@
+/**
+ * @file position_extender.cpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ethercat_interface/driver/position_extender.hpp"
+#include "ethercat_interface/entry_access.hpp"
+
+namespace ec
+{
+    namespace motion
+    {
+
+        namespace
+        {
+
+            bool isCounterEntry(const ec::SlaveLayout& layout, const std::string& entry_name)
+            {
+                for(const auto* pdos : {&layout.rxPDOs, &layout.txPDOs})
+                {
+                    for(const auto& pdo : *pdos)
+                    {
+                        for(const auto& entry : pdo.entries)
+                        {
+                            if(entry.entryName == entry_name){
+                                return entry.type == ec::DataType::INT32 || entry.type == ec::DataType::UINT32;
+                            }
+                        }
+                    }
+                }
+
+                return false;
+            }
+
+            /**
+             * @brief Sign extends the bits of the value within the mask: the range of the mask is subtracted if the highest bit is set.
+             *
+             */
+            int32_t signExtend(uint32_t value, uint32_t mask)
+            {
+                const uint32_t masked = value & mask;
+                return (int32_t)(masked - ((masked & ~(mask >> 1)) << 1));
+            }
+
+        } // End of anonymous namespace
+
+        PositionExtender::PositionExtender(uint8_t* domain_data, const std::vector<PositionEntries>& axes)
+            : m_DomainData(domain_data),
+              m_Entries(axes),
+              m_Masks(axes.size(), UINT32_MAX),
+              m_Counters(axes.size(), 0),
+              m_PreviousCounters(axes.size(), 0),
+              m_Positions(axes.size(), 0)
+        {
+
+        }
+
+        std::optional<PositionExtender> PositionExtender::fromDrivers(
+            const std::vector<ec::slave::Driver*>& drivers,
+            const std::string& actual_entry_name,
+            const std::string& target_entry_name
+        )
+        {
+            if(drivers.empty()){
+                return std::nullopt;
+            }
+
+            uint8_t* domainData = drivers.front()->getDomainDataPtr();
+            std::vector<PositionEntries> axes;
+            axes.reserve(drivers.size());
+            for(auto* driver : drivers)
+            {
+                const auto actualOffset = driver->getOffsetPtr(actual_entry_name);
+                if(driver->getDomainDataPtr() != domainData || !actualOffset || !isCounterEntry(driver->getLayout(), actual_entry_name)){
+                    return std::nullopt;
+                }
+
+                PositionEntries entries{*actualOffset.value(), std::nullopt, driver->getStaleFlag()};
+                if(!target_entry_name.empty()){
+                    const auto targetOffset = driver->getOffsetPtr(target_entry_name);
+                    if(!targetOffset || !isCounterEntry(driver->getLayout(), target_entry_name)){
+                        return std::nullopt;
+                    }
+                    entries.targetOffset = *targetOffset.value();
+                }
+                axes.push_back(entries);
+            }
+
+            return PositionExtender(domainData, axes);
+        }
+
+        bool PositionExtender::setCounterBits(std::size_t axis, uint8_t bits)
+        {
+            if(bits < 2 || bits > 32){
+                return false;
+            }
+
+            m_Masks[axis] = UINT32_MAX >> (32 - bits);
+
+            return true;
+        }
+
+        void PositionExtender::update()
+        {
+            const std::size_t axisCount = size();
+            // The counter of a stale axis is taken as unchanged, so its position is held.
+            for(std::size_t i = 0; i < axisCount; i++)
+            {
+                m_Counters[i] = entry::isStale(m_Entries[i].staleFlag)
+                    ? m_PreviousCounters[i]
+                    : EC_READ_U32(m_DomainData + m_Entries[i].actualOffset);
+            }
+
+            const uint32_t* masks = m_Masks.data();
+            const uint32_t* counters = m_Counters.data();
+            uint32_t* previousCounters = m_PreviousCounters.data();
+            int64_t* positions = m_Positions.data();
+            if(!m_IsPrimed){
+                for(std::size_t i = 0; i < axisCount; i++)
+                {
+                    positions[i] = signExtend(counters[i], masks[i]);
+                    previousCounters[i] = counters[i];
+                }
+                m_IsPrimed = true;
+                return;
+            }
+
+            // Sign extending the difference to the last counter turns a step across the wrap into a small step
+            // instead of almost the whole counter range.
+            for(std::size_t i = 0; i < axisCount; i++)
+            {
+                positions[i] += signExtend(counters[i] - previousCounters[i], masks[i]);
+                previousCounters[i] = counters[i];
+            }
+        }
+
+        bool PositionExtender::setTarget(std::size_t axis, int64_t target)
+        {
+            if(!m_Entries[axis].targetOffset){
+                return false;
+            }
+
+            const uint32_t mask = m_Masks[axis];
+            const int64_t halfRange = (int64_t)(mask >> 1) + 1;
+            const int64_t step = target - m_Positions[axis];
+            if(step >= halfRange || step < -halfRange){
+                return false;
+            }
+
+            const uint32_t counter = (m_PreviousCounters[axis] + (uint32_t)step) & mask;
+            EC_WRITE_U32(m_DomainData + m_Entries[axis].targetOffset.value(), counter);
+
+            return true;
+        }
+
+    } // End of namespace motion
+} // End of namespace ec
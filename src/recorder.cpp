@@ -0,0 +1,403 @@
+/**
+ * @file recorder.cpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ethercat_interface/recorder.hpp"
+
+#include <cstring>
+#include <chrono>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+namespace ec
+{
+    namespace recorder
+    {
+
+        ProcessDataRecorder::ProcessDataRecorder()
+        {
+
+        }
+
+        ProcessDataRecorder::~ProcessDataRecorder()
+        {
+            close();
+        }
+
+        bool ProcessDataRecorder::open(
+            const std::string& path,
+            const std::vector<DomainImageInfo>& domains,
+            std::size_t cycle_capacity,
+            std::size_t ring_slots
+        )
+        {
+            if(isOpen() || domains.empty() || cycle_capacity == 0 || ring_slots < 2){
+                return false;
+            }
+
+            m_Domains = domains;
+            m_DomainOffsets.clear();
+            m_FrameSize = 0;
+            for(const auto& domain : m_Domains)
+            {
+                if(domain.name.size() >= MaxDomainNameLength){
+                    return false;
+                }
+                m_DomainOffsets.push_back(m_FrameSize);
+                m_FrameSize += domain.size;
+            }
+
+            const std::size_t descriptorsOffset = sizeof(RecordingHeader);
+            const std::size_t indexOffset = descriptorsOffset + sizeof(DomainDescriptor) * m_Domains.size();
+            const std::size_t dataOffset = indexOffset + sizeof(IndexEntry) * cycle_capacity;
+            m_FileSize = dataOffset + m_FrameSize * cycle_capacity;
+
+            m_FileDescriptor = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+            if(m_FileDescriptor < 0){
+                return false;
+            }
+
+            // Reserve the blocks up front so the writer thread never has to extend the file.
+            if(posix_fallocate(m_FileDescriptor, 0, m_FileSize) != 0){
+                ::close(m_FileDescriptor);
+                m_FileDescriptor = -1;
+                return false;
+            }
+
+            void* mapping = mmap(nullptr, m_FileSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_FileDescriptor, 0);
+            if(mapping == MAP_FAILED){
+                ::close(m_FileDescriptor);
+                m_FileDescriptor = -1;
+                return false;
+            }
+            m_FileData = static_cast<uint8_t*>(mapping);
+
+            m_Header = reinterpret_cast<RecordingHeader*>(m_FileData);
+            std::memcpy(m_Header->magic, RecordingMagic, sizeof(RecordingMagic));
+            m_Header->version = RecordingVersion;
+            m_Header->domainCount = (uint32_t)m_Domains.size();
+            m_Header->cycleCapacity = cycle_capacity;
+            m_Header->frameSize = m_FrameSize;
+            m_Header->indexOffset = indexOffset;
+            m_Header->dataOffset = dataOffset;
+            m_Header->framesWritten = 0;
+
+            auto descriptors = reinterpret_cast<DomainDescriptor*>(m_FileData + descriptorsOffset);
+            for(std::size_t i = 0; i < m_Domains.size(); i++)
+            {
+                std::memset(descriptors[i].name, 0, MaxDomainNameLength);
+                std::memcpy(descriptors[i].name, m_Domains[i].name.data(), m_Domains[i].name.size());
+                descriptors[i].size = m_Domains[i].size;
+                descriptors[i].offsetInFrame = m_DomainOffsets[i];
+            }
+
+            m_RingSlots = ring_slots;
+            m_RingFrames = std::make_unique<uint8_t[]>(m_FrameSize * m_RingSlots);
+            m_RingIndex = std::make_unique<IndexEntry[]>(m_RingSlots);
+            // Touch the ring once so the cyclic thread does not take the page faults.
+            std::memset(m_RingFrames.get(), 0, m_FrameSize * m_RingSlots);
+
+            m_RingHead.store(0);
+            m_RingTail.store(0);
+            m_DroppedFrames.store(0);
+            m_WrittenFrames.store(0);
+
+            m_IsWriterRunning.store(true);
+            m_WriterThread = std::thread(&ProcessDataRecorder::writerLoop, this);
+
+            return true;
+        }
+
+        void ProcessDataRecorder::close()
+        {
+            if(!isOpen()){
+                return;
+            }
+
+            m_IsWriterRunning.store(false);
+            if(m_WriterThread.joinable()){
+                m_WriterThread.join();
+            }
+            // Frames recorded after the writer has seen the stop flag.
+            drainRing();
+
+            msync(m_FileData, m_FileSize, MS_SYNC);
+            munmap(m_FileData, m_FileSize);
+            ::close(m_FileDescriptor);
+
+            m_FileData = nullptr;
+            m_Header = nullptr;
+            m_FileDescriptor = -1;
+            m_RingFrames.reset();
+            m_RingIndex.reset();
+        }
+
+        bool ProcessDataRecorder::record(uint64_t cycle, uint64_t timestamp, const uint8_t* const* images)
+        {
+            const std::size_t head = m_RingHead.load(std::memory_order_relaxed);
+            const std::size_t nextHead = (head + 1) % m_RingSlots;
+            if(nextHead == m_RingTail.load(std::memory_order_acquire)){
+                m_DroppedFrames.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            uint8_t* frame = m_RingFrames.get() + head * m_FrameSize;
+            for(std::size_t i = 0; i < m_Domains.size(); i++)
+            {
+                std::memcpy(frame + m_DomainOffsets[i], images[i], m_Domains[i].size);
+            }
+            m_RingIndex[head] = {cycle, timestamp};
+
+            m_RingHead.store(nextHead, std::memory_order_release);
+
+            return true;
+        }
+
+        void ProcessDataRecorder::writerLoop()
+        {
+            while(m_IsWriterRunning.load())
+            {
+                if(drainRing() == 0){
+                    std::this_thread::sleep_for(std::chrono::microseconds(500));
+                }
+            }
+        }
+
+        std::size_t ProcessDataRecorder::drainRing()
+        {
+            std::size_t tail = m_RingTail.load(std::memory_order_relaxed);
+            const std::size_t head = m_RingHead.load(std::memory_order_acquire);
+
+            auto fileIndex = reinterpret_cast<IndexEntry*>(m_FileData + m_Header->indexOffset);
+            uint8_t* fileFrames = m_FileData + m_Header->dataOffset;
+
+            std::size_t drained = 0;
+            while(tail != head)
+            {
+                const std::size_t slot = m_Header->framesWritten % m_Header->cycleCapacity;
+                std::memcpy(fileFrames + slot * m_FrameSize, m_RingFrames.get() + tail * m_FrameSize, m_FrameSize);
+                fileIndex[slot] = m_RingIndex[tail];
+                m_Header->framesWritten += 1;
+
+                tail = (tail + 1) % m_RingSlots;
+                drained += 1;
+            }
+
+            m_RingTail.store(tail, std::memory_order_release);
+            m_WrittenFrames.fetch_add(drained, std::memory_order_relaxed);
+
+            return drained;
+        }
+
+        ProcessDataPlayer::ProcessDataPlayer()
+        {
+
+        }
+
+        ProcessDataPlayer::~ProcessDataPlayer()
+        {
+            close();
+        }
+
+        bool ProcessDataPlayer::open(const std::string& path)
+        {
+            if(m_FileData){
+                return false;
+            }
+
+            m_FileDescriptor = ::open(path.c_str(), O_RDONLY);
+            if(m_FileDescriptor < 0){
+                return false;
+            }
+
+            const off_t fileSize = lseek(m_FileDescriptor, 0, SEEK_END);
+            if(fileSize < (off_t)sizeof(RecordingHeader)){
+                ::close(m_FileDescriptor);
+                m_FileDescriptor = -1;
+                return false;
+            }
+            m_FileSize = (std::size_t)fileSize;
+
+            void* mapping = mmap(nullptr, m_FileSize, PROT_READ, MAP_SHARED, m_FileDescriptor, 0);
+            if(mapping == MAP_FAILED){
+                ::close(m_FileDescriptor);
+                m_FileDescriptor = -1;
+                return false;
+            }
+            m_FileData = static_cast<const uint8_t*>(mapping);
+            m_Header = reinterpret_cast<const RecordingHeader*>(m_FileData);
+
+            const bool headerOk = [this]() -> bool {
+                if(std::memcmp(m_Header->magic, RecordingMagic, sizeof(RecordingMagic)) != 0){
+                    return false;
+                }
+                if(m_Header->version != RecordingVersion || m_Header->domainCount == 0 || m_Header->cycleCapacity == 0){
+                    return false;
+                }
+
+                // Every table has to lie inside the file, checked without overflowing on a corrupted header.
+                const auto fitsInFile = [this](uint64_t offset, uint64_t element_size, uint64_t count) -> bool {
+                    return offset <= m_FileSize && count <= (m_FileSize - offset) / element_size;
+                };
+                if(!fitsInFile(sizeof(RecordingHeader), sizeof(DomainDescriptor), m_Header->domainCount)){
+                    return false;
+                }
+                if(m_Header->indexOffset % alignof(IndexEntry) != 0 || !fitsInFile(m_Header->indexOffset, sizeof(IndexEntry), m_Header->cycleCapacity)){
+                    return false;
+                }
+                if(m_Header->frameSize == 0 || !fitsInFile(m_Header->dataOffset, m_Header->frameSize, m_Header->cycleCapacity)){
+                    return false;
+                }
+
+                const auto domains = reinterpret_cast<const DomainDescriptor*>(m_FileData + sizeof(RecordingHeader));
+                for(std::size_t i = 0; i < m_Header->domainCount; i++)
+                {
+                    if(domains[i].size > m_Header->frameSize || domains[i].offsetInFrame > m_Header->frameSize - domains[i].size){
+                        return false;
+                    }
+                }
+
+                return true;
+            }();
+
+            if(!headerOk){
+                close();
+                return false;
+            }
+
+            m_Domains = reinterpret_cast<const DomainDescriptor*>(m_FileData + sizeof(RecordingHeader));
+            m_Index = reinterpret_cast<const IndexEntry*>(m_FileData + m_Header->indexOffset);
+
+            if(m_Header->framesWritten > m_Header->cycleCapacity){
+                m_FrameCount = m_Header->cycleCapacity;
+                m_FirstSlot = m_Header->framesWritten % m_Header->cycleCapacity;
+            }
+            else{
+                m_FrameCount = m_Header->framesWritten;
+                m_FirstSlot = 0;
+            }
+
+            m_CurrentFrame = 0;
+            m_HasStarted = false;
+
+            return true;
+        }
+
+        void ProcessDataPlayer::close()
+        {
+            if(!m_FileData){
+                return;
+            }
+
+            munmap(const_cast<uint8_t*>(m_FileData), m_FileSize);
+            ::close(m_FileDescriptor);
+
+            m_FileData = nullptr;
+            m_Header = nullptr;
+            m_Domains = nullptr;
+            m_Index = nullptr;
+            m_FileDescriptor = -1;
+            m_FrameCount = 0;
+        }
+
+        std::size_t ProcessDataPlayer::frameCount() const
+        {
+            return m_FrameCount;
+        }
+
+        std::optional<std::size_t> ProcessDataPlayer::findDomain(const std::string& domain_name) const
+        {
+            if(!m_FileData){
+                return std::nullopt;
+            }
+
+            for(std::size_t i = 0; i < m_Header->domainCount; i++)
+            {
+                if(std::strncmp(m_Domains[i].name, domain_name.c_str(), MaxDomainNameLength) == 0){
+                    return i;
+                }
+            }
+
+            return std::nullopt;
+        }
+
+        std::size_t ProcessDataPlayer::getDomainSize(std::size_t domain_index) const
+        {
+            return m_Domains[domain_index].size;
+        }
+
+        bool ProcessDataPlayer::seek(std::size_t frame)
+        {
+            if(frame >= m_FrameCount){
+                return false;
+            }
+
+            m_CurrentFrame = frame;
+            m_HasStarted = true;
+
+            return true;
+        }
+
+        bool ProcessDataPlayer::next()
+        {
+            if(!m_HasStarted){
+                m_HasStarted = true;
+                return m_FrameCount > 0;
+            }
+
+            if(m_CurrentFrame + 1 >= m_FrameCount){
+                return false;
+            }
+
+            m_CurrentFrame += 1;
+
+            return true;
+        }
+
+        const IndexEntry& ProcessDataPlayer::getCurrentIndex() const
+        {
+            return m_Index[currentSlot()];
+        }
+
+        const uint8_t* ProcessDataPlayer::getImage(std::size_t domain_index) const
+        {
+            return m_FileData + m_Header->dataOffset + currentSlot() * m_Header->frameSize + m_Domains[domain_index].offsetInFrame;
+        }
+
+        bool ProcessDataPlayer::copyImage(std::size_t domain_index, uint8_t* destination) const
+        {
+            if(!m_FileData || m_FrameCount == 0 || domain_index >= m_Header->domainCount){
+                return false;
+            }
+
+            std::memcpy(destination, getImage(domain_index), m_Domains[domain_index].size);
+
+            return true;
+        }
+
+        bool ProcessDataPlayer::copyRanges(std::size_t domain_index, uint8_t* destination, const std::vector<ImageRange>& ranges) const
+        {
+            if(!m_FileData || m_FrameCount == 0 || domain_index >= m_Header->domainCount){
+                return false;
+            }
+
+            const uint8_t* image = getImage(domain_index);
+            for(const auto& range : ranges)
+            {
+                std::memcpy(destination + range.offset, image + range.offset, range.size);
+            }
+
+            return true;
+        }
+
+    } // End of namespace recorder
+} // End of namespace ec
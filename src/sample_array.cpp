@@ -0,0 +1,114 @@
+/**
+ * @file sample_array.cpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ethercat_interface/sample_array.hpp"
+
+namespace ec
+{
+    namespace samples
+    {
+
+        namespace
+        {
+
+            constexpr std::size_t BlockSize = 8;
+
+            /**
+             * @brief One loop per sample type. The samples are converted in whole blocks the compiler vectorizes,
+             * the samples after the last whole block one by one.
+             *
+             */
+            template<typename Read>
+            void convert(const uint8_t* samples, std::size_t count, float scale, float* output, Read read)
+            {
+                // The stride is known at compile time, the loops are not vectorized with a stride passed in.
+                constexpr std::size_t sampleSize = sizeof(read(samples));
+                std::size_t block = 0;
+                for(; block + BlockSize <= count; block += BlockSize)
+                {
+#pragma GCC ivdep
+                    for(std::size_t i = block; i < block + BlockSize; i++)
+                    {
+                        output[i] = (float)read(samples + i * sampleSize) * scale;
+                    }
+                }
+                for(std::size_t i = block; i < count; i++)
+                {
+                    output[i] = (float)read(samples + i * sampleSize) * scale;
+                }
+            }
+
+        } // End of anonymous namespace
+
+        std::size_t getSampleSize(DataType type)
+        {
+            switch (type)
+            {
+            case DataType::UINT8:
+            case DataType::INT8:
+                return 1;
+            case DataType::UINT16:
+            case DataType::INT16:
+                return 2;
+            case DataType::UINT32:
+            case DataType::INT32:
+            case DataType::FLOAT:
+                return 4;
+            case DataType::UINT64:
+            case DataType::INT64:
+            case DataType::DOUBLE:
+                return 8;
+            default:
+                return 0;
+            }
+        }
+
+        bool convertToFloat(const uint8_t* samples, DataType type, std::size_t count, float scale, float* output)
+        {
+            switch (type)
+            {
+            case DataType::UINT8:
+                convert(samples, count, scale, output, [](const uint8_t* sample){ return EC_READ_U8(sample); });
+                return true;
+            case DataType::INT8:
+                convert(samples, count, scale, output, [](const uint8_t* sample){ return EC_READ_S8(sample); });
+                return true;
+            case DataType::UINT16:
+                convert(samples, count, scale, output, [](const uint8_t* sample){ return EC_READ_U16(sample); });
+                return true;
+            case DataType::INT16:
+                convert(samples, count, scale, output, [](const uint8_t* sample){ return EC_READ_S16(sample); });
+                return true;
+            case DataType::UINT32:
+                convert(samples, count, scale, output, [](const uint8_t* sample){ return EC_READ_U32(sample); });
+                return true;
+            case DataType::INT32:
+                convert(samples, count, scale, output, [](const uint8_t* sample){ return EC_READ_S32(sample); });
+                return true;
+            case DataType::UINT64:
+                convert(samples, count, scale, output, [](const uint8_t* sample){ return EC_READ_U64(sample); });
+                return true;
+            case DataType::INT64:
+                convert(samples, count, scale, output, [](const uint8_t* sample){ return EC_READ_S64(sample); });
+                return true;
+            case DataType::FLOAT:
+                convert(samples, count, scale, output, [](const uint8_t* sample){ return EC_READ_REAL(sample); });
+                return true;
+            case DataType::DOUBLE:
+                convert(samples, count, scale, output, [](const uint8_t* sample){ return EC_READ_LREAL(sample); });
+                return true;
+            default:
+                return false;
+            }
+        }
+
+    } // End of namespace samples
+} // End of namespace ec
@@ -0,0 +1,295 @@
+/**
+ * @file sdo.cpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ethercat_interface/sdo.hpp"
+
+#include <algorithm>
+
+namespace ec
+{
+    namespace sdo
+    {
+
+        SdoEngine::SdoEngine()
+        {
+
+        }
+
+        SdoEngine::~SdoEngine()
+        {
+            // The requests are owned by the slave configuration and released with the master.
+        }
+
+        bool SdoEngine::createRequests(
+            ec_slave_config_t* slave_config,
+            std::size_t requests_per_size,
+            std::size_t queue_capacity,
+            uint32_t timeout_ms
+        )
+        {
+            if(!slave_config || !m_Requests.empty() || requests_per_size == 0 || queue_capacity == 0){
+                return false;
+            }
+
+            for(const std::size_t size : SdoRequestSizes)
+            {
+                for(std::size_t i = 0; i < requests_per_size; i++)
+                {
+                    // Index and subindex are replaced before every transfer, the device type object is always present.
+                    ec_sdo_request_t* handle = ecrt_slave_config_create_sdo_request(slave_config, 0x1000, 0x00, size);
+                    if(!handle){
+                        m_Requests.clear();
+                        return false;
+                    }
+                    ecrt_sdo_request_timeout(handle, timeout_ms);
+                    m_Requests.push_back({handle, size, nullptr});
+                }
+            }
+
+            m_JobCapacity = queue_capacity;
+            m_Jobs = std::make_unique<Job[]>(m_JobCapacity);
+            m_Queue = std::make_unique<Job*[]>(m_JobCapacity + 1);
+            m_Completions = std::make_unique<Job*[]>(m_JobCapacity + 1);
+
+            return true;
+        }
+
+        std::optional<std::future<SdoResult>> SdoEngine::read(Index index, Subindex subindex)
+        {
+            std::future<SdoResult> future;
+            if(!enqueue(false, index, subindex, nullptr, 0, nullptr, &future)){
+                return std::nullopt;
+            }
+
+            return future;
+        }
+
+        bool SdoEngine::read(Index index, Subindex subindex, SdoCallback callback)
+        {
+            return enqueue(false, index, subindex, nullptr, 0, std::move(callback), nullptr);
+        }
+
+        std::optional<std::future<SdoResult>> SdoEngine::write(Index index, Subindex subindex, const void* data, std::size_t size)
+        {
+            std::future<SdoResult> future;
+            if(!enqueue(true, index, subindex, data, size, nullptr, &future)){
+                return std::nullopt;
+            }
+
+            return future;
+        }
+
+        bool SdoEngine::write(Index index, Subindex subindex, const void* data, std::size_t size, SdoCallback callback)
+        {
+            return enqueue(true, index, subindex, data, size, std::move(callback), nullptr);
+        }
+
+        bool SdoEngine::enqueue(
+            bool is_download,
+            Index index,
+            Subindex subindex,
+            const void* data,
+            std::size_t size,
+            SdoCallback callback,
+            std::future<SdoResult>* future
+        )
+        {
+            if(!m_Jobs){
+                return false;
+            }
+
+            if(is_download){
+                const bool isSizeSupported = std::find(SdoRequestSizes.cbegin(), SdoRequestSizes.cend(), size) != SdoRequestSizes.cend();
+                if(!isSizeSupported || !data){
+                    return false;
+                }
+            }
+
+            std::lock_guard<std::mutex> enqueueLock(m_EnqueueMutex);
+
+            Job* job = nullptr;
+            for(std::size_t i = 0; i < m_JobCapacity; i++)
+            {
+                if(m_Jobs[i].state.load(std::memory_order_acquire) == JobState::Free){
+                    job = &m_Jobs[i];
+                    break;
+                }
+            }
+            if(!job){
+                return false;
+            }
+
+            job->promise = std::promise<SdoResult>();
+            job->callback = std::move(callback);
+            job->hasPromise = future != nullptr;
+            if(future){
+                *future = job->promise.get_future();
+            }
+
+            job->isDownload = is_download;
+            job->index = index;
+            job->subindex = subindex;
+            job->size = size;
+            if(is_download){
+                std::memcpy(job->data.data(), data, size);
+            }
+            job->state.store(JobState::Queued, std::memory_order_relaxed);
+
+            const std::size_t head = m_QueueHead.load(std::memory_order_relaxed);
+            m_Queue[head] = job;
+            m_PendingJobs.fetch_add(1, std::memory_order_relaxed);
+            m_QueueHead.store((head + 1) % (m_JobCapacity + 1), std::memory_order_release);
+
+            return true;
+        }
+
+        std::size_t SdoEngine::process(std::size_t budget)
+        {
+            std::size_t operations = 0;
+
+            for(auto& request : m_Requests)
+            {
+                if(!request.job){
+                    continue;
+                }
+                if(operations == budget){
+                    return operations;
+                }
+
+                operations += 1;
+                const ec_request_state_t state = ecrt_sdo_request_state(request.handle);
+                if(state == EC_REQUEST_SUCCESS || state == EC_REQUEST_ERROR){
+                    complete(request, state == EC_REQUEST_SUCCESS);
+                }
+            }
+
+            std::size_t tail = m_QueueTail.load(std::memory_order_relaxed);
+            while(operations < budget && tail != m_QueueHead.load(std::memory_order_acquire))
+            {
+                Job* job = m_Queue[tail];
+                // Transfers are started in the order they were queued.
+                Request* request = findFreeRequest(*job);
+                if(!request){
+                    break;
+                }
+
+                ecrt_sdo_request_index(request->handle, job->index, job->subindex);
+                if(job->isDownload){
+                    std::memcpy(ecrt_sdo_request_data(request->handle), job->data.data(), job->size);
+                    ecrt_sdo_request_write(request->handle);
+                }
+                else{
+                    ecrt_sdo_request_read(request->handle);
+                }
+
+                request->job = job;
+                job->state.store(JobState::Running, std::memory_order_relaxed);
+                tail = (tail + 1) % (m_JobCapacity + 1);
+                m_QueueTail.store(tail, std::memory_order_release);
+                operations += 1;
+            }
+
+            return operations;
+        }
+
+        SdoEngine::Request* SdoEngine::findFreeRequest(const Job& job)
+        {
+            Request* found = nullptr;
+            for(auto& request : m_Requests)
+            {
+                if(request.job){
+                    continue;
+                }
+                if(job.isDownload){
+                    if(request.size == job.size){
+                        return &request;
+                    }
+                }
+                // Uploads take the largest free request.
+                else if(!found || request.size > found->size){
+                    found = &request;
+                }
+            }
+
+            return found;
+        }
+
+        void SdoEngine::complete(Request& request, bool success)
+        {
+            Job* job = request.job;
+
+            SdoResult result;
+            result.index = job->index;
+            result.subindex = job->subindex;
+            result.success = success;
+            if(job->isDownload){
+                result.size = job->size;
+                std::memcpy(result.data.data(), job->data.data(), job->size);
+            }
+            else if(success){
+                result.size = ecrt_sdo_request_data_size(request.handle);
+                if(result.size > MaxSdoDataSize){
+                    // Objects larger than a numeric value are not supported.
+                    result.success = false;
+                }
+                else{
+                    std::memcpy(result.data.data(), ecrt_sdo_request_data(request.handle), result.size);
+                }
+            }
+
+            job->result = result;
+            job->state.store(JobState::Completed, std::memory_order_relaxed);
+            request.job = nullptr;
+            m_PendingJobs.fetch_sub(1, std::memory_order_relaxed);
+
+            // Setting the value of a future takes a lock, the result is delivered by deliverCompletions() instead.
+            const std::size_t head = m_CompletionHead.load(std::memory_order_relaxed);
+            m_Completions[head] = job;
+            m_CompletionHead.store((head + 1) % (m_JobCapacity + 1), std::memory_order_release);
+        }
+
+        std::size_t SdoEngine::deliverCompletions()
+        {
+            if(!m_Completions){
+                return 0;
+            }
+
+            std::size_t tail = m_CompletionTail.load(std::memory_order_relaxed);
+            const std::size_t head = m_CompletionHead.load(std::memory_order_acquire);
+
+            std::size_t delivered = 0;
+            while(tail != head)
+            {
+                Job* job = m_Completions[tail];
+                const SdoResult result = job->result;
+                const bool hasPromise = job->hasPromise;
+                std::promise<SdoResult> promise = std::move(job->promise);
+                SdoCallback callback = std::move(job->callback);
+
+                // The job can be queued again while its result is being delivered.
+                tail = (tail + 1) % (m_JobCapacity + 1);
+                m_CompletionTail.store(tail, std::memory_order_release);
+                job->state.store(JobState::Free, std::memory_order_release);
+
+                if(hasPromise){
+                    promise.set_value(result);
+                }
+                else if(callback){
+                    callback(result);
+                }
+                delivered += 1;
+            }
+
+            return delivered;
+        }
+
+    } // End of namespace sdo
+} // End of namespace ec
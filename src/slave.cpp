@@ -17,6 +17,26 @@ namespace ec
     namespace slave
     {
 
+        namespace
+        {
+
+            /**
+             * @brief Number of entries of the PDO in the EtherCAT tables, every sample of an array is an entry of its own.
+             * 
+             */
+            std::size_t countSamples(const PDO& pdo)
+            {
+                std::size_t sampleCount = 0;
+                for(const auto& entry : pdo.entries)
+                {
+                    sampleCount += entry.count;
+                }
+
+                return sampleCount;
+            }
+
+        } // End of anonymous namespace
+
         Slave::Slave(const SlaveInfo& slave_info)
         {
             m_SlaveInfo = slave_info;
@@ -30,25 +50,18 @@ namespace ec
 
             //std::cout << "Created slave configuration pointer" << std::endl;
 
-            if(!configurePDOs()){
-                return false;
-            }
-
-            //std::cout << "Configured PDOs" << std::endl;
-
-            if(!createSlaveSyncManagerConfig()){
+            if(!m_AreTablesBuilt && !buildTables()){
                 return false;
             }
 
-            //std::cout << "Created slave's sync manager config." << std::endl;
-
+            const auto& syncManagerConfig = getLayout().syncManagerConfig;
             uint numSyncs = 0;
-            if(m_SlaveInfo.syncManagerConfig.size() == 4){
+            if(syncManagerConfig.size() == 4){
                 numSyncs = EC_END;
             }
             else{
-                if(m_SlaveInfo.syncManagerConfig.size() < 4)
-                numSyncs = m_SlaveInfo.syncManagerConfig.size();
+                if(syncManagerConfig.size() < 4)
+                numSyncs = syncManagerConfig.size();
             }
             
             if(ecrt_slave_config_pdos(m_SlaveConfigPtr, numSyncs, m_SyncManagerConfig)){
@@ -58,9 +71,193 @@ namespace ec
 
             //std::cout << "Configured the sync manager" << std::endl;
 
+            if(!registerStartupSdos()){
+                return false;
+            }
+
+            if(m_SlaveInfo.distributedClockConfig && m_SlaveInfo.distributedClockConfig->isAppliedToSlave){
+                if(!configureDistributedClock(m_SlaveInfo.distributedClockConfig.value())){
+                    return false;
+                }
+            }
+
+            if(!createSdoEngine()){
+                return false;
+            }
+
             return true;
         }
 
+        bool Slave::buildTables()
+        {
+            if(!m_AreTablesBuilt){
+                m_OwnTables.reserve(getTableSize());
+            }
+
+            return buildTables(m_OwnTables);
+        }
+
+        bool Slave::buildTables(arena::TableArena& arena)
+        {
+            // Slaves without process data, e.g. couplers, have no tables.
+            if(m_AreTablesBuilt || (getLayout().syncManagerConfig.empty() && getEntryCount() == 0)){
+                m_AreTablesBuilt = true;
+                return true;
+            }
+
+            if(!configurePDOs(arena)){
+                return false;
+            }
+
+            //std::cout << "Configured PDOs" << std::endl;
+
+            if(!createSlaveSyncManagerConfig(arena)){
+                return false;
+            }
+
+            //std::cout << "Created slave's sync manager config." << std::endl;
+
+            m_AreTablesBuilt = true;
+
+            return true;
+        }
+
+        std::size_t Slave::getTableSize() const
+        {
+            const SlaveLayout& layout = getLayout();
+            if(layout.syncManagerConfig.empty() && getEntryCount() == 0){
+                return 0;
+            }
+
+            std::size_t tableSize = arena::TableArena::footprint<ec_sync_info_t>(layout.syncManagerConfig.size() + 1);
+            for(const auto* pdos : {&layout.rxPDOs, &layout.txPDOs})
+            {
+                tableSize += arena::TableArena::footprint<ec_pdo_info_t>(pdos->size());
+                for(const auto& pdo : *pdos)
+                {
+                    tableSize += arena::TableArena::footprint<ec_pdo_entry_info_t>(countSamples(pdo));
+                }
+            }
+
+            return tableSize;
+        }
+
+        std::size_t Slave::getEntryCount() const
+        {
+            std::size_t entryCount = 0;
+            for(const auto* pdos : {&getLayout().rxPDOs, &getLayout().txPDOs})
+            {
+                for(const auto& pdo : *pdos)
+                {
+                    entryCount += countSamples(pdo);
+                }
+            }
+
+            return entryCount;
+        }
+
+        std::optional<ec_slave_config_state_t> Slave::readState() const
+        {
+            if(!m_SlaveConfigPtr){
+                return std::nullopt;
+            }
+
+            ec_slave_config_state_t state{};
+            ecrt_slave_config_state(m_SlaveConfigPtr, &state);
+
+            return state;
+        }
+
+        bool Slave::setupSampleArrays()
+        {
+            for(auto& [entryName, sampleArray] : m_SampleArrays)
+            {
+                auto offset = m_Offsets.find(entryName);
+                if(offset == m_Offsets.end()){
+                    return false;
+                }
+                sampleArray.offset = offset->second;
+
+                // The spans and the bulk conversion read the samples one after the other.
+                const std::size_t sampleSize = samples::getSampleSize(sampleArray.type);
+                for(std::size_t i = 0; i < sampleArray.sampleOffsets.size(); i++)
+                {
+                    if(sampleArray.sampleOffsets[i] != sampleArray.offset + (i + 1) * sampleSize){
+                        return false;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        bool Slave::readSamples(const std::string& entry_name, float* output, std::size_t output_size) const
+        {
+            if(isStale()){
+                return false;
+            }
+
+            auto found = m_SampleArrays.find(entry_name);
+            if(found == m_SampleArrays.end() || output_size < found->second.count){
+                return false;
+            }
+
+            return samples::convertToFloat(
+                m_DomainDataPtr + found->second.offset,
+                found->second.type,
+                found->second.count,
+                (float)getScalingFactor(entry_name),
+                output
+            );
+        }
+
+        bool Slave::registerStartupSdos()
+        {
+            if(!m_SlaveInfo.startupSdos){
+                return true;
+            }
+
+            // The master downloads the whole list on every PREOP to SAFEOP transition of the slave.
+            for(const auto& startupSdo : *m_SlaveInfo.startupSdos)
+            {
+                if(startupSdo.data.empty()){
+                    return false;
+                }
+                if(ecrt_slave_config_sdo(m_SlaveConfigPtr, startupSdo.index, startupSdo.subindex, startupSdo.data.data(), startupSdo.data.size()) != 0){
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        bool Slave::createSdoEngine()
+        {
+            auto sdoEngine = std::make_unique<sdo::SdoEngine>();
+            if(!sdoEngine->createRequests(m_SlaveConfigPtr)){
+                return false;
+            }
+            m_SdoEngine = std::move(sdoEngine);
+
+            return true;
+        }
+
+        bool Slave::configureDistributedClock(const DistributedClockConfig& dc_config)
+        {
+            if(!m_SlaveConfigPtr){
+                return false;
+            }
+
+            return ecrt_slave_config_dc(
+                m_SlaveConfigPtr,
+                dc_config.assignActivate,
+                dc_config.sync0Activate,
+                dc_config.sync0Shift,
+                dc_config.sync1Activate,
+                dc_config.sync1Shift
+            ) == 0;
+        }
+
         bool Slave::createSlaveConfigPtr(ec_master_t* master)
         {
             m_SlaveConfigPtr = ecrt_master_slave_config(master, m_SlaveInfo.alias, m_SlaveInfo.position, m_SlaveInfo.vendorID, m_SlaveInfo.productCode);
@@ -68,12 +265,18 @@ namespace ec
             return ((m_SlaveConfigPtr != NULL) ? 1 : 0);
         }
 
-        bool Slave::createSlaveSyncManagerConfig()
+        bool Slave::createSlaveSyncManagerConfig(arena::TableArena& arena)
         {
-            const std::size_t syncManagerSize = m_SlaveInfo.syncManagerConfig.size();
-            const auto syncManagerConfig = m_SlaveInfo.syncManagerConfig;
-            m_SyncManagerConfig = new ec_sync_info_t[syncManagerSize + 1];
-            m_SyncManagerConfig[4] = {0xff};
+            const auto& syncManagerConfig = getLayout().syncManagerConfig;
+            const std::size_t syncManagerSize = syncManagerConfig.size();
+            if(syncManagerSize < 4){
+                return false;
+            }
+            m_SyncManagerConfig = arena.allocate<ec_sync_info_t>(syncManagerSize + 1);
+            if(!m_SyncManagerConfig){
+                return false;
+            }
+            m_SyncManagerConfig[syncManagerSize] = {0xff};
             m_SyncManagerConfig[0] = {
                 0,
                 syncManagerConfig.at(0).syncManagerDirection,
@@ -121,11 +324,12 @@ namespace ec
 
         }
 
-        bool Slave::configurePDOs()
+        bool Slave::configurePDOs(arena::TableArena& arena)
         {
             
-            const std::size_t rxPdoSize = m_SlaveInfo.rxPDOs.size(); 
-            const std::size_t txPdoSize = m_SlaveInfo.txPDOs.size();
+            const SlaveLayout& layout = getLayout();
+            const std::size_t rxPdoSize = layout.rxPDOs.size(); 
+            const std::size_t txPdoSize = layout.txPDOs.size();
             
             /*
                 If PDO mapping sizes are equal to zero:
@@ -137,82 +341,107 @@ namespace ec
 
             }
             else{
-                m_RxPDOs = new ec_pdo_info_t[rxPdoSize];
+                m_RxPDOs = arena.allocate<ec_pdo_info_t>(rxPdoSize);
+                if(!m_RxPDOs){
+                    return false;
+                }
             }
     
             if(txPdoSize == 0){
 
             }else{
-                m_TxPDOs = new ec_pdo_info_t[rxPdoSize];
-                
+                m_TxPDOs = arena.allocate<ec_pdo_info_t>(txPdoSize);
+                if(!m_TxPDOs){
+                    return false;
+                }
             }
 
             for(std::size_t i = 0; i < rxPdoSize; i++)
             {   
                 // Get the current PDO info
-                auto& pdo = m_SlaveInfo.rxPDOs.at(i);
-                const std::size_t numEntries = pdo.entries.size();
+                const auto& pdo = layout.rxPDOs.at(i);
+                const std::size_t numEntries = countSamples(pdo);
                 // Create temp mapping
                 PDO_Mapping mapping;
                 mapping.first = pdo.pdoAddress;
                 // Resize the mapping pointer
-                mapping.second = new ec_pdo_entry_info_t[numEntries];
-                for(std::size_t j = 0; j < numEntries; j++)
+                mapping.second = arena.allocate<ec_pdo_entry_info_t>(numEntries);
+                if(numEntries != 0 && !mapping.second){
+                    return false;
+                }
+                std::size_t entryIndex = 0;
+                for(std::size_t j = 0; j < pdo.entries.size(); j++)
                 {
                     // Get the current PDO entry info
-                    const auto currEntry = pdo.entries.at(j);
-                    // Populate the value at index j
-                    mapping.second[j] = {
-                        currEntry.index,
-                        currEntry.subindex,
-                        currEntry.bitlength
-                    };
+                    const auto& currEntry = pdo.entries.at(j);
+                    // Populate one entry for every sample, the samples of an array have consecutive subindices
+                    for(uint16_t sample = 0; sample < currEntry.count; sample++)
+                    {
+                        mapping.second[entryIndex++] = {
+                            currEntry.index,
+                            (uint8_t)(currEntry.subindex + sample),
+                            currEntry.bitlength
+                        };
+                    }
 
                     ////std::cout << "Index: " << currEntry.index << "Subindex: " << (uint16_t)currEntry.subindex << "Bit Length: " << (uint16_t)currEntry.bitlength << std::endl;
 
                     // Add the PDO entry to the Offset map
                     m_Offsets.insert_or_assign(currEntry.entryName, uint());
+                    if(currEntry.count > 1){
+                        m_SampleArrays.insert_or_assign(currEntry.entryName, SampleArray{currEntry.type, currEntry.count, 0, std::vector<uint>(currEntry.count - 1)});
+                    }
                 }
 
                 // Save the mapping
                 m_RxMappings.push_back(mapping);
                 // Save the PDO mapping inside the ec_pdo_info_t pointer
                 m_RxPDOs[i].index = mapping.first;
-                m_RxPDOs[i].n_entries = (unsigned int)pdo.entries.size();
+                m_RxPDOs[i].n_entries = (unsigned int)numEntries;
                 m_RxPDOs[i].entries = mapping.second;
             }
 
             for(std::size_t i = 0; i < txPdoSize; i++)
             {   
                 // Get the current PDO info
-                auto& pdo = m_SlaveInfo.txPDOs.at(i);
-                const std::size_t numEntries = pdo.entries.size();
+                const auto& pdo = layout.txPDOs.at(i);
+                const std::size_t numEntries = countSamples(pdo);
                 // Create temp mapping
                 PDO_Mapping mapping;
                 mapping.first = pdo.pdoAddress;
                 // Resize the mapping pointer
-                mapping.second = new ec_pdo_entry_info_t[numEntries];
-                for(std::size_t j = 0; j < numEntries; j++)
+                mapping.second = arena.allocate<ec_pdo_entry_info_t>(numEntries);
+                if(numEntries != 0 && !mapping.second){
+                    return false;
+                }
+                std::size_t entryIndex = 0;
+                for(std::size_t j = 0; j < pdo.entries.size(); j++)
                 {
                     // Get the current PDO entry info
-                    const auto currEntry = pdo.entries.at(j);
-                    // Populate the value at index j
-                    mapping.second[j] = {
-                        currEntry.index,
-                        currEntry.subindex,
-                        currEntry.bitlength
-                    };
+                    const auto& currEntry = pdo.entries.at(j);
+                    // Populate one entry for every sample, the samples of an array have consecutive subindices
+                    for(uint16_t sample = 0; sample < currEntry.count; sample++)
+                    {
+                        mapping.second[entryIndex++] = {
+                            currEntry.index,
+                            (uint8_t)(currEntry.subindex + sample),
+                            currEntry.bitlength
+                        };
+                    }
 
                     ////std::cout << "Index: " << currEntry.index << "Subindex: " << (uint16_t)currEntry.subindex << "Bit Length: " << (uint16_t)currEntry.bitlength << std::endl;
                     // Add the PDO entry to the Offset map
                     m_Offsets.insert_or_assign(currEntry.entryName, uint());
+                    if(currEntry.count > 1){
+                        m_SampleArrays.insert_or_assign(currEntry.entryName, SampleArray{currEntry.type, currEntry.count, 0, std::vector<uint>(currEntry.count - 1)});
+                    }
                 }
 
                 // Save the mapping
                 m_TxMappings.push_back(mapping);
                 // Save the PDO mapping inside the ec_pdo_info_t pointer
                 m_TxPDOs[i].index = mapping.first;
-                m_TxPDOs[i].n_entries = (unsigned int)pdo.entries.size();
+                m_TxPDOs[i].n_entries = (unsigned int)numEntries;
                 m_TxPDOs[i].entries = mapping.second;
             }
 
@@ -233,8 +462,8 @@ namespace ec
              */
 
             // Gather all PDO mappings in one vector:
-            auto pdoMappings = m_SlaveInfo.rxPDOs;
-            pdoMappings.insert(std::end(pdoMappings), std::begin(m_SlaveInfo.txPDOs), std::end(m_SlaveInfo.txPDOs));
+            auto pdoMappings = getLayout().rxPDOs;
+            pdoMappings.insert(std::end(pdoMappings), std::begin(getLayout().txPDOs), std::end(getLayout().txPDOs));
             
             // Gather all PDO entries in one vector:
             auto pdoEntries = pdoMappings.at(0).entries;    
@@ -300,6 +529,14 @@ namespace ec
                 return false;
             }
 
+            if(!registerStartupSdos()){
+                return false;
+            }
+
+            if(!createSdoEngine()){
+                return false;
+            }
+
             return true;
         }
 
@@ -49,6 +49,18 @@ void CyclicTaskTimer::init()
     clock_gettime(m_ClockToUse, &m_WakeupTime);
 }
 
+void CyclicTaskTimer::initAligned(int64_t offset_ns)
+{
+    clock_gettime(m_ClockToUse, &m_WakeupTime);
+    const int64_t now = timespectoNanoSec(m_WakeupTime);
+
+    // sleep() adds one period before waiting, so the wake up time is set one period before the aligned one.
+    const int64_t alignedWakeup = (now / m_PeriodNanoSec + 1) * m_PeriodNanoSec + offset_ns % m_PeriodNanoSec;
+    const int64_t wakeupTime = alignedWakeup - m_PeriodNanoSec;
+    m_WakeupTime.tv_sec = wakeupTime / NanoSecPerSec;
+    m_WakeupTime.tv_nsec = wakeupTime % NanoSecPerSec;
+}
+
 void CyclicTaskTimer::sleep()
 {   
     m_WakeupTime = addTimespec(m_WakeupTime, m_CyclePeriod);
@@ -0,0 +1,92 @@
+/**
+ * @file timestamp.cpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ethercat_interface/timestamp.hpp"
+
+namespace ec
+{
+    namespace timestamp
+    {
+
+        uint64_t getLastPulse(uint64_t time, uint64_t start_time, const LatchGroup& group)
+        {
+            const int64_t cycle = (int64_t)group.cycle;
+            const int64_t sinceFirstPulse = (int64_t)(time - start_time) - group.shift;
+            // Rounded down, also for the times before the first pulse.
+            int64_t pulseCount = sinceFirstPulse / cycle;
+            if(sinceFirstPulse % cycle < 0){
+                pulseCount -= 1;
+            }
+
+            return start_time + group.shift + pulseCount * cycle;
+        }
+
+        uint64_t extendTimestamp(uint32_t timestamp, uint64_t reference_time)
+        {
+            return reference_time + (int64_t)(int32_t)(timestamp - (uint32_t)reference_time);
+        }
+
+        InputTimestamps::InputTimestamps(const uint8_t* domain_data, const std::vector<LatchGroup>& groups, const std::vector<TimestampEntry>& entries)
+            : m_DomainData(domain_data),
+              m_Groups(groups),
+              m_Entries(entries),
+              m_LatchTimes(groups.size(), 0),
+              m_Timestamps(entries.size(), 0)
+        {
+
+        }
+
+        std::optional<std::size_t> InputTimestamps::findEntry(const std::string& name) const
+        {
+            for(std::size_t i = 0; i < m_Entries.size(); i++)
+            {
+                if(m_Entries[i].name == name){
+                    return i;
+                }
+            }
+
+            return std::nullopt;
+        }
+
+        void InputTimestamps::update(uint64_t start_time, uint64_t send_time)
+        {
+            for(std::size_t i = 0; i < m_Groups.size(); i++)
+            {
+                if(m_Groups[i].cycle == 0){
+                    m_LatchTimes[i] = send_time;
+                }
+                else if(start_time != 0){
+                    m_LatchTimes[i] = getLastPulse(send_time, start_time, m_Groups[i]);
+                }
+            }
+
+            // The events of the timestamps happened around the time the frame was sent.
+            for(std::size_t i = 0; i < m_Entries.size(); i++)
+            {
+                const uint8_t* entry = m_DomainData + m_Entries[i].offset;
+                switch (m_Entries[i].type)
+                {
+                case DataType::UINT32:
+                case DataType::INT32:
+                    m_Timestamps[i] = extendTimestamp(EC_READ_U32(entry), send_time);
+                    break;
+                case DataType::UINT64:
+                case DataType::INT64:
+                    m_Timestamps[i] = EC_READ_U64(entry);
+                    break;
+                default:
+                    break;
+                }
+            }
+        }
+
+    } // End of namespace timestamp
+} // End of namespace ec
@@ -0,0 +1,230 @@
+/**
+ * @file topology.cpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ethercat_interface/topology.hpp"
+#include "ethercat_interface/binary_io.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <sstream>
+#include <iomanip>
+
+namespace ec
+{
+    namespace topology
+    {
+
+        namespace
+        {
+            // Fewest bytes each element takes in a snapshot, the counts read from a snapshot are bounded by them.
+            constexpr std::size_t MinSlaveSize = sizeof(SlaveIdentity::alias) + sizeof(SlaveIdentity::position) + sizeof(SlaveIdentity::vendorID) +
+                                                 sizeof(SlaveIdentity::productCode) + sizeof(SlaveIdentity::revisionNumber);
+            constexpr std::size_t MinDomainSize = sizeof(uint32_t) + sizeof(uint64_t) + sizeof(uint32_t);
+
+            std::string toHex(uint32_t value)
+            {
+                std::stringstream stream;
+                stream << "0x" << std::hex << std::setw(8) << std::setfill('0') << value;
+                return stream.str();
+            }
+        }
+
+        std::optional<std::vector<SlaveIdentity>> scanBus(ec_master_t* master, std::chrono::milliseconds timeout)
+        {
+            const auto deadline = std::chrono::steady_clock::now() + timeout;
+            ec_master_info_t masterInfo;
+            while(true)
+            {
+                if(ecrt_master(master, &masterInfo) != 0){
+                    return std::nullopt;
+                }
+                if(!masterInfo.scan_busy){
+                    break;
+                }
+                if(std::chrono::steady_clock::now() >= deadline){
+                    return std::nullopt;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+
+            std::vector<SlaveIdentity> bus;
+            bus.reserve(masterInfo.slave_count);
+            for(unsigned int position = 0; position < masterInfo.slave_count; position++)
+            {
+                ec_slave_info_t slaveInfo;
+                if(ecrt_master_get_slave(master, (uint16_t)position, &slaveInfo) != 0){
+                    return std::nullopt;
+                }
+                bus.push_back(SlaveIdentity{
+                    slaveInfo.alias,
+                    slaveInfo.position,
+                    slaveInfo.vendor_id,
+                    slaveInfo.product_code,
+                    slaveInfo.revision_number
+                });
+            }
+
+            return bus;
+        }
+
+        std::vector<std::string> findMismatches(const std::vector<SlaveInfo>& slave_configs, const std::vector<SlaveIdentity>& bus)
+        {
+            std::vector<std::string> mismatches;
+            for(const auto& slaveConfig : slave_configs)
+            {
+                std::size_t ringPosition = slaveConfig.position;
+                if(slaveConfig.alias != 0){
+                    auto aliasFound = std::find_if(bus.cbegin(), bus.cend(), [alias = slaveConfig.alias](const SlaveIdentity& slave){
+                        return slave.alias == alias;
+                    });
+                    if(aliasFound == bus.cend()){
+                        continue;
+                    }
+                    ringPosition += aliasFound->position;
+                }
+                if(ringPosition >= bus.size()){
+                    continue;
+                }
+
+                const SlaveIdentity& slave = bus[ringPosition];
+                if(slave.vendorID != slaveConfig.vendorID || slave.productCode != slaveConfig.productCode){
+                    mismatches.push_back(
+                        slaveConfig.slaveName + ": expected " + toHex(slaveConfig.vendorID) + ":" + toHex(slaveConfig.productCode) +
+                        " at " + std::to_string(slaveConfig.alias) + ":" + std::to_string(slaveConfig.position) +
+                        ", found " + toHex(slave.vendorID) + ":" + toHex(slave.productCode) +
+                        " at ring position " + std::to_string(ringPosition)
+                    );
+                }
+            }
+
+            return mismatches;
+        }
+
+        std::vector<uint8_t> serialize(const TopologySnapshot& snapshot)
+        {
+            binary::BinaryWriter writer;
+            for(const char c : TopologyMagic)
+            {
+                writer.write(c);
+            }
+            writer.write(TopologyVersion);
+            writer.write(snapshot.configHash);
+
+            writer.write((uint32_t)snapshot.slaves.size());
+            for(const auto& slave : snapshot.slaves)
+            {
+                writer.write(slave.alias);
+                writer.write(slave.position);
+                writer.write(slave.vendorID);
+                writer.write(slave.productCode);
+                writer.write(slave.revisionNumber);
+            }
+
+            writer.write((uint32_t)snapshot.domains.size());
+            for(const auto& domain : snapshot.domains)
+            {
+                writer.write(domain.domainName);
+                writer.write((uint64_t)domain.size);
+                writer.write((uint32_t)domain.offsets.size());
+                for(const unsigned int offset : domain.offsets)
+                {
+                    writer.write((uint32_t)offset);
+                }
+            }
+
+            return std::move(writer.getBuffer());
+        }
+
+        std::optional<TopologySnapshot> deserialize(const uint8_t* data, std::size_t size)
+        {
+            binary::BinaryReader reader(data, size);
+
+            char magic[sizeof(TopologyMagic)];
+            for(char& c : magic)
+            {
+                if(!reader.read(c)){
+                    return std::nullopt;
+                }
+            }
+            uint32_t version = 0;
+            if(std::memcmp(magic, TopologyMagic, sizeof(TopologyMagic)) != 0 || !reader.read(version) || version != TopologyVersion){
+                return std::nullopt;
+            }
+
+            TopologySnapshot snapshot;
+            uint32_t slaveCount = 0;
+            if(!reader.read(snapshot.configHash) || !reader.readCount(slaveCount, MinSlaveSize)){
+                return std::nullopt;
+            }
+            snapshot.slaves.resize(slaveCount);
+            for(auto& slave : snapshot.slaves)
+            {
+                const bool slaveOk = reader.read(slave.alias) &&
+                                     reader.read(slave.position) &&
+                                     reader.read(slave.vendorID) &&
+                                     reader.read(slave.productCode) &&
+                                     reader.read(slave.revisionNumber);
+                if(!slaveOk){
+                    return std::nullopt;
+                }
+            }
+
+            uint32_t domainCount = 0;
+            if(!reader.readCount(domainCount, MinDomainSize)){
+                return std::nullopt;
+            }
+            snapshot.domains.resize(domainCount);
+            for(auto& domain : snapshot.domains)
+            {
+                uint64_t domainSize = 0;
+                uint32_t offsetCount = 0;
+                if(!reader.read(domain.domainName) || !reader.read(domainSize) || !reader.readCount(offsetCount, sizeof(uint32_t))){
+                    return std::nullopt;
+                }
+                domain.size = (std::size_t)domainSize;
+                domain.offsets.resize(offsetCount);
+                for(auto& offset : domain.offsets)
+                {
+                    uint32_t value = 0;
+                    if(!reader.read(value)){
+                        return std::nullopt;
+                    }
+                    offset = value;
+                }
+            }
+
+            if(!reader.isAtEnd()){
+                return std::nullopt;
+            }
+
+            return snapshot;
+        }
+
+        bool writeSnapshotFile(const std::string& path_to_snapshot_file, const TopologySnapshot& snapshot)
+        {
+            return binary::writeFileAtomically(path_to_snapshot_file, serialize(snapshot));
+        }
+
+        std::optional<TopologySnapshot> readSnapshotFile(const std::string& path_to_snapshot_file)
+        {
+            std::ifstream file(path_to_snapshot_file, std::ios::binary);
+            if(!file){
+                return std::nullopt;
+            }
+            const std::vector<uint8_t> content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+            return deserialize(content.data(), content.size());
+        }
+
+    } // End of namespace topology
+} // End of namespace ec
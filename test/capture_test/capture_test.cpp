@@ -0,0 +1,181 @@
+#include "ethercat_interface/capture.hpp"
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <algorithm>
+
+using namespace ec;
+using namespace ec::capture;
+
+namespace {
+class CaptureTest : public ::testing::Test
+{
+    protected:
+
+    const std::string capturePath = "/tmp/ethercat_interface_capture_test.bin";
+
+    // Stand-in for a domain image: a position counter, a status word and a float.
+    uint8_t domainData[16] = {};
+
+    void writeCycle(uint64_t cycle)
+    {
+        // Counts down through the int32 wrap to exercise the delta encoding.
+        EC_WRITE_S32(domainData, (int32_t)(INT32_MIN + 1000 - (int64_t)cycle * 3));
+        EC_WRITE_U16(domainData + 4, (uint16_t)(cycle % 7 == 0 ? 0x0637 : 0x0237));
+        EC_WRITE_REAL(domainData + 8, (float)cycle * 0.5f);
+    }
+
+    void capture(uint64_t num_of_cycles, std::size_t chunk_size)
+    {
+        CaptureWriter writer;
+        ASSERT_TRUE(writer.addColumn("left_motor.actual_position", DataType::INT32, domainData));
+        ASSERT_TRUE(writer.addColumn("left_motor.status_word", DataType::UINT16, domainData + 4));
+        ASSERT_TRUE(writer.addColumn("left_motor.torque", DataType::FLOAT, domainData + 8));
+        ASSERT_FALSE(writer.addColumn("left_motor.torque", DataType::FLOAT, domainData + 8));
+        ASSERT_TRUE(writer.open(capturePath, chunk_size));
+
+        for(uint64_t cycle = 0; cycle < num_of_cycles; cycle++)
+        {
+            writeCycle(cycle);
+            // Wait for the writer thread instead of dropping samples.
+            while(!writer.sample(1000000 + cycle * 1000000)){}
+        }
+        ASSERT_TRUE(writer.close());
+    }
+};
+
+TEST(VarintTest, ZigZagRoundTrip)
+{
+    for(int64_t value : {int64_t(0), int64_t(-1), int64_t(1), int64_t(INT64_MIN), int64_t(INT64_MAX), int64_t(-123456789)})
+    {
+        std::vector<uint8_t> buffer;
+        encodeVarint(zigZagEncode(value), buffer);
+        std::size_t position = 0;
+        const auto decoded = decodeVarint(buffer.data(), buffer.size(), position);
+        ASSERT_NE(decoded, std::nullopt);
+        EXPECT_EQ(zigZagDecode(decoded.value()), value);
+        EXPECT_EQ(position, buffer.size());
+    }
+    EXPECT_EQ(zigZagEncode(-1), 1);
+    EXPECT_EQ(zigZagEncode(1), 2);
+}
+
+TEST_F(CaptureTest, ColumnsAreReadBack)
+{
+    capture(1000, 64);
+
+    CaptureReader reader;
+    ASSERT_TRUE(reader.open(capturePath));
+    ASSERT_EQ(reader.getColumns().size(), 4);
+
+    const auto positions = reader.readColumn("left_motor.actual_position");
+    ASSERT_NE(positions, std::nullopt);
+    ASSERT_EQ(positions->rawValues.size(), 1000);
+    for(uint64_t cycle = 0; cycle < 1000; cycle++)
+    {
+        writeCycle(cycle);
+        EXPECT_EQ(positions->timestamps[cycle], 1000000 + cycle * 1000000);
+        EXPECT_EQ(positions->rawValues[cycle], EC_READ_S32(domainData));
+    }
+
+    const auto torques = reader.readColumn("left_motor.torque");
+    ASSERT_NE(torques, std::nullopt);
+    EXPECT_DOUBLE_EQ(torques->at(999), 499.5);
+
+    EXPECT_EQ(reader.readColumn("right_motor.torque"), std::nullopt);
+}
+
+TEST_F(CaptureTest, TimeRangeOnlyReadsOverlappingChunks)
+{
+    capture(1000, 100);
+
+    CaptureReader reader;
+    ASSERT_TRUE(reader.open(capturePath));
+
+    const auto statusWords = reader.readColumn("left_motor.status_word", 250000000, 349000000);
+    ASSERT_NE(statusWords, std::nullopt);
+    ASSERT_EQ(statusWords->rawValues.size(), 100);
+    EXPECT_EQ(statusWords->timestamps.front(), 250000000);
+    EXPECT_EQ(statusWords->timestamps.back(), 349000000);
+
+    for(const auto& chunk : reader.getChunks())
+    {
+        if(chunk.columnID != 2){
+            continue;
+        }
+        EXPECT_EQ(chunk.min, 0x0237);
+        EXPECT_EQ(chunk.max, 0x0637);
+        // Constant runs encode to about a byte per sample.
+        EXPECT_LT(chunk.byteSize, chunk.sampleCount * 2);
+    }
+}
+
+}
+
+TEST_F(CaptureTest, BoundsAreTakenFromTheChunkIndex)
+{
+    capture(1000, 100);
+
+    CaptureReader reader;
+    ASSERT_TRUE(reader.open(capturePath));
+    // Only the chunks at the ends of a time range are read, the rest is answered by the index.
+    const auto positionChunk = std::find_if(reader.getChunks().cbegin(), reader.getChunks().cend(), [](const ChunkInfo& chunk){
+        return chunk.columnID == 1 && chunk.rowGroup == 5;
+    });
+    ASSERT_NE(positionChunk, reader.getChunks().cend());
+    const ChunkInfo corruptedChunk = *positionChunk;
+    reader.close();
+
+    // Varints that never end, the chunk fails to decode if it is read.
+    std::FILE* file = std::fopen(capturePath.c_str(), "r+b");
+    ASSERT_NE(file, nullptr);
+    ASSERT_EQ(std::fseek(file, (long)corruptedChunk.fileOffset, SEEK_SET), 0);
+    const std::vector<uint8_t> garbage(corruptedChunk.byteSize, 0xFF);
+    ASSERT_EQ(std::fwrite(garbage.data(), 1, garbage.size(), file), garbage.size());
+    std::fclose(file);
+
+    ASSERT_TRUE(reader.open(capturePath));
+    EXPECT_EQ(reader.readColumn("left_motor.actual_position", 520000000, 600000000), std::nullopt);
+
+    // The position wraps from INT32_MIN + 1 to INT32_MAX - 1 between cycle 333 and 334.
+    const auto positionBounds = reader.readColumnBounds("left_motor.actual_position", 250500000, 750000000);
+    ASSERT_NE(positionBounds, std::nullopt);
+    EXPECT_DOUBLE_EQ(positionBounds->first, INT32_MIN + 1);
+    EXPECT_DOUBLE_EQ(positionBounds->second, INT32_MAX - 1);
+
+    const auto torqueBounds = reader.readColumnBounds("left_motor.torque", 250500000, 750000000);
+    ASSERT_NE(torqueBounds, std::nullopt);
+    EXPECT_DOUBLE_EQ(torqueBounds->first, 125.0);
+    EXPECT_DOUBLE_EQ(torqueBounds->second, 374.5);
+
+    EXPECT_EQ(reader.readColumnBounds("left_motor.torque", 2000000000, 3000000000), std::nullopt);
+}
+
+TEST_F(CaptureTest, WriteFailureIsReported)
+{
+    CaptureWriter writer;
+    ASSERT_TRUE(writer.addColumn("left_motor.actual_position", DataType::INT32, domainData));
+    // Every write to /dev/full fails with ENOSPC once the stream is flushed.
+    ASSERT_TRUE(writer.open("/dev/full", 16));
+
+    uint64_t retries = 0;
+    for(uint64_t cycle = 0; cycle < 64; cycle++)
+    {
+        writeCycle(cycle);
+        while(!writer.sample(cycle))
+        {
+            retries += 1;
+        }
+    }
+
+    EXPECT_FALSE(writer.close());
+    EXPECT_TRUE(writer.hasWriteFailed());
+    // None of the samples reached the file.
+    EXPECT_EQ(writer.droppedSamples(), 64 + retries);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
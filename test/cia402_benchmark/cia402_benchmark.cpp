@@ -0,0 +1,80 @@
+/**
+ * @file cia402_benchmark.cpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief Status word decoding with the CiA 402 lookup table against the chain of mask comparisons it is built from.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ethercat_interface/driver/driver_state_machine.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+/**
+ * @brief Nanoseconds per status word of decoding every word of the buffer the given number of times.
+ *
+ */
+template<typename Decode>
+double measureDecodeNanoseconds(const std::vector<uint16_t>& status_words, int passes, Decode decode, uint64_t& checksum)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for(int pass = 0; pass < passes; pass++)
+    {
+        for(const uint16_t statusWord : status_words)
+        {
+            checksum += (uint64_t)decode(statusWord);
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / ((double)status_words.size() * passes);
+}
+
+int main(int argc, char** argv)
+{
+    constexpr std::size_t bufferSize = 1 << 16;
+    constexpr int passes = 256;
+
+    // Random words exercise every state, the branches of the comparison chain can not be predicted.
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<uint32_t> distribution(0, 0xFFFF);
+    std::vector<uint16_t> statusWords(bufferSize);
+    for(auto& statusWord : statusWords)
+    {
+        statusWord = (uint16_t)distribution(generator);
+    }
+
+    uint64_t tableChecksum = 0;
+    uint64_t chainChecksum = 0;
+    const double table = measureDecodeNanoseconds(statusWords, passes, [](uint16_t status_word){ return CIA402::decodeState(status_word); }, tableChecksum);
+    const double chain = measureDecodeNanoseconds(statusWords, passes, [](uint16_t status_word){ return CIA402::detail::decodeStateBits(status_word); }, chainChecksum);
+
+    CIA402::StateMachine stateMachine;
+    stateMachine.init();
+    stateMachine.setTargetState(CIA402::State::OperationEnabled);
+    uint64_t updateChecksum = 0;
+    uint16_t controlWord = 0;
+    const double update = measureDecodeNanoseconds(statusWords, passes, [&stateMachine, &controlWord](uint16_t status_word){
+        controlWord = stateMachine.update(status_word, controlWord);
+        return controlWord;
+    }, updateChecksum);
+
+    std::printf("status words: %zu\n", bufferSize * passes);
+    std::printf("%-28s %10.3f ns\n", "lookup table decode", table);
+    std::printf("%-28s %10.3f ns\n", "comparison chain decode", chain);
+    std::printf("%-28s %10.3f ns\n", "state machine update", update);
+    std::printf("speedup: %.2fx\n", chain / table);
+
+    if(tableChecksum != chainChecksum){
+        std::fprintf(stderr, "decoders disagree\n");
+        return 1;
+    }
+
+    return updateChecksum == 0 ? 1 : 0;
+}
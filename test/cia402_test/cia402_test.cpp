@@ -0,0 +1,148 @@
+#include "ethercat_interface/driver/driver_state_machine.hpp"
+#include "../fake_drive/fake_drive.hpp"
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace {
+
+using namespace CIA402;
+
+using fake_drive::statusWordOf;
+using fake_drive::SimulatedDrive;
+
+constexpr std::array<State, 8> DeviceStates = {
+    State::NotReadyToSwitchOn, State::SwitchOnDisabled, State::ReadyToSwitchOn, State::SwitchedOn,
+    State::OperationEnabled, State::QuickStopActive, State::FaultReactionActive, State::Fault
+};
+
+TEST(CIA402Test, DecodesEveryStateIgnoringTheOtherBits)
+{
+    for(State state : DeviceStates)
+    {
+        const uint16_t statusWord = statusWordOf(state);
+        EXPECT_EQ(decodeState(statusWord), state);
+        // Voltage enabled, warning and the upper bits do not change the state.
+        EXPECT_EQ(decodeState(statusWord | 0xFF90), state);
+        EXPECT_EQ(decodeState(statusWord & ~0x0010), state);
+    }
+    EXPECT_EQ(decodeState(0x0041 | 0x0020), State::Unknown);
+}
+
+TEST(CIA402Test, StateTableMatchesTheStandardMasks)
+{
+    int decodedStates = 0;
+    for(uint16_t index = 0; index < 64; index++)
+    {
+        if(StateTable[index] != State::Unknown){
+            decodedStates++;
+        }
+    }
+    // Not ready to switch on, switch on disabled, fault reaction active and fault ignore bit 5.
+    EXPECT_EQ(decodedStates, 2 + 2 + 1 + 1 + 1 + 1 + 2 + 2);
+}
+
+TEST(CIA402Test, CommandsProduceTheStandardControlWords)
+{
+    EXPECT_EQ(applyCommand(0x0000, Command::Shutdown), 0x0006);
+    EXPECT_EQ(applyCommand(0x0000, Command::SwitchOn), 0x0007);
+    EXPECT_EQ(applyCommand(0x000F, Command::DisableVoltage), 0x000D);
+    EXPECT_EQ(applyCommand(0x000F, Command::QuickStop), 0x000B);
+    EXPECT_EQ(applyCommand(0x000F, Command::DisableOperation), 0x0007);
+    EXPECT_EQ(applyCommand(0x0000, Command::EnableOperation), 0x000F);
+    EXPECT_EQ(applyCommand(0x0000, Command::FaultReset), 0x0080);
+    // Halt and the mode specific bits are kept.
+    EXPECT_EQ(applyCommand(0x0170, Command::EnableOperation), 0x017F);
+}
+
+TEST(CIA402Test, EveryCommandedTransitionIsFollowedByTheDrive)
+{
+    for(const Transition& transition : Transitions)
+    {
+        SimulatedDrive drive;
+        drive.state = transition.from;
+        drive.lastControlWord = 0;
+        drive.receive(applyCommand(0x0000, transition.command));
+        EXPECT_EQ(drive.state, transition.to) << "from " << (int)transition.from << " to " << (int)transition.to;
+    }
+}
+
+TEST(CIA402Test, NextHopsFollowTheTransitions)
+{
+    for(State from : DeviceStates)
+    {
+        for(State target : DeviceStates)
+        {
+            const Hop hop = findTransition(from, target);
+            if(hop.command == Command::None){
+                continue;
+            }
+            bool isTransition = false;
+            for(const Transition& transition : Transitions)
+            {
+                isTransition |= transition.from == from && transition.to == hop.next && transition.command == hop.command;
+            }
+            EXPECT_TRUE(isTransition) << "from " << (int)from << " to " << (int)target;
+        }
+    }
+    EXPECT_EQ(findTransition(State::OperationEnabled, State::OperationEnabled).command, Command::None);
+    EXPECT_EQ(findTransition(State::FaultReactionActive, State::OperationEnabled).command, Command::None);
+    EXPECT_EQ(findTransition(State::SwitchOnDisabled, State::Fault).command, Command::None);
+    // A quick stop never enables a disabled drive first.
+    EXPECT_EQ(findTransition(State::SwitchedOn, State::QuickStopActive).command, Command::DisableVoltage);
+}
+
+TEST(CIA402Test, StateMachineReachesEveryTargetFromEveryState)
+{
+    const std::vector<State> startStates = {
+        State::SwitchOnDisabled, State::ReadyToSwitchOn, State::SwitchedOn,
+        State::OperationEnabled, State::QuickStopActive, State::Fault
+    };
+    const std::vector<State> targets = {
+        State::SwitchOnDisabled, State::ReadyToSwitchOn, State::SwitchedOn, State::OperationEnabled
+    };
+    for(State start : startStates)
+    {
+        for(State target : targets)
+        {
+            SimulatedDrive drive;
+            drive.state = start;
+            // The previous cycle left the fault reset bit set, the state machine has to create the edge.
+            drive.lastControlWord = start == State::Fault ? 0x0080 : 0x0000;
+            CIA402::StateMachine stateMachine;
+            ASSERT_TRUE(stateMachine.init());
+            stateMachine.setTargetState(target);
+
+            uint16_t controlWord = drive.lastControlWord;
+            for(int cycle = 0; cycle < 10 && drive.state != target; cycle++)
+            {
+                controlWord = stateMachine.update(statusWordOf(drive.state), controlWord);
+                drive.receive(controlWord);
+            }
+            EXPECT_EQ(drive.state, target) << "from " << (int)start << " to " << (int)target;
+        }
+    }
+}
+
+TEST(CIA402Test, QuickStopFromOperationEnabled)
+{
+    SimulatedDrive drive;
+    drive.state = State::OperationEnabled;
+    CIA402::StateMachine stateMachine;
+    stateMachine.init();
+    stateMachine.setTargetState(State::QuickStopActive);
+
+    uint16_t controlWord = stateMachine.update(statusWordOf(drive.state), 0x000F);
+    drive.receive(controlWord);
+    EXPECT_EQ(drive.state, State::QuickStopActive);
+
+    stateMachine.update(statusWordOf(drive.state), controlWord);
+    EXPECT_TRUE(stateMachine.isTargetReached());
+}
+
+}
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,103 @@
+/**
+ * @file config_cache_benchmark.cpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief Startup time of the YAML parser against the binary configuration cache.
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include "ethercat_interface/parser.hpp"
+#include "ethercat_interface/config_cache.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <cstdio>
+
+/**
+ * @brief Writes a configuration with num_of_slaves single-slave documents shaped like the driver examples.
+ * 
+ */
+void writeSyntheticConfig(const std::string& path, std::size_t num_of_slaves)
+{
+    std::ofstream file(path);
+    file << "---\nprogram_config:\n  cycle_period: 1000\n...\n";
+    for(std::size_t i = 0; i < num_of_slaves; i++)
+    {
+        file << "---\n"
+             << "slave_name: drive_" << i << "\n"
+             << "slave_count: 1\n"
+             << "slave_type: driver\n"
+             << "alias: 0\n"
+             << "position: " << i << "\n"
+             << "vendor_id: 0x000022d2\n"
+             << "product_code: 0x00000201\n"
+             << "domain_name: domain_" << (i % 4) << "\n"
+             << "dc_config:\n  assign_activate: 0x0300\n  sync0_activate: 1000000\n  sync0_shift: 0\n  sync1_activate: 0\n  sync1_shift: 0\n"
+             << "sync_manager_config:\n";
+        const char* directions[] = {"output", "input", "output", "input"};
+        for(int sm = 0; sm < 4; sm++)
+        {
+            file << "  -\n    index: " << sm << "\n    direction: " << directions[sm] << "\n    watchdog_mode: disabled\n";
+        }
+        file << "pdo_mapping_1:\n addr: 0x1600\n type: rx\n pdos:\n"
+             << "  - {name: control_word, index: 0x6040, subindex: 0, bitlength: 16, type: uint16}\n"
+             << "  - {name: op_mode, index: 0x6060, subindex: 0, bitlength: 8, type: int8}\n"
+             << "  - {name: target_position, index: 0x607A, subindex: 0, bitlength: 32, type: int32}\n"
+             << "  - {name: target_velocity, index: 0x60FF, subindex: 0, bitlength: 32, type: int32}\n"
+             << "pdo_mapping_2:\n addr: 0x1a00\n type: tx\n pdos:\n"
+             << "  - {name: status_word, index: 0x6041, subindex: 0, bitlength: 16, type: uint16}\n"
+             << "  - {name: op_mode_display, index: 0x6061, subindex: 0, bitlength: 8, type: int8}\n"
+             << "  - {name: actual_position, index: 0x6064, subindex: 0, bitlength: 32, type: int32}\n"
+             << "  - {name: actual_velocity, index: 0x606C, subindex: 0, bitlength: 32, type: int32}\n"
+             << "...\n";
+    }
+}
+
+template<typename Func>
+double measureMilliseconds(Func&& func, int repetitions)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < repetitions; i++)
+    {
+        func();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / repetitions;
+}
+
+int main(int argc, char** argv)
+{
+    const std::string configPath = "/tmp/ethercat_interface_config_cache_benchmark.yaml";
+    const std::string cachePath = configPath + ".cache";
+
+    std::printf("%8s %14s %14s %10s\n", "slaves", "yaml [ms]", "cache [ms]", "speedup");
+    for(std::size_t numOfSlaves : {10, 100, 1000})
+    {
+        writeSyntheticConfig(configPath, numOfSlaves);
+        std::remove(cachePath.c_str());
+
+        const int repetitions = numOfSlaves >= 1000 ? 3 : 20;
+
+        const double yamlTime = measureMilliseconds([&](){
+            ec::parser::parseConfigFile(configPath);
+        }, repetitions);
+
+        // First call writes the snapshot, the measured calls only map it.
+        const auto programConfig = ec::parser::parseConfigFileCached(configPath, cachePath);
+        if(!programConfig || programConfig->slaveConfigurations.size() != numOfSlaves){
+            std::printf("Parsing the synthetic configuration failed.\n");
+            return -1;
+        }
+
+        const double cacheTime = measureMilliseconds([&](){
+            ec::parser::parseConfigFileCached(configPath, cachePath);
+        }, repetitions);
+
+        std::printf("%8zu %14.3f %14.3f %9.1fx\n", numOfSlaves, yamlTime, cacheTime, yamlTime / cacheTime);
+    }
+
+    return 0;
+}
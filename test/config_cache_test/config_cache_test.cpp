@@ -0,0 +1,135 @@
+#include "ethercat_interface/config_cache.hpp"
+#include <gtest/gtest.h>
+
+#include <functional>
+
+namespace {
+
+constexpr uint64_t ContentHash = 0x1234;
+
+/**
+ * @brief One driver with a filtered entry, a startup SDO and its sync managers, each enum field set by the callers.
+ *
+ */
+struct ConfigFields
+{
+    ec::SlaveType slaveType = ec::SlaveType::Driver;
+
+    ec::PDO_Type pdoType = ec::PDO_Type::TxPDO;
+
+    ec::DataType entryType = ec::DataType::INT32;
+
+    ec::FilterType filterType = ec::FilterType::Biquad;
+
+    ec_direction_t direction = EC_DIR_INPUT;
+
+    ec_watchdog_mode_t watchdogMode = EC_WD_DISABLE;
+
+    ec::DataType sdoType = ec::DataType::UINT16;
+};
+
+std::vector<uint8_t> serialize(const ConfigFields& fields)
+{
+    ec::SlaveLayout layout;
+    ec::PDO pdo;
+    pdo.pdoType = fields.pdoType;
+    pdo.pdoAddress = 0x1A00;
+    ec::PDO_Entry entry{"actual_position", 0x6064, 0x00, 32, fields.entryType};
+    entry.filter.type = fields.filterType;
+    pdo.entries.push_back(entry);
+    layout.txPDOs.push_back(pdo);
+    layout.syncManagerConfig.push_back({3, fields.direction, fields.watchdogMode});
+
+    ec::SlaveInfo slaveInfo;
+    slaveInfo.slaveName = "sag_teker";
+    slaveInfo.domainName = "motor_domain";
+    slaveInfo.slaveType = fields.slaveType;
+    slaveInfo.alias = 0;
+    slaveInfo.position = 1;
+    slaveInfo.vendorID = 0x000022D2;
+    slaveInfo.productCode = 0x00000201;
+    slaveInfo.layout = std::make_shared<const ec::SlaveLayout>(layout);
+    slaveInfo.startupSdos = std::make_shared<const std::vector<ec::StartupSdo>>(
+        std::vector<ec::StartupSdo>{{0x6060, 0x00, fields.sdoType, {0x08, 0x00}}}
+    );
+
+    ec::ProgramConfig programConfig;
+    programConfig.cyclePeriod = 1000;
+    programConfig.slaveConfigurations.push_back(slaveInfo);
+
+    return ec::parser::cache::serialize(programConfig, ContentHash);
+}
+
+/**
+ * @brief Offset of the only byte that differs between the snapshots, i.e. the byte of the changed enum field.
+ *
+ */
+std::optional<std::size_t> findEnumByte(const std::vector<uint8_t>& snapshot, const std::vector<uint8_t>& changed)
+{
+    std::optional<std::size_t> offset;
+    for(std::size_t i = 0; i < snapshot.size() && i < changed.size(); i++)
+    {
+        if(snapshot[i] != changed[i]){
+            if(offset){
+                return std::nullopt;
+            }
+            offset = i;
+        }
+    }
+    return offset;
+}
+
+TEST(ConfigCacheTest, SnapshotIsReadBack)
+{
+    const auto snapshot = serialize(ConfigFields{});
+    const auto programConfig = ec::parser::cache::deserialize(snapshot.data(), snapshot.size(), ContentHash);
+    ASSERT_TRUE(programConfig);
+    ASSERT_EQ(programConfig->slaveConfigurations.size(), 1);
+    const auto& slaveInfo = programConfig->slaveConfigurations.at(0);
+    EXPECT_EQ(slaveInfo.slaveType, ec::SlaveType::Driver);
+    EXPECT_EQ(slaveInfo.layout->txPDOs.at(0).pdoType, ec::PDO_Type::TxPDO);
+    EXPECT_EQ(slaveInfo.layout->txPDOs.at(0).entries.at(0).type, ec::DataType::INT32);
+    EXPECT_EQ(slaveInfo.layout->txPDOs.at(0).entries.at(0).filter.type, ec::FilterType::Biquad);
+    EXPECT_EQ(slaveInfo.layout->syncManagerConfig.at(0).syncManagerDirection, EC_DIR_INPUT);
+    EXPECT_EQ(slaveInfo.layout->syncManagerConfig.at(0).watchdogMode, EC_WD_DISABLE);
+    EXPECT_EQ(slaveInfo.startupSdos->at(0).type, ec::DataType::UINT16);
+}
+
+TEST(ConfigCacheTest, OutOfRangeEnumIsACacheMiss)
+{
+    const auto snapshot = serialize(ConfigFields{});
+    const std::vector<std::pair<const char*, std::function<void(ConfigFields&)>>> changes{
+        {"slave type", [](ConfigFields& fields){ fields.slaveType = ec::SlaveType::IO; }},
+        {"PDO type", [](ConfigFields& fields){ fields.pdoType = ec::PDO_Type::RxPDO; }},
+        {"entry type", [](ConfigFields& fields){ fields.entryType = ec::DataType::UNKNOWN; }},
+        {"filter type", [](ConfigFields& fields){ fields.filterType = ec::FilterType::Median3; }},
+        {"sync manager direction", [](ConfigFields& fields){ fields.direction = EC_DIR_INVALID; }},
+        {"watchdog mode", [](ConfigFields& fields){ fields.watchdogMode = EC_WD_DEFAULT; }},
+        {"startup SDO type", [](ConfigFields& fields){ fields.sdoType = ec::DataType::DOUBLE; }}
+    };
+    for(const auto& [name, change] : changes)
+    {
+        ConfigFields fields;
+        change(fields);
+        const auto changed = serialize(fields);
+        // The last enumerator of each type is still read.
+        ASSERT_TRUE(ec::parser::cache::deserialize(changed.data(), changed.size(), ContentHash)) << name;
+
+        const auto offset = findEnumByte(snapshot, changed);
+        ASSERT_TRUE(offset) << name;
+        for(const uint8_t corrupted : {(uint8_t)0x0B, (uint8_t)0x7F, (uint8_t)0xFF})
+        {
+            auto corruptedSnapshot = snapshot;
+            corruptedSnapshot[offset.value()] = corrupted;
+            EXPECT_FALSE(ec::parser::cache::deserialize(corruptedSnapshot.data(), corruptedSnapshot.size(), ContentHash))
+                << name << " " << (int)corrupted;
+        }
+    }
+}
+
+}
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,229 @@
+#include "ethercat_interface/config_diff.hpp"
+#include "ethercat_interface/master.hpp"
+#include "../fake_ecrt/fake_ecrt.hpp"
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <cstdio>
+
+namespace {
+
+ec::SlaveInfo makeSlave(const std::string& name, uint16_t position, ec::SlaveLayoutPtr layout)
+{
+    ec::SlaveInfo slaveInfo;
+    slaveInfo.slaveName = name;
+    slaveInfo.domainName = "motor_domain";
+    slaveInfo.slaveType = ec::SlaveType::Driver;
+    slaveInfo.alias = 0;
+    slaveInfo.position = position;
+    slaveInfo.vendorID = 0x000022D2;
+    slaveInfo.productCode = 0x00000201;
+    slaveInfo.layout = layout;
+    slaveInfo.distributedClockConfig = ec::DistributedClockConfig{0x0300, 2000000, 0, 0, 0};
+
+    return slaveInfo;
+}
+
+ec::SlaveLayoutPtr makeLayout(ec::Index target_position_index)
+{
+    ec::SlaveLayout layout;
+    ec::PDO rxPDO;
+    rxPDO.pdoType = ec::PDO_Type::RxPDO;
+    rxPDO.pdoAddress = 0x1600;
+    rxPDO.entries.push_back({"control_word", 0x6040, 0x00, 16, ec::DataType::UINT16});
+    rxPDO.entries.push_back({"target_position", target_position_index, 0x00, 32, ec::DataType::INT32});
+    layout.rxPDOs.push_back(rxPDO);
+
+    return std::make_shared<const ec::SlaveLayout>(layout);
+}
+
+class ConfigDiffTest : public ::testing::Test
+{
+    protected:
+
+    void SetUp() override{
+        const auto layout = makeLayout(0x607A);
+        activeConfig.cyclePeriod = 2;
+        activeConfig.slaveConfigurations.push_back(makeSlave("sag_teker", 1, layout));
+        activeConfig.slaveConfigurations.push_back(makeSlave("sol_teker", 2, layout));
+
+        // A reparsed file holds equal but not shared layouts.
+        reloadedConfig = activeConfig;
+        const auto reparsedLayout = makeLayout(0x607A);
+        for(auto& slaveInfo : reloadedConfig.slaveConfigurations)
+        {
+            slaveInfo.layout = reparsedLayout;
+        }
+    }
+
+    ec::ProgramConfig activeConfig;
+    ec::ProgramConfig reloadedConfig;
+};
+
+TEST_F(ConfigDiffTest, IdenticalConfigsHaveNoChanges)
+{
+    const auto diff = ec::parser::diffConfigs(activeConfig, reloadedConfig);
+    EXPECT_TRUE(diff.isEmpty());
+    EXPECT_FALSE(diff.isStructural());
+}
+
+TEST_F(ConfigDiffTest, TuningChangesAreTunable)
+{
+    auto& tuning = reloadedConfig.slaveConfigurations.at(1).tuning;
+    tuning.cycleDivisor = 4;
+    tuning.scalingFactors["target_position"] = 0.001;
+    tuning.telemetryEntries = {"target_position"};
+
+    const auto diff = ec::parser::diffConfigs(activeConfig, reloadedConfig);
+    EXPECT_FALSE(diff.isStructural());
+    EXPECT_EQ(diff.tunableChanges.size(), 3);
+    EXPECT_EQ(diff.retunedSlaves, std::vector<std::size_t>{1});
+    EXPECT_EQ(diff.tunableChanges.at(0), "sol_teker: cycle_divisor: 1 -> 4");
+}
+
+TEST_F(ConfigDiffTest, MappingChangeIsStructural)
+{
+    reloadedConfig.slaveConfigurations.at(1).layout = makeLayout(0x607B);
+    reloadedConfig.slaveConfigurations.at(1).tuning.cycleDivisor = 2;
+
+    const auto diff = ec::parser::diffConfigs(activeConfig, reloadedConfig);
+    ASSERT_TRUE(diff.isStructural());
+    ASSERT_EQ(diff.structuralChanges.size(), 1);
+    EXPECT_EQ(diff.structuralChanges.at(0), "sol_teker: RxPDO PDO 0x1600 entry target_position index: 0x607A -> 0x607B");
+    EXPECT_TRUE(diff.retunedSlaves.empty());
+}
+
+TEST_F(ConfigDiffTest, AddedAndRemovedSlavesAreStructural)
+{
+    reloadedConfig.slaveConfigurations.at(1).slaveName = "lifter_motor";
+    reloadedConfig.cyclePeriod = 1;
+
+    const auto diff = ec::parser::diffConfigs(activeConfig, reloadedConfig);
+    ASSERT_EQ(diff.structuralChanges.size(), 3);
+    EXPECT_EQ(diff.structuralChanges.at(0), "cycle_period: 2 -> 1");
+    EXPECT_EQ(diff.structuralChanges.at(1), "lifter_motor: slave added");
+    EXPECT_EQ(diff.structuralChanges.at(2), "sol_teker: slave removed");
+}
+
+TEST_F(ConfigDiffTest, CycleAlignmentIsReportedOnItsOwn)
+{
+    reloadedConfig.alignCycles = true;
+
+    const auto diff = ec::parser::diffConfigs(activeConfig, reloadedConfig);
+    ASSERT_EQ(diff.structuralChanges.size(), 1);
+    EXPECT_EQ(diff.structuralChanges.at(0), "align_cycles: false -> true");
+}
+
+TEST_F(ConfigDiffTest, DistributedClockActivationIsStructural)
+{
+    reloadedConfig.slaveConfigurations.at(0).distributedClockConfig->sync0Activate = 1000000;
+    reloadedConfig.slaveConfigurations.at(1).distributedClockConfig = std::nullopt;
+
+    const auto diff = ec::parser::diffConfigs(activeConfig, reloadedConfig);
+    ASSERT_EQ(diff.structuralChanges.size(), 2);
+    EXPECT_EQ(diff.structuralChanges.at(0), "sag_teker: sync0_cycle: 2000000 -> 1000000");
+    EXPECT_EQ(diff.structuralChanges.at(1), "sol_teker: distributed clock disabled");
+}
+
+TEST_F(ConfigDiffTest, DistributedClockShiftRequiresRestart)
+{
+    reloadedConfig.slaveConfigurations.at(0).distributedClockConfig->sync0Shift = 500000;
+    reloadedConfig.slaveConfigurations.at(1).distributedClockConfig->isAppliedToSlave = true;
+    reloadedConfig.slaveConfigurations.at(1).tuning.cycleDivisor = 4;
+
+    const auto diff = ec::parser::diffConfigs(activeConfig, reloadedConfig);
+    ASSERT_EQ(diff.structuralChanges.size(), 2);
+    EXPECT_EQ(diff.structuralChanges.at(0), "sag_teker: sync0_shift: 0 -> 500000 requires restart");
+    EXPECT_EQ(diff.structuralChanges.at(1), "sol_teker: apply_to_slave enabled");
+    EXPECT_TRUE(diff.retunedSlaves.empty());
+}
+
+class ReloadMasterTest : public ::testing::Test
+{
+    protected:
+
+    void writeConfig(int32_t sync0_shift, bool is_applied_to_slave, uint16_t cycle_divisor = 1)
+    {
+        std::ofstream file(configPath);
+        file << "---\nprogram_config:\n  cycle_period: 1000\n...\n"
+             << "---\n"
+             << "slave_name: drives\n"
+             << "slave_count: 2\n"
+             << "slave_tags:\n  - left_wheel\n  - right_wheel\n"
+             << "slave_type: driver\n"
+             << "alias: 0\n"
+             << "position: 0\n"
+             << "vendor_id: 0x000022d2\n"
+             << "product_code: 0x00000201\n"
+             << "domain_name: drive_domain\n"
+             << "cycle_divisor: " << cycle_divisor << "\n"
+             << "dc_config:\n"
+             << "  assign_activate: 0x0300\n"
+             << "  sync0_activate: 1000000\n"
+             << "  sync0_shift: " << sync0_shift << "\n"
+             << "  sync1_activate: 0\n"
+             << "  sync1_shift: 0\n"
+             << "  apply_to_slave: " << (is_applied_to_slave ? "true" : "false") << "\n"
+             << "sync_manager_config:\n"
+             << "  -\n    index: 0\n    direction: output\n    watchdog_mode: disabled\n"
+             << "  -\n    index: 1\n    direction: input\n    watchdog_mode: disabled\n"
+             << "  -\n    index: 2\n    direction: output\n    watchdog_mode: disabled\n"
+             << "  -\n    index: 3\n    direction: input\n    watchdog_mode: disabled\n"
+             << "pdo_mapping_1:\n addr: 0x1600\n type: rx\n pdos:\n"
+             << "  - {name: control_word, index: 0x6040, subindex: 0, bitlength: 16, type: uint16}\n"
+             << "pdo_mapping_2:\n addr: 0x1a00\n type: tx\n pdos:\n"
+             << "  - {name: status_word, index: 0x6041, subindex: 0, bitlength: 16, type: uint16}\n"
+             << "...\n";
+    }
+
+    void TearDown() override{
+        for(const std::string suffix : {"", ".cache", ".topology"})
+        {
+            std::remove((configPath + suffix).c_str());
+        }
+    }
+
+    std::string configPath = "/tmp/ethercat_interface_config_diff_test.yaml";
+};
+
+TEST_F(ReloadMasterTest, DistributedClockIsOnlyConfiguredWhenApplied)
+{
+    writeConfig(0, false);
+    {
+        Master master(configPath);
+        const std::size_t configCount = fake_ecrt::getDistributedClockConfigCount();
+        ASSERT_TRUE(master.init());
+        EXPECT_EQ(fake_ecrt::getDistributedClockConfigCount(), configCount);
+    }
+
+    writeConfig(0, true);
+    Master master(configPath);
+    const std::size_t configCount = fake_ecrt::getDistributedClockConfigCount();
+    ASSERT_TRUE(master.init());
+    EXPECT_EQ(fake_ecrt::getDistributedClockConfigCount(), configCount + 2);
+}
+
+TEST_F(ReloadMasterTest, ShiftChangeIsRejected)
+{
+    writeConfig(0, true);
+    Master master(configPath);
+    ASSERT_TRUE(master.init());
+    const std::size_t configCount = fake_ecrt::getDistributedClockConfigCount();
+
+    // The tuning change in the same file is not applied either.
+    writeConfig(250000, true, 2);
+    const ReloadReport report = master.reloadConfig();
+    EXPECT_FALSE(report.applied);
+    EXPECT_TRUE(report.appliedChanges.empty());
+    ASSERT_EQ(report.rejectedChanges.size(), 2);
+    EXPECT_EQ(report.rejectedChanges.at(0), "left_wheel: sync0_shift: 0 -> 250000 requires restart");
+    EXPECT_EQ(fake_ecrt::getDistributedClockConfigCount(), configCount);
+    EXPECT_EQ(master.getSlave<Slave*>("left_wheel").value()->getTuning().cycleDivisor, 1);
+}
+
+}
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
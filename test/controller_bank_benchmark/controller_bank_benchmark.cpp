@@ -0,0 +1,132 @@
+/**
+ * @file controller_bank_benchmark.cpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief Cycle cost of the PID loops of 64 axes in a controller bank against one controller object per axis.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ethercat_interface/driver/controller_bank.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief The usual controller: an object per axis, updated one after the other.
+ *
+ */
+struct AxisController
+{
+    ec::motion::PidGains gains;
+
+    double setpoint = 0.0;
+
+    double previousActual = 0.0;
+
+    double integral = 0.0;
+
+    double derivative = 0.0;
+
+    double update(double actual, double cycle_time)
+    {
+        const double error = setpoint - actual;
+        derivative = gains.derivativeFilter * derivative + (1.0 - gains.derivativeFilter) * (previousActual - actual) / cycle_time;
+        previousActual = actual;
+        const double candidate = integral + gains.ki * error * cycle_time;
+        const double unsaturated = gains.kp * error + candidate + gains.kd * derivative;
+        if(unsaturated > gains.outputMax){
+            if(error <= 0.0){
+                integral = candidate;
+            }
+            return gains.outputMax;
+        }
+        if(unsaturated < gains.outputMin){
+            if(error >= 0.0){
+                integral = candidate;
+            }
+            return gains.outputMin;
+        }
+        integral = std::clamp(candidate, gains.integralMin, gains.integralMax);
+        return unsaturated;
+    }
+};
+
+int main(int argc, char** argv)
+{
+    constexpr std::size_t axisCount = 64;
+    constexpr int cycles = 200000;
+    constexpr double cycleTime = 0.001;
+
+    std::vector<uint8_t> domain(axisCount * 8, 0);
+    std::vector<ec::motion::ControllerEntries> axes;
+    for(std::size_t i = 0; i < axisCount; i++)
+    {
+        axes.push_back(ec::motion::ControllerEntries{(uint32_t)(8 * i), ec::DataType::INT32, (uint32_t)(8 * i + 4), ec::DataType::INT32});
+    }
+
+    ec::motion::PidGains gains{2.0, 5.0, 0.001};
+    gains.outputMin = -3000.0;
+    gains.outputMax = 3000.0;
+    gains.derivativeFilter = 0.5;
+
+    ec::motion::ControllerBank bank(domain.data(), axes, cycleTime);
+    bank.setGains(gains);
+    bank.setEnabled(true);
+
+    // The objects are allocated one by one like the axis objects of an application.
+    std::vector<std::unique_ptr<AxisController>> controllers;
+    for(std::size_t i = 0; i < axisCount; i++)
+    {
+        controllers.push_back(std::make_unique<AxisController>());
+        controllers.back()->gains = gains;
+    }
+
+    const auto moveAxes = [&](int cycle){
+        for(std::size_t i = 0; i < axisCount; i++)
+        {
+            const int32_t actual = (int32_t)((cycle * 7 + i * 13) % 2000) - 1000;
+            std::memcpy(domain.data() + 8 * i, &actual, sizeof(actual));
+        }
+    };
+
+    double bankNanoseconds = 0.0;
+    double objectNanoseconds = 0.0;
+    int64_t checksum = 0;
+    for(int cycle = 0; cycle < cycles; cycle++)
+    {
+        moveAxes(cycle);
+
+        auto start = std::chrono::steady_clock::now();
+        bank.update();
+        auto end = std::chrono::steady_clock::now();
+        bankNanoseconds += std::chrono::duration<double, std::nano>(end - start).count();
+
+        start = std::chrono::steady_clock::now();
+        for(std::size_t i = 0; i < axisCount; i++)
+        {
+            int32_t actual;
+            std::memcpy(&actual, domain.data() + 8 * i, sizeof(actual));
+            const int32_t output = (int32_t)std::lround(controllers[i]->update(actual, cycleTime));
+            std::memcpy(domain.data() + 8 * i + 4, &output, sizeof(output));
+        }
+        end = std::chrono::steady_clock::now();
+        objectNanoseconds += std::chrono::duration<double, std::nano>(end - start).count();
+
+        checksum += (int64_t)bank.getOutput(axisCount - 1);
+    }
+
+    std::printf("axes: %zu, cycles: %d\n", axisCount, cycles);
+    std::printf("%-28s %10.3f ns\n", "controller bank", bankNanoseconds / cycles);
+    std::printf("%-28s %10.3f ns\n", "controller per axis", objectNanoseconds / cycles);
+    std::printf("speedup: %.2fx\n", objectNanoseconds / bankNanoseconds);
+
+    return checksum == 0 ? 1 : 0;
+}
@@ -0,0 +1,255 @@
+#include "ethercat_interface/master.hpp"
+#include "ethercat_interface/driver/controller_bank.hpp"
+#include "../fake_ecrt/fake_ecrt.hpp"
+#include "../test_config/test_config.hpp"
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+using namespace ec::motion;
+
+/**
+ * @brief Process image of axes with a 32 bit actual value at 8 * axis and a 32 bit output right after it.
+ *
+ */
+struct ProcessImage
+{
+    explicit ProcessImage(std::size_t axis_count, ec::DataType output_type = ec::DataType::INT32)
+        : domain(axis_count * 8, 0)
+    {
+        for(std::size_t i = 0; i < axis_count; i++)
+        {
+            axes.push_back(ControllerEntries{(uint32_t)(8 * i), ec::DataType::INT32, (uint32_t)(8 * i + 4), output_type});
+        }
+    }
+
+    void setActual(std::size_t axis, int32_t value)
+    {
+        std::memcpy(domain.data() + 8 * axis, &value, sizeof(value));
+    }
+
+    int32_t getOutput(std::size_t axis) const
+    {
+        int32_t value;
+        std::memcpy(&value, domain.data() + 8 * axis + 4, sizeof(value));
+        return value;
+    }
+
+    std::vector<uint8_t> domain;
+
+    std::vector<ControllerEntries> axes;
+};
+
+TEST(ControllerBankTest, ProportionalOutputIsWrittenForEveryAxis)
+{
+    // Five axes, so the last block is padded.
+    ProcessImage image(5);
+    ControllerBank bank(image.domain.data(), image.axes, 0.001);
+    bank.setGains(PidGains{2.0});
+    bank.setEnabled(true);
+    for(std::size_t axis = 0; axis < 5; axis++)
+    {
+        image.setActual(axis, (int32_t)(10 * axis));
+        bank.setSetpoint(axis, 100.0);
+        bank.setFeedForward(axis, (double)axis);
+    }
+
+    bank.update();
+    for(std::size_t axis = 0; axis < 5; axis++)
+    {
+        EXPECT_EQ(bank.getActual(axis), 10.0 * axis);
+        EXPECT_EQ(image.getOutput(axis), (int32_t)(2 * (100 - 10 * axis) + axis));
+    }
+}
+
+TEST(ControllerBankTest, IntegralDoesNotWindUpWhileSaturated)
+{
+    ProcessImage image(1);
+    ControllerBank bank(image.domain.data(), image.axes, 0.001);
+    PidGains gains;
+    gains.kp = 1.0;
+    gains.ki = 100.0;
+    gains.outputMin = -50.0;
+    gains.outputMax = 50.0;
+    bank.setGains(gains);
+    bank.setEnabled(0, true);
+
+    // An error of 1000 saturates the output from the first cycle, the integral only takes the first step.
+    bank.setSetpoint(0, 1000.0);
+    for(int cycle = 0; cycle < 100; cycle++)
+    {
+        bank.update();
+    }
+    EXPECT_EQ(image.getOutput(0), 50);
+    EXPECT_NEAR(bank.getIntegral(0), 0.0, 1e-9);
+
+    // Once the error reverses, the output leaves the saturation right away.
+    bank.setSetpoint(0, -10.0);
+    bank.update();
+    EXPECT_EQ(image.getOutput(0), -11);
+}
+
+TEST(ControllerBankTest, IntegralIsClampedToItsLimits)
+{
+    ProcessImage image(1);
+    ControllerBank bank(image.domain.data(), image.axes, 0.001);
+    PidGains gains;
+    gains.ki = 1000.0;
+    gains.integralMax = 5.0;
+    bank.setGains(gains);
+    bank.setEnabled(true);
+    bank.setSetpoint(0, 1.0);
+    for(int cycle = 0; cycle < 4; cycle++)
+    {
+        bank.update();
+        EXPECT_NEAR(bank.getIntegral(0), 1.0 + cycle, 1e-9);
+    }
+    for(int cycle = 0; cycle < 10; cycle++)
+    {
+        bank.update();
+    }
+    EXPECT_NEAR(bank.getIntegral(0), 5.0, 1e-9);
+}
+
+TEST(ControllerBankTest, DerivativeActsOnTheMeasurementOnly)
+{
+    ProcessImage image(1);
+    ControllerBank bank(image.domain.data(), image.axes, 0.001);
+    PidGains gains;
+    gains.kd = 0.01;
+    bank.setGains(gains);
+    bank.setEnabled(true);
+    bank.update();
+
+    // A setpoint step does not kick the output.
+    bank.setSetpoint(0, 1000.0);
+    bank.update();
+    EXPECT_EQ(image.getOutput(0), 0);
+
+    // The actual value moving 2 per cycle is a rate of 2000 per second.
+    image.setActual(0, 2);
+    bank.update();
+    EXPECT_EQ(image.getOutput(0), -20);
+}
+
+TEST(ControllerBankTest, DisabledAxesWriteNothingAndRestartWithoutABump)
+{
+    ProcessImage image(2);
+    ControllerBank bank(image.domain.data(), image.axes, 0.001);
+    bank.setGains(PidGains{1.0, 100.0, 0.01});
+    bank.setEnabled(true);
+    bank.setSetpoint(0, 10.0);
+    bank.setSetpoint(1, 10.0);
+    bank.update();
+    bank.update();
+    EXPECT_GT(bank.getIntegral(1), 0.0);
+
+    bank.setEnabled(1, false);
+    EXPECT_FALSE(bank.isEnabled(1));
+    image.setActual(1, 5);
+    std::memset(image.domain.data() + 12, 0x5A, 4);
+    bank.update();
+    EXPECT_EQ(image.getOutput(1), 0x5A5A5A5A);
+    EXPECT_EQ(bank.getOutput(1), 0.0);
+    EXPECT_EQ(bank.getIntegral(1), 0.0);
+
+    // The derivative is taken from the last actual value seen while disabled, the integral starts from zero.
+    bank.setEnabled(1, true);
+    bank.update();
+    EXPECT_NEAR(bank.getOutput(1), 5.0 + 0.5, 1e-9);
+    EXPECT_EQ(image.getOutput(1), 6);
+}
+
+TEST(ControllerBankTest, OutputsAreSaturatedToTheEntryType)
+{
+    ProcessImage image(1, ec::DataType::INT16);
+    ControllerBank bank(image.domain.data(), image.axes, 0.001);
+    bank.setGains(PidGains{1.0});
+    bank.setEnabled(true);
+
+    bank.setSetpoint(0, 1e6);
+    bank.update();
+    int16_t output;
+    std::memcpy(&output, image.domain.data() + 4, sizeof(output));
+    EXPECT_EQ(output, INT16_MAX);
+
+    bank.setSetpoint(0, -1e6);
+    bank.update();
+    std::memcpy(&output, image.domain.data() + 4, sizeof(output));
+    EXPECT_EQ(output, INT16_MIN);
+}
+
+TEST(ControllerBankTest, StaleAxesAreHeld)
+{
+    std::atomic<bool> stale{false};
+    ProcessImage image(2);
+    image.axes[1].staleFlag = &stale;
+    ControllerBank bank(image.domain.data(), image.axes, 0.001);
+    bank.setGains(PidGains{1.0, 100.0});
+    bank.setEnabled(true);
+    bank.setSetpoint(0, 10.0);
+    bank.setSetpoint(1, 10.0);
+    bank.update();
+    const double integral = bank.getIntegral(1);
+    const double output = bank.getOutput(1);
+    const int32_t written = image.getOutput(1);
+
+    // The actual value of the stale slave is not read and nothing is written to it.
+    stale = true;
+    image.setActual(0, 1000);
+    image.setActual(1, 1000);
+    std::memset(image.domain.data() + 12, 0x5A, 4);
+    bank.update();
+    bank.update();
+    EXPECT_EQ(bank.getActual(0), 1000.0);
+    EXPECT_EQ(bank.getActual(1), 0.0);
+    EXPECT_EQ(bank.getIntegral(1), integral);
+    EXPECT_EQ(bank.getOutput(1), output);
+    EXPECT_EQ(image.getOutput(1), 0x5A5A5A5A);
+    EXPECT_NE(image.getOutput(0), written);
+
+    stale = false;
+    bank.update();
+    EXPECT_EQ(bank.getActual(1), 1000.0);
+    EXPECT_EQ(image.getOutput(1), (int32_t)bank.getOutput(1));
+}
+
+class ControllerBankMasterTest : public ::testing::Test
+{
+    protected:
+
+    void TearDown() override{
+        test_config::removeGeneratedFiles(configPath);
+    }
+
+    const std::string configPath = test_config::getConfigPath("controller_bank_test");
+};
+
+TEST_F(ControllerBankMasterTest, BankIsCreatedFromTheDriversOfADomain)
+{
+    Master master(configPath);
+    ASSERT_TRUE(master.init());
+
+    auto drivers = master.getDrivers("main_domain");
+    EXPECT_FALSE(ControllerBank::fromDrivers(drivers, "actual_position", "target_velocity", 0.001));
+
+    auto bank = ControllerBank::fromDrivers(drivers, "actual_position", "target_torque", 0.001);
+    ASSERT_TRUE(bank);
+    ASSERT_EQ(bank->size(), 2);
+    bank->setGains(PidGains{3.0});
+    bank->setEnabled(true);
+    ASSERT_TRUE(drivers[1]->write<int32_t>("actual_position", -100));
+    bank->update();
+    EXPECT_EQ(drivers[0]->read<int16_t>("target_torque").value(), 0);
+    EXPECT_EQ(drivers[1]->read<int16_t>("target_torque").value(), 300);
+}
+
+}
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,101 @@
+/**
+ * @file fake_drive.hpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief Stand-in for a CiA 402 drive, answers control words with status words.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef FAKE_DRIVE_HPP_
+#define FAKE_DRIVE_HPP_
+
+#include "ethercat_interface/driver/driver_state_machine.hpp"
+
+namespace fake_drive
+{
+    using CIA402::State;
+
+    /**
+     * @brief Status word a drive reports in each state, with voltage enabled and the remote bit set.
+     *
+     */
+    inline uint16_t statusWordOf(State state)
+    {
+        switch(state)
+        {
+            case State::NotReadyToSwitchOn: return 0x0200;
+            case State::SwitchOnDisabled: return 0x0250;
+            case State::ReadyToSwitchOn: return 0x0231;
+            case State::SwitchedOn: return 0x0233;
+            case State::OperationEnabled: return 0x0237;
+            case State::QuickStopActive: return 0x0217;
+            case State::FaultReactionActive: return 0x021F;
+            case State::Fault: return 0x0218;
+            default: return 0x0000;
+        }
+    }
+
+    /**
+     * @brief Drive that follows the device control state machine of CiA 402 on the control words it receives.
+     *
+     */
+    struct SimulatedDrive
+    {
+        State state = State::SwitchOnDisabled;
+
+        uint16_t lastControlWord = 0;
+
+        void receive(uint16_t control_word)
+        {
+            const bool faultResetEdge = (control_word & 0x80) && !(lastControlWord & 0x80);
+            lastControlWord = control_word;
+            if(state == State::Fault){
+                if(faultResetEdge){
+                    state = State::SwitchOnDisabled;
+                }
+                return;
+            }
+
+            const uint16_t command = control_word & 0x8F;
+            const bool shutdown = (command & 0x87) == 0x06;
+            const bool switchOn = (command & 0x8F) == 0x07;
+            const bool enableOperation = (command & 0x8F) == 0x0F;
+            const bool disableVoltage = (command & 0x82) == 0x00;
+            const bool quickStop = (command & 0x86) == 0x02;
+
+            switch(state)
+            {
+                case State::SwitchOnDisabled:
+                    if(shutdown) state = State::ReadyToSwitchOn;
+                    break;
+                case State::ReadyToSwitchOn:
+                    if(switchOn) state = State::SwitchedOn;
+                    else if(disableVoltage || quickStop) state = State::SwitchOnDisabled;
+                    break;
+                case State::SwitchedOn:
+                    if(enableOperation) state = State::OperationEnabled;
+                    else if(shutdown) state = State::ReadyToSwitchOn;
+                    else if(disableVoltage || quickStop) state = State::SwitchOnDisabled;
+                    break;
+                case State::OperationEnabled:
+                    if(switchOn) state = State::SwitchedOn;
+                    else if(shutdown) state = State::ReadyToSwitchOn;
+                    else if(disableVoltage) state = State::SwitchOnDisabled;
+                    else if(quickStop) state = State::QuickStopActive;
+                    break;
+                case State::QuickStopActive:
+                    if(enableOperation) state = State::OperationEnabled;
+                    else if(disableVoltage) state = State::SwitchOnDisabled;
+                    break;
+                default:
+                    break;
+            }
+        }
+    };
+
+} // End of namespace fake_drive
+
+#endif // FAKE_DRIVE_HPP_
@@ -0,0 +1,464 @@
+/**
+ * @file fake_ecrt.cpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "fake_ecrt.hpp"
+
+#include <map>
+#include <set>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <cstring>
+
+#include "ecrt.h"
+
+struct ec_sdo_request
+{
+    std::vector<uint8_t> data;
+
+    ec_request_state_t state = EC_REQUEST_UNUSED;
+};
+
+struct ec_slave_config
+{
+    uint16_t alias;
+
+    uint16_t position;
+
+    /**
+     * @brief Sync manager of each mapped entry and the entry's offset in the process data of the sync manager,
+     * keyed by index and subindex. Every entry is byte aligned.
+     *
+     */
+    std::map<std::pair<uint16_t, uint8_t>, std::pair<uint8_t, unsigned int>> entryPlacements;
+
+    /**
+     * @brief Direction and process data size of the sync managers with mapped entries.
+     *
+     */
+    std::map<uint8_t, std::pair<ec_direction_t, unsigned int>> syncManagers;
+
+    std::vector<std::unique_ptr<ec_sdo_request>> sdoRequests;
+};
+
+struct ec_domain
+{
+    ec_master* master = nullptr;
+
+    std::size_t size = 0;
+
+    std::vector<uint8_t> data;
+
+    /**
+     * @brief Slave configurations with entries in the domain, and the directions of these entries.
+     *
+     */
+    std::map<const ec_slave_config*, std::set<ec_direction_t>> members;
+
+    /**
+     * @brief Domain offset of the process data of each mapped sync manager. Like the FMMUs of the master,
+     * registering one entry maps all entries of its sync manager into the domain.
+     *
+     */
+    std::map<std::pair<const ec_slave_config*, uint8_t>, unsigned int> syncManagerOffsets;
+};
+
+struct ec_master
+{
+    std::vector<std::unique_ptr<ec_domain>> domains;
+
+    std::map<std::pair<uint16_t, uint16_t>, std::unique_ptr<ec_slave_config>> slaveConfigs;
+
+    bool isActive = false;
+};
+
+namespace
+{
+    std::chrono::nanoseconds callLatency{0};
+
+    std::atomic<std::size_t> callCount{0};
+
+    std::atomic<std::size_t> distributedClockConfigCount{0};
+
+    /**
+     * @brief One master per index, all of them see the same bus.
+     *
+     */
+    std::map<unsigned int, ec_master> fakeMasters;
+
+    std::vector<fake_ecrt::BusSlave> busSlaves;
+
+    std::optional<unsigned int> workingCounter;
+
+    std::optional<unsigned int> respondingSlaves;
+
+    ec_slave_config_state_t slaveState{1, 1, 8};
+
+    std::map<uint16_t, ec_slave_config_state_t> slaveStateOverrides;
+
+    void emulateCall()
+    {
+        callCount.fetch_add(1, std::memory_order_relaxed);
+        if(callLatency.count() == 0){
+            return;
+        }
+        const auto end = std::chrono::steady_clock::now() + callLatency;
+        while(std::chrono::steady_clock::now() < end)
+        {
+
+        }
+    }
+}
+
+namespace fake_ecrt
+{
+    void setCallLatency(std::chrono::nanoseconds latency)
+    {
+        callLatency = latency;
+    }
+
+    void setBus(const std::vector<BusSlave>& bus_slaves)
+    {
+        busSlaves = bus_slaves;
+    }
+
+    void setWorkingCounter(std::optional<unsigned int> working_counter)
+    {
+        workingCounter = working_counter;
+    }
+
+    void setRespondingSlaves(std::optional<unsigned int> responding_slaves)
+    {
+        respondingSlaves = responding_slaves;
+    }
+
+    void setSlaveState(uint8_t al_state, bool online, std::optional<uint16_t> position)
+    {
+        ec_slave_config_state_t state{};
+        state.online = online;
+        state.operational = al_state == 8;
+        state.al_state = al_state;
+        if(position){
+            slaveStateOverrides[*position] = state;
+            return;
+        }
+        slaveState = state;
+        slaveStateOverrides.clear();
+    }
+
+    bool isMasterActive(unsigned int master_index)
+    {
+        auto fakeMaster = fakeMasters.find(master_index);
+        return fakeMaster != fakeMasters.end() && fakeMaster->second.isActive;
+    }
+
+    std::size_t getCallCount()
+    {
+        return callCount.load();
+    }
+
+    std::size_t getDistributedClockConfigCount()
+    {
+        return distributedClockConfigCount.load();
+    }
+
+} // End of namespace fake_ecrt
+
+extern "C" {
+
+ec_master_t* ecrt_request_master(unsigned int master_index)
+{
+    emulateCall();
+    ec_master& fakeMaster = fakeMasters[master_index];
+    fakeMaster.domains.clear();
+    fakeMaster.slaveConfigs.clear();
+    fakeMaster.isActive = false;
+    return &fakeMaster;
+}
+
+void ecrt_release_master(ec_master_t*)
+{
+
+}
+
+ec_domain_t* ecrt_master_create_domain(ec_master_t* master)
+{
+    emulateCall();
+    master->domains.push_back(std::make_unique<ec_domain>());
+    master->domains.back()->master = master;
+    return master->domains.back().get();
+}
+
+ec_slave_config_t* ecrt_master_slave_config(ec_master_t* master, uint16_t alias, uint16_t position, uint32_t, uint32_t)
+{
+    emulateCall();
+    auto& slaveConfig = master->slaveConfigs[{alias, position}];
+    if(!slaveConfig){
+        slaveConfig = std::make_unique<ec_slave_config>();
+        slaveConfig->alias = alias;
+        slaveConfig->position = position;
+    }
+    return slaveConfig.get();
+}
+
+int ecrt_master(ec_master_t*, ec_master_info_t* master_info)
+{
+    emulateCall();
+    *master_info = {};
+    master_info->slave_count = (unsigned int)busSlaves.size();
+    master_info->link_up = !busSlaves.empty();
+    master_info->scan_busy = 0;
+    return 0;
+}
+
+int ecrt_master_get_slave(ec_master_t*, uint16_t slave_position, ec_slave_info_t* slave_info)
+{
+    emulateCall();
+    if(slave_position >= busSlaves.size()){
+        return -1;
+    }
+    *slave_info = {};
+    slave_info->position = slave_position;
+    slave_info->alias = busSlaves[slave_position].alias;
+    slave_info->vendor_id = busSlaves[slave_position].vendorID;
+    slave_info->product_code = busSlaves[slave_position].productCode;
+    slave_info->revision_number = busSlaves[slave_position].revisionNumber;
+    return 0;
+}
+
+int ecrt_master_activate(ec_master_t* master)
+{
+    emulateCall();
+    for(auto& domain : master->domains)
+    {
+        domain->data.assign(domain->size, 0);
+    }
+    master->isActive = true;
+    return 0;
+}
+
+int ecrt_master_deactivate(ec_master_t* master)
+{
+    master->isActive = false;
+    return 0;
+}
+
+void ecrt_master_deactivate_slaves(ec_master_t*)
+{
+
+}
+
+int ecrt_master_send(ec_master_t*)
+{
+    return 0;
+}
+
+int ecrt_master_receive(ec_master_t*)
+{
+    return 0;
+}
+
+int ecrt_master_application_time(ec_master_t*, uint64_t)
+{
+    return 0;
+}
+
+int ecrt_master_sync_reference_clock(ec_master_t*)
+{
+    return 0;
+}
+
+int ecrt_master_sync_reference_clock_to(ec_master_t*, uint64_t)
+{
+    return 0;
+}
+
+int ecrt_master_sync_slave_clocks(ec_master_t*)
+{
+    return 0;
+}
+
+int ecrt_slave_config_pdos(ec_slave_config_t* sc, unsigned int n_syncs, const ec_sync_info_t syncs[])
+{
+    emulateCall();
+    for(unsigned int i = 0; i < n_syncs && syncs[i].index != 0xff; i++)
+    {
+        for(unsigned int j = 0; j < syncs[i].n_pdos; j++)
+        {
+            const ec_pdo_info_t& pdo = syncs[i].pdos[j];
+            auto& syncManager = sc->syncManagers[syncs[i].index];
+            syncManager.first = syncs[i].dir;
+            for(unsigned int k = 0; k < pdo.n_entries; k++)
+            {
+                sc->entryPlacements[{pdo.entries[k].index, pdo.entries[k].subindex}] = {syncs[i].index, syncManager.second};
+                syncManager.second += (pdo.entries[k].bit_length + 7) / 8;
+            }
+        }
+    }
+    return 0;
+}
+
+int ecrt_slave_config_dc(ec_slave_config_t*, uint16_t, uint32_t, int32_t, uint32_t, int32_t)
+{
+    emulateCall();
+    distributedClockConfigCount.fetch_add(1, std::memory_order_relaxed);
+    return 0;
+}
+
+int ecrt_slave_config_sdo(ec_slave_config_t*, uint16_t, uint8_t, const uint8_t*, size_t)
+{
+    emulateCall();
+    return 0;
+}
+
+ec_sdo_request_t* ecrt_slave_config_create_sdo_request(ec_slave_config_t* sc, uint16_t, uint8_t, size_t size)
+{
+    emulateCall();
+    sc->sdoRequests.push_back(std::make_unique<ec_sdo_request>());
+    sc->sdoRequests.back()->data.resize(size);
+    return sc->sdoRequests.back().get();
+}
+
+int ecrt_sdo_request_index(ec_sdo_request_t*, uint16_t, uint8_t)
+{
+    return 0;
+}
+
+int ecrt_sdo_request_timeout(ec_sdo_request_t*, uint32_t)
+{
+    return 0;
+}
+
+uint8_t* ecrt_sdo_request_data(ec_sdo_request_t* req)
+{
+    return req->data.data();
+}
+
+size_t ecrt_sdo_request_data_size(const ec_sdo_request_t* req)
+{
+    return req->data.size();
+}
+
+ec_request_state_t ecrt_sdo_request_state(ec_sdo_request_t* req)
+{
+    return req->state;
+}
+
+int ecrt_sdo_request_write(ec_sdo_request_t* req)
+{
+    req->state = EC_REQUEST_SUCCESS;
+    return 0;
+}
+
+int ecrt_sdo_request_read(ec_sdo_request_t* req)
+{
+    req->state = EC_REQUEST_SUCCESS;
+    return 0;
+}
+
+int ecrt_domain_reg_pdo_entry_list(ec_domain_t* domain, const ec_pdo_entry_reg_t* pdo_entry_regs)
+{
+    for(const ec_pdo_entry_reg_t* reg = pdo_entry_regs; reg->index; reg++)
+    {
+        emulateCall();
+        auto slaveConfig = domain->master->slaveConfigs.find({reg->alias, reg->position});
+        if(slaveConfig == domain->master->slaveConfigs.end()){
+            return -1;
+        }
+        const ec_slave_config* sc = slaveConfig->second.get();
+        auto placement = sc->entryPlacements.find({reg->index, reg->subindex});
+        if(placement == sc->entryPlacements.end()){
+            return -1;
+        }
+
+        const auto [syncIndex, entryOffset] = placement->second;
+        auto syncManagerOffset = domain->syncManagerOffsets.find({sc, syncIndex});
+        if(syncManagerOffset == domain->syncManagerOffsets.end()){
+            const auto& [direction, syncManagerSize] = sc->syncManagers.at(syncIndex);
+            syncManagerOffset = domain->syncManagerOffsets.emplace(std::make_pair(sc, syncIndex), (unsigned int)domain->size).first;
+            domain->size += syncManagerSize;
+            domain->members[sc].insert(direction);
+        }
+
+        *reg->offset = syncManagerOffset->second + entryOffset;
+        if(reg->bit_position){
+            *reg->bit_position = 0;
+        }
+    }
+    return 0;
+}
+
+size_t ecrt_domain_size(const ec_domain_t* domain)
+{
+    return domain->size;
+}
+
+uint8_t* ecrt_domain_data(ec_domain_t* domain)
+{
+    return domain->data.empty() ? nullptr : domain->data.data();
+}
+
+int ecrt_domain_process(ec_domain_t*)
+{
+    return 0;
+}
+
+int ecrt_domain_queue(ec_domain_t*)
+{
+    return 0;
+}
+
+int ecrt_domain_state(const ec_domain_t* domain, ec_domain_state_t* state)
+{
+    *state = {};
+    if(workingCounter){
+        state->working_counter = *workingCounter;
+        return 0;
+    }
+
+    // Complete exchange: LRW counts 2 per writing and 1 per reading slave, LWR and LRD count 1 per slave.
+    bool hasOutputs = false;
+    bool hasInputs = false;
+    for(const auto& [slaveConfig, directions] : domain->members)
+    {
+        hasOutputs |= directions.count(EC_DIR_OUTPUT) > 0;
+        hasInputs |= directions.count(EC_DIR_INPUT) > 0;
+    }
+    for(const auto& [slaveConfig, directions] : domain->members)
+    {
+        if(hasOutputs && hasInputs){
+            state->working_counter += 2 * directions.count(EC_DIR_OUTPUT) + directions.count(EC_DIR_INPUT);
+        }
+        else{
+            state->working_counter += 1;
+        }
+    }
+    state->wc_state = EC_WC_COMPLETE;
+    return 0;
+}
+
+int ecrt_master_state(const ec_master_t*, ec_master_state_t* state)
+{
+    *state = {};
+    state->slaves_responding = respondingSlaves.value_or((unsigned int)busSlaves.size());
+    state->al_states = slaveState.al_state;
+    state->link_up = !busSlaves.empty();
+    return 0;
+}
+
+int ecrt_slave_config_state(const ec_slave_config_t* sc, ec_slave_config_state_t* state)
+{
+    auto stateOverride = slaveStateOverrides.find(sc->position);
+    *state = stateOverride != slaveStateOverrides.end() ? stateOverride->second : slaveState;
+    return 0;
+}
+
+}
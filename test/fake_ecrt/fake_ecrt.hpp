@@ -0,0 +1,91 @@
+/**
+ * @file fake_ecrt.hpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief Stand-in for the userspace library of the IgH EtherCAT Master (ecrt.h of version 1.6),
+ * used to run the master without a bus. Linking fake_ecrt.cpp into an executable makes its
+ * definitions take precedence over the ones of libethercat.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef FAKE_ECRT_HPP_
+#define FAKE_ECRT_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace fake_ecrt
+{
+    /**
+     * @brief Slave reported by ecrt_master_get_slave(), its ring position is its index on the bus.
+     * 
+     */
+    struct BusSlave
+    {
+        uint16_t alias;
+
+        uint32_t vendorID;
+
+        uint32_t productCode;
+
+        uint32_t revisionNumber;
+    };
+
+    /**
+     * @brief Sets the slaves found by the bus scan, the bus is empty by default.
+     * 
+     */
+    void setBus(const std::vector<BusSlave>& bus_slaves);
+
+    /**
+     * @brief Working counter reported by ecrt_domain_state(), std::nullopt reports the one of a complete exchange.
+     * 
+     */
+    void setWorkingCounter(std::optional<unsigned int> working_counter);
+
+    /**
+     * @brief Number of slaves ecrt_master_state() reports as responding, std::nullopt reports the whole bus.
+     * 
+     */
+    void setRespondingSlaves(std::optional<unsigned int> responding_slaves);
+
+    /**
+     * @brief State ecrt_slave_config_state() reports, OP and online by default.
+     * 
+     * @param position Ring position of the slave, std::nullopt sets the state of every slave.
+     */
+    void setSlaveState(uint8_t al_state, bool online, std::optional<uint16_t> position = std::nullopt);
+
+    /**
+     * @brief Busy waits this long in every configuration call to model the ioctl round trip of the real library.
+     *
+     */
+    void setCallLatency(std::chrono::nanoseconds latency);
+
+    /**
+     * @brief Whether the master of the given index has been requested and activated.
+     * 
+     */
+    bool isMasterActive(unsigned int master_index);
+
+    /**
+     * @brief Number of configuration calls made since the program started.
+     *
+     */
+    std::size_t getCallCount();
+
+    /**
+     * @brief Number of ecrt_slave_config_dc() calls made since the program started.
+     *
+     */
+    std::size_t getDistributedClockConfigCount();
+
+} // End of namespace fake_ecrt
+
+#endif // FAKE_ECRT_HPP_
@@ -0,0 +1,278 @@
+#include "ethercat_interface/master.hpp"
+#include "ethercat_interface/filter.hpp"
+#include "../fake_ecrt/fake_ecrt.hpp"
+#include "../test_config/test_config.hpp"
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+using namespace ec::filter;
+
+/**
+ * @brief Process image of int32 entries at 4 * index.
+ *
+ */
+struct ProcessImage
+{
+    explicit ProcessImage(const std::vector<ec::EntryFilter>& filters)
+        : domain(filters.size() * 4, 0)
+    {
+        for(std::size_t i = 0; i < filters.size(); i++)
+        {
+            entries.push_back(FilteredEntry{(uint32_t)(4 * i), ec::DataType::INT32, filters[i]});
+        }
+    }
+
+    void set(std::size_t index, int32_t value)
+    {
+        std::memcpy(domain.data() + 4 * index, &value, sizeof(value));
+    }
+
+    std::vector<uint8_t> domain;
+
+    std::vector<FilteredEntry> entries;
+};
+
+ec::EntryFilter biquad(double b0, double b1, double b2, double a1, double a2)
+{
+    ec::EntryFilter filter;
+    filter.type = ec::FilterType::Biquad;
+    filter.coefficients = {b0, b1, b2, a1, a2};
+    return filter;
+}
+
+ec::EntryFilter movingAverage(uint16_t window)
+{
+    ec::EntryFilter filter;
+    filter.type = ec::FilterType::MovingAverage;
+    filter.window = window;
+    return filter;
+}
+
+ec::EntryFilter median3()
+{
+    ec::EntryFilter filter;
+    filter.type = ec::FilterType::Median3;
+    return filter;
+}
+
+TEST(FilterBankTest, BiquadsMatchTheDifferenceEquation)
+{
+    // Five biquads, so the last block is padded. Different coefficients per entry.
+    std::vector<ec::EntryFilter> filters;
+    for(int i = 0; i < 5; i++)
+    {
+        const double pole = 0.5 + 0.08 * i;
+        filters.push_back(biquad((1 - pole) * (1 - pole), 0.0, 0.0, -2 * pole, pole * pole));
+    }
+    ProcessImage image(filters);
+    FilterBank bank(image.domain.data(), image.entries);
+
+    std::vector<double> x1(5, 0.0), x2(5, 0.0), y1(5, 0.0), y2(5, 0.0);
+    for(int cycle = 0; cycle < 50; cycle++)
+    {
+        for(std::size_t i = 0; i < 5; i++)
+        {
+            image.set(i, (cycle % 7) * 100 - (int32_t)(i * 10));
+        }
+        bank.update();
+        for(std::size_t i = 0; i < 5; i++)
+        {
+            const auto& c = filters[i].coefficients;
+            const double x = (cycle % 7) * 100 - (double)(i * 10);
+            // The filter starts in the steady state of the first sample, these filters have a DC gain of 1.
+            const double y = cycle == 0 ? x : c[0] * x + c[1] * x1[i] + c[2] * x2[i] - c[3] * y1[i] - c[4] * y2[i];
+            x2[i] = cycle == 0 ? x : x1[i];
+            x1[i] = x;
+            y2[i] = cycle == 0 ? y : y1[i];
+            y1[i] = y;
+            EXPECT_NEAR(bank.getValue(i), y, 1e-9) << "entry " << i << " cycle " << cycle;
+        }
+    }
+}
+
+TEST(FilterBankTest, FiltersStartWithoutATransient)
+{
+    ProcessImage image({biquad(0.01, 0.02, 0.01, -1.6, 0.64), movingAverage(8), median3()});
+    FilterBank bank(image.domain.data(), image.entries);
+    for(std::size_t i = 0; i < 3; i++)
+    {
+        image.set(i, 1000);
+    }
+    for(int cycle = 0; cycle < 20; cycle++)
+    {
+        bank.update();
+        for(std::size_t i = 0; i < 3; i++)
+        {
+            EXPECT_NEAR(bank.getValue(i), 1000.0, 1e-9);
+        }
+    }
+
+    // After a reset the filters start from the next sample again.
+    bank.reset();
+    for(std::size_t i = 0; i < 3; i++)
+    {
+        image.set(i, -50);
+    }
+    bank.update();
+    for(std::size_t i = 0; i < 3; i++)
+    {
+        EXPECT_NEAR(bank.getValue(i), -50.0, 1e-9);
+    }
+}
+
+TEST(FilterBankTest, MovingAverageAndMedianOfThree)
+{
+    ProcessImage image({movingAverage(4), median3()});
+    FilterBank bank(image.domain.data(), image.entries);
+    const int32_t samples[] = {0, 4, 8, 12, 1000, 16, 20};
+    const double averages[] = {0.0, 1.0, 3.0, 6.0, 256.0, 259.0, 262.0};
+    const double medians[] = {0.0, 0.0, 4.0, 8.0, 12.0, 16.0, 20.0};
+    for(std::size_t cycle = 0; cycle < 7; cycle++)
+    {
+        image.set(0, samples[cycle]);
+        image.set(1, samples[cycle]);
+        bank.update();
+        EXPECT_DOUBLE_EQ(bank.getValue(0), averages[cycle]) << "cycle " << cycle;
+        EXPECT_DOUBLE_EQ(bank.getValue(1), medians[cycle]) << "cycle " << cycle;
+    }
+}
+
+TEST(FilterBankTest, FiltersAreParsedFromYaml)
+{
+    using ec::parser::parseEntryFilter;
+
+    const auto lowPass = parseEntryFilter(YAML::Load("{type: biquad, b: [0.5, 1.0, 0.5], a: [2.0, -1.0, 0.5]}"));
+    ASSERT_TRUE(lowPass);
+    EXPECT_EQ(lowPass->type, ec::FilterType::Biquad);
+    EXPECT_EQ(lowPass->coefficients, (std::array<double, 5>{0.25, 0.5, 0.25, -0.5, 0.25}));
+
+    const auto average = parseEntryFilter(YAML::Load("{type: moving_average, window: 16}"));
+    ASSERT_TRUE(average);
+    EXPECT_EQ(average->window, 16);
+    EXPECT_TRUE(parseEntryFilter(YAML::Load("{type: median3}")));
+
+    EXPECT_FALSE(parseEntryFilter(YAML::Load("{type: biquad, b: [1.0], a: [0.0, 0.0]}")));
+    EXPECT_FALSE(parseEntryFilter(YAML::Load("{type: biquad, b: [1.0, 0.0, 0.0], a: [0.0, 0.0, 0.0]}")));
+    EXPECT_FALSE(parseEntryFilter(YAML::Load("{type: moving_average, window: 0}")));
+    EXPECT_FALSE(parseEntryFilter(YAML::Load("{type: kalman}")));
+}
+
+TEST(FilterBankTest, StaleEntriesAreHeld)
+{
+    // Entry 0 belongs to a healthy slave, the others to a slave that goes stale.
+    std::atomic<bool> stale{false};
+    const std::vector<ec::EntryFilter> filters{biquad(0.25, 0.0, 0.0, -1.0, 0.25), biquad(0.25, 0.0, 0.0, -1.0, 0.25), movingAverage(4), median3()};
+    ProcessImage image(filters);
+    ProcessImage reference(filters);
+    FilterBank referenceBank(reference.domain.data(), reference.entries);
+    for(std::size_t i = 1; i < image.entries.size(); i++)
+    {
+        image.entries[i].staleFlag = &stale;
+    }
+    FilterBank bank(image.domain.data(), image.entries);
+    for(int cycle = 0; cycle < 5; cycle++)
+    {
+        for(std::size_t i = 0; i < 4; i++)
+        {
+            image.set(i, 100 * cycle);
+            reference.set(i, 100 * cycle);
+        }
+        bank.update();
+        referenceBank.update();
+    }
+    std::vector<double> held;
+    for(std::size_t i = 0; i < 4; i++)
+    {
+        held.push_back(bank.getValue(i));
+    }
+
+    // Whatever the stale slave's bytes hold is not filtered.
+    stale = true;
+    for(int cycle = 0; cycle < 3; cycle++)
+    {
+        for(std::size_t i = 0; i < 4; i++)
+        {
+            image.set(i, 100000);
+        }
+        bank.update();
+        EXPECT_NE(bank.getValue(0), held[0]);
+        for(std::size_t i = 1; i < 4; i++)
+        {
+            EXPECT_EQ(bank.getValue(i), held[i]) << "entry " << i << " cycle " << cycle;
+        }
+    }
+
+    // The filters continue from the held state once the slave is back, as if the stale cycles never happened.
+    stale = false;
+    bank.update();
+    for(std::size_t i = 0; i < 4; i++)
+    {
+        reference.set(i, 100000);
+    }
+    referenceBank.update();
+    for(std::size_t i = 1; i < 4; i++)
+    {
+        EXPECT_EQ(bank.getValue(i), referenceBank.getValue(i)) << "entry " << i;
+    }
+}
+
+class FilterMasterTest : public ::testing::Test
+{
+    protected:
+
+    void TearDown() override{
+        test_config::removeGeneratedFiles(configPath);
+    }
+
+    const std::string configPath = test_config::getConfigPath("filter_test");
+};
+
+TEST_F(FilterMasterTest, FilteredValuesAreReadNextToTheRawValues)
+{
+    // The second master reads the configuration from the cache written by the first one.
+    for(int run = 0; run < 2; run++)
+    {
+        Master master(configPath);
+        ASSERT_TRUE(master.init());
+
+        auto slaveFound = master.getSlave<Slave*>("ai_2");
+        ASSERT_TRUE(slaveFound);
+        Slave* slave = slaveFound.value();
+        EXPECT_FALSE(slave->readFiltered("channel_3"));
+
+        for(const int16_t sample : {100, 300, 200})
+        {
+            ASSERT_TRUE(slave->write<int16_t>("channel_1", sample));
+            ASSERT_TRUE(slave->write<int16_t>("channel_2", sample));
+            ASSERT_TRUE(master.receiveDomainData("main_domain"));
+        }
+        EXPECT_EQ(slave->read<int16_t>("channel_1").value(), 200);
+        EXPECT_DOUBLE_EQ(slave->readFiltered("channel_1").value(), 250.0);
+        EXPECT_DOUBLE_EQ(slave->readFiltered("channel_2").value(), 200.0);
+    }
+}
+
+TEST_F(FilterMasterTest, InvalidFilterFailsTheConfiguration)
+{
+    auto configDocs = YAML::LoadAllFromFile(configPath);
+    ASSERT_TRUE(ec::parser::parseConfigDocuments(configDocs));
+
+    configDocs.at(1)["pdo_mapping_1"]["pdos"][0]["filter"]["window"] = 0;
+    EXPECT_FALSE(ec::parser::parseConfigDocuments(configDocs));
+
+    configDocs.at(1)["pdo_mapping_1"]["pdos"][0]["filter"]["window"] = 2;
+    configDocs.at(1)["pdo_mapping_1"]["pdos"][1]["filter"]["type"] = "kalman";
+    EXPECT_FALSE(ec::parser::parseConfigDocuments(configDocs));
+}
+
+}
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,235 @@
+#include "ethercat_interface/master.hpp"
+#include "../fake_ecrt/fake_ecrt.hpp"
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <cstdio>
+
+namespace {
+
+using ec::health::DomainMember;
+using ec::health::expectedWorkingCounter;
+
+TEST(ExpectedWorkingCounterTest, FollowsTheDatagramTypeOfTheDomain)
+{
+    // LRW: 2 for every writing and 1 for every reading slave.
+    EXPECT_EQ(expectedWorkingCounter({{true, true}, {false, true}, {true, false}}), 6);
+    // LRD and LWR: 1 per slave.
+    EXPECT_EQ(expectedWorkingCounter({{false, true}, {false, true}}), 2);
+    EXPECT_EQ(expectedWorkingCounter({{true, false}}), 1);
+    // Slaves without process data in the domain do not count.
+    EXPECT_EQ(expectedWorkingCounter({{false, false}, {true, true}}), 3);
+    EXPECT_EQ(expectedWorkingCounter({}), 0);
+}
+
+TEST(DomainHealthTest, CountsFaultyCycles)
+{
+    ec::health::DomainHealth health;
+    health.expectedWorkingCounter = 3;
+    for(uint32_t workingCounter : {3, 2, 0, 0, 3, 1})
+    {
+        health.check(workingCounter);
+    }
+
+    const auto status = ec::health::readStatus(health);
+    EXPECT_EQ(status.checkedCycles, 6);
+    EXPECT_EQ(status.incompleteCycles, 2);
+    EXPECT_EQ(status.zeroCycles, 2);
+    EXPECT_EQ(status.consecutiveFaultyCycles, 1);
+    EXPECT_EQ(status.lastWorkingCounter, 1);
+}
+
+class HealthTest : public ::testing::Test
+{
+    protected:
+
+    void SetUp() override{
+        std::ofstream file(configPath);
+        file << "---\nprogram_config:\n  cycle_period: 1000\n...\n";
+        file << "---\n"
+             << "slave_name: coupler\n"
+             << "slave_count: 1\n"
+             << "slave_type: coupler\n"
+             << "alias: 0\n"
+             << "position: 0\n"
+             << "vendor_id: 0x00000002\n"
+             << "product_code: 0x044c2c52\n"
+             << "domain_name: main_domain\n"
+             << "...\n";
+        writeSlave(file, "drive", "driver", 1, "main_domain", true);
+        writeSlave(file, "inputs", "io", 2, "main_domain", false);
+        writeSlave(file, "sensor", "io", 3, "sensor_domain", false);
+        file.close();
+
+        fake_ecrt::setBus({{0, 0x2, 0x044c2c52, 0}, {0, 0x22d2, 0x201, 0}, {0, 0x22d2, 0x201, 0}, {0, 0x22d2, 0x201, 0}});
+        fake_ecrt::setWorkingCounter(std::nullopt);
+        fake_ecrt::setRespondingSlaves(std::nullopt);
+        fake_ecrt::setSlaveState(8, true);
+    }
+
+    void TearDown() override{
+        fake_ecrt::setBus({});
+        fake_ecrt::setWorkingCounter(std::nullopt);
+        fake_ecrt::setRespondingSlaves(std::nullopt);
+        fake_ecrt::setSlaveState(8, true);
+        for(const std::string suffix : {"", ".cache", ".topology"})
+        {
+            std::remove((configPath + suffix).c_str());
+        }
+    }
+
+    void writeSlave(std::ofstream& file, const std::string& name, const std::string& type, int position, const std::string& domain, bool has_outputs)
+    {
+        file << "---\n"
+             << "slave_name: " << name << "\n"
+             << "slave_count: 1\n"
+             << "slave_type: " << type << "\n"
+             << "alias: 0\n"
+             << "position: " << position << "\n"
+             << "vendor_id: 0x000022d2\n"
+             << "product_code: 0x00000201\n"
+             << "domain_name: " << domain << "\n"
+             << "sync_manager_config:\n";
+        const char* directions[] = {"output", "input", "output", "input"};
+        for(int sm = 0; sm < 4; sm++)
+        {
+            file << "  -\n    index: " << sm << "\n    direction: " << directions[sm] << "\n    watchdog_mode: disabled\n";
+        }
+        if(has_outputs){
+            file << "pdo_mapping_1:\n addr: 0x1600\n type: rx\n pdos:\n"
+                 << "  - {name: control_word, index: 0x6040, subindex: 0, bitlength: 16, type: uint16}\n";
+        }
+        file << "pdo_mapping_" << (has_outputs ? 2 : 1) << ":\n addr: 0x1a00\n type: tx\n pdos:\n"
+             << "  - {name: status_word, index: 0x6041, subindex: 0, bitlength: 16, type: uint16}\n"
+             << "...\n";
+    }
+
+    void runCycles(Master& master, int cycles)
+    {
+        for(int i = 0; i < cycles; i++)
+        {
+            master.receive();
+            master.receiveDomainData("main_domain");
+            master.receiveDomainData("sensor_domain");
+            master.send();
+        }
+    }
+
+    std::string configPath = "/tmp/ethercat_interface_health_test.yaml";
+};
+
+TEST_F(HealthTest, WorkingCounterIsCheckedEveryCycle)
+{
+    Master master(configPath);
+    ASSERT_TRUE(master.init());
+
+    // The drive reads and writes, the inputs only read: 2 + 1 + 1.
+    EXPECT_EQ(master.getDomainStatus("main_domain")->expectedWorkingCounter, 4);
+    EXPECT_EQ(master.getDomainStatus("sensor_domain")->expectedWorkingCounter, 1);
+    EXPECT_FALSE(master.getDomainStatus("unknown"));
+
+    runCycles(master, 10);
+    auto status = master.getDomainStatus("main_domain").value();
+    EXPECT_EQ(status.checkedCycles, 10);
+    EXPECT_EQ(status.lastWorkingCounter, 4);
+    EXPECT_EQ(status.incompleteCycles + status.zeroCycles, 0);
+
+    fake_ecrt::setWorkingCounter(1);
+    runCycles(master, 3);
+    fake_ecrt::setWorkingCounter(0);
+    runCycles(master, 2);
+
+    status = master.getDomainStatus("main_domain").value();
+    EXPECT_EQ(status.incompleteCycles, 3);
+    EXPECT_EQ(status.zeroCycles, 2);
+    EXPECT_EQ(status.consecutiveFaultyCycles, 5);
+    // 1 is the complete working counter of the sensor domain.
+    EXPECT_EQ(master.getDomainStatus("sensor_domain")->incompleteCycles, 0);
+    EXPECT_EQ(master.getDomainStatus("sensor_domain")->zeroCycles, 2);
+}
+
+TEST_F(HealthTest, StatesArePolledInTurns)
+{
+    Master master(configPath);
+    master.setStateCheck(10, 2);
+    ASSERT_TRUE(master.init());
+
+    // The first check polls the first two slaves, the second one the other two.
+    runCycles(master, 1);
+    EXPECT_EQ(master.getMasterStatus().stateChecks, 1);
+    EXPECT_EQ(master.getMasterStatus().slavesResponding, 4);
+    EXPECT_TRUE(master.getMasterStatus().linkUp);
+    EXPECT_EQ(master.getSlaveStatus("drive")->alState, 8);
+    EXPECT_EQ(master.getSlaveStatus("inputs")->alState, 0);
+
+    runCycles(master, 10);
+    EXPECT_EQ(master.getMasterStatus().stateChecks, 2);
+    EXPECT_TRUE(master.getSlaveStatus("sensor")->operational);
+
+    fake_ecrt::setRespondingSlaves(3);
+    fake_ecrt::setSlaveState(2, true);
+    runCycles(master, 10);
+    EXPECT_EQ(master.getMasterStatus().respondingDrops, 1);
+    EXPECT_EQ(master.getSlaveStatus("coupler")->alState, 2);
+    EXPECT_EQ(master.getSlaveStatus("coupler")->stateChanges, 1);
+    EXPECT_FALSE(master.getSlaveStatus("drive")->operational);
+    EXPECT_EQ(master.getSlaveStatus("sensor")->stateChanges, 0);
+    EXPECT_FALSE(master.getSlaveStatus("unknown"));
+}
+
+TEST_F(HealthTest, LostSlaveIsStaleUntilItRejoins)
+{
+    Master master(configPath);
+    master.setStateCheck(1, 4);
+    std::vector<std::pair<std::string, bool>> events;
+    master.setSlaveStateCallback([&events](const std::string& slave_name, bool rejoined){
+        events.emplace_back(slave_name, rejoined);
+    });
+    ASSERT_TRUE(master.init());
+
+    auto inputs = master.getSlave<ec::slave::Slave*>("inputs").value();
+    auto drive = master.getSlave<ec::slave::Slave*>("drive").value();
+    runCycles(master, 1);
+    EXPECT_TRUE(inputs->read<uint16_t>("status_word"));
+
+    // The inputs power cycle, the drive in the same domain keeps being exchanged.
+    fake_ecrt::setSlaveState(1, false, 2);
+    runCycles(master, 3);
+    EXPECT_TRUE(inputs->isStale());
+    EXPECT_FALSE(inputs->read<uint16_t>("status_word"));
+    EXPECT_FALSE(drive->isStale());
+    EXPECT_TRUE(drive->read<uint16_t>("status_word"));
+    EXPECT_EQ(master.getSlaveStatus("inputs")->losses, 1);
+
+    fake_ecrt::setSlaveState(2, true, 2);
+    runCycles(master, 3);
+    EXPECT_TRUE(inputs->isStale());
+
+    fake_ecrt::setSlaveState(8, true, 2);
+    runCycles(master, 1);
+    EXPECT_FALSE(inputs->isStale());
+    EXPECT_TRUE(inputs->read<uint16_t>("status_word"));
+    EXPECT_EQ(master.getSlaveStatus("inputs")->rejoins, 1);
+
+    const std::vector<std::pair<std::string, bool>> expectedEvents{{"inputs", false}, {"inputs", true}};
+    EXPECT_EQ(events, expectedEvents);
+}
+
+TEST_F(HealthTest, SlavesStartingUpAreNotLost)
+{
+    fake_ecrt::setSlaveState(4, true);
+    Master master(configPath);
+    master.setStateCheck(1, 4);
+    ASSERT_TRUE(master.init());
+
+    runCycles(master, 2);
+    EXPECT_FALSE(master.getSlaveStatus("drive")->stale);
+    EXPECT_EQ(master.getSlaveStatus("drive")->losses, 0);
+}
+
+}
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
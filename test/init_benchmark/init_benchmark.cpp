@@ -0,0 +1,182 @@
+/**
+ * @file init_benchmark.cpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief Master::init() time for large buses with the PDO tables built on one and on all cores,
+ * and of a restart with the domain offsets of the previous start, run against the stand-in EtherCAT master in test/fake_ecrt.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ethercat_interface/master.hpp"
+#include "../fake_ecrt/fake_ecrt.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <cstdio>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Writes a configuration with num_of_slaves drives, eight identical drives per document.
+ *
+ */
+void writeSyntheticConfig(const std::string& path, std::size_t num_of_slaves)
+{
+    constexpr std::size_t drivesPerDocument = 8;
+
+    std::ofstream file(path);
+    file << "---\nprogram_config:\n  cycle_period: 1000\n...\n";
+    for(std::size_t first = 0; first < num_of_slaves; first += drivesPerDocument)
+    {
+        file << "---\n"
+             << "slave_name: drive_group_" << first << "\n"
+             << "slave_count: " << drivesPerDocument << "\n"
+             << "slave_tags:\n";
+        for(std::size_t i = 0; i < drivesPerDocument; i++)
+        {
+            file << "  - drive_" << first + i << "\n";
+        }
+        file << "slave_type: driver\n"
+             << "alias: 0\n"
+             << "position: " << first + 1 << "\n"
+             << "vendor_id: 0x000022d2\n"
+             << "product_code: 0x00000201\n"
+             << "domain_name: domain_" << (first / drivesPerDocument) % 4 << "\n"
+             << "sync_manager_config:\n";
+        const char* directions[] = {"output", "input", "output", "input"};
+        for(int sm = 0; sm < 4; sm++)
+        {
+            file << "  -\n    index: " << sm << "\n    direction: " << directions[sm] << "\n    watchdog_mode: disabled\n";
+        }
+        file << "pdo_mapping_1:\n addr: 0x1600\n type: rx\n pdos:\n"
+             << "  - {name: control_word, index: 0x6040, subindex: 0, bitlength: 16, type: uint16}\n"
+             << "  - {name: op_mode, index: 0x6060, subindex: 0, bitlength: 8, type: int8}\n"
+             << "  - {name: target_position, index: 0x607A, subindex: 0, bitlength: 32, type: int32}\n"
+             << "  - {name: target_velocity, index: 0x60FF, subindex: 0, bitlength: 32, type: int32}\n"
+             << "  - {name: target_torque, index: 0x6071, subindex: 0, bitlength: 16, type: int16}\n"
+             << "  - {name: digital_outputs, index: 0x60FE, subindex: 1, bitlength: 32, type: uint32}\n"
+             << "pdo_mapping_2:\n addr: 0x1a00\n type: tx\n pdos:\n"
+             << "  - {name: status_word, index: 0x6041, subindex: 0, bitlength: 16, type: uint16}\n"
+             << "  - {name: op_mode_display, index: 0x6061, subindex: 0, bitlength: 8, type: int8}\n"
+             << "  - {name: actual_position, index: 0x6064, subindex: 0, bitlength: 32, type: int32}\n"
+             << "  - {name: actual_velocity, index: 0x606C, subindex: 0, bitlength: 32, type: int32}\n"
+             << "  - {name: actual_torque, index: 0x6077, subindex: 0, bitlength: 16, type: int16}\n"
+             << "  - {name: error_code, index: 0x603F, subindex: 0, bitlength: 16, type: uint16}\n"
+             << "  - {name: digital_inputs, index: 0x60FD, subindex: 0, bitlength: 32, type: uint32}\n"
+             << "...\n";
+    }
+}
+
+/**
+ * @brief Median duration of Master::init() over the given number of runs.
+ *
+ */
+double measureInitMilliseconds(const std::string& config_path, std::size_t thread_count, int repetitions)
+{
+    std::vector<double> durations;
+    for(int i = 0; i < repetitions; i++)
+    {
+        Master master(config_path);
+        master.setInitThreadCount(thread_count);
+
+        const auto start = std::chrono::steady_clock::now();
+        const bool initOk = master.init();
+        const auto end = std::chrono::steady_clock::now();
+        if(!initOk){
+            std::fprintf(stderr, "Master::init() failed\n");
+            return -1.0;
+        }
+        durations.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+
+    std::sort(durations.begin(), durations.end());
+    return durations[durations.size() / 2];
+}
+
+/**
+ * @brief Median duration of Master::init() on a bus without a topology snapshot and of the restarts after it.
+ *
+ */
+std::pair<double, double> measureRestartMilliseconds(const std::string& config_path, int repetitions)
+{
+    std::vector<double> firstStarts;
+    std::vector<double> restarts;
+    for(int i = 0; i < repetitions; i++)
+    {
+        std::remove((config_path + ".topology").c_str());
+        for(auto* durations : {&firstStarts, &restarts})
+        {
+            Master master(config_path);
+            const auto start = std::chrono::steady_clock::now();
+            const bool initOk = master.init();
+            const auto end = std::chrono::steady_clock::now();
+            if(!initOk || master.isFastRestart() != (durations == &restarts)){
+                std::fprintf(stderr, "Master::init() failed\n");
+                return {-1.0, -1.0};
+            }
+            durations->push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        }
+    }
+
+    std::sort(firstStarts.begin(), firstStarts.end());
+    std::sort(restarts.begin(), restarts.end());
+    return {firstStarts[firstStarts.size() / 2], restarts[restarts.size() / 2]};
+}
+
+int main(int argc, char** argv)
+{
+    const std::string configPath = "/tmp/ethercat_interface_init_benchmark.yaml";
+    const std::size_t threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    // The init output of the master is not part of the measurement.
+    std::cout.setstate(std::ios::failbit);
+
+    std::printf("%8s %12s %14s %14s %10s\n", "slaves", "latency [us]", "1 thread [ms]", "threads [ms]", "speedup");
+    for(const int latencyMicroseconds : {0, 5})
+    {
+        fake_ecrt::setCallLatency(std::chrono::microseconds(latencyMicroseconds));
+        for(std::size_t numOfSlaves : {64, 256, 1024})
+        {
+            writeSyntheticConfig(configPath, numOfSlaves);
+            std::remove((configPath + ".cache").c_str());
+
+            const double serial = measureInitMilliseconds(configPath, 1, 5);
+            const double parallel = measureInitMilliseconds(configPath, threadCount, 5);
+
+            std::printf("%8zu %12d %14.3f %14.3f %9.2fx\n", numOfSlaves, latencyMicroseconds, serial, parallel, serial / parallel);
+        }
+    }
+    std::printf("threads: %zu\n", threadCount);
+
+    // The restarts need a bus to compare with the snapshot: a coupler in front of the drives.
+    std::printf("\n%8s %12s %14s %14s %10s\n", "slaves", "latency [us]", "first [ms]", "restart [ms]", "speedup");
+    for(const int latencyMicroseconds : {0, 5})
+    {
+        fake_ecrt::setCallLatency(std::chrono::microseconds(latencyMicroseconds));
+        for(std::size_t numOfSlaves : {64, 256, 1024})
+        {
+            std::vector<fake_ecrt::BusSlave> bus(numOfSlaves + 1, {0, 0x000022d2, 0x00000201, 0x00010000});
+            bus.front() = {0, 0x00000002, 0x044c2c52, 0x00110000};
+            fake_ecrt::setBus(bus);
+            writeSyntheticConfig(configPath, numOfSlaves);
+            std::remove((configPath + ".cache").c_str());
+
+            const auto [firstStart, restart] = measureRestartMilliseconds(configPath, 5);
+
+            std::printf("%8zu %12d %14.3f %14.3f %9.2fx\n", numOfSlaves, latencyMicroseconds, firstStart, restart, firstStart / restart);
+        }
+    }
+    fake_ecrt::setBus({});
+
+    for(const std::string suffix : {"", ".cache", ".topology"})
+    {
+        std::remove((configPath + suffix).c_str());
+    }
+
+    return 0;
+}
@@ -0,0 +1,216 @@
+#include "ethercat_interface/master.hpp"
+#include "ethercat_interface/driver/interpolator.hpp"
+#include "../fake_ecrt/fake_ecrt.hpp"
+#include "../test_config/test_config.hpp"
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+namespace {
+
+using namespace ec::motion;
+
+constexpr uint64_t Millisecond = 1000000;
+
+int32_t readS32(const std::vector<uint8_t>& domain, uint32_t offset)
+{
+    int32_t value;
+    std::memcpy(&value, domain.data() + offset, sizeof(value));
+    return value;
+}
+
+TEST(InterpolatorTest, LinearSegmentsAreStraight)
+{
+    const Waypoint from{0, 0.0};
+    const Waypoint to{10 * Millisecond, 100.0};
+    for(uint64_t ms = 0; ms <= 10; ms++)
+    {
+        const Setpoint setpoint = interpolate(from, to, ms * Millisecond, InterpolationMode::Linear);
+        EXPECT_NEAR(setpoint.position, 10.0 * ms, 1e-9);
+        EXPECT_NEAR(setpoint.velocity, 10000.0, 1e-6);
+    }
+}
+
+TEST(InterpolatorTest, CubicHermiteMatchesTheEndVelocities)
+{
+    const Waypoint from{0, 0.0, 1000.0};
+    const Waypoint to{20 * Millisecond, 50.0, -500.0};
+
+    const Setpoint start = interpolate(from, to, 0, InterpolationMode::CubicHermite);
+    const Setpoint end = interpolate(from, to, 20 * Millisecond, InterpolationMode::CubicHermite);
+    EXPECT_NEAR(start.position, 0.0, 1e-9);
+    EXPECT_NEAR(start.velocity, 1000.0, 1e-6);
+    EXPECT_NEAR(end.position, 50.0, 1e-9);
+    EXPECT_NEAR(end.velocity, -500.0, 1e-6);
+
+    // The velocity is the derivative of the position.
+    const Setpoint before = interpolate(from, to, 7 * Millisecond - 1000, InterpolationMode::CubicHermite);
+    const Setpoint after = interpolate(from, to, 7 * Millisecond + 1000, InterpolationMode::CubicHermite);
+    const Setpoint middle = interpolate(from, to, 7 * Millisecond, InterpolationMode::CubicHermite);
+    EXPECT_NEAR((after.position - before.position) / 2e-6, middle.velocity, 1e-2);
+}
+
+TEST(InterpolatorTest, QuinticMatchesTheEndAccelerations)
+{
+    const Waypoint from{0, 10.0, 200.0, 5000.0};
+    const Waypoint to{8 * Millisecond, 20.0, 0.0, -3000.0};
+    const auto velocityAt = [&](uint64_t time_ns){
+        return interpolate(from, to, time_ns, InterpolationMode::Quintic).velocity;
+    };
+
+    EXPECT_NEAR(interpolate(from, to, 0, InterpolationMode::Quintic).position, 10.0, 1e-9);
+    EXPECT_NEAR(interpolate(from, to, 8 * Millisecond, InterpolationMode::Quintic).position, 20.0, 1e-6);
+    EXPECT_NEAR(velocityAt(0), 200.0, 1e-6);
+    EXPECT_NEAR(velocityAt(8 * Millisecond), 0.0, 1e-3);
+    EXPECT_NEAR((velocityAt(10) - velocityAt(0)) / 1e-8, 5000.0, 20.0);
+    EXPECT_NEAR((velocityAt(8 * Millisecond) - velocityAt(8 * Millisecond - 10)) / 1e-8, -3000.0, 20.0);
+}
+
+TEST(InterpolatorTest, UpsamplesWaypointsToEveryCycle)
+{
+    std::vector<uint8_t> domain(8, 0);
+    Interpolator interpolator(domain.data(), 0, 4);
+    interpolator.setMode(InterpolationMode::Linear);
+    EXPECT_TRUE(interpolator.hasVelocityFeedForward());
+    EXPECT_FALSE(interpolator.update(0));
+
+    // Waypoints every 10 cycles, 1 ms cycle.
+    for(int i = 0; i <= 4; i++)
+    {
+        ASSERT_TRUE(interpolator.pushWaypoint(Waypoint{(uint64_t)(i * 10) * Millisecond, i * 1000.0}));
+    }
+    for(int cycle = 0; cycle <= 40; cycle++)
+    {
+        ASSERT_TRUE(interpolator.update((uint64_t)cycle * Millisecond));
+        EXPECT_EQ(readS32(domain, 0), cycle * 100);
+        if(cycle > 0){
+            EXPECT_EQ(readS32(domain, 4), 100000);
+        }
+    }
+    EXPECT_EQ(interpolator.getStarvedCycles(), 0);
+
+    // Out of waypoints: the position is held.
+    interpolator.update(41 * Millisecond);
+    EXPECT_EQ(readS32(domain, 0), 4000);
+    EXPECT_EQ(readS32(domain, 4), 0);
+    EXPECT_EQ(interpolator.getStarvedCycles(), 1);
+
+    // The next segment starts at the held position, without a jump.
+    ASSERT_TRUE(interpolator.pushWaypoint(Waypoint{51 * Millisecond, 5000.0}));
+    interpolator.update(42 * Millisecond);
+    EXPECT_EQ(readS32(domain, 0), 4100);
+}
+
+TEST(InterpolatorTest, TimeOffsetShiftsTheEvaluation)
+{
+    std::vector<uint8_t> domain(4, 0);
+    Interpolator interpolator(domain.data(), 0);
+    interpolator.setMode(InterpolationMode::Linear);
+    interpolator.setTimeOffset(250000);
+    interpolator.pushWaypoint(Waypoint{0, 0.0});
+    interpolator.pushWaypoint(Waypoint{Millisecond, 1000.0});
+
+    interpolator.update(0);
+    EXPECT_EQ(readS32(domain, 0), 250);
+    EXPECT_FALSE(interpolator.hasVelocityFeedForward());
+}
+
+TEST(InterpolatorTest, QueueRefusesWaypointsWhenFullOrOutOfOrder)
+{
+    std::vector<uint8_t> domain(4, 0);
+    Interpolator interpolator(domain.data(), 0, std::nullopt, 2);
+    EXPECT_TRUE(interpolator.pushWaypoint(Waypoint{10, 1.0}));
+    EXPECT_FALSE(interpolator.pushWaypoint(Waypoint{5, 1.0}));
+    EXPECT_TRUE(interpolator.pushWaypoint(Waypoint{20, 2.0}));
+    EXPECT_FALSE(interpolator.pushWaypoint(Waypoint{30, 3.0}));
+    EXPECT_EQ(interpolator.getDroppedWaypoints(), 1);
+
+    // Consuming the first two frees their slots.
+    interpolator.update(20);
+    EXPECT_TRUE(interpolator.pushWaypoint(Waypoint{30, 3.0}));
+}
+
+TEST(InterpolatorTest, ProducerThreadFeedsTheCyclicThread)
+{
+    std::vector<uint8_t> domain(4, 0);
+    Interpolator interpolator(domain.data(), 0, std::nullopt, 4);
+    interpolator.setMode(InterpolationMode::Linear);
+
+    constexpr int WaypointCount = 2000;
+    std::atomic<bool> isProducerDone{false};
+    std::thread producer([&](){
+        for(int i = 0; i < WaypointCount; i++)
+        {
+            while(!interpolator.pushWaypoint(Waypoint{(uint64_t)i * 4, i * 4.0}))
+            {
+                std::this_thread::yield();
+            }
+        }
+        isProducerDone.store(true);
+    });
+
+    // The consumer does not wait for the producer, every position has to lie on or behind the pushed line.
+    uint64_t time = 0;
+    while(!isProducerDone.load() || time < (WaypointCount - 1) * 4)
+    {
+        if(interpolator.update(time)){
+            const double position = interpolator.getSetpoint().position;
+            EXPECT_LE(position, (double)time);
+            if(interpolator.getStarvedCycles() == 0){
+                EXPECT_DOUBLE_EQ(position, (double)time);
+            }
+            time++;
+        }
+    }
+    producer.join();
+    interpolator.update(time);
+    EXPECT_DOUBLE_EQ(interpolator.getSetpoint().position, (WaypointCount - 1) * 4.0);
+}
+
+class InterpolatorMasterTest : public ::testing::Test
+{
+    protected:
+
+    void TearDown() override{
+        test_config::removeGeneratedFiles(configPath);
+    }
+
+    const std::string configPath = test_config::getConfigPath("interpolator_test");
+};
+
+TEST_F(InterpolatorMasterTest, InterpolatorIsAttachedToADriver)
+{
+    Master master(configPath);
+    EXPECT_EQ(master.getApplicationTime(), 0);
+    ASSERT_TRUE(master.init());
+
+    auto drive = master.getSlave<DriverPtr>("with_feed_forward").value();
+    auto interpolator = ec::motion::Interpolator::fromDriver(drive);
+    ASSERT_TRUE(interpolator);
+    EXPECT_TRUE(interpolator->hasVelocityFeedForward());
+    interpolator->setMode(InterpolationMode::Linear);
+    interpolator->setVelocityFactor(0.001);
+
+    interpolator->pushWaypoint(Waypoint{0, 0.0});
+    interpolator->pushWaypoint(Waypoint{2 * Millisecond, 2000.0});
+    ASSERT_TRUE(interpolator->update(Millisecond));
+    EXPECT_EQ(drive->read<int32_t>("target_position").value(), 1000);
+    EXPECT_EQ(drive->read<int32_t>("velocity_offset").value(), 1000);
+
+    auto other = master.getSlave<DriverPtr>("without_feed_forward").value();
+    auto withoutFeedForward = ec::motion::Interpolator::fromDriver(other, "target_position", "missing");
+    ASSERT_TRUE(withoutFeedForward);
+    EXPECT_FALSE(withoutFeedForward->hasVelocityFeedForward());
+    EXPECT_FALSE(ec::motion::Interpolator::fromDriver(other, "missing"));
+}
+
+}
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
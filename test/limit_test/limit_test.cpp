@@ -0,0 +1,259 @@
+#include "ethercat_interface/master.hpp"
+#include "ethercat_interface/limit.hpp"
+#include "../fake_ecrt/fake_ecrt.hpp"
+#include "../test_config/test_config.hpp"
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+using namespace ec::limit;
+
+ec::EntryLimit makeLimit(double min, double max, double max_step = INFINITY)
+{
+    ec::EntryLimit limit;
+    limit.isLimited = true;
+    limit.min = min;
+    limit.max = max;
+    limit.maxStep = max_step;
+    return limit;
+}
+
+/**
+ * @brief Process image of int32 entries at 4 * index.
+ *
+ */
+struct ProcessImage
+{
+    explicit ProcessImage(const std::vector<ec::EntryLimit>& limits)
+        : domain(limits.size() * 4, 0)
+    {
+        for(std::size_t i = 0; i < limits.size(); i++)
+        {
+            entries.push_back(LimitedEntry{"axis_" + std::to_string(i), (uint32_t)(4 * i), ec::DataType::INT32, limits[i]});
+        }
+    }
+
+    void set(std::size_t index, int32_t value)
+    {
+        std::memcpy(domain.data() + 4 * index, &value, sizeof(value));
+    }
+
+    int32_t get(std::size_t index) const
+    {
+        int32_t value;
+        std::memcpy(&value, domain.data() + 4 * index, sizeof(value));
+        return value;
+    }
+
+    std::vector<uint8_t> domain;
+
+    std::vector<LimitedEntry> entries;
+};
+
+TEST(LimitStageTest, ValuesAreClampedToTheirRange)
+{
+    // Five entries, so the last block is padded.
+    ProcessImage image(std::vector<ec::EntryLimit>(5, makeLimit(-100.0, 100.0)));
+    LimitStage stage(image.domain.data(), image.entries);
+    const int32_t written[] = {50, 101, -1000, 100, INT32_MIN};
+    const int32_t sent[] = {50, 100, -100, 100, -100};
+    for(std::size_t i = 0; i < 5; i++)
+    {
+        image.set(i, written[i]);
+    }
+
+    stage.apply();
+    for(std::size_t i = 0; i < 5; i++)
+    {
+        EXPECT_EQ(image.get(i), sent[i]) << "entry " << i;
+        EXPECT_EQ(stage.getClampCount(i), written[i] == sent[i] ? 0u : 1u) << "entry " << i;
+    }
+    EXPECT_EQ(stage.getTotalClampCount(), 3u);
+    EXPECT_EQ(stage.findEntry("axis_4"), 4u);
+    EXPECT_FALSE(stage.findEntry("axis_5"));
+}
+
+TEST(LimitStageTest, StepsAreLimitedFromTheValueSentBefore)
+{
+    ProcessImage image({makeLimit(-1000.0, 1000.0, 30.0)});
+    LimitStage stage(image.domain.data(), image.entries);
+    stage.apply();
+
+    // The update function jumps to 100 and keeps writing it, the output ramps there.
+    for(const int32_t expected : {30, 60, 90, 100, 100})
+    {
+        image.set(0, 100);
+        stage.apply();
+        EXPECT_EQ(image.get(0), expected);
+    }
+    EXPECT_EQ(stage.getClampCount(0), 3u);
+
+    image.set(0, -100);
+    stage.apply();
+    EXPECT_EQ(image.get(0), 70);
+}
+
+TEST(LimitStageTest, DisabledEntriesAreSentAsWritten)
+{
+    ProcessImage image({makeLimit(-10.0, 10.0, 5.0)});
+    LimitStage stage(image.domain.data(), image.entries);
+    stage.setEnabled(0, false);
+    EXPECT_FALSE(stage.isEnabled(0));
+    image.set(0, 500);
+    stage.apply();
+    image.set(0, -500);
+    stage.apply();
+    EXPECT_EQ(image.get(0), -500);
+    EXPECT_EQ(stage.getTotalClampCount(), 0u);
+
+    // The step limit continues from the value sent while disabled.
+    stage.setEnabled(0, true);
+    image.set(0, 0);
+    stage.apply();
+    EXPECT_EQ(image.get(0), -10);
+    EXPECT_EQ(stage.getClampCount(0), 1u);
+}
+
+TEST(LimitStageTest, EntryTypesBoundTheLimits)
+{
+    std::vector<uint8_t> domain(10, 0);
+    LimitStage stage(domain.data(), {
+        LimitedEntry{"torque", 0, ec::DataType::INT16, makeLimit(-1e9, 1e9, 1e9)},
+        LimitedEntry{"velocity", 2, ec::DataType::DOUBLE, makeLimit(-2.5, 2.5)}
+    });
+
+    double velocity = 1.5;
+    std::memcpy(domain.data() + 2, &velocity, sizeof(velocity));
+    stage.apply();
+
+    // A NaN is not sent, the value before is held.
+    velocity = NAN;
+    std::memcpy(domain.data() + 2, &velocity, sizeof(velocity));
+    stage.apply();
+    std::memcpy(&velocity, domain.data() + 2, sizeof(velocity));
+    EXPECT_EQ(velocity, 1.5);
+
+    velocity = -3.0;
+    std::memcpy(domain.data() + 2, &velocity, sizeof(velocity));
+    stage.apply();
+    std::memcpy(&velocity, domain.data() + 2, sizeof(velocity));
+    EXPECT_EQ(velocity, -2.5);
+    EXPECT_EQ(stage.getClampCount(1), 2u);
+
+    // The limits of the int16 torque are narrowed to its range, the untouched entry is not clamped.
+    int16_t torque;
+    std::memcpy(&torque, domain.data(), sizeof(torque));
+    EXPECT_EQ(torque, 0);
+    EXPECT_EQ(stage.getClampCount(0), 0u);
+}
+
+TEST(LimitStageTest, LimitsAreParsedFromYaml)
+{
+    using ec::parser::parseEntryLimit;
+
+    const auto limit = parseEntryLimit(YAML::Load("{min: -100, max: 200, max_step: 5.5}"));
+    ASSERT_TRUE(limit);
+    EXPECT_TRUE(limit->isLimited);
+    EXPECT_EQ(limit->min, -100.0);
+    EXPECT_EQ(limit->max, 200.0);
+    EXPECT_EQ(limit->maxStep, 5.5);
+
+    const auto stepOnly = parseEntryLimit(YAML::Load("{max_step: 10}"));
+    ASSERT_TRUE(stepOnly);
+    EXPECT_EQ(stepOnly->min, -INFINITY);
+    EXPECT_EQ(stepOnly->max, INFINITY);
+
+    EXPECT_FALSE(parseEntryLimit(YAML::Load("{min: 10, max: -10}")));
+    EXPECT_FALSE(parseEntryLimit(YAML::Load("{max_step: -1}")));
+}
+
+TEST(LimitStageTest, StaleEntriesResendTheValueSentBefore)
+{
+    std::atomic<bool> stale{false};
+    ProcessImage image({makeLimit(-1000.0, 1000.0, 30.0), makeLimit(-1000.0, 1000.0, 30.0)});
+    image.entries[1].staleFlag = &stale;
+    LimitStage stage(image.domain.data(), image.entries);
+    image.set(0, 20);
+    image.set(1, 20);
+    stage.apply();
+
+    // The entry of the stale slave is sent as before and nothing is counted for it.
+    stale = true;
+    image.set(0, 40);
+    image.set(1, 500);
+    stage.apply();
+    EXPECT_EQ(image.get(0), 40);
+    EXPECT_EQ(image.get(1), 20);
+    EXPECT_EQ(stage.getClampCount(1), 0u);
+
+    // The step limit continues from the held value.
+    stale = false;
+    image.set(1, 500);
+    stage.apply();
+    EXPECT_EQ(image.get(1), 50);
+    EXPECT_EQ(stage.getClampCount(1), 1u);
+}
+
+class LimitMasterTest : public ::testing::Test
+{
+    protected:
+
+    void TearDown() override{
+        test_config::removeGeneratedFiles(configPath);
+    }
+
+    const std::string configPath = test_config::getConfigPath("limit_test");
+};
+
+TEST_F(LimitMasterTest, OutputsAreClampedBeforeTheDomainIsSent)
+{
+    // The second master reads the configuration from the cache written by the first one.
+    for(int run = 0; run < 2; run++)
+    {
+        Master master(configPath);
+        ASSERT_TRUE(master.init());
+        EXPECT_EQ(master.getLimitStage("missing_domain"), nullptr);
+        ec::limit::LimitStage* stage = master.getLimitStage("main_domain");
+        ASSERT_NE(stage, nullptr);
+        ASSERT_EQ(stage->size(), 4);
+
+        auto drivers = master.getDrivers("main_domain");
+        ASSERT_TRUE(master.sendDomainData("main_domain"));
+        ASSERT_TRUE(drivers[1]->write<int32_t>("target_velocity", 1000000));
+        ASSERT_TRUE(drivers[1]->write<int16_t>("target_torque", 500));
+        ASSERT_TRUE(drivers[1]->write<uint16_t>("control_word", 0x0F));
+        ASSERT_TRUE(master.sendDomainData("main_domain"));
+        EXPECT_EQ(drivers[1]->read<int32_t>("target_velocity").value(), 3000);
+        EXPECT_EQ(drivers[1]->read<int16_t>("target_torque").value(), 10);
+        EXPECT_EQ(drivers[1]->read<uint16_t>("control_word").value(), 0x0F);
+
+        EXPECT_EQ(stage->getClampCount(stage->findEntry("y.target_velocity").value()), 1u);
+        EXPECT_EQ(stage->getClampCount(stage->findEntry("x.target_velocity").value()), 0u);
+        EXPECT_EQ(stage->getTotalClampCount(), 2u);
+    }
+}
+
+TEST_F(LimitMasterTest, InvalidLimitFailsTheConfiguration)
+{
+    auto configDocs = YAML::LoadAllFromFile(configPath);
+    ASSERT_TRUE(ec::parser::parseConfigDocuments(configDocs));
+
+    // Leaving the drives out of the configuration would neither limit nor report their axes.
+    configDocs.at(1)["pdo_mapping_1"]["pdos"][0]["limit"]["min"] = 5000;
+    EXPECT_FALSE(ec::parser::parseConfigDocuments(configDocs));
+
+    configDocs.at(1)["pdo_mapping_1"]["pdos"][0]["limit"]["min"] = -3000;
+    configDocs.at(1)["pdo_mapping_1"]["pdos"][1]["limit"]["max_step"] = -1;
+    EXPECT_FALSE(ec::parser::parseConfigDocuments(configDocs));
+}
+
+}
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,77 @@
+/**
+ * @file motion_planner_benchmark.cpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief Cost of evaluating the S-curve profiles of 64 axes once per cycle, and of planning their move.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ethercat_interface/driver/motion_planner.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+    constexpr std::size_t axisCount = 64;
+    constexpr uint64_t cyclePeriodNs = 1000000;
+    constexpr int moves = 20;
+
+    std::vector<uint8_t> domain(axisCount * 4, 0);
+    std::vector<uint32_t> positionOffsets(axisCount);
+    std::vector<ec::motion::AxisLimits> limits(axisCount);
+    std::vector<double> startPositions(axisCount, 0.0);
+    std::vector<double> targetPositions(axisCount);
+    for(std::size_t axis = 0; axis < axisCount; axis++)
+    {
+        positionOffsets[axis] = (uint32_t)(4 * axis);
+        limits[axis] = ec::motion::AxisLimits{100000.0 + 1000.0 * axis, 1000000.0, 50000000.0};
+    }
+    ec::motion::MotionPlanner planner(domain.data(), positionOffsets, limits);
+
+    double planNanoseconds = 0.0;
+    double worstCycleNanoseconds = 0.0;
+    double totalCycleNanoseconds = 0.0;
+    uint64_t cycles = 0;
+    uint64_t time = 0;
+    double checksum = 0.0;
+    for(int move = 0; move < moves; move++)
+    {
+        for(std::size_t axis = 0; axis < axisCount; axis++)
+        {
+            startPositions[axis] = targetPositions[axis];
+            targetPositions[axis] = (move % 2 ? -1.0 : 1.0) * (10000.0 + 997.0 * axis);
+        }
+
+        const auto planStart = std::chrono::steady_clock::now();
+        planner.plan(startPositions, targetPositions, time);
+        const auto planEnd = std::chrono::steady_clock::now();
+        planNanoseconds += std::chrono::duration<double, std::nano>(planEnd - planStart).count();
+
+        do
+        {
+            const auto start = std::chrono::steady_clock::now();
+            planner.update(time);
+            const auto end = std::chrono::steady_clock::now();
+            const double cycleNanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+            totalCycleNanoseconds += cycleNanoseconds;
+            worstCycleNanoseconds = std::max(worstCycleNanoseconds, cycleNanoseconds);
+            checksum += planner.getState(axisCount - 1).position;
+            cycles++;
+            time += cyclePeriodNs;
+        } while(!planner.isDone());
+    }
+
+    std::printf("axes: %zu, cycles: %lu, moves: %d\n", axisCount, (unsigned long)cycles, moves);
+    std::printf("%-28s %10.3f ns\n", "plan", planNanoseconds / moves);
+    std::printf("%-28s %10.3f ns\n", "update, mean", totalCycleNanoseconds / cycles);
+    std::printf("%-28s %10.3f ns\n", "update, worst", worstCycleNanoseconds);
+    std::printf("%-28s %10.3f ns\n", "update per axis, mean", totalCycleNanoseconds / cycles / axisCount);
+
+    return checksum == 0.0 ? 1 : 0;
+}
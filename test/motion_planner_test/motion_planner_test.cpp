@@ -0,0 +1,192 @@
+#include "ethercat_interface/master.hpp"
+#include "ethercat_interface/driver/motion_planner.hpp"
+#include "../fake_ecrt/fake_ecrt.hpp"
+#include "../test_config/test_config.hpp"
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+using namespace ec::motion;
+
+constexpr uint64_t Millisecond = 1000000;
+
+/**
+ * @brief Largest velocity, acceleration and position step seen sampling the profile every microsecond.
+ *
+ */
+struct ProfilePeaks
+{
+    double velocity = 0.0;
+
+    double acceleration = 0.0;
+
+    double positionStep = 0.0;
+};
+
+ProfilePeaks samplePeaks(const AxisProfile& profile, double duration)
+{
+    ProfilePeaks peaks;
+    std::size_t phaseIndex = 0;
+    double previousPosition = profile.phases[0].position;
+    for(double time = 0.0; time <= duration + 1e-3; time += 1e-6)
+    {
+        const ProfileState state = evaluateProfile(profile, time, phaseIndex);
+        peaks.velocity = std::max(peaks.velocity, std::abs(state.velocity));
+        peaks.acceleration = std::max(peaks.acceleration, std::abs(state.acceleration));
+        peaks.positionStep = std::max(peaks.positionStep, std::abs(state.position - previousPosition));
+        previousPosition = state.position;
+    }
+
+    return peaks;
+}
+
+TEST(MotionPlannerTest, SCurveStaysWithinTheLimits)
+{
+    const AxisLimits limits{1000.0, 20000.0, 1000000.0};
+    AxisProfile profile;
+    const double duration = computeProfile(0.0, 500.0, limits, ProfileType::SCurve, 0.0, profile);
+
+    // Accelerating to 1000 takes 0.07 s and 35 units, the remaining 430 units are cruised.
+    EXPECT_NEAR(duration, 0.07 + 0.43 + 0.07, 1e-9);
+
+    const ProfilePeaks peaks = samplePeaks(profile, duration);
+    EXPECT_NEAR(peaks.velocity, 1000.0, 1e-6);
+    EXPECT_NEAR(peaks.acceleration, 20000.0, 1e-6);
+    EXPECT_LT(peaks.positionStep, 1000.0 * 1e-6 + 1e-9);
+
+    std::size_t phaseIndex = 0;
+    const ProfileState end = evaluateProfile(profile, duration, phaseIndex);
+    EXPECT_DOUBLE_EQ(end.position, 500.0);
+    EXPECT_EQ(end.velocity, 0.0);
+
+    // Just before the rest, the integrated segments meet the target.
+    phaseIndex = 0;
+    const ProfileState beforeEnd = evaluateProfile(profile, duration - 1e-9, phaseIndex);
+    EXPECT_NEAR(beforeEnd.position, 500.0, 1e-6);
+    EXPECT_NEAR(beforeEnd.velocity, 0.0, 1e-3);
+}
+
+TEST(MotionPlannerTest, ShortSCurveMovesDoNotReachTheLimits)
+{
+    const AxisLimits limits{1000.0, 20000.0, 1000000.0};
+    for(const double distance : {0.5, 5.0, 30.0})
+    {
+        AxisProfile profile;
+        const double duration = computeProfile(10.0, 10.0 - distance, limits, ProfileType::SCurve, 0.0, profile);
+        const ProfilePeaks peaks = samplePeaks(profile, duration);
+        EXPECT_LT(peaks.velocity, 1000.0);
+        EXPECT_LE(peaks.acceleration, 20000.0 + 1e-6);
+
+        std::size_t phaseIndex = 0;
+        EXPECT_NEAR(evaluateProfile(profile, duration - 1e-9, phaseIndex).position, 10.0 - distance, 1e-6);
+    }
+}
+
+TEST(MotionPlannerTest, TrapezoidalProfileAcceleratesCruisesAndDecelerates)
+{
+    const AxisLimits limits{100.0, 1000.0, 0.0};
+    AxisProfile profile;
+    const double duration = computeProfile(0.0, 50.0, limits, ProfileType::Trapezoidal, 0.0, profile);
+    EXPECT_NEAR(duration, 50.0 / 100.0 + 100.0 / 1000.0, 1e-9);
+
+    std::size_t phaseIndex = 0;
+    EXPECT_NEAR(evaluateProfile(profile, 0.05, phaseIndex).velocity, 50.0, 1e-9);
+    EXPECT_NEAR(evaluateProfile(profile, 0.3, phaseIndex).velocity, 100.0, 1e-9);
+    EXPECT_NEAR(evaluateProfile(profile, 0.3, phaseIndex).acceleration, 0.0, 1e-9);
+    EXPECT_NEAR(evaluateProfile(profile, duration - 1e-9, phaseIndex).position, 50.0, 1e-6);
+}
+
+TEST(MotionPlannerTest, AxesStartAndArriveTogether)
+{
+    std::vector<uint8_t> domain(12, 0);
+    const std::vector<AxisLimits> limits(3, AxisLimits{1000.0, 20000.0, 1000000.0});
+    MotionPlanner planner(domain.data(), {0, 4, 8}, limits);
+    EXPECT_FALSE(planner.update(0));
+
+    ASSERT_TRUE(planner.plan({0.0, 0.0, 100.0}, {500.0, -50.0, 100.0}, 10 * Millisecond));
+    const double duration = 0.57;
+
+    std::vector<double> peakVelocities(3, 0.0);
+    uint64_t time = 0;
+    for(; !planner.isDone(); time += Millisecond)
+    {
+        ASSERT_TRUE(planner.update(time));
+        ASSERT_LT(time, 2000 * Millisecond);
+        for(std::size_t axis = 0; axis < 3; axis++)
+        {
+            peakVelocities[axis] = std::max(peakVelocities[axis], std::abs(planner.getState(axis).velocity));
+            int32_t position;
+            std::memcpy(&position, domain.data() + 4 * axis, sizeof(position));
+            EXPECT_EQ(position, (int32_t)std::llround(planner.getState(axis).position));
+        }
+    }
+    EXPECT_NEAR(planner.getDuration(), duration, 1e-9);
+    EXPECT_EQ(time - Millisecond, 10 * Millisecond + 570 * Millisecond);
+
+    // The short axis is stretched to the same duration, so it moves slower than it could.
+    EXPECT_NEAR(peakVelocities[0], 1000.0, 1e-6);
+    EXPECT_GT(peakVelocities[1], 50.0 / duration);
+    EXPECT_LT(peakVelocities[1], 2.0 * 50.0 / duration);
+    EXPECT_EQ(peakVelocities[2], 0.0);
+    EXPECT_DOUBLE_EQ(planner.getState(0).position, 500.0);
+    EXPECT_DOUBLE_EQ(planner.getState(1).position, -50.0);
+    EXPECT_DOUBLE_EQ(planner.getState(2).position, 100.0);
+}
+
+TEST(MotionPlannerTest, NextPlanIsTakenByTheNextUpdate)
+{
+    std::vector<uint8_t> domain(4, 0);
+    MotionPlanner planner(domain.data(), {0}, {AxisLimits{100.0, 1000.0, 100000.0}});
+    EXPECT_FALSE(planner.plan({0.0}, {1.0, 2.0}, 0));
+    EXPECT_FALSE(MotionPlanner(domain.data(), {0}, {AxisLimits{100.0, 1000.0, 0.0}}).plan({0.0}, {1.0}, 0));
+
+    ASSERT_TRUE(planner.plan({0.0}, {10.0}, 0));
+    EXPECT_FALSE(planner.plan({0.0}, {20.0}, 0));
+    planner.update(0);
+    ASSERT_TRUE(planner.plan({0.0}, {20.0}, 0, ProfileType::Trapezoidal));
+
+    // The first plan is executed until the switch.
+    planner.update(Millisecond);
+    planner.update(10000 * Millisecond);
+    EXPECT_DOUBLE_EQ(planner.getState(0).position, 20.0);
+}
+
+class MotionPlannerMasterTest : public ::testing::Test
+{
+    protected:
+
+    void TearDown() override{
+        test_config::removeGeneratedFiles(configPath);
+    }
+
+    const std::string configPath = test_config::getConfigPath("motion_planner_test");
+};
+
+TEST_F(MotionPlannerMasterTest, PlannerWritesTheTargetPositionsOfTheDrivers)
+{
+    Master master(configPath);
+    ASSERT_TRUE(master.init());
+
+    auto drivers = master.getDrivers("main_domain");
+    const std::vector<AxisLimits> limits(2, AxisLimits{10000.0, 100000.0, 10000000.0});
+    EXPECT_FALSE(MotionPlanner::fromDrivers(drivers, {limits.front()}));
+    EXPECT_FALSE(MotionPlanner::fromDrivers(drivers, limits, "missing"));
+
+    auto planner = MotionPlanner::fromDrivers(drivers, limits);
+    ASSERT_TRUE(planner);
+    ASSERT_TRUE(planner->plan({0.0, 0.0}, {1000.0, -2000.0}, 0));
+    planner->update(1000 * Millisecond);
+    EXPECT_EQ(drivers[0]->read<int32_t>("target_position").value(), 1000);
+    EXPECT_EQ(drivers[1]->read<int32_t>("target_position").value(), -2000);
+}
+
+}
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,229 @@
+#include "ethercat_interface/master.hpp"
+#include "../fake_ecrt/fake_ecrt.hpp"
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <new>
+
+#include <unistd.h>
+
+namespace {
+
+class MultiMasterTest : public ::testing::Test
+{
+    protected:
+
+    void TearDown() override{
+        for(const std::string& path : writtenPaths)
+        {
+            for(const std::string suffix : {"", ".cache", ".topology"})
+            {
+                std::remove((path + suffix).c_str());
+            }
+        }
+    }
+
+    std::string writeConfig(int master_index, const std::string& extra_program_config = "")
+    {
+        const std::string path = "/tmp/ethercat_interface_multi_master_test_" + std::to_string(master_index) + ".yaml";
+        std::ofstream file(path);
+        file << "---\nprogram_config:\n  cycle_period: 1000\n  master_index: " << master_index << "\n" << extra_program_config << "...\n"
+             << "---\n"
+             << "slave_name: inputs_" << master_index << "\n"
+             << "slave_count: 1\n"
+             << "slave_type: io\n"
+             << "alias: 0\n"
+             << "position: 0\n"
+             << "vendor_id: 0x000022d2\n"
+             << "product_code: 0x00000201\n"
+             << "domain_name: main_domain\n"
+             << "sync_manager_config:\n";
+        const char* directions[] = {"output", "input", "output", "input"};
+        for(int sm = 0; sm < 4; sm++)
+        {
+            file << "  -\n    index: " << sm << "\n    direction: " << directions[sm] << "\n    watchdog_mode: disabled\n";
+        }
+        file << "pdo_mapping_1:\n addr: 0x1a00\n type: tx\n pdos:\n"
+             << "  - {name: status_word, index: 0x6041, subindex: 0, bitlength: 16, type: uint16}\n"
+             << "...\n";
+        writtenPaths.push_back(path);
+        return path;
+    }
+
+    std::vector<std::string> writtenPaths;
+};
+
+TEST_F(MultiMasterTest, EachMasterRequestsItsOwnIndex)
+{
+    Master first(writeConfig(0));
+    Master second(writeConfig(1));
+    ASSERT_TRUE(first.init());
+    ASSERT_TRUE(second.init());
+
+    EXPECT_TRUE(fake_ecrt::isMasterActive(0));
+    EXPECT_TRUE(fake_ecrt::isMasterActive(1));
+    EXPECT_TRUE(first.getSlave<IoPtr>("inputs_0"));
+    EXPECT_TRUE(second.getSlave<IoPtr>("inputs_1"));
+}
+
+TEST_F(MultiMasterTest, MastersCycleOnTheirOwnThreads)
+{
+    Master first(writeConfig(0, "  align_cycles: true\n  cpu_core: 0\n"));
+    Master second(writeConfig(1, "  align_cycles: true\n  cycle_offset: 250\n"));
+    ASSERT_TRUE(first.init());
+    ASSERT_TRUE(second.init());
+
+    std::atomic<int> firstUpdates{0};
+    std::atomic<int> secondUpdates{0};
+    first.setUpdateFunction([&firstUpdates](){ firstUpdates++; });
+    second.setUpdateFunction([&secondUpdates](){ secondUpdates++; });
+
+    ASSERT_TRUE(first.start());
+    ASSERT_TRUE(second.start());
+    EXPECT_FALSE(first.start());
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    first.stop();
+    second.stop();
+
+    EXPECT_FALSE(first.isRunning());
+    EXPECT_GT(first.getCycleCounter(), 10);
+    EXPECT_GT(second.getCycleCounter(), 10);
+    EXPECT_EQ((uint64_t)firstUpdates.load(), first.getCycleCounter());
+    EXPECT_EQ(second.getDomainStatus("main_domain")->checkedCycles, second.getCycleCounter());
+}
+
+TEST_F(MultiMasterTest, StreamsAreHandedOverWhileCycling)
+{
+    const std::string recordingPath = "/tmp/ethercat_interface_multi_master_test.rec";
+    Master master(writeConfig(0));
+    ASSERT_TRUE(master.init());
+    ASSERT_TRUE(master.start());
+
+    ASSERT_TRUE(master.startRecording(recordingPath, 1000));
+    EXPECT_FALSE(master.startRecording(recordingPath, 1000));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_TRUE(master.stopRecording());
+
+    ec::recorder::ProcessDataPlayer player;
+    ASSERT_TRUE(player.open(recordingPath));
+    EXPECT_GT(player.frameCount(), 5);
+    player.close();
+
+    // The replay ends by itself, the cyclic thread stops using the player until stopReplay() closes it.
+    ASSERT_TRUE(master.startReplay(recordingPath));
+    EXPECT_TRUE(master.isReplaying());
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while(master.isReplaying() && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_FALSE(master.isReplaying());
+    ASSERT_TRUE(master.startReplay(recordingPath));
+    ASSERT_TRUE(master.stopReplay());
+    EXPECT_FALSE(master.isReplaying());
+
+    master.stop();
+    std::remove(recordingPath.c_str());
+}
+
+TEST_F(MultiMasterTest, RecordingIsReplayedOfflineDeterministically)
+{
+    char recordingPath[] = "/tmp/ethercat_interface_multi_master_test_XXXXXX";
+    const int fileDescriptor = mkstemp(recordingPath);
+    ASSERT_NE(fileDescriptor, -1);
+    ::close(fileDescriptor);
+    writtenPaths.push_back(recordingPath);
+
+    Master master(writeConfig(0));
+    ASSERT_TRUE(master.init());
+    Slave* slave = master.getSlave<Slave*>("inputs_0").value();
+
+    // Cycles driven by hand, the status word stands in for what the slave sent.
+    ASSERT_TRUE(master.startRecording(recordingPath, 100));
+    for(uint16_t cycle = 0; cycle < 50; cycle++)
+    {
+        master.receive();
+        ASSERT_TRUE(slave->write<uint16_t>("status_word", cycle * 3));
+        master.receiveDomainData("main_domain");
+        master.sendDomainData("main_domain");
+        master.send();
+    }
+    ASSERT_TRUE(master.stopRecording());
+    const uint64_t cycleCounter = master.getCycleCounter();
+
+    std::vector<std::pair<uint64_t, uint16_t>> seenInputs;
+    master.setUpdateFunction([&](){
+        seenInputs.emplace_back(master.getCycleCounter(), slave->read<uint16_t>("status_word").value());
+    });
+
+    for(int run = 0; run < 2; run++)
+    {
+        ASSERT_TRUE(slave->write<uint16_t>("status_word", 0xFFFF));
+        seenInputs.clear();
+        EXPECT_EQ(master.replayOffline(recordingPath), 50);
+
+        ASSERT_EQ(seenInputs.size(), 50);
+        for(uint16_t cycle = 0; cycle < 50; cycle++)
+        {
+            EXPECT_EQ(seenInputs[cycle].first, cycle);
+            EXPECT_EQ(seenInputs[cycle].second, cycle * 3);
+        }
+    }
+    EXPECT_EQ(master.getCycleCounter(), cycleCounter);
+
+    ASSERT_TRUE(master.start());
+    EXPECT_EQ(master.replayOffline(recordingPath), std::nullopt);
+    master.stop();
+}
+
+TEST_F(MultiMasterTest, PinningToAMissingCoreFails)
+{
+    Master master(writeConfig(0, "  cpu_core: 100000\n"));
+    ASSERT_TRUE(master.init());
+    EXPECT_FALSE(master.start());
+    EXPECT_FALSE(master.isRunning());
+}
+
+TEST_F(MultiMasterTest, MasterWithAnInvalidConfigurationIsDestroyed)
+{
+    const std::string path = writeConfig(0);
+    {
+        std::ofstream file(path, std::ios::app);
+        file << "---\nslave_name: unknown\nslave_count: 1\nslave_type: missing_type\n...\n";
+    }
+
+    // Constructed over non-zero bytes, so a member without an initializer does not happen to be null.
+    void* storage = ::operator new(sizeof(Master));
+    std::memset(storage, 0xA5, sizeof(Master));
+    Master* master = new (storage) Master(path);
+    EXPECT_FALSE(master->init());
+    EXPECT_FALSE(fake_ecrt::isMasterActive(0));
+    master->~Master();
+    ::operator delete(storage);
+
+    Master neverInitialized;
+}
+
+TEST(CyclicTaskTimerTest, AlignedTimersWakeUpAtPeriodMultiples)
+{
+    constexpr int64_t period = 1000000;
+    CyclicTaskTimer timer(period);
+    timer.initAligned(250000);
+    timer.sleep();
+
+    const int64_t wakeupTime = timespectoNanoSec(timer.getWakeupTime());
+    EXPECT_EQ(wakeupTime % period, 250000);
+
+    std::timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    EXPECT_GE((int64_t)timespectoNanoSec(now), wakeupTime);
+}
+
+}
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
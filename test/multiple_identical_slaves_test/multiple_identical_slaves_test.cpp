@@ -41,12 +41,56 @@ TEST_F(MultipleIdenticalSlavesTest, IsParseSuccessful)
     EXPECT_EQ(conf.slaveConfigurations.at(1).position, 2);
     EXPECT_EQ(conf.slaveConfigurations.at(2).position, 3);
 
+    // Identical slaves share one PDO layout instead of holding copies.
+    EXPECT_NE(conf.slaveConfigurations.at(0).layout, nullptr);
+    EXPECT_EQ(conf.slaveConfigurations.at(0).layout, conf.slaveConfigurations.at(1).layout);
+    EXPECT_EQ(conf.slaveConfigurations.at(0).layout, conf.slaveConfigurations.at(2).layout);
+
+    // The startup parameter list is shared the same way.
+    const auto& startupSdos = conf.slaveConfigurations.at(0).startupSdos;
+    ASSERT_NE(startupSdos, nullptr);
+    EXPECT_EQ(startupSdos, conf.slaveConfigurations.at(2).startupSdos);
+    ASSERT_EQ(startupSdos->size(), 2);
+    EXPECT_EQ(startupSdos->at(0).index, 0x6060);
+    EXPECT_EQ(startupSdos->at(0).data, std::vector<uint8_t>{0x08});
+    EXPECT_EQ(startupSdos->at(1).subindex, 1);
+    EXPECT_EQ(startupSdos->at(1).data, (std::vector<uint8_t>{0x60, 0x79, 0xFE, 0xFF}));
+
     for(const auto& currConf : conf.slaveConfigurations)
     {
         std::cout << currConf.toString() << std::endl;
     }
 
 }
+
+TEST_F(MultipleIdenticalSlavesTest, InvalidStartupSdoFailsTheWholeConfiguration)
+{
+    auto configDocs = YAML::LoadAllFromFile(configFilePath);
+    ASSERT_EQ(configDocs.size(), 2);
+    ASSERT_TRUE(ec::parser::parseConfigDocuments(configDocs));
+
+    // 300 does not fit the int8 object, none of the slaves created from the document may be configured.
+    configDocs.at(1)["startup_sdos"][0]["value"] = 300;
+    EXPECT_FALSE(ec::parser::parseConfigDocuments(configDocs));
+
+    configDocs.at(1)["startup_sdos"][0]["value"] = 8;
+    configDocs.at(1)["startup_sdos"][1]["subindex"] = 256;
+    EXPECT_FALSE(ec::parser::parseConfigDocuments(configDocs));
+}
+
+TEST(StartupSdoTest, ValuesMustFitTheirType)
+{
+    using ec::parser::encodeSdoValue;
+
+    EXPECT_EQ(encodeSdoValue(YAML::Load("255"), ec::DataType::UINT8), std::vector<uint8_t>{0xFF});
+    EXPECT_EQ(encodeSdoValue(YAML::Load("-128"), ec::DataType::INT8), std::vector<uint8_t>{0x80});
+    EXPECT_EQ(encodeSdoValue(YAML::Load("0x1234"), ec::DataType::UINT16), (std::vector<uint8_t>{0x34, 0x12}));
+
+    EXPECT_FALSE(encodeSdoValue(YAML::Load("256"), ec::DataType::UINT8));
+    EXPECT_FALSE(encodeSdoValue(YAML::Load("128"), ec::DataType::INT8));
+    EXPECT_FALSE(encodeSdoValue(YAML::Load("-129"), ec::DataType::INT8));
+    EXPECT_FALSE(encodeSdoValue(YAML::Load("2147483648"), ec::DataType::INT32));
+}
 }
 int main(int argc, char** argv)
 {
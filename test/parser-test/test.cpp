@@ -21,8 +21,8 @@ TEST(
     SingleSlaveConfigFileParserTest, SuccessfulParse 
 ){
     ASSERT_NE(std::nullopt, parseConfigFile(configFilePath));
-    ASSERT_EQ(4, parseConfigFile(configFilePath)->slaveConfigurations.at(0).rxPDOs.at(0).entries.size());
-    ASSERT_EQ(4, parseConfigFile(configFilePath)->slaveConfigurations.at(0).txPDOs.at(0).entries.size());
+    ASSERT_EQ(4, parseConfigFile(configFilePath)->slaveConfigurations.at(0).layout->rxPDOs.at(0).entries.size());
+    ASSERT_EQ(4, parseConfigFile(configFilePath)->slaveConfigurations.at(0).layout->txPDOs.at(0).entries.size());
 }
 
 /* class SingleSlaveConfigFileParserTest : public ::testing::Test
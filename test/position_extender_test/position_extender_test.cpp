@@ -0,0 +1,192 @@
+#include "ethercat_interface/master.hpp"
+#include "ethercat_interface/driver/position_extender.hpp"
+#include "../fake_ecrt/fake_ecrt.hpp"
+#include "../test_config/test_config.hpp"
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+using namespace ec::motion;
+
+/**
+ * @brief Process image of axes with a 32 bit counter at 8 * axis and a 32 bit target right after it.
+ *
+ */
+struct ProcessImage
+{
+    explicit ProcessImage(std::size_t axis_count)
+        : domain(axis_count * 8, 0)
+    {
+        for(std::size_t i = 0; i < axis_count; i++)
+        {
+            axes.push_back(PositionEntries{(uint32_t)(8 * i), (uint32_t)(8 * i + 4)});
+        }
+    }
+
+    void setCounter(std::size_t axis, uint32_t value)
+    {
+        std::memcpy(domain.data() + 8 * axis, &value, sizeof(value));
+    }
+
+    uint32_t getTarget(std::size_t axis) const
+    {
+        uint32_t value;
+        std::memcpy(&value, domain.data() + 8 * axis + 4, sizeof(value));
+        return value;
+    }
+
+    std::vector<uint8_t> domain;
+
+    std::vector<PositionEntries> axes;
+};
+
+TEST(PositionExtenderTest, PositionsContinueAcrossTheWrap)
+{
+    // Axes moving at different speeds in both directions, the fastest one at almost half the counter range per cycle.
+    const int64_t speeds[] = {1000, -1000, 0x10000000, -0x7FFFFFFF, 7};
+    const int64_t starts[] = {INT32_MAX - 5000, INT32_MIN + 5000, 0, -1, 0};
+    ProcessImage image(5);
+    PositionExtender extender(image.domain.data(), image.axes);
+    for(int cycle = 0; cycle < 1000; cycle++)
+    {
+        for(std::size_t axis = 0; axis < 5; axis++)
+        {
+            image.setCounter(axis, (uint32_t)(starts[axis] + speeds[axis] * cycle));
+        }
+        extender.update();
+        for(std::size_t axis = 0; axis < 5; axis++)
+        {
+            ASSERT_EQ(extender.getPosition(axis), starts[axis] + speeds[axis] * cycle) << "axis " << axis << " cycle " << cycle;
+        }
+    }
+}
+
+TEST(PositionExtenderTest, NarrowerCountersWrapAtTheirRange)
+{
+    ProcessImage image(1);
+    PositionExtender extender(image.domain.data(), image.axes);
+    EXPECT_FALSE(extender.setCounterBits(0, 1));
+    EXPECT_FALSE(extender.setCounterBits(0, 33));
+    ASSERT_TRUE(extender.setCounterBits(0, 20));
+
+    // A 20 bit multi-turn counter, the bits above are not cleared by the drive.
+    image.setCounter(0, 0xABC00000 | 0xFFFF0);
+    extender.update();
+    EXPECT_EQ(extender.getPosition(0), -16);
+    for(int cycle = 1; cycle <= 100; cycle++)
+    {
+        image.setCounter(0, 0xABC00000 | ((0xFFFF0 + 300 * cycle) & 0xFFFFF));
+        extender.update();
+    }
+    EXPECT_EQ(extender.getPosition(0), -16 + 300 * 100);
+
+    ASSERT_TRUE(extender.setTarget(0, -100));
+    EXPECT_EQ(image.getTarget(0), (uint32_t)(-100 & 0xFFFFF));
+    EXPECT_FALSE(extender.setTarget(0, extender.getPosition(0) + (1 << 19)));
+}
+
+TEST(PositionExtenderTest, TargetsAreNarrowedRelativeToThePosition)
+{
+    ProcessImage image(2);
+    image.axes[1].targetOffset = std::nullopt;
+    PositionExtender extender(image.domain.data(), image.axes);
+
+    // Seven turns of the 32 bit counter, then homing moves the position.
+    const int64_t position = 7 * ((int64_t)1 << 32) + 123;
+    image.setCounter(0, 0);
+    extender.update();
+    for(int64_t step = 1; step <= 7 * 4 * 2; step++)
+    {
+        image.setCounter(0, (uint32_t)(step * ((int64_t)1 << 29)));
+        extender.update();
+    }
+    image.setCounter(0, 123);
+    extender.update();
+    ASSERT_EQ(extender.getPosition(0), position);
+
+    ASSERT_TRUE(extender.setTarget(0, position + 1000000));
+    EXPECT_EQ(image.getTarget(0), 123u + 1000000u);
+    ASSERT_TRUE(extender.setTarget(0, position - 1000));
+    EXPECT_EQ(image.getTarget(0), (uint32_t)(123 - 1000));
+    EXPECT_FALSE(extender.setTarget(0, position + ((int64_t)1 << 31)));
+    EXPECT_TRUE(extender.setTarget(0, position - ((int64_t)1 << 31)));
+    EXPECT_FALSE(extender.setTarget(0, position - ((int64_t)1 << 31) - 1));
+
+    extender.setPosition(0, 0);
+    ASSERT_TRUE(extender.setTarget(0, 10));
+    EXPECT_EQ(image.getTarget(0), 133u);
+
+    EXPECT_FALSE(extender.setTarget(1, 0));
+}
+
+TEST(PositionExtenderTest, PositionsOfStaleAxesAreHeld)
+{
+    std::atomic<bool> stale{false};
+    ProcessImage image(2);
+    image.axes[1].staleFlag = &stale;
+    PositionExtender extender(image.domain.data(), image.axes);
+    image.setCounter(0, 100);
+    image.setCounter(1, 100);
+    extender.update();
+
+    // A full turn of the counter in quarter steps.
+    stale = true;
+    for(const uint32_t counter : {0x40000000u, 0x80000000u, 0xC0000000u, 0u})
+    {
+        image.setCounter(0, counter);
+        image.setCounter(1, counter);
+        extender.update();
+    }
+    EXPECT_EQ(extender.getPosition(0), (int64_t)1 << 32);
+    EXPECT_EQ(extender.getPosition(1), 100);
+
+    // The counter is followed again from the value it was held at.
+    stale = false;
+    image.setCounter(1, 150);
+    extender.update();
+    EXPECT_EQ(extender.getPosition(1), 150);
+}
+
+class PositionExtenderMasterTest : public ::testing::Test
+{
+    protected:
+
+    void TearDown() override{
+        test_config::removeGeneratedFiles(configPath);
+    }
+
+    const std::string configPath = test_config::getConfigPath("position_extender_test");
+};
+
+TEST_F(PositionExtenderMasterTest, ExtenderIsCreatedFromTheDriversOfADomain)
+{
+    Master master(configPath);
+    ASSERT_TRUE(master.init());
+
+    auto drivers = master.getDrivers("main_domain");
+    EXPECT_FALSE(PositionExtender::fromDrivers(drivers, "actual_position", "target_torque"));
+    EXPECT_FALSE(PositionExtender::fromDrivers(drivers, "actual_velocity"));
+    EXPECT_TRUE(PositionExtender::fromDrivers(drivers, "actual_position", ""));
+
+    auto extender = PositionExtender::fromDrivers(drivers);
+    ASSERT_TRUE(extender);
+    ASSERT_EQ(extender->size(), 2);
+    ASSERT_TRUE(drivers[1]->write<int32_t>("actual_position", INT32_MAX));
+    extender->update();
+    ASSERT_TRUE(drivers[1]->write<int32_t>("actual_position", INT32_MIN));
+    extender->update();
+    EXPECT_EQ(extender->getPosition(1), (int64_t)INT32_MAX + 1);
+
+    ASSERT_TRUE(extender->setTarget(1, (int64_t)INT32_MAX + 11));
+    EXPECT_EQ(drivers[1]->read<int32_t>("target_position").value(), INT32_MIN + 10);
+}
+
+}
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,203 @@
+#include "ethercat_interface/recorder.hpp"
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <cstdio>
+#include <ctime>
+#include <functional>
+
+#include <unistd.h>
+
+using namespace ec::recorder;
+
+namespace {
+class RecorderTest : public ::testing::Test
+{
+    protected:
+
+    void SetUp() override{
+        // Unique per run, so parallel runs of the test do not share the file.
+        char path[] = "/tmp/ethercat_interface_recorder_test_XXXXXX";
+        const int fileDescriptor = mkstemp(path);
+        ASSERT_NE(fileDescriptor, -1);
+        ::close(fileDescriptor);
+        recordingPath = path;
+    }
+
+    void TearDown() override{
+        std::remove(recordingPath.c_str());
+    }
+
+    std::string recordingPath;
+
+    const std::vector<DomainImageInfo> domains = {
+        {"wheel_domain", 2048},
+        {"io_domain", 64}
+    };
+
+    void recordCycles(std::size_t cycle_capacity, uint64_t num_of_cycles)
+    {
+        ProcessDataRecorder recorder;
+        ASSERT_TRUE(recorder.open(recordingPath, domains, cycle_capacity));
+
+        std::vector<uint8_t> wheelImage(2048);
+        std::vector<uint8_t> ioImage(64);
+        for(uint64_t cycle = 0; cycle < num_of_cycles; cycle++)
+        {
+            std::memset(wheelImage.data(), cycle & 0xFF, wheelImage.size());
+            std::memset(ioImage.data(), (cycle + 1) & 0xFF, ioImage.size());
+            const uint8_t* images[] = {wheelImage.data(), ioImage.data()};
+            // Let the writer thread catch up instead of dropping frames.
+            while(!recorder.record(cycle, cycle * 250000, images)){}
+        }
+
+        recorder.close();
+        EXPECT_EQ(recorder.writtenFrames(), num_of_cycles);
+    }
+};
+
+TEST_F(RecorderTest, RecordedCyclesAreReplayedInOrder)
+{
+    recordCycles(1000, 500);
+
+    ProcessDataPlayer player;
+    ASSERT_TRUE(player.open(recordingPath));
+    ASSERT_EQ(player.frameCount(), 500);
+
+    const auto ioIndex = player.findDomain("io_domain");
+    ASSERT_NE(ioIndex, std::nullopt);
+    EXPECT_EQ(player.getDomainSize(ioIndex.value()), 64);
+
+    uint64_t expectedCycle = 0;
+    std::vector<uint8_t> ioImage(64);
+    while(player.next())
+    {
+        EXPECT_EQ(player.getCurrentIndex().cycle, expectedCycle);
+        EXPECT_EQ(player.getCurrentIndex().timestamp, expectedCycle * 250000);
+        ASSERT_TRUE(player.copyImage(ioIndex.value(), ioImage.data()));
+        EXPECT_EQ(ioImage.back(), (expectedCycle + 1) & 0xFF);
+        expectedCycle += 1;
+    }
+    EXPECT_EQ(expectedCycle, 500);
+}
+
+TEST_F(RecorderTest, FullRecordingKeepsTheLatestCycles)
+{
+    recordCycles(100, 250);
+
+    ProcessDataPlayer player;
+    ASSERT_TRUE(player.open(recordingPath));
+    ASSERT_EQ(player.frameCount(), 100);
+
+    ASSERT_TRUE(player.next());
+    EXPECT_EQ(player.getCurrentIndex().cycle, 150);
+    EXPECT_EQ(player.getImage(0)[0], 150);
+
+    ASSERT_TRUE(player.seek(99));
+    EXPECT_EQ(player.getCurrentIndex().cycle, 249);
+    EXPECT_FALSE(player.next());
+}
+
+TEST_F(RecorderTest, SustainsFourKilohertzWithoutDrops)
+{
+    constexpr uint64_t NumOfCycles = 8000;
+    constexpr long CyclePeriod = 250000;
+
+    ProcessDataRecorder recorder;
+    ASSERT_TRUE(recorder.open(recordingPath, domains, NumOfCycles));
+
+    std::vector<uint8_t> wheelImage(2048);
+    std::vector<uint8_t> ioImage(64);
+    const uint8_t* images[] = {wheelImage.data(), ioImage.data()};
+
+    // Two seconds at 4 kHz, each record() is called once like in the cyclic thread.
+    std::timespec wakeup;
+    clock_gettime(CLOCK_MONOTONIC, &wakeup);
+    for(uint64_t cycle = 0; cycle < NumOfCycles; cycle++)
+    {
+        wakeup.tv_nsec += CyclePeriod;
+        if(wakeup.tv_nsec >= 1000000000){
+            wakeup.tv_nsec -= 1000000000;
+            wakeup.tv_sec += 1;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeup, nullptr);
+
+        std::memset(wheelImage.data(), cycle & 0xFF, wheelImage.size());
+        EXPECT_TRUE(recorder.record(cycle, cycle * CyclePeriod, images));
+    }
+    recorder.close();
+
+    EXPECT_EQ(recorder.droppedFrames(), 0);
+    EXPECT_EQ(recorder.writtenFrames(), NumOfCycles);
+
+    ProcessDataPlayer player;
+    ASSERT_TRUE(player.open(recordingPath));
+    ASSERT_EQ(player.frameCount(), NumOfCycles);
+    ASSERT_TRUE(player.seek(NumOfCycles - 1));
+    EXPECT_EQ(player.getCurrentIndex().cycle, NumOfCycles - 1);
+    EXPECT_EQ(player.getImage(0)[2047], (NumOfCycles - 1) & 0xFF);
+}
+
+TEST_F(RecorderTest, RangesLeaveTheRestOfTheImageUntouched)
+{
+    recordCycles(10, 3);
+
+    ProcessDataPlayer player;
+    ASSERT_TRUE(player.open(recordingPath));
+    ASSERT_TRUE(player.next());
+
+    std::vector<uint8_t> ioImage(64, 0xAA);
+    ASSERT_TRUE(player.copyRanges(1, ioImage.data(), {{4, 2}, {60, 4}}));
+    for(std::size_t i = 0; i < ioImage.size(); i++)
+    {
+        const bool isCopied = (i >= 4 && i < 6) || i >= 60;
+        EXPECT_EQ(ioImage[i], isCopied ? 1 : 0xAA) << "byte " << i;
+    }
+}
+
+TEST_F(RecorderTest, CorruptedFilesAreRejected)
+{
+    recordCycles(10, 3);
+
+    std::vector<uint8_t> recording;
+    {
+        std::FILE* file = std::fopen(recordingPath.c_str(), "rb");
+        ASSERT_NE(file, nullptr);
+        uint8_t buffer[4096];
+        std::size_t read = 0;
+        while((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0)
+        {
+            recording.insert(recording.end(), buffer, buffer + read);
+        }
+        std::fclose(file);
+    }
+
+    auto expectRejected = [&](const std::function<void(RecordingHeader&, DomainDescriptor*)>& corrupt){
+        std::vector<uint8_t> corrupted = recording;
+        auto header = reinterpret_cast<RecordingHeader*>(corrupted.data());
+        corrupt(*header, reinterpret_cast<DomainDescriptor*>(corrupted.data() + sizeof(RecordingHeader)));
+        std::FILE* file = std::fopen(recordingPath.c_str(), "wb");
+        ASSERT_NE(file, nullptr);
+        std::fwrite(corrupted.data(), 1, corrupted.size(), file);
+        std::fclose(file);
+
+        ProcessDataPlayer player;
+        EXPECT_FALSE(player.open(recordingPath));
+    };
+
+    expectRejected([](RecordingHeader& header, DomainDescriptor*){ header.domainCount = 0; });
+    expectRejected([](RecordingHeader& header, DomainDescriptor*){ header.domainCount = 0xFFFFFFFF; });
+    expectRejected([](RecordingHeader& header, DomainDescriptor*){ header.indexOffset = UINT64_MAX - 8; });
+    expectRejected([](RecordingHeader& header, DomainDescriptor*){ header.cycleCapacity = UINT64_MAX / 2; });
+    expectRejected([](RecordingHeader& header, DomainDescriptor*){ header.frameSize = UINT64_MAX / 4; });
+    expectRejected([](RecordingHeader&, DomainDescriptor* domains){ domains[1].offsetInFrame = 2048 + 1; });
+    expectRejected([](RecordingHeader&, DomainDescriptor* domains){ domains[0].size = UINT64_MAX; });
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
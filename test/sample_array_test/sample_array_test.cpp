@@ -0,0 +1,186 @@
+#include "ethercat_interface/master.hpp"
+#include "ethercat_interface/sample_array.hpp"
+#include "../fake_ecrt/fake_ecrt.hpp"
+#include "../test_config/test_config.hpp"
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+using namespace ec::samples;
+
+template<typename T>
+std::vector<uint8_t> toBytes(const std::vector<T>& values)
+{
+    std::vector<uint8_t> bytes(values.size() * sizeof(T));
+    std::memcpy(bytes.data(), values.data(), bytes.size());
+    return bytes;
+}
+
+TEST(SampleArrayTest, SamplesAreConvertedToFloats)
+{
+    // 19 samples, so the last ones are after the last whole block.
+    std::vector<int16_t> values;
+    for(int i = 0; i < 19; i++)
+    {
+        values.push_back((int16_t)(i * 1000 - 9000));
+    }
+    const auto bytes = toBytes(values);
+    std::vector<float> output(19, 0.0f);
+    ASSERT_TRUE(convertToFloat(bytes.data(), ec::DataType::INT16, values.size(), 0.5f, output.data()));
+    for(std::size_t i = 0; i < values.size(); i++)
+    {
+        EXPECT_EQ(output[i], values[i] * 0.5f) << "sample " << i;
+    }
+
+    const auto doubles = toBytes(std::vector<double>{1.25, -2.5, 1e10});
+    ASSERT_TRUE(convertToFloat(doubles.data(), ec::DataType::DOUBLE, 3, 1.0f, output.data()));
+    EXPECT_EQ(output[0], 1.25f);
+    EXPECT_EQ(output[1], -2.5f);
+    EXPECT_EQ(output[2], 1e10f);
+
+    const auto bytesU8 = toBytes(std::vector<uint8_t>{0, 128, 255});
+    ASSERT_TRUE(convertToFloat(bytesU8.data(), ec::DataType::UINT8, 3, 2.0f, output.data()));
+    EXPECT_EQ(output[2], 510.0f);
+
+    EXPECT_FALSE(convertToFloat(bytes.data(), ec::DataType::UNKNOWN, 1, 1.0f, output.data()));
+}
+
+TEST(SampleArrayTest, SpansReadTypedSamples)
+{
+    const auto bytes = toBytes(std::vector<int32_t>{-1, 2, INT32_MIN, 7});
+    SampleSpan<int32_t> span(bytes.data(), 4);
+    ASSERT_EQ(span.size(), 4);
+    EXPECT_EQ(span[0], -1);
+    EXPECT_EQ(span[2], INT32_MIN);
+    EXPECT_EQ(span[3], 7);
+
+    float output[4];
+    span.toFloat(output, 2.0f);
+    EXPECT_EQ(output[1], 4.0f);
+    EXPECT_EQ(getSampleSize(getDataType<int32_t>()), 4);
+}
+
+std::string writeSlaveConfig(const std::string& entries)
+{
+    std::ostringstream config;
+    config << "slave_name: vibration\n"
+           << "slave_count: 1\n"
+           << "slave_type: io\n"
+           << "alias: 0\n"
+           << "position: 0\n"
+           << "vendor_id: 0x00000002\n"
+           << "product_code: 0x0e883052\n"
+           << "domain_name: main_domain\n"
+           << "sync_manager_config:\n";
+    const char* directions[] = {"output", "input", "output", "input"};
+    for(int sm = 0; sm < 4; sm++)
+    {
+        config << "  -\n    index: " << sm << "\n    direction: " << directions[sm] << "\n    watchdog_mode: disabled\n";
+    }
+    config << "pdo_mapping_1:\n addr: 0x1a00\n type: tx\n pdos:\n" << entries;
+
+    return config.str();
+}
+
+TEST(SampleArrayTest, ArraysAreParsedFromYaml)
+{
+    using ec::parser::parseSlaveConfig;
+
+    const auto parsed = parseSlaveConfig(YAML::Load(writeSlaveConfig(
+        "  - {name: samples, index: 0x6000, subindex: 1, bitlength: 16, type: int16, count: 10}\n"
+        "  - {name: cycle_count, index: 0x6010, subindex: 1, bitlength: 16, type: uint16}\n"
+    )));
+    ASSERT_TRUE(parsed);
+    const auto& entries = std::get<ec::SlaveInfo>(parsed.value()).layout->txPDOs.at(0).entries;
+    ASSERT_EQ(entries.size(), 2);
+    EXPECT_EQ(entries[0].count, 10);
+    EXPECT_EQ(entries[1].count, 1);
+
+    const char* invalidEntries[] = {
+        "  - {name: samples, index: 0x6000, subindex: 1, bitlength: 16, type: int16, count: 0}\n",
+        "  - {name: samples, index: 0x6000, subindex: 250, bitlength: 16, type: int16, count: 10}\n",
+        "  - {name: samples, index: 0x6000, subindex: 1, bitlength: 12, type: int16, count: 10}\n",
+        "  - {name: samples, index: 0x6000, subindex: 1, bitlength: 16, type: int16, count: 10, filter: {type: median3}}\n"
+    };
+    for(const char* invalidEntry : invalidEntries)
+    {
+        EXPECT_FALSE(parseSlaveConfig(YAML::Load(writeSlaveConfig(invalidEntry)))) << invalidEntry;
+    }
+}
+
+class SampleArrayMasterTest : public ::testing::Test
+{
+    protected:
+
+    void TearDown() override{
+        test_config::removeGeneratedFiles(configPath);
+    }
+
+    const std::string configPath = test_config::getConfigPath("sample_array_test");
+};
+
+TEST_F(SampleArrayMasterTest, SamplesAreRegisteredContiguously)
+{
+    // The second master reads the configuration from the cache written by the first one.
+    for(int run = 0; run < 2; run++)
+    {
+        Master master(configPath);
+        ASSERT_TRUE(master.init());
+
+        auto slaveFound = master.getSlave<ec::slave::Slave*>("vibration");
+        ASSERT_TRUE(slaveFound);
+        ec::slave::Slave* slave = slaveFound.value();
+        EXPECT_EQ(slave->getEntryCount(), 11);
+        EXPECT_EQ(slave->getSampleCount("samples"), 10u);
+        EXPECT_FALSE(slave->getSampleCount("cycle_count"));
+
+        const uint firstOffset = *slave->getOffsetPtr("samples").value();
+        for(std::size_t sample = 0; sample < 10; sample++)
+        {
+            ASSERT_EQ(*slave->getOffsetPtr("samples", sample).value(), firstOffset + 2 * sample);
+            const int16_t value = (int16_t)(100 * sample - 400);
+            std::memcpy(slave->getDomainDataPtr() + firstOffset + 2 * sample, &value, sizeof(value));
+        }
+        EXPECT_FALSE(slave->getOffsetPtr("samples", 10));
+        EXPECT_EQ(*slave->getOffsetPtr("cycle_count").value(), firstOffset + 20);
+
+        EXPECT_FALSE(slave->readSamples<int32_t>("samples"));
+        EXPECT_FALSE(slave->readSamples<uint16_t>("cycle_count"));
+        const auto span = slave->readSamples<int16_t>("samples");
+        ASSERT_TRUE(span);
+        ASSERT_EQ(span->size(), 10);
+        EXPECT_EQ((*span)[0], -400);
+        EXPECT_EQ((*span)[9], 500);
+
+        float output[10];
+        EXPECT_FALSE(slave->readSamples("samples", output, 9));
+        ASSERT_TRUE(slave->readSamples("samples", output, 10));
+        for(std::size_t sample = 0; sample < 10; sample++)
+        {
+            EXPECT_EQ(output[sample], (100.0f * sample - 400.0f) * 0.25f) << "sample " << sample;
+        }
+    }
+}
+
+TEST_F(SampleArrayMasterTest, InvalidCountFailsTheConfiguration)
+{
+    auto configDocs = YAML::LoadAllFromFile(configPath);
+    ASSERT_TRUE(ec::parser::parseConfigDocuments(configDocs));
+
+    configDocs.at(1)["pdo_mapping_1"]["pdos"][0]["count"] = 0;
+    EXPECT_FALSE(ec::parser::parseConfigDocuments(configDocs));
+
+    configDocs.at(1)["pdo_mapping_1"]["pdos"][0]["count"] = 300;
+    EXPECT_FALSE(ec::parser::parseConfigDocuments(configDocs));
+}
+
+}
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
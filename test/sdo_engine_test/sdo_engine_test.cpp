@@ -0,0 +1,295 @@
+#include "ethercat_interface/sdo.hpp"
+#include <gtest/gtest.h>
+
+#include <map>
+#include <thread>
+
+/**
+ * Stand-in for the SDO request functions of the EtherCAT master, the executable's definitions
+ * take precedence over the ones in libethercat. A request completes after PollsUntilDone state polls.
+ */
+struct ec_sdo_request
+{
+    uint16_t index;
+    uint8_t subindex;
+    std::vector<uint8_t> data;
+    std::size_t dataSize;
+    ec_request_state_t state;
+    int remainingPolls;
+};
+
+namespace {
+
+constexpr int PollsUntilDone = 3;
+
+std::vector<std::unique_ptr<ec_sdo_request>> fakeRequests;
+
+// Object dictionary of the fake slave, a missing object aborts the transfer.
+std::map<std::pair<uint16_t, uint8_t>, std::vector<uint8_t>> objectDictionary;
+
+void finishTransfer(ec_sdo_request* req, bool is_download)
+{
+    auto object = objectDictionary.find({req->index, req->subindex});
+    if(object == objectDictionary.end() || (is_download && object->second.size() != req->dataSize)){
+        req->state = EC_REQUEST_ERROR;
+        return;
+    }
+
+    if(is_download){
+        object->second.assign(req->data.begin(), req->data.begin() + req->dataSize);
+    }
+    else{
+        req->data = object->second;
+        req->dataSize = object->second.size();
+    }
+    req->state = EC_REQUEST_SUCCESS;
+}
+
+}
+
+extern "C" {
+
+ec_sdo_request_t* ecrt_slave_config_create_sdo_request(ec_slave_config_t*, uint16_t index, uint8_t subindex, size_t size)
+{
+    fakeRequests.push_back(std::make_unique<ec_sdo_request>(ec_sdo_request{index, subindex, std::vector<uint8_t>(size), size, EC_REQUEST_UNUSED, 0}));
+    return fakeRequests.back().get();
+}
+
+int ecrt_sdo_request_index(ec_sdo_request_t* req, uint16_t index, uint8_t subindex)
+{
+    req->index = index;
+    req->subindex = subindex;
+    return 0;
+}
+
+int ecrt_sdo_request_timeout(ec_sdo_request_t*, uint32_t)
+{
+    return 0;
+}
+
+uint8_t* ecrt_sdo_request_data(ec_sdo_request_t* req)
+{
+    return req->data.data();
+}
+
+size_t ecrt_sdo_request_data_size(const ec_sdo_request_t* req)
+{
+    return req->dataSize;
+}
+
+int ecrt_sdo_request_write(ec_sdo_request_t* req)
+{
+    req->state = EC_REQUEST_BUSY;
+    req->remainingPolls = -PollsUntilDone;
+    return 0;
+}
+
+int ecrt_sdo_request_read(ec_sdo_request_t* req)
+{
+    req->state = EC_REQUEST_BUSY;
+    req->remainingPolls = PollsUntilDone;
+    return 0;
+}
+
+ec_request_state_t ecrt_sdo_request_state(ec_sdo_request_t* req)
+{
+    if(req->state == EC_REQUEST_BUSY){
+        // Negative poll counts mark downloads.
+        const bool isDownload = req->remainingPolls < 0;
+        req->remainingPolls += isDownload ? 1 : -1;
+        if(req->remainingPolls == 0){
+            finishTransfer(req, isDownload);
+        }
+    }
+    return req->state;
+}
+
+}
+
+namespace {
+
+class SdoEngineTest : public ::testing::Test
+{
+    protected:
+
+    void SetUp() override{
+        fakeRequests.clear();
+        objectDictionary.clear();
+        objectDictionary[{0x1000, 0x00}] = {0x92, 0x01, 0x02, 0x00};
+        objectDictionary[{0x603F, 0x00}] = {0x10, 0x23};
+        objectDictionary[{0x6060, 0x00}] = {0x00};
+        ASSERT_TRUE(engine.createRequests(reinterpret_cast<ec_slave_config_t*>(&fakeSlaveConfig), 1, 4));
+    }
+
+    void runCycles(std::size_t cycles, std::size_t budget = 8)
+    {
+        for(std::size_t i = 0; i < cycles; i++)
+        {
+            engine.process(budget);
+        }
+    }
+
+    int fakeSlaveConfig = 0;
+    ec::sdo::SdoEngine engine;
+};
+
+TEST_F(SdoEngineTest, ReadDeliversThroughFuture)
+{
+    auto future = engine.read(0x603F, 0x00);
+    ASSERT_TRUE(future);
+    EXPECT_TRUE(engine.hasWork());
+
+    runCycles(PollsUntilDone + 1);
+    EXPECT_EQ(engine.deliverCompletions(), 1);
+
+    ASSERT_EQ(future->wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    const auto result = future->get();
+    EXPECT_TRUE(result.success);
+    EXPECT_EQ(result.size, 2);
+    EXPECT_EQ(result.as<uint16_t>(), 0x2310);
+    EXPECT_FALSE(engine.hasWork());
+}
+
+TEST_F(SdoEngineTest, WriteDeliversThroughCallback)
+{
+    bool isCalled = false;
+    ASSERT_TRUE(engine.write(0x6060, 0x00, std::vector<uint8_t>{0x08}.data(), 1, [&isCalled](const ec::sdo::SdoResult& result){
+        isCalled = true;
+        EXPECT_TRUE(result.success);
+    }));
+
+    runCycles(PollsUntilDone + 1);
+    EXPECT_FALSE(isCalled);
+    engine.deliverCompletions();
+
+    EXPECT_TRUE(isCalled);
+    EXPECT_EQ(objectDictionary.at({0x6060, 0x00}).at(0), 0x08);
+}
+
+TEST_F(SdoEngineTest, AbortedTransferFails)
+{
+    auto missing = engine.read(0x2000, 0x01);
+    auto wrongSize = engine.write<uint32_t>(0x6060, 0x00, 8);
+    ASSERT_TRUE(missing && wrongSize);
+
+    runCycles(PollsUntilDone + 1);
+    engine.deliverCompletions();
+
+    EXPECT_FALSE(missing->get().success);
+    EXPECT_FALSE(wrongSize->get().success);
+}
+
+TEST_F(SdoEngineTest, UnsupportedSizeAndFullQueueAreRejected)
+{
+    const uint8_t data[3] = {};
+    EXPECT_FALSE(engine.write(0x6060, 0x00, data, sizeof(data)));
+
+    std::vector<std::future<ec::sdo::SdoResult>> futures;
+    for(int i = 0; i < 4; i++)
+    {
+        auto future = engine.read(0x1000, 0x00);
+        ASSERT_TRUE(future);
+        futures.push_back(std::move(future.value()));
+    }
+    EXPECT_FALSE(engine.read(0x1000, 0x00));
+
+    // Finished jobs free their slots for new transfers.
+    runCycles(4 * PollsUntilDone);
+    engine.deliverCompletions();
+    for(auto& future : futures)
+    {
+        EXPECT_EQ(future.get().as<uint32_t>(), 0x00020192);
+    }
+    EXPECT_TRUE(engine.read(0x1000, 0x00));
+}
+
+TEST_F(SdoEngineTest, BudgetBoundsWorkPerCycle)
+{
+    for(int i = 0; i < 4; i++)
+    {
+        ASSERT_TRUE(engine.read(0x1000, 0x00));
+    }
+
+    // Nothing running yet, a budget of one starts a single transfer.
+    EXPECT_EQ(engine.process(1), 1);
+    for(int i = 0; i < 100; i++)
+    {
+        EXPECT_LE(engine.process(2), 2);
+    }
+    EXPECT_FALSE(engine.hasWork());
+}
+
+TEST_F(SdoEngineTest, QueueingFromAnotherThread)
+{
+    std::atomic<int> completed{0};
+    std::thread producer([this, &completed](){
+        for(int i = 0; i < 200; i++)
+        {
+            while(!engine.read(0x603F, 0x00, [&completed](const ec::sdo::SdoResult& result){
+                if(result.success){
+                    completed.fetch_add(1);
+                }
+            }))
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    while(completed.load() < 200)
+    {
+        engine.process(8);
+        engine.deliverCompletions();
+    }
+    producer.join();
+
+    EXPECT_EQ(completed.load(), 200);
+}
+
+TEST_F(SdoEngineTest, SlowCallbackDoesNotDelayProcess)
+{
+    std::atomic<bool> isCallbackRunning{false};
+    std::atomic<bool> isCallbackReleased{false};
+    ASSERT_TRUE(engine.read(0x603F, 0x00, [&](const ec::sdo::SdoResult&){
+        isCallbackRunning.store(true);
+        while(!isCallbackReleased.load())
+        {
+            std::this_thread::yield();
+        }
+    }));
+
+    std::atomic<bool> isDelivering{true};
+    std::thread deliverer([&](){
+        while(isDelivering.load())
+        {
+            engine.deliverCompletions();
+            std::this_thread::yield();
+        }
+    });
+
+    while(!isCallbackRunning.load())
+    {
+        engine.process(8);
+        std::this_thread::yield();
+    }
+
+    // The callback blocks the deliverer, the cyclic side keeps running transfers to completion.
+    auto future = engine.read(0x6060, 0x00);
+    ASSERT_TRUE(future);
+    runCycles(PollsUntilDone + 1);
+    EXPECT_FALSE(engine.hasWork());
+    EXPECT_EQ(future->wait_for(std::chrono::seconds(0)), std::future_status::timeout);
+
+    isCallbackReleased.store(true);
+    EXPECT_EQ(future->get().as<uint8_t>(), 0x00);
+
+    isDelivering.store(false);
+    deliverer.join();
+}
+
+}
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -37,11 +37,11 @@ TEST_F(SingleSlaveTest, IsParseSuccessful)
     auto dcConfig = conf.slaveConfigurations.at(0).distributedClockConfig;
     EXPECT_NE(dcConfig, std::nullopt);
 
-    std::size_t rxPdoCount = conf.slaveConfigurations.at(0).rxPDOs.size();
+    std::size_t rxPdoCount = conf.slaveConfigurations.at(0).layout->rxPDOs.size();
 
     EXPECT_EQ(rxPdoCount, 1);
 
-    std::size_t txPdoCount = conf.slaveConfigurations.at(0).txPDOs.size();
+    std::size_t txPdoCount = conf.slaveConfigurations.at(0).layout->txPDOs.size();
 
     EXPECT_EQ(txPdoCount, 1);
 
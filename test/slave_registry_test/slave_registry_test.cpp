@@ -0,0 +1,118 @@
+#include "ethercat_interface/master.hpp"
+#include "../fake_ecrt/fake_ecrt.hpp"
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <cstdio>
+
+namespace {
+
+class SlaveRegistryTest : public ::testing::Test
+{
+    protected:
+
+    void SetUp() override{
+        // The documents are not in bus order, the coupler comes last.
+        std::ofstream file(configPath);
+        file << "---\nprogram_config:\n  cycle_period: 1000\n...\n";
+        writeSlave(file, "drive", "driver", 2, "0x6041");
+        writeSlave(file, "inputs", "io", 1, "0x6000");
+        file << "---\n"
+             << "slave_name: coupler\n"
+             << "slave_count: 1\n"
+             << "slave_type: coupler\n"
+             << "alias: 0\n"
+             << "position: 0\n"
+             << "vendor_id: 0x00000002\n"
+             << "product_code: 0x044c2c52\n"
+             << "domain_name: main_domain\n"
+             << "...\n";
+        file.close();
+    }
+
+    void TearDown() override{
+        for(const std::string suffix : {"", ".cache", ".topology"})
+        {
+            std::remove((configPath + suffix).c_str());
+        }
+    }
+
+    void writeSlave(std::ofstream& file, const std::string& name, const std::string& type, int position, const std::string& tx_index)
+    {
+        file << "---\n"
+             << "slave_name: " << name << "\n"
+             << "slave_count: 1\n"
+             << "slave_type: " << type << "\n"
+             << "alias: 0\n"
+             << "position: " << position << "\n"
+             << "vendor_id: 0x000022d2\n"
+             << "product_code: 0x00000201\n"
+             << "domain_name: main_domain\n"
+             << "sync_manager_config:\n";
+        const char* directions[] = {"output", "input", "output", "input"};
+        for(int sm = 0; sm < 4; sm++)
+        {
+            file << "  -\n    index: " << sm << "\n    direction: " << directions[sm] << "\n    watchdog_mode: disabled\n";
+        }
+        file << "pdo_mapping_1:\n addr: 0x1600\n type: rx\n pdos:\n"
+             << "  - {name: control_word, index: 0x6040, subindex: 0, bitlength: 16, type: uint16}\n"
+             << "pdo_mapping_2:\n addr: 0x1a00\n type: tx\n pdos:\n"
+             << "  - {name: status_word, index: " << tx_index << ", subindex: 0, bitlength: 16, type: uint16}\n"
+             << "...\n";
+    }
+
+    std::string configPath = "/tmp/ethercat_interface_slave_registry_test.yaml";
+};
+
+TEST_F(SlaveRegistryTest, TypedAccessorsReturnTheConcreteSlaves)
+{
+    Master master(configPath);
+    ASSERT_TRUE(master.init());
+
+    auto drive = master.getSlave<DriverPtr>("drive");
+    ASSERT_TRUE(drive);
+    ASSERT_NE(drive.value(), nullptr);
+    EXPECT_EQ(drive.value()->getSlaveInfo().slaveName, "drive");
+    EXPECT_NE(drive.value()->getDomainDataPtr(), nullptr);
+
+    auto inputs = master.getSlave<IoPtr>("inputs");
+    ASSERT_TRUE(inputs);
+    EXPECT_EQ(inputs.value()->getSlaveInfo().position, 1);
+
+    EXPECT_TRUE(master.getSlave<ec::slave::Coupler*>("coupler"));
+}
+
+TEST_F(SlaveRegistryTest, WrongTypeOrNameIsNotFound)
+{
+    Master master(configPath);
+    ASSERT_TRUE(master.init());
+
+    EXPECT_FALSE(master.getSlave<IoPtr>("drive"));
+    EXPECT_FALSE(master.getSlave<DriverPtr>("unknown"));
+
+    // Any slave can be fetched through its base class.
+    auto drive = master.getSlave<ec::slave::Slave*>("drive");
+    ASSERT_TRUE(drive);
+    EXPECT_EQ(static_cast<ec::slave::Slave*>(master.getSlave<DriverPtr>("drive").value()), drive.value());
+}
+
+TEST_F(SlaveRegistryTest, SlavesAreKeptInBusOrder)
+{
+    Master master(configPath);
+    ASSERT_TRUE(master.init());
+
+    auto coupler = master.getSlave<ec::slave::Slave*>("coupler").value();
+    auto inputs = master.getSlave<ec::slave::Slave*>("inputs").value();
+    auto drive = master.getSlave<ec::slave::Slave*>("drive").value();
+
+    // Stored by value in one array, ordered by position.
+    EXPECT_LT(reinterpret_cast<uintptr_t>(coupler), reinterpret_cast<uintptr_t>(inputs));
+    EXPECT_LT(reinterpret_cast<uintptr_t>(inputs), reinterpret_cast<uintptr_t>(drive));
+}
+
+}
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
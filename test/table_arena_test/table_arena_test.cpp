@@ -0,0 +1,78 @@
+#include "ethercat_interface/ethercat_interface.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+
+using ec::arena::TableArena;
+
+TEST(TableArenaTest, AllocationsAreAlignedAndZeroed)
+{
+    TableArena arena;
+    arena.reserve(TableArena::footprint<ec_pdo_entry_info_t>(3) + TableArena::footprint<ec_sync_info_t>(5));
+    EXPECT_EQ(arena.getCapacity() % TableArena::Alignment, 0);
+
+    auto entries = arena.allocate<ec_pdo_entry_info_t>(3);
+    auto syncs = arena.allocate<ec_sync_info_t>(5);
+    ASSERT_NE(entries, nullptr);
+    ASSERT_NE(syncs, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(syncs) % TableArena::Alignment, 0);
+    for(int i = 0; i < 5; i++)
+    {
+        EXPECT_EQ(syncs[i].n_pdos, 0);
+        EXPECT_EQ(syncs[i].pdos, nullptr);
+    }
+    EXPECT_EQ(arena.getUsed(), arena.getCapacity());
+
+    // An exhausted arena fails instead of growing, handed out tables never move.
+    EXPECT_EQ(arena.allocate<ec_pdo_info_t>(1), nullptr);
+}
+
+TEST(TableArenaTest, CarvedRegionsAreContiguous)
+{
+    TableArena arena;
+    arena.reserve(3 * TableArena::Alignment);
+
+    auto first = arena.carve(TableArena::Alignment);
+    auto second = arena.carve(2 * TableArena::Alignment);
+    auto third = arena.carve(1);
+    EXPECT_EQ(first.getCapacity(), TableArena::Alignment);
+    EXPECT_EQ(second.getCapacity(), 2 * TableArena::Alignment);
+    EXPECT_EQ(third.getCapacity(), 0);
+
+    auto firstData = first.allocate<uint8_t>(1);
+    auto secondData = second.allocate<uint8_t>(1);
+    EXPECT_EQ(secondData - firstData, (std::ptrdiff_t)TableArena::Alignment);
+}
+
+TEST(TableArenaTest, SlaveTablesFillTheirRegionExactly)
+{
+    ec::SlaveInfo slaveInfo;
+    slaveInfo.slaveName = "lifter";
+    ec::SlaveLayout layout;
+    layout.rxPDOs = {ec::PDO{ec::PDO_Type::RxPDO, 0x1600, {{"control_word", 0x6040, 0, 16, ec::DataType::UINT16}}}};
+    // More TxPDOs than RxPDOs, the TxPDO table has to be sized by its own count.
+    layout.txPDOs = {
+        ec::PDO{ec::PDO_Type::TxPDO, 0x1a00, {{"status_word", 0x6041, 0, 16, ec::DataType::UINT16}}},
+        ec::PDO{ec::PDO_Type::TxPDO, 0x1a01, {{"actual_position", 0x6064, 0, 32, ec::DataType::INT32}, {"actual_velocity", 0x606C, 0, 32, ec::DataType::INT32}}},
+        ec::PDO{ec::PDO_Type::TxPDO, 0x1a02, {{"error_code", 0x603F, 0, 16, ec::DataType::UINT16}}}
+    };
+    for(uint8_t i = 0; i < 4; i++)
+    {
+        layout.syncManagerConfig.push_back(ec::SyncManagerConfig{i, i % 2 ? EC_DIR_INPUT : EC_DIR_OUTPUT, EC_WD_DISABLE});
+    }
+    slaveInfo.layout = std::make_shared<const ec::SlaveLayout>(std::move(layout));
+
+    ec::slave::Slave slave(slaveInfo);
+    TableArena arena;
+    arena.reserve(slave.getTableSize());
+    ASSERT_TRUE(slave.buildTables(arena));
+    EXPECT_EQ(arena.getUsed(), arena.getCapacity());
+    EXPECT_EQ(slave.getEntryCount(), 5);
+}
+
+}
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
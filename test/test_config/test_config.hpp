@@ -0,0 +1,44 @@
+/**
+ * @file test_config.hpp
+ * @author Eren Naci Odabasi (enaciodabasi@outlook.com)
+ * @brief Locates the configuration files of the tests running a master on fake_ecrt.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef TEST_CONFIG_HPP_
+#define TEST_CONFIG_HPP_
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace test_config
+{
+    /**
+     * @brief Path of "test/<test_name>/<test_name>.yaml" in the repository of the user, like the other tests' configuration files.
+     *
+     */
+    inline std::string getConfigPath(const std::string& test_name)
+    {
+        return "/home/" + std::string(std::getenv("USER")) + "/ethercat_interface/test/" + test_name + "/" + test_name + ".yaml";
+    }
+
+    /**
+     * @brief Removes the cache and the topology snapshot the master writes next to the configuration file.
+     *
+     */
+    inline void removeGeneratedFiles(const std::string& config_path)
+    {
+        for(const std::string suffix : {".cache", ".topology"})
+        {
+            std::remove((config_path + suffix).c_str());
+        }
+    }
+
+} // End of namespace test_config
+
+#endif // TEST_CONFIG_HPP_
@@ -0,0 +1,181 @@
+#include "ethercat_interface/master.hpp"
+#include "ethercat_interface/timestamp.hpp"
+#include "../fake_ecrt/fake_ecrt.hpp"
+#include "../test_config/test_config.hpp"
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+using namespace ec::timestamp;
+
+constexpr uint64_t StartTime = 1000000000000;
+
+TEST(TimestampTest, LatchTimesAreTheLastPulses)
+{
+    const LatchGroup group{1000000, 250000};
+    // Between two pulses, on a pulse and before the first pulse.
+    EXPECT_EQ(getLastPulse(StartTime + 5000000 + 100000, StartTime, group), StartTime + 4000000 + 250000);
+    EXPECT_EQ(getLastPulse(StartTime + 5000000 + 250000, StartTime, group), StartTime + 5000000 + 250000);
+    EXPECT_EQ(getLastPulse(StartTime - 10, StartTime, group), StartTime + 250000 - 1000000);
+
+    const LatchGroup negativeShift{1000000, -100000};
+    EXPECT_EQ(getLastPulse(StartTime + 50, StartTime, negativeShift), StartTime - 100000);
+    EXPECT_EQ(getLastPulse(StartTime + 900000, StartTime, negativeShift), StartTime + 900000);
+}
+
+TEST(TimestampTest, TimestampsAreExtendedAroundTheReference)
+{
+    EXPECT_EQ(extendTimestamp(0x00000010, 0x1FFFFFF00), 0x200000010u);
+    EXPECT_EQ(extendTimestamp(0xFFFFFF00, 0x200000010), 0x1FFFFFF00u);
+    EXPECT_EQ(extendTimestamp(0x12345678, 0x712345000), 0x712345678u);
+}
+
+TEST(TimestampTest, InputsAreTaggedWithTheirLatchTimes)
+{
+    std::vector<uint8_t> domain(12, 0);
+    InputTimestamps timestamps(domain.data(), {LatchGroup{}, LatchGroup{1000000, 250000}}, {
+        TimestampEntry{"probe.latch_low", 0, ec::DataType::UINT32, 1},
+        TimestampEntry{"probe.latch", 4, ec::DataType::UINT64, 1}
+    });
+    ASSERT_EQ(timestamps.size(), 2);
+    ASSERT_EQ(timestamps.getGroupCount(), 2);
+    EXPECT_EQ(timestamps.findEntry("probe.latch"), 1u);
+    EXPECT_FALSE(timestamps.findEntry("latch"));
+
+    // The touch probe triggered 4 s after the start, 2^32 ns wrapped the lower 32 bits.
+    const uint64_t latch = StartTime + 4000000000 + 123;
+    const uint32_t latchLow = (uint32_t)latch;
+    std::memcpy(domain.data(), &latchLow, sizeof(latchLow));
+    std::memcpy(domain.data() + 4, &latch, sizeof(latch));
+    const uint64_t sendTime = StartTime + 4000700000;
+
+    // Without a start time only the slaves without a distributed clock have a latch time.
+    timestamps.update(0, sendTime);
+    EXPECT_EQ(timestamps.getLatchTime(0), sendTime);
+    EXPECT_EQ(timestamps.getLatchTime(1), 0u);
+
+    timestamps.update(StartTime, sendTime);
+    EXPECT_EQ(timestamps.getLatchTime(1), StartTime + 4000250000);
+    EXPECT_EQ(timestamps.getTimestamp(0), latch);
+    EXPECT_EQ(timestamps.getTimestamp(1), latch);
+}
+
+std::string writeSlaveConfig(const std::string& entries)
+{
+    std::ostringstream config;
+    config << "slave_name: probe\n"
+           << "slave_count: 1\n"
+           << "slave_type: io\n"
+           << "alias: 0\n"
+           << "position: 0\n"
+           << "vendor_id: 0x00000002\n"
+           << "product_code: 0x04e43052\n"
+           << "domain_name: main_domain\n"
+           << "sync_manager_config:\n";
+    const char* directions[] = {"output", "input", "output", "input"};
+    for(int sm = 0; sm < 4; sm++)
+    {
+        config << "  -\n    index: " << sm << "\n    direction: " << directions[sm] << "\n    watchdog_mode: disabled\n";
+    }
+    config << "pdo_mapping_1:\n addr: 0x1a00\n type: tx\n pdos:\n" << entries;
+
+    return config.str();
+}
+
+TEST(TimestampTest, TimestampEntriesAreParsedFromYaml)
+{
+    using ec::parser::parseSlaveConfig;
+
+    const auto parsed = parseSlaveConfig(YAML::Load(writeSlaveConfig(
+        "  - {name: latch_time, index: 0x6000, subindex: 1, bitlength: 32, type: uint32, timestamp: true}\n"
+        "  - {name: status, index: 0x6000, subindex: 2, bitlength: 16, type: uint16, timestamp: false}\n"
+    )));
+    ASSERT_TRUE(parsed);
+    const auto& entries = std::get<ec::SlaveInfo>(parsed.value()).layout->txPDOs.at(0).entries;
+    EXPECT_TRUE(entries[0].isTimestamp);
+    EXPECT_FALSE(entries[1].isTimestamp);
+
+    EXPECT_FALSE(parseSlaveConfig(YAML::Load(writeSlaveConfig(
+        "  - {name: latch_time, index: 0x6000, subindex: 1, bitlength: 16, type: uint16, timestamp: true}\n"
+    ))));
+    EXPECT_FALSE(parseSlaveConfig(YAML::Load(writeSlaveConfig(
+        "  - {name: latch_time, index: 0x6000, subindex: 1, bitlength: 32, type: uint32, count: 2, timestamp: true}\n"
+    ))));
+}
+
+class TimestampMasterTest : public ::testing::Test
+{
+    protected:
+
+    void TearDown() override{
+        test_config::removeGeneratedFiles(configPath);
+    }
+
+    const std::string configPath = test_config::getConfigPath("timestamp_test");
+};
+
+uint64_t now()
+{
+    std::timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return timespectoNanoSec(time);
+}
+
+TEST_F(TimestampMasterTest, InputsAreLatchedWhenTheFramePasses)
+{
+    // The second master reads the configuration from the cache written by the first one.
+    for(int run = 0; run < 2; run++)
+    {
+        Master master(configPath);
+        ASSERT_TRUE(master.init());
+        EXPECT_EQ(master.getInputTimestamps("missing_domain"), nullptr);
+        InputTimestamps* timestamps = master.getInputTimestamps("main_domain");
+        ASSERT_NE(timestamps, nullptr);
+        EXPECT_EQ(timestamps->findEntry("probe.latch_time"), 0u);
+
+        auto slaveFound = master.getSlave<ec::slave::Slave*>("probe");
+        ASSERT_TRUE(slaveFound);
+        ec::slave::Slave* slave = slaveFound.value();
+        ASSERT_TRUE(master.receiveDomainData("main_domain"));
+        EXPECT_FALSE(slave->getInputLatchTime());
+        EXPECT_FALSE(slave->readTimestamp("status"));
+
+        const uint64_t beforeSend = now();
+        master.send();
+        const uint64_t afterSend = now();
+        ASSERT_TRUE(slave->write<uint32_t>("latch_time", (uint32_t)(beforeSend - 1000)));
+        master.receive();
+        ASSERT_TRUE(master.receiveDomainData("main_domain"));
+
+        const auto latchTime = slave->getInputLatchTime();
+        ASSERT_TRUE(latchTime);
+        EXPECT_GE(latchTime.value(), beforeSend);
+        EXPECT_LE(latchTime.value(), afterSend);
+        EXPECT_EQ(slave->readTimestamp("latch_time"), beforeSend - 1000);
+    }
+}
+
+TEST_F(TimestampMasterTest, InvalidTimestampFlagFailsTheConfiguration)
+{
+    auto configDocs = YAML::LoadAllFromFile(configPath);
+    ASSERT_TRUE(ec::parser::parseConfigDocuments(configDocs));
+
+    configDocs.at(1)["pdo_mapping_1"]["pdos"][0]["timestamp"] = "sometimes";
+    EXPECT_FALSE(ec::parser::parseConfigDocuments(configDocs));
+
+    // The status word can not hold a system time.
+    configDocs.at(1)["pdo_mapping_1"]["pdos"][0]["timestamp"] = true;
+    configDocs.at(1)["pdo_mapping_1"]["pdos"][1]["timestamp"] = true;
+    EXPECT_FALSE(ec::parser::parseConfigDocuments(configDocs));
+}
+
+}
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
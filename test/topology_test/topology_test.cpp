@@ -0,0 +1,241 @@
+#include "ethercat_interface/master.hpp"
+#include "../fake_ecrt/fake_ecrt.hpp"
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+constexpr uint32_t VendorID = 0x000022d2;
+constexpr uint32_t ProductCode = 0x00000201;
+
+class TopologyTest : public ::testing::Test
+{
+    protected:
+
+    void SetUp() override{
+        std::ofstream file(configPath);
+        file << "---\nprogram_config:\n  cycle_period: 1000\n...\n"
+             << "---\n"
+             << "slave_name: drives\n"
+             << "slave_count: 3\n"
+             << "slave_tags:\n  - left_wheel\n  - right_wheel\n  - lifter\n"
+             << "slave_type: driver\n"
+             << "alias: 0\n"
+             << "position: 1\n"
+             << "vendor_id: 0x000022d2\n"
+             << "product_code: 0x00000201\n"
+             << "domain_name: drive_domain\n"
+             << "sync_manager_config:\n"
+             << "  -\n    index: 0\n    direction: output\n    watchdog_mode: disabled\n"
+             << "  -\n    index: 1\n    direction: input\n    watchdog_mode: disabled\n"
+             << "  -\n    index: 2\n    direction: output\n    watchdog_mode: disabled\n"
+             << "  -\n    index: 3\n    direction: input\n    watchdog_mode: disabled\n"
+             << "pdo_mapping_1:\n addr: 0x1600\n type: rx\n pdos:\n"
+             << "  - {name: control_word, index: 0x6040, subindex: 0, bitlength: 16, type: uint16}\n"
+             << "  - {name: target_position, index: 0x607A, subindex: 0, bitlength: 32, type: int32}\n"
+             << "pdo_mapping_2:\n addr: 0x1a00\n type: tx\n pdos:\n"
+             << "  - {name: status_word, index: 0x6041, subindex: 0, bitlength: 16, type: uint16}\n"
+             << "  - {name: actual_position, index: 0x6064, subindex: 0, bitlength: 32, type: int32}\n"
+             << "...\n";
+        file.close();
+
+        // A coupler in front of the three drives.
+        bus = {
+            {0, 0x00000002, 0x044c2c52, 0x00110000},
+            {0, VendorID, ProductCode, 0x00010000},
+            {0, VendorID, ProductCode, 0x00010000},
+            {0, VendorID, ProductCode, 0x00010000}
+        };
+        fake_ecrt::setBus(bus);
+    }
+
+    void TearDown() override{
+        for(const std::string suffix : {"", ".cache", ".topology"})
+        {
+            std::remove((configPath + suffix).c_str());
+        }
+    }
+
+    std::string configPath = "/tmp/ethercat_interface_topology_test.yaml";
+    std::vector<fake_ecrt::BusSlave> bus;
+};
+
+TEST_F(TopologyTest, FirstStartValidatesAndRecordsSnapshot)
+{
+    Master master(configPath);
+    ASSERT_TRUE(master.init());
+    EXPECT_FALSE(master.isFastRestart());
+
+    const auto snapshot = ec::topology::readSnapshotFile(configPath + ".topology");
+    ASSERT_TRUE(snapshot);
+    EXPECT_EQ(snapshot->slaves.size(), 4);
+    EXPECT_EQ(snapshot->slaves.at(2).position, 2);
+    EXPECT_EQ(snapshot->slaves.at(2).revisionNumber, 0x00010000);
+    ASSERT_EQ(snapshot->domains.size(), 1);
+    EXPECT_EQ(snapshot->domains.at(0).domainName, "drive_domain");
+    EXPECT_EQ(snapshot->domains.at(0).offsets.size(), 12);
+    EXPECT_EQ(snapshot->domains.at(0).size, 36);
+}
+
+std::vector<uint> getOffsets(Master& master, const std::string& slave_name)
+{
+    Slave* slave = master.getSlave<Slave*>(slave_name).value();
+    std::vector<uint> offsets;
+    for(const std::string entryName : {"control_word", "target_position", "status_word", "actual_position"})
+    {
+        offsets.push_back(*slave->getOffsetPtr(entryName).value());
+    }
+    return offsets;
+}
+
+TEST_F(TopologyTest, UnchangedBusRestartsFast)
+{
+    std::size_t callCount = fake_ecrt::getCallCount();
+    std::vector<uint> firstOffsets;
+    {
+        Master master(configPath);
+        ASSERT_TRUE(master.init());
+        firstOffsets = getOffsets(master, "lifter");
+    }
+    const std::size_t firstStartCalls = fake_ecrt::getCallCount() - callCount;
+
+    callCount = fake_ecrt::getCallCount();
+    Master master(configPath);
+    ASSERT_TRUE(master.init());
+    EXPECT_TRUE(master.isFastRestart());
+
+    // One registration per sync manager instead of one per entry, the offsets are the ones of the first start.
+    EXPECT_EQ(firstStartCalls - (fake_ecrt::getCallCount() - callCount), 3u * 2u);
+    EXPECT_EQ(getOffsets(master, "lifter"), firstOffsets);
+    EXPECT_EQ(getOffsets(master, "lifter"), (std::vector<uint>{24, 26, 30, 32}));
+}
+
+TEST_F(TopologyTest, DifferingOffsetsAreRegistered)
+{
+    {
+        Master master(configPath);
+        ASSERT_TRUE(master.init());
+    }
+
+    // Layouts the bus can not have, the first entry of the left wheel's outputs is registered at 0.
+    auto snapshot = ec::topology::readSnapshotFile(configPath + ".topology");
+    ASSERT_TRUE(snapshot);
+    for(auto& offset : snapshot->domains.at(0).offsets)
+    {
+        offset += 2;
+    }
+    ASSERT_TRUE(ec::topology::writeSnapshotFile(configPath + ".topology", snapshot.value()));
+
+    {
+        Master master(configPath);
+        ASSERT_TRUE(master.init());
+        EXPECT_TRUE(master.isFastRestart());
+        EXPECT_EQ(getOffsets(master, "lifter"), (std::vector<uint>{24, 26, 30, 32}));
+    }
+
+    // The snapshot was rewritten with the registered offsets.
+    Master master(configPath);
+    ASSERT_TRUE(master.init());
+    EXPECT_EQ(getOffsets(master, "lifter"), (std::vector<uint>{24, 26, 30, 32}));
+    EXPECT_EQ(ec::topology::readSnapshotFile(configPath + ".topology")->domains.at(0).offsets.front(), 0u);
+}
+
+TEST_F(TopologyTest, ChangedBusFallsBackToValidation)
+{
+    {
+        Master master(configPath);
+        ASSERT_TRUE(master.init());
+    }
+
+    // Same identities, a drive got a firmware update.
+    bus.at(3).revisionNumber = 0x00020000;
+    fake_ecrt::setBus(bus);
+    {
+        Master master(configPath);
+        ASSERT_TRUE(master.init());
+        EXPECT_FALSE(master.isFastRestart());
+    }
+
+    Master master(configPath);
+    ASSERT_TRUE(master.init());
+    EXPECT_TRUE(master.isFastRestart());
+}
+
+TEST_F(TopologyTest, ChangedConfigurationFallsBackToValidation)
+{
+    {
+        Master master(configPath);
+        ASSERT_TRUE(master.init());
+    }
+
+    std::ofstream(configPath, std::ios::app) << "# edited\n";
+
+    Master master(configPath);
+    ASSERT_TRUE(master.init());
+    EXPECT_FALSE(master.isFastRestart());
+}
+
+TEST_F(TopologyTest, MismatchedSlaveFailsInit)
+{
+    bus.at(2).productCode = 0x00000301;
+    fake_ecrt::setBus(bus);
+
+    Master master(configPath);
+    EXPECT_FALSE(master.init());
+}
+
+TEST_F(TopologyTest, MismatchesAreFoundThroughAliases)
+{
+    ec::SlaveInfo slaveInfo;
+    slaveInfo.slaveName = "lifter";
+    slaveInfo.alias = 7;
+    slaveInfo.position = 1;
+    slaveInfo.vendorID = VendorID;
+    slaveInfo.productCode = ProductCode;
+
+    std::vector<ec::topology::SlaveIdentity> scannedBus = {
+        {0, 0, 0x00000002, 0x044c2c52, 0},
+        {7, 1, VendorID, ProductCode, 0},
+        {0, 2, VendorID, 0x00000301, 0}
+    };
+
+    const auto mismatches = ec::topology::findMismatches({slaveInfo}, scannedBus);
+    ASSERT_EQ(mismatches.size(), 1);
+    EXPECT_NE(mismatches.at(0).find("ring position 2"), std::string::npos);
+
+    // Slaves that are not on the bus are left to the master.
+    slaveInfo.position = 5;
+    EXPECT_TRUE(ec::topology::findMismatches({slaveInfo}, scannedBus).empty());
+}
+
+TEST_F(TopologyTest, CorruptedSnapshotIsRejected)
+{
+    ec::topology::TopologySnapshot snapshot{0x1234, {{0, 0, VendorID, ProductCode, 1}}, {{"domain", 8, {0, 2, 4}}}};
+    auto bytes = ec::topology::serialize(snapshot);
+
+    const auto restored = ec::topology::deserialize(bytes.data(), bytes.size());
+    ASSERT_TRUE(restored);
+    EXPECT_TRUE(restored->matches(0x1234, snapshot.slaves));
+    EXPECT_EQ(restored->domains, snapshot.domains);
+
+    EXPECT_FALSE(ec::topology::deserialize(bytes.data(), bytes.size() - 1));
+
+    // A count larger than the rest of the data fails before anything is allocated.
+    auto oversized = bytes;
+    const uint32_t slaveCount = UINT32_MAX;
+    std::memcpy(oversized.data() + sizeof(ec::topology::TopologyMagic) + sizeof(uint32_t) + sizeof(uint64_t), &slaveCount, sizeof(slaveCount));
+    EXPECT_FALSE(ec::topology::deserialize(oversized.data(), oversized.size()));
+
+    bytes.at(8) += 1;
+    EXPECT_FALSE(ec::topology::deserialize(bytes.data(), bytes.size()));
+}
+
+}
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}